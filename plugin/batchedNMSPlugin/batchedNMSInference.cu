@@ -18,6 +18,7 @@
 #include "common/kernels/kernel.h"
 #include "common/nmsUtils.h"
 #include "gatherNMSOutputs.h"
+#include <cstring>
 #include <cuda_runtime_api.h>
 namespace nvinfer1
 {
@@ -27,8 +28,8 @@ pluginStatus_t nmsInference(cudaStream_t stream, const int N, const int perBatch
     const bool shareLocation, const int backgroundLabelId, const int numPredsPerClass, const int numClasses,
     const int topK, const int keepTopK, const float scoreThreshold, const float iouThreshold, const DataType DT_BBOX,
     const void* locData, const DataType DT_SCORE, const void* confData, void* keepCount, void* nmsedBoxes,
-    void* nmsedScores, void* nmsedClasses, void* workspace, bool isNormalized, bool confSigmoid, bool clipBoxes,
-    int scoreBits, bool caffeSemantics)
+    void* nmsedScores, void* nmsedClasses, void* workspace, WorkspacePlanner& planner, bool isNormalized,
+    bool confSigmoid, bool clipBoxes, int scoreBits, bool caffeSemantics)
 {
     // locCount = batch_size * number_boxes_per_sample * 4
     const int locCount = N * perBatchBoxesSize;
@@ -41,9 +42,19 @@ pluginStatus_t nmsInference(cudaStream_t stream, const int N, const int perBatch
      */
     const int numLocClasses = shareLocation ? 1 : numClasses;
 
+    DetectionWorkspace buffers;
+    detectionInferenceWorkspaceLayout(shareLocation, N, perBatchBoxesSize, perBatchScoresSize, numClasses,
+        numPredsPerClass, topK, DT_BBOX, DT_SCORE, workspace, planner, &buffers);
     size_t bboxDataSize = detectionForwardBBoxDataSize(N, perBatchBoxesSize, DT_BBOX);
-    void* bboxDataRaw = workspace;
-    CSC(cudaMemcpyAsync(bboxDataRaw, locData, bboxDataSize, cudaMemcpyDeviceToDevice, stream), STATUS_FAILURE);
+    void* bboxDataRaw = buffers.bboxDataRaw;
+    if (getDetectionBackend() == DetectionBackend::kCPU)
+    {
+        std::memcpy(bboxDataRaw, locData, bboxDataSize);
+    }
+    else
+    {
+        CSC(cudaMemcpyAsync(bboxDataRaw, locData, bboxDataSize, cudaMemcpyDeviceToDevice, stream), STATUS_FAILURE);
+    }
     pluginStatus_t status;
 
     /*
@@ -52,8 +63,7 @@ pluginStatus_t nmsInference(cudaStream_t stream, const int N, const int perBatch
      */
     // float for now
     void* bboxData;
-    size_t bboxPermuteSize = detectionForwardBBoxPermuteSize(shareLocation, N, perBatchBoxesSize, DT_BBOX);
-    void* bboxPermute = nextWorkspacePtr((int8_t*) bboxDataRaw, bboxDataSize);
+    void* bboxPermute = buffers.bboxPermute;
 
     /*
      * After permutation, bboxData format:
@@ -81,9 +91,7 @@ pluginStatus_t nmsInference(cudaStream_t stream, const int N, const int perBatch
      * [batch size, numPriors * param.numClasses, 1, 1]
      */
     const int numScores = N * perBatchScoresSize;
-    size_t totalScoresSize = detectionForwardPreNMSSize(N, perBatchScoresSize);
-    if(DT_SCORE == DataType::kHALF) totalScoresSize /= 2; // detectionForwardPreNMSSize is implemented in terms of kFLOAT
-    void* scores = nextWorkspacePtr((int8_t*) bboxPermute, bboxPermuteSize);
+    void* scores = buffers.scores;
 
     // need a conf_scores
     /*
@@ -94,22 +102,16 @@ pluginStatus_t nmsInference(cudaStream_t stream, const int N, const int perBatch
         stream, numScores, numClasses, numPredsPerClass, 1, DT_SCORE, confSigmoid, confData, scores);
     ASSERT_FAILURE(status == STATUS_SUCCESS);
 
-    size_t indicesSize = detectionForwardPreNMSSize(N, perBatchScoresSize);
-    void* indices = nextWorkspacePtr((int8_t*) scores, totalScoresSize);
-
-    size_t postNMSScoresSize = detectionForwardPostNMSSize(N, numClasses, topK);
-    if(DT_SCORE == DataType::kHALF) postNMSScoresSize /= 2; // detectionForwardPostNMSSize is implemented in terms of kFLOAT
-    size_t postNMSIndicesSize = detectionForwardPostNMSSize(N, numClasses, topK); // indices are full int32
-    void* postNMSScores = nextWorkspacePtr((int8_t*) indices, indicesSize);
-    void* postNMSIndices = nextWorkspacePtr((int8_t*) postNMSScores, postNMSScoresSize);
+    void* indices = buffers.indices;
+    void* postNMSScores = buffers.postNMSScores;
+    void* postNMSIndices = buffers.postNMSIndices;
 
-    void* sortingWorkspace = nextWorkspacePtr((int8_t*) postNMSIndices, postNMSIndicesSize);
     // Sort the scores so that the following NMS could be applied.
     float scoreShift = 0.f;
     if(DT_SCORE == DataType::kHALF && scoreBits > 0 && scoreBits <= 10)
         scoreShift = 1.f;
     status = sortScoresPerClass(stream, N, numClasses, numPredsPerClass, backgroundLabelId, scoreThreshold,
-        DT_SCORE, scores, indices, sortingWorkspace, scoreBits, scoreShift);
+        DT_SCORE, scores, indices, buffers.sortPerClassWorkspace, scoreBits, scoreShift);
 
     ASSERT_FAILURE(status == STATUS_SUCCESS);
 
@@ -124,7 +126,7 @@ pluginStatus_t nmsInference(cudaStream_t stream, const int N, const int perBatch
 
     // Sort the bounding boxes after NMS using scores
     status = sortScoresPerImage(stream, N, numClasses * topK, DT_SCORE, postNMSScores, postNMSIndices, scores,
-        indices, sortingWorkspace, scoreBits);
+        indices, buffers.sortPerImageWorkspace, scoreBits);
 
     ASSERT_FAILURE(status == STATUS_SUCCESS);
 
@@ -271,7 +271,8 @@ int32_t BatchedNMSPlugin::enqueue(
         pluginStatus_t status = nmsInference(stream, batchSize, mBoxesSize, mScoresSize, param.shareLocation,
             param.backgroundLabelId, mNumPriors, param.numClasses, param.topK, param.keepTopK, param.scoreThreshold,
             param.iouThreshold, mPrecision, locData, mPrecision, confData, keepCount, nmsedBoxes, nmsedScores,
-            nmsedClasses, workspace, param.isNormalized, false, mClipBoxes, mScoreBits, mCaffeSemantics);
+            nmsedClasses, workspace, mWorkspacePlanner, param.isNormalized, false, mClipBoxes, mScoreBits,
+            mCaffeSemantics);
         return status == STATUS_SUCCESS ? 0 : -1;
     }
     catch (std::exception const& e)
@@ -302,7 +303,8 @@ int32_t BatchedNMSDynamicPlugin::enqueue(PluginTensorDesc const* inputDesc, Plug
         pluginStatus_t status = nmsInference(stream, inputDesc[0].dims.d[0], mBoxesSize, mScoresSize,
             param.shareLocation, param.backgroundLabelId, mNumPriors, param.numClasses, param.topK, param.keepTopK,
             param.scoreThreshold, param.iouThreshold, mPrecision, locData, mPrecision, confData, keepCount, nmsedBoxes,
-            nmsedScores, nmsedClasses, workspace, param.isNormalized, false, mClipBoxes, mScoreBits, mCaffeSemantics);
+            nmsedScores, nmsedClasses, workspace, mWorkspacePlanner, param.isNormalized, false, mClipBoxes, mScoreBits,
+            mCaffeSemantics);
         return status;
     }
     catch (std::exception const& e)
@@ -77,6 +77,8 @@ private:
     int32_t mScoreBits;
     bool mCaffeSemantics{true};
     pluginStatus_t mPluginStatus{};
+    //! Re-planned on every enqueue, reusing its storage.
+    WorkspacePlanner mWorkspacePlanner;
 };
 
 class BatchedNMSDynamicPlugin : public IPluginV2DynamicExt
@@ -129,6 +131,8 @@ private:
     int32_t mScoreBits;
     bool mCaffeSemantics{true};
     pluginStatus_t mPluginStatus{};
+    //! Re-planned on every enqueue, reusing its storage.
+    WorkspacePlanner mWorkspacePlanner;
 };
 
 class BatchedNMSBasePluginCreator : public nvinfer1::pluginInternal::BaseCreator
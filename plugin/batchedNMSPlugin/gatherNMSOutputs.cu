@@ -208,6 +208,12 @@ pluginStatus_t gatherNMSOutputs(
     const float scoreShift
     )
 {
+    if (nvinfer1::plugin::getDetectionBackend() == nvinfer1::plugin::DetectionBackend::kCPU)
+    {
+        return nvinfer1::plugin::cpu::gatherNMSOutputs(stream, shareLocation, numImages, numPredsPerClass, numClasses,
+            topK, keepTopK, DT_BBOX, DT_SCORE, indices, scores, bboxData, numDetections, nmsedBoxes, nmsedScores,
+            nmsedClasses, clipBoxes, scoreShift);
+    }
     nmsOutLaunchConfig lc = nmsOutLaunchConfig(DT_BBOX, DT_SCORE);
     for (unsigned i = 0; i < nmsOutLCOptions.size(); ++i)
     {
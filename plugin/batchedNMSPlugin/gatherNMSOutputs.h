@@ -23,4 +23,20 @@ pluginStatus_t gatherNMSOutputs(cudaStream_t stream, bool shareLocation, int num
     void const* indices, void const* scores, void const* bboxData, void* keepCount, void* nmsedBoxes, void* nmsedScores,
     void* nmsedClasses, bool clipBoxes, float const scoreShift);
 
+namespace nvinfer1
+{
+namespace plugin
+{
+namespace cpu
+{
+//! Host implementation of gatherNMSOutputs, used by nmsInference under DetectionBackend::kCPU. The stream is ignored
+//! and only FP32 data is supported.
+pluginStatus_t gatherNMSOutputs(cudaStream_t stream, bool shareLocation, int32_t numImages, int32_t numPredsPerClass,
+    int32_t numClasses, int32_t topK, int32_t keepTopK, nvinfer1::DataType DT_BBOX, nvinfer1::DataType DT_SCORE,
+    void const* indices, void const* scores, void const* bboxData, void* keepCount, void* nmsedBoxes,
+    void* nmsedScores, void* nmsedClasses, bool clipBoxes, float const scoreShift);
+} // namespace cpu
+} // namespace plugin
+} // namespace nvinfer1
+
 #endif
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/plugin.h"
+#include "gatherNMSOutputs.h"
+#include <algorithm>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+namespace cpu
+{
+pluginStatus_t gatherNMSOutputs(cudaStream_t /* stream */, bool shareLocation, int32_t numImages,
+    int32_t numPredsPerClass, int32_t numClasses, int32_t topK, int32_t keepTopK, DataType DT_BBOX, DataType DT_SCORE,
+    void const* indices, void const* scores, void const* bboxData, void* keepCount, void* nmsedBoxes,
+    void* nmsedScores, void* nmsedClasses, bool clipBoxes, float const scoreShift)
+{
+    if (DT_BBOX != DataType::kFLOAT || DT_SCORE != DataType::kFLOAT)
+    {
+        return STATUS_BAD_PARAM;
+    }
+    auto const* inIndices = static_cast<int32_t const*>(indices);
+    auto const* inScores = static_cast<float const*>(scores);
+    auto const* bboxes = static_cast<float const*>(bboxData);
+    auto* counts = static_cast<int32_t*>(keepCount);
+    auto* outBoxes = static_cast<float*>(nmsedBoxes);
+    auto* outScores = static_cast<float*>(nmsedScores);
+    auto* outClasses = static_cast<float*>(nmsedClasses);
+    // Clamps to [0, 1] like __saturatef, mapping NaN to 0.
+    auto const clip = [clipBoxes](float v) { return !clipBoxes ? v : (v > 0.F ? (v < 1.F ? v : 1.F) : 0.F); };
+
+    std::fill_n(counts, numImages, 0);
+    if (keepTopK > topK)
+    {
+        return STATUS_SUCCESS;
+    }
+    for (int32_t i = 0; i < numImages * keepTopK; ++i)
+    {
+        int32_t const imgId = i / keepTopK;
+        int32_t const offset = imgId * numClasses * topK + i % keepTopK;
+        int32_t const index = inIndices[offset];
+        float* box = outBoxes + i * 4;
+        if (index == -1)
+        {
+            outClasses[i] = -1.F;
+            outScores[i] = 0.F;
+            std::fill_n(box, 4, 0.F);
+            continue;
+        }
+        int32_t const bboxOffset = imgId * (shareLocation ? numPredsPerClass : (numClasses * numPredsPerClass));
+        int32_t const bboxId
+            = ((shareLocation ? (index % numPredsPerClass) : index % (numClasses * numPredsPerClass)) + bboxOffset) * 4;
+        outClasses[i] = static_cast<float>((index % (numClasses * numPredsPerClass)) / numPredsPerClass);
+        outScores[i] = inScores[offset] - scoreShift;
+        for (int32_t j = 0; j < 4; ++j)
+        {
+            box[j] = clip(bboxes[bboxId + j]);
+        }
+        ++counts[imgId];
+    }
+    return STATUS_SUCCESS;
+}
+} // namespace cpu
+} // namespace plugin
+} // namespace nvinfer1
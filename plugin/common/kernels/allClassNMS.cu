@@ -377,6 +377,12 @@ pluginStatus_t allClassNMS(cudaStream_t stream, const int num, const int num_cla
     void* beforeNMS_index_array, void* afterNMS_scores, void* afterNMS_index_array, bool flipXY,
     const float score_shift, bool caffeSemantics)
 {
+    if (getDetectionBackend() == DetectionBackend::kCPU)
+    {
+        return cpu::allClassNMS(stream, num, num_classes, num_preds_per_class, top_k, nms_threshold, share_location,
+            isNormalized, DT_SCORE, DT_BBOX, bbox_data, beforeNMS_scores, beforeNMS_index_array, afterNMS_scores,
+            afterNMS_index_array, flipXY, score_shift, caffeSemantics);
+    }
     nmsLaunchConfigSSD lc = nmsLaunchConfigSSD(DT_SCORE, DT_BBOX);
     for (unsigned i = 0; i < nmsSsdLCOptions.size(); ++i)
     {
@@ -382,6 +382,11 @@ pluginStatus_t decodeBBoxes(
     void* bbox_data,
     const bool batch_agnostic)
 {
+    if (getDetectionBackend() == DetectionBackend::kCPU)
+    {
+        return cpu::decodeBBoxes(stream, nthreads, code_type, variance_encoded_in_target, num_priors, share_location,
+            num_loc_classes, background_label_id, clip_bbox, DT_BBOX, loc_data, prior_data, bbox_data, batch_agnostic);
+    }
     dbbLaunchConfig lc = dbbLaunchConfig(DT_BBOX);
     for (unsigned i = 0; i < dbbLCOptions.size(); ++i)
     {
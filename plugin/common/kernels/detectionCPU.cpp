@@ -0,0 +1,511 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/kernels/kernel.h"
+#include "common/parallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+namespace
+{
+thread_local DetectionBackend gDetectionBackend{DetectionBackend::kCUDA};
+
+// Work below this many elements per thread is not worth a thread of its own.
+int32_t constexpr kMIN_ELEMENTS_PER_THREAD{16384};
+// Boxes are decoded in blocks of this size, transposed to structure-of-arrays so the arithmetic vectorizes.
+int32_t constexpr kDECODE_BLOCK{64};
+
+// Calls func(begin, end) on ranges of [0, count) holding at least kMIN_ELEMENTS_PER_THREAD elements, using up to one
+// thread per core.
+template <typename Func>
+void parallelForElements(int32_t count, int32_t elementsPerItem, Func const& func)
+{
+    parallelFor(count, std::max(1, kMIN_ELEMENTS_PER_THREAD / std::max(1, elementsPerItem)), 0, func);
+}
+
+// Clamps to [0, 1] like __saturatef, mapping NaN to 0.
+inline float saturate(float v)
+{
+    return v > 0.F ? (v < 1.F ? v : 1.F) : 0.F;
+}
+
+// Sorts (score, index) pairs by descending score, keeping the order of equal scores like the CUB radix sort.
+void sortPairsDescending(std::vector<std::pair<float, int32_t>>& items)
+{
+    std::stable_sort(items.begin(), items.end(),
+        [](std::pair<float, int32_t> const& a, std::pair<float, int32_t> const& b) { return a.first > b.first; });
+}
+} // namespace
+
+void setDetectionBackend(DetectionBackend backend)
+{
+    gDetectionBackend = backend;
+}
+
+DetectionBackend getDetectionBackend()
+{
+    return gDetectionBackend;
+}
+
+namespace cpu
+{
+pluginStatus_t decodeBBoxes(cudaStream_t /* stream */, int32_t nthreads, CodeTypeSSD code_type,
+    bool variance_encoded_in_target, int32_t num_priors, bool share_location, int32_t num_loc_classes,
+    int32_t background_label_id, bool clip_bbox, DataType DT_BBOX, void const* loc_data, void const* prior_data,
+    void* bbox_data, bool const batch_agnostic)
+{
+    if (DT_BBOX != DataType::kFLOAT)
+    {
+        return STATUS_BAD_PARAM;
+    }
+    auto const* loc = static_cast<float const*>(loc_data);
+    auto const* prior = static_cast<float const*>(prior_data);
+    auto* bbox = static_cast<float*>(bbox_data);
+    // TF_CENTER always applies the variances, like the CUDA kernel.
+    bool const useVariance = !variance_encoded_in_target || code_type == CodeTypeSSD::TF_CENTER;
+    int32_t const nbBoxes = nthreads / 4;
+    int32_t const nbBlocks = (nbBoxes + kDECODE_BLOCK - 1) / kDECODE_BLOCK;
+
+    parallelForElements(nbBlocks, kDECODE_BLOCK * 4, [&](int32_t blockBegin, int32_t blockEnd) {
+        float p[4][kDECODE_BLOCK];
+        float v[4][kDECODE_BLOCK];
+        float l[4][kDECODE_BLOCK];
+        float out[4][kDECODE_BLOCK];
+        for (int32_t block = blockBegin; block < blockEnd; ++block)
+        {
+            int32_t const first = block * kDECODE_BLOCK;
+            int32_t const count = std::min(kDECODE_BLOCK, nbBoxes - first);
+
+            // Gather the block into structure-of-arrays form.
+            for (int32_t k = 0; k < count; ++k)
+            {
+                int32_t const box = first + k;
+                int32_t const d = (box / num_loc_classes) % num_priors;
+                int32_t const batch = box / (num_loc_classes * num_priors);
+                int32_t const pi = batch_agnostic ? d * 4 : (batch * 2 * num_priors + d) * 4;
+                int32_t const vi = pi + num_priors * 4;
+                for (int32_t j = 0; j < 4; ++j)
+                {
+                    p[j][k] = prior[pi + j];
+                    v[j][k] = useVariance ? prior[vi + j] : 1.F;
+                    l[j][k] = loc[box * 4 + j];
+                }
+            }
+
+            switch (code_type)
+            {
+            case CodeTypeSSD::CORNER:
+                for (int32_t j = 0; j < 4; ++j)
+                {
+                    for (int32_t k = 0; k < count; ++k)
+                    {
+                        out[j][k] = p[j][k] + l[j][k] * v[j][k];
+                    }
+                }
+                break;
+            case CodeTypeSSD::CORNER_SIZE:
+                for (int32_t j = 0; j < 4; ++j)
+                {
+                    int32_t const lo = j % 2;
+                    for (int32_t k = 0; k < count; ++k)
+                    {
+                        out[j][k] = p[j][k] + l[j][k] * v[j][k] * (p[lo + 2][k] - p[lo][k]);
+                    }
+                }
+                break;
+            case CodeTypeSSD::CENTER_SIZE:
+            case CodeTypeSSD::TF_CENTER:
+            {
+                // TF_CENTER predicts (y, x, h, w) rather than (x, y, w, h).
+                int32_t const xi = code_type == CodeTypeSSD::TF_CENTER ? 1 : 0;
+                int32_t const yi = 1 - xi;
+                for (int32_t k = 0; k < count; ++k)
+                {
+                    float const priorWidth = p[2][k] - p[0][k];
+                    float const priorHeight = p[3][k] - p[1][k];
+                    float const priorCenterX = (p[0][k] + p[2][k]) / 2.F;
+                    float const priorCenterY = (p[1][k] + p[3][k]) / 2.F;
+                    float const centerX = v[0][k] * l[xi][k] * priorWidth + priorCenterX;
+                    float const centerY = v[1][k] * l[yi][k] * priorHeight + priorCenterY;
+                    float const width = std::exp(v[2][k] * l[xi + 2][k]) * priorWidth;
+                    float const height = std::exp(v[3][k] * l[yi + 2][k]) * priorHeight;
+                    out[0][k] = centerX - width / 2.F;
+                    out[1][k] = centerY - height / 2.F;
+                    out[2][k] = centerX + width / 2.F;
+                    out[3][k] = centerY + height / 2.F;
+                }
+                break;
+            }
+            }
+
+            // Scatter back, leaving the boxes of the background class untouched when locations are per class.
+            for (int32_t k = 0; k < count; ++k)
+            {
+                int32_t const box = first + k;
+                if (!share_location && box % num_loc_classes == background_label_id)
+                {
+                    continue;
+                }
+                for (int32_t j = 0; j < 4; ++j)
+                {
+                    bbox[box * 4 + j] = clip_bbox ? saturate(out[j][k]) : out[j][k];
+                }
+            }
+        }
+    });
+    return STATUS_SUCCESS;
+}
+
+pluginStatus_t permuteData(cudaStream_t /* stream */, int32_t nthreads, int32_t num_classes, int32_t num_data,
+    int32_t num_dim, DataType DT_DATA, bool confSigmoid, void const* data, void* new_data)
+{
+    if (DT_DATA != DataType::kFLOAT)
+    {
+        return STATUS_BAD_PARAM;
+    }
+    auto const* src = static_cast<float const*>(data);
+    auto* dst = static_cast<float*>(new_data);
+    // [batch_size, num_data, num_classes, num_dim] to [batch_size, num_classes, num_data, num_dim]
+    int32_t const rowSize = num_classes * num_dim;
+    int32_t const nbRows = nthreads / rowSize;
+    parallelForElements(nbRows, rowSize, [&](int32_t rowBegin, int32_t rowEnd) {
+        for (int32_t row = rowBegin; row < rowEnd; ++row)
+        {
+            int32_t const d = row % num_data;
+            int32_t const n = row / num_data;
+            for (int32_t c = 0; c < num_classes; ++c)
+            {
+                float const* in = src + (row * num_classes + c) * num_dim;
+                float* out = dst + ((n * num_classes + c) * num_data + d) * num_dim;
+                for (int32_t i = 0; i < num_dim; ++i)
+                {
+                    out[i] = confSigmoid ? std::exp(in[i]) / (1 + std::exp(in[i])) : in[i];
+                }
+            }
+        }
+    });
+    return STATUS_SUCCESS;
+}
+
+pluginStatus_t sortScoresPerClass(cudaStream_t /* stream */, int32_t num, int32_t num_classes,
+    int32_t num_preds_per_class, int32_t background_label_id, float confidence_threshold, DataType DT_SCORE,
+    void* conf_scores_gpu, void* index_array_gpu, void* /* workspace */, int32_t const /* score_bits */,
+    float const score_shift)
+{
+    if (DT_SCORE != DataType::kFLOAT)
+    {
+        return STATUS_BAD_PARAM;
+    }
+    auto* scores = static_cast<float*>(conf_scores_gpu);
+    auto* indices = static_cast<int32_t*>(index_array_gpu);
+    int32_t const numPredsPerBatch = num_classes * num_preds_per_class;
+    float const clipValue = score_shift + 1.F - 1.F / 1024.F;
+
+    parallelForElements(num * num_classes, num_preds_per_class, [&](int32_t segmentBegin, int32_t segmentEnd) {
+        std::vector<std::pair<float, int32_t>> items(num_preds_per_class);
+        for (int32_t segment = segmentBegin; segment < segmentEnd; ++segment)
+        {
+            int32_t const image = segment / num_classes;
+            int32_t const classId = segment % num_classes;
+            int32_t const offset = segment * num_preds_per_class;
+            for (int32_t p = 0; p < num_preds_per_class; ++p)
+            {
+                float const score = scores[offset + p];
+                if (classId == background_label_id || !(score > confidence_threshold))
+                {
+                    items[p] = {score_shift, -1};
+                }
+                else
+                {
+                    float shifted = score + score_shift;
+                    if (score_shift > 0.F && shifted >= clipValue)
+                    {
+                        shifted = clipValue;
+                    }
+                    items[p] = {shifted, classId * num_preds_per_class + p + image * numPredsPerBatch};
+                }
+            }
+            sortPairsDescending(items);
+            for (int32_t p = 0; p < num_preds_per_class; ++p)
+            {
+                scores[offset + p] = items[p].first;
+                indices[offset + p] = items[p].second;
+            }
+        }
+    });
+    return STATUS_SUCCESS;
+}
+
+pluginStatus_t allClassNMS(cudaStream_t /* stream */, int32_t num, int32_t num_classes, int32_t num_preds_per_class,
+    int32_t top_k, float nms_threshold, bool share_location, bool isNormalized, DataType DT_SCORE, DataType DT_BBOX,
+    void* bbox_data, void* beforeNMS_scores, void* beforeNMS_index_array, void* afterNMS_scores,
+    void* afterNMS_index_array, bool flipXY, float const score_shift, bool caffeSemantics)
+{
+    if (DT_SCORE != DataType::kFLOAT || DT_BBOX != DataType::kFLOAT)
+    {
+        return STATUS_BAD_PARAM;
+    }
+    auto const* bboxes = static_cast<float const*>(bbox_data);
+    auto const* inScores = static_cast<float const*>(beforeNMS_scores);
+    auto const* inIndices = static_cast<int32_t const*>(beforeNMS_index_array);
+    auto* outScores = static_cast<float*>(afterNMS_scores);
+    auto* outIndices = static_cast<int32_t*>(afterNMS_index_array);
+    // Only when using Caffe semantics, IOU calculation adds "1" to width and height if bbox is not normalized.
+    float const intersectPad = (!isNormalized && caffeSemantics) ? 1.F : 0.F;
+    float const areaPad = isNormalized ? 0.F : 1.F;
+    int32_t const nbCandidates = std::min(top_k, num_preds_per_class);
+
+    int32_t const elementsPerSegment = nbCandidates * nbCandidates / 8 + 1;
+    parallelForElements(num * num_classes, elementsPerSegment, [&](int32_t segmentBegin, int32_t segmentEnd) {
+        // Candidates of one class, as structure-of-arrays with min/max sorted corners.
+        std::vector<float> x1(nbCandidates), y1(nbCandidates), x2(nbCandidates), y2(nbCandidates);
+        std::vector<float> area(nbCandidates);
+        std::vector<uint8_t> kept(nbCandidates);
+        for (int32_t segment = segmentBegin; segment < segmentEnd; ++segment)
+        {
+            int32_t const image = segment / num_classes;
+            int32_t const offset = segment * num_preds_per_class;
+            int32_t const bboxIdxOffset = image * num_preds_per_class * (share_location ? 1 : num_classes);
+            for (int32_t t = 0; t < nbCandidates; ++t)
+            {
+                int32_t const index = inIndices[offset + t];
+                kept[t] = index != -1;
+                if (!kept[t])
+                {
+                    x1[t] = y1[t] = x2[t] = y2[t] = area[t] = 0.F;
+                    continue;
+                }
+                int32_t const bboxIdx = share_location ? index % num_preds_per_class + bboxIdxOffset : index;
+                float const* box = bboxes + bboxIdx * 4;
+                float const xa = flipXY ? box[1] : box[0];
+                float const ya = flipXY ? box[0] : box[1];
+                float const xb = flipXY ? box[3] : box[2];
+                float const yb = flipXY ? box[2] : box[3];
+                x1[t] = std::min(xa, xb);
+                x2[t] = std::max(xa, xb);
+                y1[t] = std::min(ya, yb);
+                y2[t] = std::max(ya, yb);
+                area[t] = (x2[t] - x1[t] + areaPad) * (y2[t] - y1[t] + areaPad);
+            }
+
+            // Greedy suppression in score order. The inner loop is branch free so that it vectorizes.
+            for (int32_t r = 0; r < nbCandidates; ++r)
+            {
+                if (!kept[r])
+                {
+                    continue;
+                }
+                float const rx1 = x1[r];
+                float const ry1 = y1[r];
+                float const rx2 = x2[r];
+                float const ry2 = y2[r];
+                float const rArea = area[r];
+                for (int32_t t = r + 1; t < nbCandidates; ++t)
+                {
+                    bool const disjoint = x1[t] > rx2 || x2[t] < rx1 || y1[t] > ry2 || y2[t] < ry1;
+                    float const width = (disjoint ? 0.F : std::min(rx2, x2[t]) - std::max(rx1, x1[t])) + intersectPad;
+                    float const height = (disjoint ? 0.F : std::min(ry2, y2[t]) - std::max(ry1, y1[t])) + intersectPad;
+                    float const intersection = width * height;
+                    bool const overlaps = width > 0.F && height > 0.F
+                        && intersection / (rArea + area[t] - intersection) > nms_threshold;
+                    kept[t] = kept[t] & static_cast<uint8_t>(!overlaps);
+                }
+            }
+
+            int32_t const writeOffset = segment * top_k;
+            for (int32_t t = 0; t < top_k; ++t)
+            {
+                bool const keep = t < nbCandidates && kept[t];
+                outScores[writeOffset + t] = keep ? inScores[offset + t] : score_shift;
+                outIndices[writeOffset + t] = keep ? inIndices[offset + t] : -1;
+            }
+        }
+    });
+    return STATUS_SUCCESS;
+}
+
+pluginStatus_t sortScoresPerImage(cudaStream_t /* stream */, int32_t num_images, int32_t num_items_per_image,
+    DataType DT_SCORE, void* unsorted_scores, void* unsorted_bbox_indices, void* sorted_scores,
+    void* sorted_bbox_indices, void* /* workspace */, int32_t /* score_bits */)
+{
+    if (DT_SCORE != DataType::kFLOAT)
+    {
+        return STATUS_BAD_PARAM;
+    }
+    auto const* inScores = static_cast<float const*>(unsorted_scores);
+    auto const* inIndices = static_cast<int32_t const*>(unsorted_bbox_indices);
+    auto* outScores = static_cast<float*>(sorted_scores);
+    auto* outIndices = static_cast<int32_t*>(sorted_bbox_indices);
+
+    parallelForElements(num_images, num_items_per_image, [&](int32_t imageBegin, int32_t imageEnd) {
+        std::vector<std::pair<float, int32_t>> items(num_items_per_image);
+        for (int32_t image = imageBegin; image < imageEnd; ++image)
+        {
+            int32_t const offset = image * num_items_per_image;
+            for (int32_t i = 0; i < num_items_per_image; ++i)
+            {
+                items[i] = {inScores[offset + i], inIndices[offset + i]};
+            }
+            sortPairsDescending(items);
+            for (int32_t i = 0; i < num_items_per_image; ++i)
+            {
+                outScores[offset + i] = items[i].first;
+                outIndices[offset + i] = items[i].second;
+            }
+        }
+    });
+    return STATUS_SUCCESS;
+}
+
+pluginStatus_t gatherTopDetections(cudaStream_t /* stream */, bool shareLocation, int32_t numImages,
+    int32_t numPredsPerClass, int32_t numClasses, int32_t topK, int32_t keepTopK, DataType DT_BBOX, DataType DT_SCORE,
+    void const* indices, void const* scores, void const* bboxData, void* keepCount, void* topDetections,
+    float const scoreShift)
+{
+    if (DT_BBOX != DataType::kFLOAT || DT_SCORE != DataType::kFLOAT)
+    {
+        return STATUS_BAD_PARAM;
+    }
+    auto const* inIndices = static_cast<int32_t const*>(indices);
+    auto const* inScores = static_cast<float const*>(scores);
+    auto const* bboxes = static_cast<float const*>(bboxData);
+    auto* counts = static_cast<int32_t*>(keepCount);
+    auto* detections = static_cast<float*>(topDetections);
+
+    std::fill_n(counts, numImages, 0);
+    if (keepTopK > topK)
+    {
+        return STATUS_SUCCESS;
+    }
+    for (int32_t imgId = 0; imgId < numImages; ++imgId)
+    {
+        int32_t const offset = imgId * numClasses * topK;
+        for (int32_t detId = 0; detId < keepTopK; ++detId)
+        {
+            float* det = detections + (imgId * keepTopK + detId) * 7;
+            int32_t const index = inIndices[offset + detId];
+            det[0] = static_cast<float>(imgId);
+            if (index == -1)
+            {
+                std::fill_n(det + 1, 6, 0.F);
+                det[1] = -1.F;
+                continue;
+            }
+            int32_t const bboxOffset = imgId * (shareLocation ? numPredsPerClass : (numClasses * numPredsPerClass));
+            int32_t const bboxId
+                = ((shareLocation ? (index % numPredsPerClass) : index % (numClasses * numPredsPerClass)) + bboxOffset)
+                * 4;
+            det[1] = static_cast<float>((index % (numClasses * numPredsPerClass)) / numPredsPerClass);
+            det[2] = inScores[offset + detId] - scoreShift;
+            for (int32_t j = 0; j < 4; ++j)
+            {
+                det[3 + j] = saturate(bboxes[bboxId + j]);
+            }
+            ++counts[imgId];
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+pluginStatus_t priorBoxInference(cudaStream_t /* stream */, PriorBoxParameters param, int32_t H, int32_t W,
+    int32_t numPriors, int32_t numAspectRatios, void const* minSize, void const* maxSize, void const* aspectRatios,
+    void* outputData)
+{
+    PLUGIN_ASSERT(param.numMaxSize >= 0);
+    auto const* minSizes = static_cast<float const*>(minSize);
+    auto const* maxSizes = static_cast<float const*>(maxSize);
+    auto const* ratios = static_cast<float const*>(aspectRatios);
+    auto* output = static_cast<float*>(outputData);
+    // output dims: (H, W, param.numMinSize, (1+haveMaxSize+numAR-1), 4)
+    int32_t const dim = H * W * numPriors;
+    bool const haveMaxSize = param.numMaxSize > 0;
+    int32_t const dimAR = (haveMaxSize ? 1 : 0) + numAspectRatios;
+    auto const clip = [&param](float v) { return param.clip ? std::min(std::max(v, 0.0F), 1.0F) : v; };
+
+    for (int32_t i = 0; i < dim; ++i)
+    {
+        int32_t const w = (i / numPriors) % W;
+        int32_t const h = (i / numPriors) / W;
+        float const centerX = (w + param.offset) * param.stepW;
+        float const centerY = (h + param.offset) * param.stepH;
+        int32_t const minSizeId = (i / dimAR) % param.numMinSize;
+        int32_t const arId = i % dimAR;
+        float boxW{};
+        float boxH{};
+        if (arId == 0)
+        {
+            boxW = minSizes[minSizeId];
+            boxH = boxW;
+        }
+        else if (haveMaxSize && arId == 1)
+        {
+            boxW = std::sqrt(minSizes[minSizeId] * maxSizes[minSizeId]);
+            boxH = boxW;
+        }
+        else
+        {
+            int32_t const arOffset = haveMaxSize ? arId - 1 : arId;
+            boxW = minSizes[minSizeId] * std::sqrt(ratios[arOffset]);
+            boxH = minSizes[minSizeId] / std::sqrt(ratios[arOffset]);
+        }
+        output[i * 4] = clip((centerX - boxW / 2.0F) / param.imgW);
+        output[i * 4 + 1] = clip((centerY - boxH / 2.0F) / param.imgH);
+        output[i * 4 + 2] = clip((centerX + boxW / 2.0F) / param.imgW);
+        output[i * 4 + 3] = clip((centerY + boxH / 2.0F) / param.imgH);
+        std::copy_n(param.variance, 4, output + (dim + i) * 4);
+    }
+    return STATUS_SUCCESS;
+}
+
+pluginStatus_t anchorGridInference(cudaStream_t /* stream */, GridAnchorParameters param, int32_t numAspectRatios,
+    void const* widths, void const* heights, void* outputData)
+{
+    auto const* anchorWidths = static_cast<float const*>(widths);
+    auto const* anchorHeights = static_cast<float const*>(heights);
+    auto* output = static_cast<float*>(outputData);
+    int32_t const dim = param.H * param.W * numAspectRatios;
+    float const anchorStrideH = (1.0F / param.H);
+    float const anchorStrideW = (1.0F / param.W);
+    float const anchorOffsetH = 0.5F * anchorStrideH;
+    float const anchorOffsetW = 0.5F * anchorStrideW;
+
+    for (int32_t tid = 0; tid < dim; ++tid)
+    {
+        int32_t const arId = tid % numAspectRatios;
+        int32_t const currIndex = tid / numAspectRatios;
+        int32_t const w = currIndex % param.W;
+        int32_t const h = currIndex / param.W;
+        float const yC = h * anchorStrideH + anchorOffsetH;
+        float const xC = w * anchorStrideW + anchorOffsetW;
+        output[tid * 4] = xC - 0.5 * anchorWidths[arId];
+        output[tid * 4 + 1] = yC - 0.5 * anchorHeights[arId];
+        output[tid * 4 + 2] = xC + 0.5 * anchorWidths[arId];
+        output[tid * 4 + 3] = yC + 0.5 * anchorHeights[arId];
+        std::copy_n(param.variance, 4, output + (dim + tid) * 4);
+    }
+    return STATUS_SUCCESS;
+}
+} // namespace cpu
+
+} // namespace plugin
+} // namespace nvinfer1
@@ -44,6 +44,7 @@ pluginStatus_t detectionInference(
     void* keepCount,
     void* topDetections,
     void* workspace,
+    WorkspacePlanner& planner,
     bool isNormalized,
     bool confSigmoid,
     int scoreBits,
@@ -61,8 +62,10 @@ pluginStatus_t detectionInference(
      */
     const int numLocClasses = shareLocation ? 1 : numClasses;
 
-    size_t bboxDataSize = detectionForwardBBoxDataSize(N, C1, DT_BBOX);
-    void* bboxDataRaw = workspace;
+    DetectionWorkspace buffers;
+    detectionInferenceWorkspaceLayout(shareLocation, N, C1, C2, numClasses, numPredsPerClass, topK, DT_BBOX, DT_SCORE,
+        workspace, planner, &buffers);
+    void* bboxDataRaw = buffers.bboxDataRaw;
 
     pluginStatus_t status = decodeBBoxes(stream,
                                       locCount,
@@ -87,8 +90,7 @@ pluginStatus_t detectionInference(
      */
     // float for now
     void* bboxData;
-    size_t bboxPermuteSize = detectionForwardBBoxPermuteSize(shareLocation, N, C1, DT_BBOX);
-    void* bboxPermute = nextWorkspacePtr((int8_t*) bboxDataRaw, bboxDataSize);
+    void* bboxPermute = buffers.bboxPermute;
 
     /*
      * After permutation, bboxData format:
@@ -122,9 +124,7 @@ pluginStatus_t detectionInference(
      * [batch size, numPriors * param.numClasses, 1, 1]
      */
     const int numScores = N * C2;
-    size_t scoresSize = detectionForwardPreNMSSize(N, C2);
-    if (DT_SCORE == DataType::kHALF) scoresSize /= 2;
-    void* scores = nextWorkspacePtr((int8_t*) bboxPermute, bboxPermuteSize);
+    void* scores = buffers.scores;
     // need a conf_scores
     /*
      * After permutation, confData format:
@@ -141,17 +141,9 @@ pluginStatus_t detectionInference(
                          scores);
     ASSERT_FAILURE(status == STATUS_SUCCESS);
 
-    size_t indicesSize = detectionForwardPreNMSSize(N, C2);
-    void* indices = nextWorkspacePtr((int8_t*) scores, scoresSize);
-
-    size_t postNMSScoresSize = detectionForwardPostNMSSize(N, numClasses, topK);
-    if (DT_SCORE == DataType::kHALF) postNMSScoresSize /= 2;
-    size_t postNMSIndicesSize = detectionForwardPostNMSSize(N, numClasses, topK);
-    void* postNMSScores = nextWorkspacePtr((int8_t*) indices, indicesSize);
-    void* postNMSIndices = nextWorkspacePtr((int8_t*) postNMSScores, postNMSScoresSize);
-
-    //size_t sortingWorkspaceSize = sortScoresPerClassWorkspaceSize(N, numClasses, numPredsPerClass, FLOAT32);
-    void* sortingWorkspace = nextWorkspacePtr((int8_t*) postNMSIndices, postNMSIndicesSize);
+    void* indices = buffers.indices;
+    void* postNMSScores = buffers.postNMSScores;
+    void* postNMSIndices = buffers.postNMSIndices;
     // Sort the scores so that the following NMS could be applied.
     float scoreShift = 0.f;
     if(DT_SCORE == DataType::kHALF && scoreBits > 0 && scoreBits <= 10)
@@ -165,7 +157,7 @@ pluginStatus_t detectionInference(
                                 DT_SCORE,
                                 scores,
                                 indices,
-                                sortingWorkspace,
+                                buffers.sortPerClassWorkspace,
                                 scoreBits,
                                 scoreShift);
     ASSERT_FAILURE(status == STATUS_SUCCESS);
@@ -184,7 +176,7 @@ pluginStatus_t detectionInference(
                                 postNMSIndices,
                                 scores,
                                 indices,
-                                sortingWorkspace,
+                                buffers.sortPerImageWorkspace,
                                 scoreBits);
     ASSERT_FAILURE(status == STATUS_SUCCESS);
 
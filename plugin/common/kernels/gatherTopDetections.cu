@@ -203,6 +203,11 @@ pluginStatus_t gatherTopDetections(
     void* topDetections,
     const float score_shift)
 {
+    if (getDetectionBackend() == DetectionBackend::kCPU)
+    {
+        return cpu::gatherTopDetections(stream, shareLocation, numImages, numPredsPerClass, numClasses, topK, keepTopK,
+            DT_BBOX, DT_SCORE, indices, scores, bboxData, keepCount, topDetections, score_shift);
+    }
     gtdLaunchConfig lc = gtdLaunchConfig(DT_BBOX, DT_SCORE);
     for (unsigned i = 0; i < gtdLCOptions.size(); ++i)
     {
@@ -108,6 +108,10 @@ namespace plugin
 pluginStatus_t anchorGridInference(cudaStream_t stream, const GridAnchorParameters param, const int numAspectRatios,
     const void* widths, const void* heights, void* outputData)
 {
+    if (getDetectionBackend() == DetectionBackend::kCPU)
+    {
+        return cpu::anchorGridInference(stream, param, numAspectRatios, widths, heights, outputData);
+    }
     const int dim = param.H * param.W * numAspectRatios;
     ReducedDivisor divObj(numAspectRatios);
     if (dim > 5120)
@@ -17,23 +17,68 @@
 
 #include "common/kernels/kernel.h"
 #include "common/plugin.h"
+#include "common/workspacePlanner.h"
 namespace nvinfer1
 {
 namespace plugin
 {
+namespace
+{
+// Steps of detectionInference and nmsInference, in the order they touch the workspace.
+enum DetectionStep : int32_t
+{
+    kDECODE = 0,
+    kPERMUTE,
+    kSORT_PER_CLASS,
+    kNMS,
+    kSORT_PER_IMAGE,
+    kGATHER
+};
+} // namespace
+
+size_t detectionInferenceWorkspaceLayout(bool shareLocation, int32_t N, int32_t C1, int32_t C2, int32_t numClasses,
+    int32_t numPredsPerClass, int32_t topK, DataType DT_BBOX, DataType DT_SCORE, void* workspace,
+    WorkspacePlanner& planner, DetectionWorkspace* buffers)
+{
+    // Declared so that the short-lived sort workspaces are packed with the decoded boxes when those die early.
+    planner.reset();
+    // The decoded boxes are only needed until they are permuted, unless they are used as they are.
+    int32_t const bboxDataRaw = planner.addBuffer(
+        detectionForwardBBoxDataSize(N, C1, DT_BBOX), kDECODE, shareLocation ? kGATHER : kPERMUTE);
+    int32_t const bboxPermute
+        = planner.addBuffer(detectionForwardBBoxPermuteSize(shareLocation, N, C1, DT_BBOX), kPERMUTE, kGATHER);
+    // Scores and indices are sorted per class, consumed by NMS, then overwritten with the per-image sort results.
+    int32_t const scores = planner.addBuffer(detectionForwardPreNMSSize(N, C2), kPERMUTE, kGATHER);
+    int32_t const sortPerClassWorkspace = planner.addBuffer(
+        sortScoresPerClassWorkspaceSize(N, numClasses, numPredsPerClass, DT_SCORE), kSORT_PER_CLASS, kSORT_PER_CLASS);
+    int32_t const sortPerImageWorkspace = planner.addBuffer(
+        sortScoresPerImageWorkspaceSize(N, numClasses * topK, DT_SCORE), kSORT_PER_IMAGE, kSORT_PER_IMAGE);
+    int32_t const indices = planner.addBuffer(detectionForwardPreNMSSize(N, C2), kSORT_PER_CLASS, kGATHER);
+    int32_t const postNMSScores
+        = planner.addBuffer(detectionForwardPostNMSSize(N, numClasses, topK), kNMS, kSORT_PER_IMAGE);
+    int32_t const postNMSIndices
+        = planner.addBuffer(detectionForwardPostNMSSize(N, numClasses, topK), kNMS, kSORT_PER_IMAGE);
+
+    if (buffers != nullptr)
+    {
+        buffers->bboxDataRaw = planner.getBuffer<void>(workspace, bboxDataRaw);
+        buffers->bboxPermute = planner.getBuffer<void>(workspace, bboxPermute);
+        buffers->scores = planner.getBuffer<void>(workspace, scores);
+        buffers->indices = planner.getBuffer<void>(workspace, indices);
+        buffers->postNMSScores = planner.getBuffer<void>(workspace, postNMSScores);
+        buffers->postNMSIndices = planner.getBuffer<void>(workspace, postNMSIndices);
+        buffers->sortPerClassWorkspace = planner.getBuffer<void>(workspace, sortPerClassWorkspace);
+        buffers->sortPerImageWorkspace = planner.getBuffer<void>(workspace, sortPerImageWorkspace);
+    }
+    return planner.getTotalSize();
+}
+
 size_t detectionInferenceWorkspaceSize(bool shareLocation, int32_t N, int32_t C1, int32_t C2, int32_t numClasses,
     int32_t numPredsPerClass, int32_t topK, DataType DT_BBOX, DataType DT_SCORE)
 {
-    size_t wss[7];
-    wss[0] = detectionForwardBBoxDataSize(N, C1, DT_BBOX);
-    wss[1] = detectionForwardBBoxPermuteSize(shareLocation, N, C1, DT_BBOX);
-    wss[2] = detectionForwardPreNMSSize(N, C2);
-    wss[3] = detectionForwardPreNMSSize(N, C2);
-    wss[4] = detectionForwardPostNMSSize(N, numClasses, topK);
-    wss[5] = detectionForwardPostNMSSize(N, numClasses, topK);
-    wss[6] = std::max(sortScoresPerClassWorkspaceSize(N, numClasses, numPredsPerClass, DT_SCORE),
-        sortScoresPerImageWorkspaceSize(N, numClasses * topK, DT_SCORE));
-    return calculateTotalWorkspaceSize(wss, 7);
+    WorkspacePlanner planner;
+    return detectionInferenceWorkspaceLayout(
+        shareLocation, N, C1, C2, numClasses, numPredsPerClass, topK, DT_BBOX, DT_SCORE, nullptr, planner, nullptr);
 }
 } // namespace plugin
 } // namespace nvinfer1
@@ -19,6 +19,7 @@
 #define TRT_KERNEL_H
 
 #include "common/plugin.h"
+#include "common/workspacePlanner.h"
 #include <algorithm>
 #include <cassert>
 #include <cstdio>
@@ -46,21 +47,40 @@ pluginStatus_t detectionInference(cudaStream_t stream, int32_t N, int32_t C1, in
     bool varianceEncodedInTarget, int32_t backgroundLabelId, int32_t numPredsPerClass, int32_t numClasses, int32_t topK,
     int32_t keepTopK, float confidenceThreshold, float nmsThreshold, nvinfer1::plugin::CodeTypeSSD codeType,
     nvinfer1::DataType DT_BBOX, void const* locData, void const* priorData, nvinfer1::DataType DT_SCORE,
-    void const* confData, void* keepCount, void* topDetections, void* workspace, bool isNormalized = true,
-    bool confSigmoid = false, int32_t scoreBits = 16, bool const isBatchAgnostic = true);
+    void const* confData, void* keepCount, void* topDetections, void* workspace, WorkspacePlanner& planner,
+    bool isNormalized = true, bool confSigmoid = false, int32_t scoreBits = 16, bool const isBatchAgnostic = true);
 
 pluginStatus_t nmsInference(cudaStream_t stream, int32_t N, int32_t boxesSize, int32_t scoresSize, bool shareLocation,
     int32_t backgroundLabelId, int32_t numPredsPerClass, int32_t numClasses, int32_t topK, int32_t keepTopK,
     float scoreThreshold, float iouThreshold, nvinfer1::DataType DT_BBOX, void const* locData,
     nvinfer1::DataType DT_SCORE, void const* confData, void* keepCount, void* nmsedBoxes, void* nmsedScores,
-    void* nmsedClasses, void* workspace, bool isNormalized = true, bool confSigmoid = false, bool clipBoxes = true,
-    int32_t scoreBits = 16, bool caffeSemantics = true);
+    void* nmsedClasses, void* workspace, WorkspacePlanner& planner, bool isNormalized = true, bool confSigmoid = false,
+    bool clipBoxes = true, int32_t scoreBits = 16, bool caffeSemantics = true);
 
 pluginStatus_t gatherTopDetections(cudaStream_t stream, bool shareLocation, int32_t numImages, int32_t numPredsPerClass,
     int32_t numClasses, int32_t topK, int32_t keepTopK, nvinfer1::DataType DT_BBOX, nvinfer1::DataType DT_SCORE,
     void const* indices, void const* scores, void const* bboxData, void* keepCount, void* topDetections,
     float const scoreShift);
 
+//! Scratch buffers shared by detectionInference and nmsInference.
+struct DetectionWorkspace
+{
+    void* bboxDataRaw;
+    void* bboxPermute;
+    void* scores;
+    void* indices;
+    void* postNMSScores;
+    void* postNMSIndices;
+    void* sortPerClassWorkspace;
+    void* sortPerImageWorkspace;
+};
+
+//! Lays out the detection scratch buffers with planner, aliasing the ones with disjoint lifetimes. Fills buffers with
+//! their addresses in workspace when buffers is not null, and returns the workspace size.
+size_t detectionInferenceWorkspaceLayout(bool shareLocation, int32_t N, int32_t C1, int32_t C2, int32_t numClasses,
+    int32_t numPredsPerClass, int32_t topK, nvinfer1::DataType DT_BBOX, nvinfer1::DataType DT_SCORE, void* workspace,
+    WorkspacePlanner& planner, DetectionWorkspace* buffers);
+
 size_t detectionForwardBBoxDataSize(int32_t N, int32_t C1, nvinfer1::DataType DT_BBOX);
 
 size_t detectionForwardBBoxPermuteSize(bool shareLocation, int32_t N, int32_t C1, nvinfer1::DataType DT_BBOX);
@@ -116,6 +136,60 @@ pluginStatus_t reorgInference(cudaStream_t stream, int32_t batch, int32_t C, int
 pluginStatus_t anchorGridInference(cudaStream_t stream, nvinfer1::plugin::GridAnchorParameters param,
     int32_t numAspectRatios, void const* aspectRatios, void const* scales, void* outputData);
 
+//! Where the SSD/Faster R-CNN detection kernels run: decodeBBoxes, permuteData, sortScoresPerClass, allClassNMS,
+//! sortScoresPerImage, gatherTopDetections, priorBoxInference and anchorGridInference, and so detectionInference and
+//! nmsInference. With kCPU these launchers forward to the implementations in namespace cpu, so all their pointers,
+//! the workspace included, must be host pointers. The backend is selected per thread and defaults to kCUDA. Plugins
+//! always enqueue with kCUDA, since TensorRT hands them device buffers; kCPU is for host callers of the kernel
+//! library, such as CPU-only post-processing and the tests in plugin/tests.
+enum class DetectionBackend : int32_t
+{
+    kCUDA = 0,
+    kCPU = 1
+};
+
+void setDetectionBackend(DetectionBackend backend);
+
+DetectionBackend getDetectionBackend();
+
+namespace cpu
+{
+//! Host implementations of the detection kernels, with the signatures of the CUDA launchers. The stream is ignored,
+//! only FP32 data is supported, and work is split across threads by image and class.
+pluginStatus_t decodeBBoxes(cudaStream_t stream, int32_t nthreads, nvinfer1::plugin::CodeTypeSSD code_type,
+    bool variance_encoded_in_target, int32_t num_priors, bool share_location, int32_t num_loc_classes,
+    int32_t background_label_id, bool clip_bbox, nvinfer1::DataType DT_BBOX, void const* loc_data,
+    void const* prior_data, void* bbox_data, bool const batch_agnostic);
+
+pluginStatus_t permuteData(cudaStream_t stream, int32_t nthreads, int32_t num_classes, int32_t num_data,
+    int32_t num_dim, nvinfer1::DataType DT_DATA, bool confSigmoid, void const* data, void* new_data);
+
+pluginStatus_t sortScoresPerClass(cudaStream_t stream, int32_t num, int32_t num_classes, int32_t num_preds_per_class,
+    int32_t background_label_id, float confidence_threshold, nvinfer1::DataType DT_SCORE, void* conf_scores_gpu,
+    void* index_array_gpu, void* workspace, int32_t const score_bits, float const score_shift);
+
+pluginStatus_t allClassNMS(cudaStream_t stream, int32_t num, int32_t num_classes, int32_t num_preds_per_class,
+    int32_t top_k, float nms_threshold, bool share_location, bool isNormalized, nvinfer1::DataType DT_SCORE,
+    nvinfer1::DataType DT_BBOX, void* bbox_data, void* beforeNMS_scores, void* beforeNMS_index_array,
+    void* afterNMS_scores, void* afterNMS_index_array, bool flipXY, float const score_shift, bool caffeSemantics);
+
+pluginStatus_t sortScoresPerImage(cudaStream_t stream, int32_t num_images, int32_t num_items_per_image,
+    nvinfer1::DataType DT_SCORE, void* unsorted_scores, void* unsorted_bbox_indices, void* sorted_scores,
+    void* sorted_bbox_indices, void* workspace, int32_t score_bits);
+
+pluginStatus_t gatherTopDetections(cudaStream_t stream, bool shareLocation, int32_t numImages, int32_t numPredsPerClass,
+    int32_t numClasses, int32_t topK, int32_t keepTopK, nvinfer1::DataType DT_BBOX, nvinfer1::DataType DT_SCORE,
+    void const* indices, void const* scores, void const* bboxData, void* keepCount, void* topDetections,
+    float const scoreShift);
+
+pluginStatus_t priorBoxInference(cudaStream_t stream, nvinfer1::plugin::PriorBoxParameters param, int32_t H, int32_t W,
+    int32_t numPriors, int32_t numAspectRatios, void const* minSize, void const* maxSize, void const* aspectRatios,
+    void* outputData);
+
+pluginStatus_t anchorGridInference(cudaStream_t stream, nvinfer1::plugin::GridAnchorParameters param,
+    int32_t numAspectRatios, void const* aspectRatios, void const* scales, void* outputData);
+} // namespace cpu
+
 pluginStatus_t regionInference(cudaStream_t stream, int32_t batch, int32_t C, int32_t H, int32_t W, int32_t num,
     int32_t coords, int32_t classes, bool hasSoftmaxTree, nvinfer1::plugin::softmaxTree const* smTree,
     void const* input, void* output);
@@ -262,6 +336,13 @@ void generateBaseFeatures_launch(int32_t batch_size, uint32_t* mask, float* voxe
     int32_t grid_x_size, uint32_t* pillar_num, int32_t max_pillar_num, int32_t max_points_per_voxel,
     int32_t num_point_values, float* voxel_features, uint32_t* voxel_num_points, uint32_t* coords, cudaStream_t stream);
 
+void generateSparseVoxels_launch(int32_t batch_size, int32_t max_num_points, float* points, uint32_t* points_size,
+    float min_x_range, float max_x_range, float min_y_range, float max_y_range, float min_z_range, float max_z_range,
+    float pillar_x_size, float pillar_y_size, int32_t grid_x_size, int32_t num_point_values,
+    int32_t max_points_per_voxel, uint32_t hash_capacity, uint32_t* hash_keys, uint32_t* hash_values,
+    uint32_t* pillar_num, int32_t max_pillar_num, uint32_t* coords, int32_t sparse_pillar_num, uint32_t* pillar_points,
+    float* voxels, uint32_t* voxel_num_points, cudaStream_t stream);
+
 int32_t generateFeatures_launch(int32_t batch_size, int32_t dense_pillar_num, float* voxel_features,
     uint32_t* voxel_num_points, uint32_t* coords, uint32_t* params, float voxel_x, float voxel_y, float voxel_z,
     float range_min_x, float range_min_y, float range_min_z, uint32_t voxel_features_size, uint32_t max_points,
@@ -92,6 +92,10 @@ static std::array<pdLaunchConfig, 2> pdLCOptions = {
 pluginStatus_t permuteData(cudaStream_t stream, const int nthreads, const int num_classes, const int num_data,
     const int num_dim, const DataType DT_DATA, bool confSigmoid, const void* data, void* new_data)
 {
+    if (getDetectionBackend() == DetectionBackend::kCPU)
+    {
+        return cpu::permuteData(stream, nthreads, num_classes, num_data, num_dim, DT_DATA, confSigmoid, data, new_data);
+    }
     pdLaunchConfig lc = pdLaunchConfig(DT_DATA);
     for (unsigned i = 0; i < pdLCOptions.size(); ++i)
     {
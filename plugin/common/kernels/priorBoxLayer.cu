@@ -191,6 +191,11 @@ pluginStatus_t priorBoxInference(cudaStream_t stream, const PriorBoxParameters p
     const int numPriors, const int numAspectRatios, const void* minSize, const void* maxSize, const void* aspectRatios,
     void* outputData)
 {
+    if (getDetectionBackend() == DetectionBackend::kCPU)
+    {
+        return cpu::priorBoxInference(
+            stream, param, H, W, numPriors, numAspectRatios, minSize, maxSize, aspectRatios, outputData);
+    }
     PLUGIN_ASSERT(param.numMaxSize >= 0);
     if (param.numMaxSize)
         return priorBoxGpu(stream, param, H, W, numPriors, numAspectRatios, minSize, maxSize, aspectRatios, outputData);
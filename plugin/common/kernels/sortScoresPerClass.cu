@@ -244,6 +244,11 @@ pluginStatus_t sortScoresPerClass(
     const float score_shift
 )
 {
+    if (getDetectionBackend() == DetectionBackend::kCPU)
+    {
+        return cpu::sortScoresPerClass(stream, num, num_classes, num_preds_per_class, background_label_id,
+            confidence_threshold, DT_SCORE, conf_scores_gpu, index_array_gpu, workspace, score_bits, score_shift);
+    }
     sspcLaunchConfig lc = sspcLaunchConfig(DT_SCORE);
     for (unsigned i = 0; i < sspcLCOptions.size(); ++i)
     {
@@ -103,6 +103,11 @@ pluginStatus_t sortScoresPerImage(
     int score_bits
 )
 {
+    if (getDetectionBackend() == DetectionBackend::kCPU)
+    {
+        return cpu::sortScoresPerImage(stream, num_images, num_items_per_image, DT_SCORE, unsorted_scores,
+            unsorted_bbox_indices, sorted_scores, sorted_bbox_indices, workspace, score_bits);
+    }
     sspiLaunchConfig lc = sspiLaunchConfig(DT_SCORE);
     for (unsigned i = 0; i < sspiLCOptions.size(); ++i)
     {
@@ -157,6 +157,182 @@ void generateBaseFeatures_launch(
       );
 }
 
+// Sparse voxelization: occupied pillars are found with an open addressing hash table of pillar indices, so that
+// the workspace scales with the number of points rather than with the size of the grid.
+// Hash keys are the pillar index in the frame plus one, so that zero marks an empty slot.
+__device__ inline unsigned int hashPillar(unsigned int key, unsigned int hash_capacity)
+{
+  return (key * 2654435761u) & (hash_capacity - 1);
+}
+
+__device__ inline bool getPointPillarKey(
+        float *points, int point_idx, int num_point_values,
+        float min_x_range, float max_x_range,
+        float min_y_range, float max_y_range,
+        float min_z_range, float max_z_range,
+        float pillar_x_size, float pillar_y_size,
+        int grid_x_size, unsigned int &key)
+{
+  float px = points[num_point_values * point_idx];
+  float py = points[num_point_values * point_idx + 1];
+  float pz = points[num_point_values * point_idx + 2];
+  if(px<min_x_range||px>=max_x_range
+    || py<min_y_range||py>=max_y_range
+    || pz<min_z_range||pz>=max_z_range) return false;
+  int voxel_idx = floorf((px - min_x_range)/pillar_x_size);
+  int voxel_idy = floorf((py - min_y_range)/pillar_y_size);
+  key = voxel_idy * grid_x_size + voxel_idx + 1;
+  return true;
+}
+
+__global__ void insertPillars_kernel(
+        int batch_size, int max_num_points,
+        float *points, unsigned int* points_size,
+        float min_x_range, float max_x_range,
+        float min_y_range, float max_y_range,
+        float min_z_range, float max_z_range,
+        float pillar_x_size, float pillar_y_size,
+        int grid_x_size, int num_point_values,
+        unsigned int hash_capacity, unsigned int *hash_keys)
+{
+  int point_idx = blockIdx.x * blockDim.x + threadIdx.x;
+  int batch_idx = point_idx / max_num_points;
+  int point_idx_in_frame = point_idx % max_num_points;
+  if(batch_idx >= batch_size || point_idx_in_frame >= points_size[batch_idx]) return;
+  unsigned int key;
+  if(!getPointPillarKey(points, point_idx, num_point_values, min_x_range, max_x_range, min_y_range, max_y_range,
+      min_z_range, max_z_range, pillar_x_size, pillar_y_size, grid_x_size, key)) return;
+  unsigned int *keys = hash_keys + batch_idx * hash_capacity;
+  unsigned int slot = hashPillar(key, hash_capacity);
+  // The table holds at least twice as many slots as points, so probing always terminates.
+  while (true) {
+    unsigned int prev = atomicCAS(keys + slot, 0u, key);
+    if (prev == 0u || prev == key) return;
+    slot = (slot + 1) & (hash_capacity - 1);
+  }
+}
+
+__global__ void compactPillars_kernel(
+        int batch_size,
+        unsigned int hash_capacity, unsigned int *hash_keys, unsigned int *hash_values,
+        int grid_x_size,
+        unsigned int *pillar_num,
+        int max_pillar_num,
+        unsigned int *coords)
+{
+  int slot_id = blockIdx.x * blockDim.x + threadIdx.x;
+  int batch_id = slot_id / hash_capacity;
+  if (batch_id >= batch_size) return;
+  unsigned int key = hash_keys[slot_id];
+  if (key == 0u) return;
+  unsigned int current_pillarId = atomicAdd(pillar_num + batch_id, 1);
+  hash_values[slot_id] = current_pillarId;
+  if (current_pillarId >= max_pillar_num) return;
+  int voxel_idx = (key - 1) % grid_x_size;
+  int voxel_idy = (key - 1) / grid_x_size;
+  int4 coord = {0, 0, voxel_idy, voxel_idx};
+  ((int4*)coords)[batch_id * max_pillar_num + current_pillarId] = coord;
+}
+
+__global__ void scatterPoints_kernel(
+        int batch_size, int max_num_points,
+        float *points, unsigned int* points_size,
+        float min_x_range, float max_x_range,
+        float min_y_range, float max_y_range,
+        float min_z_range, float max_z_range,
+        float pillar_x_size, float pillar_y_size,
+        int grid_x_size, int num_point_values,
+        int max_points_per_voxel,
+        unsigned int hash_capacity, unsigned int *hash_keys, unsigned int *hash_values,
+        int sparse_pillar_num, unsigned int *pillar_points, float *voxels)
+{
+  int point_idx = blockIdx.x * blockDim.x + threadIdx.x;
+  int batch_idx = point_idx / max_num_points;
+  int point_idx_in_frame = point_idx % max_num_points;
+  if(batch_idx >= batch_size || point_idx_in_frame >= points_size[batch_idx]) return;
+  unsigned int key;
+  if(!getPointPillarKey(points, point_idx, num_point_values, min_x_range, max_x_range, min_y_range, max_y_range,
+      min_z_range, max_z_range, pillar_x_size, pillar_y_size, grid_x_size, key)) return;
+  unsigned int *keys = hash_keys + batch_idx * hash_capacity;
+  unsigned int slot = hashPillar(key, hash_capacity);
+  while (keys[slot] != key) {
+    slot = (slot + 1) & (hash_capacity - 1);
+  }
+  unsigned int pillar_index = batch_idx * sparse_pillar_num + hash_values[batch_idx * hash_capacity + slot];
+  unsigned int point_id = atomicAdd(&(pillar_points[pillar_index]), 1);
+  if(point_id >= max_points_per_voxel) return;
+  float *address = voxels + (pillar_index*max_points_per_voxel + point_id)*num_point_values;
+  for (int k = 0; k < num_point_values; k++) {
+    address[k] = points[num_point_values * point_idx + k];
+  }
+}
+
+__global__ void clampPillarPoints_kernel(
+        int total_pillar_num,
+        unsigned int *pillar_points,
+        int max_points_per_voxel,
+        unsigned int *voxel_num_points)
+{
+  int pillar_id = blockIdx.x * blockDim.x + threadIdx.x;
+  if (pillar_id >= total_pillar_num) return;
+  unsigned int count = pillar_points[pillar_id];
+  voxel_num_points[pillar_id] = count<max_points_per_voxel?count:max_points_per_voxel;
+}
+
+void generateSparseVoxels_launch(
+        int batch_size, int max_num_points,
+        float *points, unsigned int* points_size,
+        float min_x_range, float max_x_range,
+        float min_y_range, float max_y_range,
+        float min_z_range, float max_z_range,
+        float pillar_x_size, float pillar_y_size,
+        int grid_x_size, int num_point_values,
+        int max_points_per_voxel,
+        unsigned int hash_capacity, unsigned int *hash_keys, unsigned int *hash_values,
+        unsigned int *pillar_num, int max_pillar_num, unsigned int *coords,
+        int sparse_pillar_num, unsigned int *pillar_points, float *voxels,
+        unsigned int *voxel_num_points,
+        cudaStream_t stream)
+{
+  int threadNum = 256;
+  dim3 threads(threadNum);
+  dim3 pointBlocks((batch_size * max_num_points + threadNum - 1) / threadNum);
+  insertPillars_kernel<<<pointBlocks, threads, 0, stream>>>
+      (batch_size, max_num_points,
+        points, points_size,
+        min_x_range, max_x_range,
+        min_y_range, max_y_range,
+        min_z_range, max_z_range,
+        pillar_x_size, pillar_y_size,
+        grid_x_size, num_point_values,
+        hash_capacity, hash_keys);
+  dim3 slotBlocks((batch_size * hash_capacity + threadNum - 1) / threadNum);
+  compactPillars_kernel<<<slotBlocks, threads, 0, stream>>>
+      (batch_size,
+        hash_capacity, hash_keys, hash_values,
+        grid_x_size,
+        pillar_num,
+        max_pillar_num,
+        coords);
+  scatterPoints_kernel<<<pointBlocks, threads, 0, stream>>>
+      (batch_size, max_num_points,
+        points, points_size,
+        min_x_range, max_x_range,
+        min_y_range, max_y_range,
+        min_z_range, max_z_range,
+        pillar_x_size, pillar_y_size,
+        grid_x_size, num_point_values,
+        max_points_per_voxel,
+        hash_capacity, hash_keys, hash_values,
+        sparse_pillar_num, pillar_points, voxels);
+  dim3 pillarBlocks((batch_size * sparse_pillar_num + threadNum - 1) / threadNum);
+  clampPillarPoints_kernel<<<pillarBlocks, threads, 0, stream>>>
+      (batch_size * sparse_pillar_num,
+        pillar_points,
+        max_points_per_voxel,
+        voxel_num_points);
+}
+
 __global__ void generateFeatures_kernel(
     int batch_size,
     int dense_pillar_num,
@@ -178,6 +354,7 @@ __global__ void generateFeatures_kernel(
     int batch_idx = pillar_idx / max_voxels;
     if (batch_idx >= batch_size) return;
     int pillar_idx_in_frame = pillar_idx % max_voxels;
+    // The voxel buffers of each frame are dense_pillar_num pillars apart, and the coords are max_voxels apart.
     int dense_pillar_idx = pillar_idx_in_frame + dense_pillar_num * batch_idx;
     int pillar_idx_inBlock = threadIdx.x/warp_size;
     // Limit number of voxels to max_voxels
@@ -197,7 +374,7 @@ __global__ void generateFeatures_kernel(
 
     if (point_idx == 0) {
       pointsNumSM[pillar_idx_inBlock] = voxel_num_points[dense_pillar_idx];
-      cordsSM[pillar_idx_inBlock] = ((int4*)coords)[dense_pillar_idx];
+      cordsSM[pillar_idx_inBlock] = ((int4*)coords)[pillar_idx];
       pillarSumSM[pillar_idx_inBlock] = {0,0,0,0};
     }
     for(int k=0; k<5; k++) {
@@ -239,7 +416,7 @@ __global__ void generateFeatures_kernel(
       pillarOutSM[pillar_idx_inBlock][point_idx][5 + 3] = center.x;
       pillarOutSM[pillar_idx_inBlock][point_idx][5 + 4] = center.y;
       if (5 + 5 < voxel_features_size)
-        pillarOutSM[pillar_idx_inBlock][point_idx][warp_size + 5] = center.z;
+        pillarOutSM[pillar_idx_inBlock][point_idx][5 + 5] = center.z;
     } else {
       for (int k = 0; k < voxel_features_size; k++)
         pillarOutSM[pillar_idx_inBlock][point_idx][k] = 0;
@@ -274,6 +451,7 @@ __global__ void generateFeatures_kernel_4x(
   int batch_idx = pillar_idx / max_voxels;
   if (batch_idx >= batch_size) return;
   int pillar_idx_in_frame = pillar_idx % max_voxels;
+  // The voxel buffers of each frame are dense_pillar_num pillars apart, and the coords are max_voxels apart.
   int dense_pillar_idx = pillar_idx_in_frame + dense_pillar_num * batch_idx;
   int pillar_idx_inBlock = threadIdx.x / warp_size;
   // Limit number of voxels to max_voxels
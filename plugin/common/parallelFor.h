@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TRT_PARALLEL_FOR_H
+#define TRT_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+//!
+//! \brief Calls func(begin, end) on ranges of at most grainSize items that together cover [0, count).
+//!
+//! The ranges are handed out in order to up to numThreads threads, the caller included, so that uneven ranges are
+//! balanced. numThreads <= 0 uses one thread per core. No more threads are started than there are ranges, and a
+//! single thread calls func(0, count) once.
+//!
+template <typename Func>
+void parallelFor(int32_t count, int32_t grainSize, int32_t numThreads, Func const& func)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    grainSize = std::max(1, grainSize);
+    if (numThreads <= 0)
+    {
+        numThreads = std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()));
+    }
+    int32_t const nbRanges = (count + grainSize - 1) / grainSize;
+    int32_t const nbWorkers = std::min(numThreads, nbRanges);
+    if (nbWorkers == 1)
+    {
+        func(0, count);
+        return;
+    }
+
+    std::atomic<int32_t> next{0};
+    auto worker = [&next, nbRanges, grainSize, count, &func]() {
+        for (int32_t range = next++; range < nbRanges; range = next++)
+        {
+            int32_t const begin = range * grainSize;
+            func(begin, std::min(count, begin + grainSize));
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int32_t t = 1; t < nbWorkers; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+} // namespace plugin
+} // namespace nvinfer1
+
+#endif // TRT_PARALLEL_FOR_H
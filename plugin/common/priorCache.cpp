@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/priorCache.h"
+#include "common/checkMacrosPlugin.h"
+#include <cuda_runtime_api.h>
+#include <unordered_map>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+namespace
+{
+// Entries are held weakly so that the priors of destroyed engines are released.
+std::mutex gPriorCacheMutex;
+std::unordered_map<std::string, std::weak_ptr<PriorCache>> gPriorCaches;
+} // namespace
+
+PriorCache::PriorCache(std::vector<float>&& priors)
+    : mHost(std::move(priors))
+{
+}
+
+PriorCache::~PriorCache()
+{
+    int32_t current{0};
+    bool const restore = cudaGetDevice(&current) == cudaSuccess;
+    for (size_t ordinal = 0; ordinal < mDevice.size(); ++ordinal)
+    {
+        if (mDevice[ordinal] != nullptr && cudaSetDevice(static_cast<int32_t>(ordinal)) == cudaSuccess)
+        {
+            PLUGIN_CUERROR(cudaFree(mDevice[ordinal]));
+        }
+    }
+    if (restore)
+    {
+        cudaSetDevice(current);
+    }
+}
+
+std::shared_ptr<PriorCache> PriorCache::lookup(
+    std::string const& key, std::function<std::vector<float>()> const& makePriors)
+{
+    std::lock_guard<std::mutex> lock(gPriorCacheMutex);
+    auto& slot = gPriorCaches[key];
+    std::shared_ptr<PriorCache> entry = slot.lock();
+    if (!entry)
+    {
+        entry.reset(new PriorCache(makePriors()));
+        slot = entry;
+    }
+    // Drop the slots of released entries while the lock is held anyway.
+    for (auto it = gPriorCaches.begin(); it != gPriorCaches.end();)
+    {
+        it = it->second.expired() ? gPriorCaches.erase(it) : std::next(it);
+    }
+    return entry;
+}
+
+std::shared_ptr<PriorCache> PriorCache::acquire(std::string const& key, Generator const& generate)
+{
+    return lookup(key, [&generate]() {
+        std::vector<float> priors;
+        generate(priors);
+        return priors;
+    });
+}
+
+std::shared_ptr<PriorCache> PriorCache::adopt(std::string const& key, std::vector<float>&& priors)
+{
+    return lookup(key, [&priors]() { return std::move(priors); });
+}
+
+float const* PriorCache::getDevice()
+{
+    int32_t ordinal{0};
+    if (mHost.empty() || cudaGetDevice(&ordinal) != cudaSuccess)
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mDeviceMutex);
+    if (static_cast<size_t>(ordinal) >= mDevice.size())
+    {
+        mDevice.resize(ordinal + 1, nullptr);
+    }
+    if (mDevice[ordinal] == nullptr)
+    {
+        void* device{nullptr};
+        if (cudaMalloc(&device, getSizeInBytes()) != cudaSuccess)
+        {
+            return nullptr;
+        }
+        if (cudaMemcpy(device, mHost.data(), getSizeInBytes(), cudaMemcpyHostToDevice) != cudaSuccess)
+        {
+            PLUGIN_CUERROR(cudaFree(device));
+            return nullptr;
+        }
+        mDevice[ordinal] = device;
+    }
+    return static_cast<float const*>(mDevice[ordinal]);
+}
+
+} // namespace plugin
+} // namespace nvinfer1
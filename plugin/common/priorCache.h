@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TRT_PRIOR_CACHE_H
+#define TRT_PRIOR_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+//!
+//! \brief Prior (anchor) tensor that depends only on plugin parameters and feature-map size, computed once.
+//!
+//! Entries are shared through a process-wide registry keyed by the bytes of everything the priors depend on, so
+//! clones and identical layers of different engines reuse one host copy and one copy per device. The host copy is
+//! generated on first use, or adopted from a serialized plugin; a copy is uploaded to each device on the first call
+//! to getDevice() made with that device current, and freed with the last reference.
+//!
+class PriorCache
+{
+public:
+    using Generator = std::function<void(std::vector<float>&)>;
+
+    //! Returns the entry for key, calling generate to fill the host priors if there is none yet.
+    static std::shared_ptr<PriorCache> acquire(std::string const& key, Generator const& generate);
+
+    //! Returns the entry for key, seeding it with already computed priors if there is none yet.
+    static std::shared_ptr<PriorCache> adopt(std::string const& key, std::vector<float>&& priors);
+
+    ~PriorCache();
+
+    PriorCache(PriorCache const&) = delete;
+    PriorCache& operator=(PriorCache const&) = delete;
+
+    std::vector<float> const& getHost() const noexcept
+    {
+        return mHost;
+    }
+
+    size_t getSizeInBytes() const noexcept
+    {
+        return mHost.size() * sizeof(float);
+    }
+
+    //! Copy of the priors on the current device, uploaded on first use. Returns nullptr if the upload fails.
+    float const* getDevice();
+
+    //! Appends the bytes of value to a cache key.
+    template <typename T>
+    static void appendKey(std::string& key, T const& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "cache keys are built from plain values");
+        key.append(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static void appendKey(std::string& key, T const* values, size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "cache keys are built from plain values");
+        appendKey(key, count);
+        key.append(reinterpret_cast<char const*>(values), count * sizeof(T));
+    }
+
+private:
+    explicit PriorCache(std::vector<float>&& priors);
+
+    static std::shared_ptr<PriorCache> lookup(
+        std::string const& key, std::function<std::vector<float>()> const& makePriors);
+
+    std::vector<float> mHost;
+    std::mutex mDeviceMutex;
+    //! Device copies, indexed by device ordinal.
+    std::vector<void*> mDevice;
+};
+
+} // namespace plugin
+} // namespace nvinfer1
+
+#endif // TRT_PRIOR_CACHE_H
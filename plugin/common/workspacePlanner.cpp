@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/workspacePlanner.h"
+#include "common/checkMacrosPlugin.h"
+#include <algorithm>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+WorkspacePlanner::WorkspacePlanner(size_t alignment)
+    : mAlignment(alignment)
+{
+    PLUGIN_VALIDATE(alignment > 0);
+}
+
+void WorkspacePlanner::reset()
+{
+    mBuffers.clear();
+    mSlotSizes.clear();
+}
+
+int32_t WorkspacePlanner::addBuffer(size_t size, int32_t firstUse, int32_t lastUse)
+{
+    PLUGIN_VALIDATE(firstUse <= lastUse);
+    size_t const alignedSize = (size + mAlignment - 1) / mAlignment * mAlignment;
+    auto const fitsSlot = [&](int32_t slot) {
+        return std::all_of(mBuffers.begin(), mBuffers.end(), [&](Buffer const& other) {
+            return other.slot != slot || other.lastUse < firstUse || lastUse < other.firstUse;
+        });
+    };
+
+    int32_t slot = 0;
+    while (slot < static_cast<int32_t>(mSlotSizes.size()) && !fitsSlot(slot))
+    {
+        ++slot;
+    }
+    if (slot == static_cast<int32_t>(mSlotSizes.size()))
+    {
+        mSlotSizes.push_back(0);
+    }
+
+    int32_t const id = static_cast<int32_t>(mBuffers.size());
+    mBuffers.push_back(Buffer{alignedSize, firstUse, lastUse, slot});
+    mSlotSizes[slot] = std::max(mSlotSizes[slot], alignedSize);
+    return id;
+}
+
+size_t WorkspacePlanner::getTotalSize() const
+{
+    size_t total = 0;
+    for (size_t slotSize : mSlotSizes)
+    {
+        total += slotSize;
+    }
+    return total;
+}
+
+size_t WorkspacePlanner::getUnaliasedSize() const
+{
+    size_t total = 0;
+    for (auto const& buffer : mBuffers)
+    {
+        total += buffer.size;
+    }
+    return total;
+}
+
+size_t WorkspacePlanner::getOffset(int32_t id) const
+{
+    PLUGIN_VALIDATE(id >= 0 && id < static_cast<int32_t>(mBuffers.size()));
+    size_t offset = 0;
+    for (int32_t slot = 0; slot < mBuffers[id].slot; ++slot)
+    {
+        offset += mSlotSizes[slot];
+    }
+    return offset;
+}
+
+} // namespace plugin
+} // namespace nvinfer1
@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TRT_WORKSPACE_PLANNER_H
+#define TRT_WORKSPACE_PLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+//! Alignment of the buffers placed by WorkspacePlanner, matching nextWorkspacePtr().
+constexpr size_t kWORKSPACE_ALIGNMENT{256};
+
+//!
+//! \brief Lays out the scratch buffers of a plugin in one workspace, aliasing buffers whose lifetimes do not overlap.
+//!
+//! Each buffer is declared with the first and last step (inclusive) of the plugin's enqueue that use it. Buffers are
+//! packed into slots: a buffer joins the first slot, in declaration order, whose buffers are all dead while it is
+//! live, and each slot is as large as its largest buffer. The slot assignment depends only on the lifetimes, so
+//! shrinking any buffer never grows the workspace and a plan sized for the largest shapes covers every smaller one.
+//!
+//! A plugin keeps its planner as a member and re-plans with reset() on every enqueue, which reuses the storage of the
+//! previous plan instead of allocating.
+//!
+class WorkspacePlanner
+{
+public:
+    explicit WorkspacePlanner(size_t alignment = kWORKSPACE_ALIGNMENT);
+
+    //! Removes all buffers, keeping the allocated storage.
+    void reset();
+
+    //! Declares a buffer of size bytes, live from step firstUse to step lastUse. Returns the buffer id.
+    int32_t addBuffer(size_t size, int32_t firstUse, int32_t lastUse);
+
+    //! Size of the aliased layout.
+    size_t getTotalSize() const;
+
+    //! Size of the layout without aliasing, as calculateTotalWorkspaceSize() computes it.
+    size_t getUnaliasedSize() const;
+
+    //! Offset of a buffer from the start of the workspace.
+    size_t getOffset(int32_t id) const;
+
+    template <typename T>
+    T* getBuffer(void* workspace, int32_t id) const
+    {
+        return reinterpret_cast<T*>(static_cast<int8_t*>(workspace) + getOffset(id));
+    }
+
+private:
+    struct Buffer
+    {
+        size_t size;
+        int32_t firstUse;
+        int32_t lastUse;
+        int32_t slot;
+    };
+
+    size_t mAlignment;
+    std::vector<Buffer> mBuffers;
+    std::vector<size_t> mSlotSizes;
+};
+
+} // namespace plugin
+} // namespace nvinfer1
+
+#endif // TRT_WORKSPACE_PLANNER_H
@@ -28,4 +28,12 @@ pluginStatus_t EfficientNMSInference(nvinfer1::plugin::EfficientNMSParameters pa
     void const* scoresInput, void const* anchorsInput, void* numDetectionsOutput, void* nmsBoxesOutput,
     void* nmsScoresOutput, void* nmsClassesOutput, void* nmsIndicesOutput, void* workspace, cudaStream_t stream);
 
+// Host implementation of EfficientNMSInference, for CPU fallback and validation without a GPU. All pointers are host
+// pointers and no workspace is needed. Candidates with equal scores are ordered by their element index, and inputs are
+// always filtered by the score threshold. The batch and class NMS groups are processed by numThreads threads, or by
+// the hardware concurrency if numThreads <= 0.
+pluginStatus_t EfficientNMSHostInference(nvinfer1::plugin::EfficientNMSParameters param, void const* boxesInput,
+    void const* scoresInput, void const* anchorsInput, void* numDetectionsOutput, void* nmsBoxesOutput,
+    void* nmsScoresOutput, void* nmsClassesOutput, void* nmsIndicesOutput, int32_t numThreads = 0);
+
 #endif
@@ -0,0 +1,479 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "efficientNMSInference.h"
+
+#include "common/parallelFor.h"
+
+#include <cuda_fp16.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace nvinfer1;
+using namespace nvinfer1::plugin;
+
+namespace
+{
+
+float toFloat(float a)
+{
+    return a;
+}
+
+float toFloat(__half a)
+{
+    return __half2float(a);
+}
+
+template <typename T>
+T fromFloat(float a);
+
+template <>
+float fromFloat<float>(float a)
+{
+    return a;
+}
+
+template <>
+__half fromFloat<__half>(float a)
+{
+    return __float2half(a);
+}
+
+//! A box decoded to corner coding, in the original (possibly unordered) coordinate order.
+struct HostBox
+{
+    float y1, x1, y2, x2;
+};
+
+//! A candidate that passed the score filter. elementIdx = anchorIdx * numClasses + classIdx.
+struct Candidate
+{
+    float score;
+    int32_t elementIdx;
+};
+
+//! Boxes of one NMS group (an image, or an image and class), in struct of arrays layout and descending score order.
+//! The coordinates are reordered so that y1 <= y2 and x1 <= x2.
+struct GroupBoxes
+{
+    std::vector<float> y1;
+    std::vector<float> x1;
+    std::vector<float> y2;
+    std::vector<float> x2;
+    std::vector<float> area;
+
+    void resize(size_t n)
+    {
+        y1.resize(n);
+        x1.resize(n);
+        y2.resize(n);
+        x2.resize(n);
+        area.resize(n);
+    }
+};
+
+float boxArea(float y1, float x1, float y2, float x2)
+{
+    float const h = y2 - y1;
+    float const w = x2 - x1;
+    return (h <= 0.F || w <= 0.F) ? 0.F : h * w;
+}
+
+template <typename T>
+HostBox decodeBox(EfficientNMSParameters const& param, T const* boxesInput, T const* anchorsInput, int32_t imageIdx,
+    int32_t anchorIdx, int32_t classIdx)
+{
+    // Shape of boxesInput: [batchSize, numAnchors, 1 or numClasses, 4]
+    int32_t const boxIdx = param.shareLocation
+        ? imageIdx * param.numAnchors + anchorIdx
+        : (imageIdx * param.numAnchors + anchorIdx) * param.numClasses + classIdx;
+    T const* b = boxesInput + 4 * static_cast<int64_t>(boxIdx);
+    float v[4] = {toFloat(b[0]), toFloat(b[1]), toFloat(b[2]), toFloat(b[3])};
+
+    if (param.boxDecoder)
+    {
+        // Shape of anchorsInput: [1 or batchSize, numAnchors, 4]
+        int32_t const anchorOffset = param.shareAnchors ? anchorIdx : imageIdx * param.numAnchors + anchorIdx;
+        T const* a = anchorsInput + 4 * static_cast<int64_t>(anchorOffset);
+        float const av[4] = {toFloat(a[0]), toFloat(a[1]), toFloat(a[2]), toFloat(a[3])};
+        if (param.boxCoding == 0)
+        {
+            // Same as BoxCorner::decode() of reordered boxes and anchors.
+            float const anchorY1 = std::min(av[0], av[2]);
+            float const anchorX1 = std::min(av[1], av[3]);
+            float const anchorY2 = std::max(av[0], av[2]);
+            float const anchorX2 = std::max(av[1], av[3]);
+            return {std::min(v[0], v[2]) + anchorY1, std::min(v[1], v[3]) + anchorX1, std::max(v[0], v[2]) + anchorY2,
+                std::max(v[1], v[3]) + anchorX2};
+        }
+        // Same as BoxCenterSize::decode().
+        v[0] = v[0] * av[2] + av[0];
+        v[1] = v[1] * av[3] + av[1];
+        v[2] = av[2] * std::exp(v[2]);
+        v[3] = av[3] * std::exp(v[3]);
+    }
+
+    if (param.boxCoding == 1)
+    {
+        float const h2 = v[2] * 0.5F;
+        float const w2 = v[3] * 0.5F;
+        return {v[0] - h2, v[1] - w2, v[0] + h2, v[1] + w2};
+    }
+    return {v[0], v[1], v[2], v[3]};
+}
+
+//!
+//! \brief Greedy NMS of the boxes of one group, sorted by descending score.
+//!
+//! The IOU of each kept box against all the following boxes is computed without branches over the struct of arrays
+//! layout, so that the inner loop is vectorized by the compiler. Division is avoided by comparing the intersection
+//! against iouThreshold times the union.
+//!
+//! \param keep Set to 1 for the kept boxes.
+//!
+void nmsGroup(GroupBoxes const& boxes, float iouThreshold, std::vector<uint8_t>& keep)
+{
+    size_t const n = boxes.area.size();
+    keep.assign(n, 1);
+    float const* __restrict__ y1 = boxes.y1.data();
+    float const* __restrict__ x1 = boxes.x1.data();
+    float const* __restrict__ y2 = boxes.y2.data();
+    float const* __restrict__ x2 = boxes.x2.data();
+    float const* __restrict__ area = boxes.area.data();
+    uint8_t* __restrict__ k = keep.data();
+    // With a non-positive threshold, boxes without overlap (IOU of 0) are suppressed as well.
+    uint8_t const suppressDisjoint = iouThreshold <= 0.F ? 1 : 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!k[i])
+        {
+            continue;
+        }
+        float const by1 = y1[i];
+        float const bx1 = x1[i];
+        float const by2 = y2[i];
+        float const bx2 = x2[i];
+        float const bArea = area[i];
+        for (size_t j = i + 1; j < n; ++j)
+        {
+            float const h = std::min(by2, y2[j]) - std::max(by1, y1[j]);
+            float const w = std::min(bx2, x2[j]) - std::max(bx1, x1[j]);
+            float const intersect = (h > 0.F && w > 0.F) ? h * w : 0.F;
+            float const unionArea = bArea + area[j] - intersect;
+            uint8_t const overlap = (intersect > 0.F && unionArea > 0.F) ? (intersect >= iouThreshold * unionArea)
+                                                                          : suppressDisjoint;
+            k[j] &= static_cast<uint8_t>(1 - overlap);
+        }
+    }
+}
+
+//! Results of one image, in the order they are written out.
+struct ImageResult
+{
+    std::vector<int32_t> elementIdx;
+    std::vector<float> score;
+    std::vector<HostBox> box;
+};
+
+template <typename T>
+class EfficientNMSHost
+{
+public:
+    EfficientNMSHost(EfficientNMSParameters const& param, T const* boxesInput, T const* scoresInput,
+        T const* anchorsInput)
+        : mParam(param)
+        , mBoxesInput(boxesInput)
+        , mScoresInput(scoresInput)
+        , mAnchorsInput(anchorsInput)
+        , mNbGroups(param.classAgnostic ? 1 : param.numClasses)
+        , mCandidates(param.batchSize)
+        , mGroups(static_cast<size_t>(param.batchSize) * mNbGroups)
+        , mResults(param.batchSize)
+    {
+        if (mParam.scoreSigmoid)
+        {
+            // Filter the logits against the inverse sigmoid of the threshold, as the device kernels do.
+            mParam.scoreThreshold = mParam.scoreThreshold <= 0.F
+                ? -(1 << 15)
+                : std::log(mParam.scoreThreshold / (1.F - mParam.scoreThreshold));
+        }
+    }
+
+    void run(int32_t numThreads)
+    {
+        // One image or group per range, as their costs can differ widely.
+        parallelFor(mParam.batchSize, 1, numThreads, [this](int32_t begin, int32_t end) {
+            for (int32_t imageIdx = begin; imageIdx < end; ++imageIdx)
+            {
+                selectCandidates(imageIdx);
+            }
+        });
+        parallelFor(static_cast<int32_t>(mGroups.size()), 1, numThreads, [this](int32_t begin, int32_t end) {
+            for (int32_t groupIdx = begin; groupIdx < end; ++groupIdx)
+            {
+                nms(groupIdx);
+            }
+        });
+        parallelFor(mParam.batchSize, 1, numThreads, [this](int32_t begin, int32_t end) {
+            for (int32_t imageIdx = begin; imageIdx < end; ++imageIdx)
+            {
+                merge(imageIdx);
+            }
+        });
+    }
+
+    void write(void* numDetectionsOutput, void* nmsBoxesOutput, void* nmsScoresOutput, void* nmsClassesOutput,
+        void* nmsIndicesOutput) const
+    {
+        size_t const numOutputs = static_cast<size_t>(mParam.batchSize) * mParam.numOutputBoxes;
+        if (mParam.outputONNXIndices)
+        {
+            auto* indices = static_cast<int32_t*>(nmsIndicesOutput);
+            std::fill_n(indices, numOutputs * 3, -1);
+            size_t idx = 0;
+            for (int32_t imageIdx = 0; imageIdx < mParam.batchSize; ++imageIdx)
+            {
+                for (int32_t elementIdx : mResults[imageIdx].elementIdx)
+                {
+                    indices[idx * 3 + 0] = imageIdx;
+                    indices[idx * 3 + 1] = elementIdx % mParam.numClasses;
+                    indices[idx * 3 + 2] = elementIdx / mParam.numClasses;
+                    ++idx;
+                }
+            }
+            // Pad with the last selected index, as PadONNXResult does.
+            for (size_t pidx = idx; idx > 0 && pidx < numOutputs; ++pidx)
+            {
+                std::copy_n(indices + (idx - 1) * 3, 3, indices + pidx * 3);
+            }
+            return;
+        }
+
+        auto* numDetections = static_cast<int32_t*>(numDetectionsOutput);
+        auto* boxes = static_cast<T*>(nmsBoxesOutput);
+        auto* scores = static_cast<T*>(nmsScoresOutput);
+        auto* classes = static_cast<int32_t*>(nmsClassesOutput);
+        std::fill_n(boxes, numOutputs * 4, fromFloat<T>(0.F));
+        std::fill_n(scores, numOutputs, fromFloat<T>(0.F));
+        std::fill_n(classes, numOutputs, 0);
+        for (int32_t imageIdx = 0; imageIdx < mParam.batchSize; ++imageIdx)
+        {
+            auto const& result = mResults[imageIdx];
+            numDetections[imageIdx] = static_cast<int32_t>(result.elementIdx.size());
+            for (size_t r = 0; r < result.elementIdx.size(); ++r)
+            {
+                size_t const outputIdx = static_cast<size_t>(imageIdx) * mParam.numOutputBoxes + r;
+                float const score = result.score[r];
+                scores[outputIdx] = fromFloat<T>(mParam.scoreSigmoid ? 1.F / (1.F + std::exp(-score)) : score);
+                classes[outputIdx] = result.elementIdx[r] % mParam.numClasses;
+                HostBox b = result.box[r];
+                if (mParam.clipBoxes)
+                {
+                    b = {clip(b.y1), clip(b.x1), clip(b.y2), clip(b.x2)};
+                }
+                T* out = boxes + outputIdx * 4;
+                out[0] = fromFloat<T>(b.y1);
+                out[1] = fromFloat<T>(b.x1);
+                out[2] = fromFloat<T>(b.y2);
+                out[3] = fromFloat<T>(b.x2);
+            }
+        }
+    }
+
+private:
+    static float clip(float v)
+    {
+        return std::min(std::max(v, 0.F), 1.F);
+    }
+
+    //! Filter the scores of an image and keep the numSelectedBoxes highest ones, in descending order.
+    void selectCandidates(int32_t imageIdx)
+    {
+        auto& candidates = mCandidates[imageIdx];
+        candidates.clear();
+        T const* scores = mScoresInput + static_cast<int64_t>(imageIdx) * mParam.numScoreElements;
+        for (int32_t elementIdx = 0; elementIdx < mParam.numScoreElements; ++elementIdx)
+        {
+            float const score = toFloat(scores[elementIdx]);
+            if (score >= mParam.scoreThreshold && elementIdx % mParam.numClasses != mParam.backgroundClass)
+            {
+                candidates.push_back({score, elementIdx});
+            }
+        }
+
+        // Ties are broken by element index, which makes the selection deterministic.
+        auto const higher = [](Candidate const& a, Candidate const& b) {
+            return a.score > b.score || (a.score == b.score && a.elementIdx < b.elementIdx);
+        };
+        size_t const numSelected
+            = std::min(candidates.size(), static_cast<size_t>(std::max(mParam.numSelectedBoxes, 0)));
+        // Partial selection: only the numSelectedBoxes highest scores are sorted.
+        if (numSelected < candidates.size())
+        {
+            std::nth_element(candidates.begin(), candidates.begin() + numSelected, candidates.end(), higher);
+            candidates.resize(numSelected);
+        }
+        std::sort(candidates.begin(), candidates.end(), higher);
+    }
+
+    //! Run NMS on the candidates of one image (class agnostic) or one image and class.
+    void nms(int32_t groupIdx)
+    {
+        int32_t const imageIdx = groupIdx / mNbGroups;
+        int32_t const classIdx = groupIdx % mNbGroups;
+        auto& group = mGroups[groupIdx];
+        group.members.clear();
+        auto const& candidates = mCandidates[imageIdx];
+        for (size_t c = 0; c < candidates.size(); ++c)
+        {
+            if (mParam.classAgnostic || candidates[c].elementIdx % mParam.numClasses == classIdx)
+            {
+                group.members.push_back(static_cast<int32_t>(c));
+            }
+        }
+
+        size_t const n = group.members.size();
+        group.decoded.resize(n);
+        group.boxes.resize(n);
+        for (size_t m = 0; m < n; ++m)
+        {
+            int32_t const elementIdx = candidates[group.members[m]].elementIdx;
+            HostBox const b = decodeBox(mParam, mBoxesInput, mAnchorsInput, imageIdx, elementIdx / mParam.numClasses,
+                elementIdx % mParam.numClasses);
+            group.decoded[m] = b;
+            group.boxes.y1[m] = std::min(b.y1, b.y2);
+            group.boxes.x1[m] = std::min(b.x1, b.x2);
+            group.boxes.y2[m] = std::max(b.y1, b.y2);
+            group.boxes.x2[m] = std::max(b.x1, b.x2);
+            group.boxes.area[m] = boxArea(group.boxes.y1[m], group.boxes.x1[m], group.boxes.y2[m], group.boxes.x2[m]);
+        }
+        nmsGroup(group.boxes, mParam.iouThreshold, group.keep);
+    }
+
+    //! Merge the kept boxes of the groups of an image in score order, applying the output limits.
+    void merge(int32_t imageIdx)
+    {
+        auto const& candidates = mCandidates[imageIdx];
+        // Group of each kept candidate and its position in the group, or -1 if it was suppressed.
+        std::vector<int32_t> keptGroup(candidates.size(), -1);
+        std::vector<int32_t> keptMember(candidates.size(), -1);
+        for (int32_t g = 0; g < mNbGroups; ++g)
+        {
+            auto const& group = mGroups[imageIdx * mNbGroups + g];
+            for (size_t m = 0; m < group.members.size(); ++m)
+            {
+                if (group.keep[m])
+                {
+                    keptGroup[group.members[m]] = g;
+                    keptMember[group.members[m]] = static_cast<int32_t>(m);
+                }
+            }
+        }
+
+        auto& result = mResults[imageIdx];
+        result.elementIdx.clear();
+        result.score.clear();
+        result.box.clear();
+        std::vector<int32_t> classCounts(mParam.numClasses, 0);
+        for (size_t c = 0; c < candidates.size(); ++c)
+        {
+            if (static_cast<int32_t>(result.elementIdx.size()) >= mParam.numOutputBoxes)
+            {
+                break;
+            }
+            if (keptGroup[c] < 0)
+            {
+                continue;
+            }
+            int32_t const elementIdx = candidates[c].elementIdx;
+            // A kept box over the per class limit still suppresses other boxes, but is not written out.
+            if (mParam.numOutputBoxesPerClass >= 0
+                && classCounts[elementIdx % mParam.numClasses]++ >= mParam.numOutputBoxesPerClass)
+            {
+                continue;
+            }
+            result.elementIdx.push_back(elementIdx);
+            result.score.push_back(candidates[c].score);
+            result.box.push_back(mGroups[imageIdx * mNbGroups + keptGroup[c]].decoded[keptMember[c]]);
+        }
+    }
+
+    struct Group
+    {
+        std::vector<int32_t> members; //!< Indices of the group's boxes in the candidates of the image
+        std::vector<HostBox> decoded;
+        GroupBoxes boxes;
+        std::vector<uint8_t> keep;
+    };
+
+    EfficientNMSParameters mParam;
+    T const* mBoxesInput;
+    T const* mScoresInput;
+    T const* mAnchorsInput;
+    int32_t mNbGroups;
+    std::vector<std::vector<Candidate>> mCandidates;
+    std::vector<Group> mGroups;
+    std::vector<ImageResult> mResults;
+};
+
+template <typename T>
+pluginStatus_t EfficientNMSHostDispatch(EfficientNMSParameters const& param, void const* boxesInput,
+    void const* scoresInput, void const* anchorsInput, void* numDetectionsOutput, void* nmsBoxesOutput,
+    void* nmsScoresOutput, void* nmsClassesOutput, void* nmsIndicesOutput, int32_t numThreads)
+{
+    EfficientNMSHost<T> nms(param, static_cast<T const*>(boxesInput), static_cast<T const*>(scoresInput),
+        static_cast<T const*>(anchorsInput));
+    if (param.numScoreElements >= 1)
+    {
+        nms.run(numThreads);
+    }
+    nms.write(numDetectionsOutput, nmsBoxesOutput, nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput);
+    return STATUS_SUCCESS;
+}
+
+} // namespace
+
+pluginStatus_t EfficientNMSHostInference(EfficientNMSParameters param, void const* boxesInput, void const* scoresInput,
+    void const* anchorsInput, void* numDetectionsOutput, void* nmsBoxesOutput, void* nmsScoresOutput,
+    void* nmsClassesOutput, void* nmsIndicesOutput, int32_t numThreads)
+{
+    if (param.batchSize < 1 || param.numClasses < 1 || param.numAnchors < 0 || param.numOutputBoxes < 0
+        || (param.boxDecoder && anchorsInput == nullptr) || (param.boxCoding != 0 && param.boxCoding != 1))
+    {
+        return STATUS_BAD_PARAM;
+    }
+
+    if (param.datatype == DataType::kFLOAT)
+    {
+        return EfficientNMSHostDispatch<float>(param, boxesInput, scoresInput, anchorsInput, numDetectionsOutput,
+            nmsBoxesOutput, nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput, numThreads);
+    }
+    else if (param.datatype == DataType::kHALF)
+    {
+        return EfficientNMSHostDispatch<__half>(param, boxesInput, scoresInput, anchorsInput, numDetectionsOutput,
+            nmsBoxesOutput, nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput, numThreads);
+    }
+    else
+    {
+        return STATUS_NOT_SUPPORTED;
+    }
+}
@@ -16,6 +16,7 @@
  */
 
 #include "gridAnchorPlugin.h"
+#include <algorithm>
 #include <cstring>
 #include <cublas_v2.h>
 #include <cudnn.h>
@@ -47,6 +48,9 @@ GridAnchorGenerator::GridAnchorGenerator(GridAnchorParameters const* paramIn, in
     PLUGIN_CUASSERT(cudaMallocHost((void**) &mDeviceHeights, mNumLayers * sizeof(Weights)));
 
     mParam.resize(mNumLayers);
+    mWidthsCPU.resize(mNumLayers);
+    mHeightsCPU.resize(mNumLayers);
+    mPriorCaches.resize(mNumLayers);
     for (int id = 0; id < mNumLayers; id++)
     {
         mParam[id] = paramIn[id];
@@ -124,6 +128,12 @@ GridAnchorGenerator::GridAnchorGenerator(GridAnchorParameters const* paramIn, in
 
         mDeviceWidths[id] = copyToDevice(&tmpWidths[0], tmpWidths.size());
         mDeviceHeights[id] = copyToDevice(&tmpHeights[0], tmpHeights.size());
+        mWidthsCPU[id] = std::move(tmpWidths);
+        mHeightsCPU[id] = std::move(tmpHeights);
+
+        // Identical layers, including those of clones, share the priors generated here.
+        mPriorCaches[id] = PriorCache::acquire(
+            getPriorCacheKey(id), [this, id](std::vector<float>& priors) { generatePriors(id, priors); });
     }
 }
 
@@ -136,6 +146,9 @@ GridAnchorGenerator::GridAnchorGenerator(void const* data, size_t length, char c
     PLUGIN_CUASSERT(cudaMallocHost((void**) &mDeviceWidths, mNumLayers * sizeof(Weights)));
     PLUGIN_CUASSERT(cudaMallocHost((void**) &mDeviceHeights, mNumLayers * sizeof(Weights)));
     mParam.resize(mNumLayers);
+    mWidthsCPU.resize(mNumLayers);
+    mHeightsCPU.resize(mNumLayers);
+    mPriorCaches.resize(mNumLayers);
     for (int id = 0; id < mNumLayers; id++)
     {
         // we have to deserialize GridAnchorParameters by hand
@@ -155,10 +168,37 @@ GridAnchorGenerator::GridAnchorGenerator(void const* data, size_t length, char c
         }
 
         mNumPriors[id] = read<int>(d);
+        mWidthsCPU[id].resize(mNumPriors[id]);
+        std::memcpy(mWidthsCPU[id].data(), d, mNumPriors[id] * sizeof(float));
         mDeviceWidths[id] = deserializeToDevice(d, mNumPriors[id]);
+        mHeightsCPU[id].resize(mNumPriors[id]);
+        std::memcpy(mHeightsCPU[id].data(), d, mNumPriors[id] * sizeof(float));
         mDeviceHeights[id] = deserializeToDevice(d, mNumPriors[id]);
     }
 
+    // Engines serialized before the priors were cached end here; generate their priors instead.
+    bool const hasPriors = d < a + length;
+    for (int id = 0; id < mNumLayers; id++)
+    {
+        if (hasPriors)
+        {
+            // Check the sizes against the remaining bytes before reading, as they come from the serialized data.
+            PLUGIN_VALIDATE(static_cast<size_t>(a + length - d) >= sizeof(int));
+            int const nbPriorValues = read<int>(d);
+            PLUGIN_VALIDATE(nbPriorValues >= 0
+                && static_cast<size_t>(nbPriorValues) <= static_cast<size_t>(a + length - d) / sizeof(float));
+            std::vector<float> priors(nbPriorValues);
+            std::memcpy(priors.data(), d, priors.size() * sizeof(float));
+            d += priors.size() * sizeof(float);
+            mPriorCaches[id] = PriorCache::adopt(getPriorCacheKey(id), std::move(priors));
+        }
+        else
+        {
+            mPriorCaches[id] = PriorCache::acquire(
+                getPriorCacheKey(id), [this, id](std::vector<float>& priors) { generatePriors(id, priors); });
+        }
+    }
+
     PLUGIN_VALIDATE(d == a + length);
 }
 
@@ -190,6 +230,14 @@ Dims GridAnchorGenerator::getOutputDimensions(int index, Dims const* inputs, int
 
 int GridAnchorGenerator::initialize() noexcept
 {
+    // Upload the priors now rather than on the first enqueue.
+    for (int id = 0; id < mNumLayers; id++)
+    {
+        if (mPriorCaches[id]->getDevice() == nullptr)
+        {
+            return STATUS_FAILURE;
+        }
+    }
     return STATUS_SUCCESS;
 }
 
@@ -203,15 +251,16 @@ size_t GridAnchorGenerator::getWorkspaceSize(int maxBatchSize) const noexcept
 int GridAnchorGenerator::enqueue(
     int batchSize, void const* const* inputs, void* const* outputs, void* workspace, cudaStream_t stream) noexcept
 {
-    // Generate prior boxes for each layer
+    // The priors only depend on the parameters, so copy the cached ones instead of regenerating them.
     for (int id = 0; id < mNumLayers; id++)
     {
-        void* outputData = outputs[id];
-        pluginStatus_t status = anchorGridInference(
-            stream, mParam[id], mNumPriors[id], mDeviceWidths[id].values, mDeviceHeights[id].values, outputData);
-        if (status != STATUS_SUCCESS)
+        float const* priors = mPriorCaches[id]->getDevice();
+        if (priors == nullptr
+            || cudaMemcpyAsync(
+                   outputs[id], priors, mPriorCaches[id]->getSizeInBytes(), cudaMemcpyDeviceToDevice, stream)
+                != cudaSuccess)
         {
-            return status;
+            return STATUS_FAILURE;
         }
     }
     return STATUS_SUCCESS;
@@ -227,6 +276,7 @@ size_t GridAnchorGenerator::getSerializationSize() const noexcept
             * sizeof(float); // mParam[i].{minSize, maxSize, aspectRatios, variance[4]}
         sum += mDeviceWidths[i].count * sizeof(float);
         sum += mDeviceHeights[i].count * sizeof(float);
+        sum += sizeof(int) + mPriorCaches[i]->getSizeInBytes(); // precomputed priors
     }
     return sum;
 }
@@ -256,9 +306,36 @@ void GridAnchorGenerator::serialize(void* buffer) const noexcept
         serializeFromDevice(d, mDeviceWidths[id]);
         serializeFromDevice(d, mDeviceHeights[id]);
     }
+    for (int id = 0; id < mNumLayers; id++)
+    {
+        std::vector<float> const& priors = mPriorCaches[id]->getHost();
+        write(d, static_cast<int>(priors.size()));
+        std::memcpy(d, priors.data(), mPriorCaches[id]->getSizeInBytes());
+        d += mPriorCaches[id]->getSizeInBytes();
+    }
     PLUGIN_ASSERT(d == a + getSerializationSize());
 }
 
+std::string GridAnchorGenerator::getPriorCacheKey(int id) const
+{
+    std::string key{"GridAnchor"};
+    PriorCache::appendKey(key, mParam[id].H);
+    PriorCache::appendKey(key, mParam[id].W);
+    PriorCache::appendKey(key, mParam[id].variance, 4);
+    PriorCache::appendKey(key, mWidthsCPU[id].data(), mWidthsCPU[id].size());
+    PriorCache::appendKey(key, mHeightsCPU[id].data(), mHeightsCPU[id].size());
+    return key;
+}
+
+void GridAnchorGenerator::generatePriors(int id, std::vector<float>& priors) const
+{
+    // 2 channels of H * W * numPriors boxes: the box coordinates, then the variances.
+    priors.resize(2 * mParam[id].H * mParam[id].W * mNumPriors[id] * 4);
+    PLUGIN_VALIDATE(cpu::anchorGridInference(nullptr, mParam[id], mNumPriors[id], mWidthsCPU[id].data(),
+                        mHeightsCPU[id].data(), priors.data())
+        == STATUS_SUCCESS);
+}
+
 Weights GridAnchorGenerator::copyToDevice(void const* hostData, size_t count) noexcept
 {
     void* deviceData;
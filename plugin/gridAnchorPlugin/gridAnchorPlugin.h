@@ -19,8 +19,10 @@
 #define TRT_GRID_ANCHOR_PLUGIN_H
 #include "common/kernels/kernel.h"
 #include "common/plugin.h"
+#include "common/priorCache.h"
 #include "cudnn.h"
 #include <cublas_v2.h>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -94,10 +96,20 @@ private:
 
     Weights deserializeToDevice(char const*& hostBuffer, size_t count) noexcept;
 
+    //! Key of the prior cache of layer id: everything its output depends on.
+    std::string getPriorCacheKey(int id) const;
+
+    //! Generates the priors of layer id on the host.
+    void generatePriors(int id, std::vector<float>& priors) const;
+
     int mNumLayers;
     std::vector<GridAnchorParameters> mParam;
     int* mNumPriors;
     Weights *mDeviceWidths, *mDeviceHeights;
+    std::vector<std::vector<float>> mWidthsCPU;
+    std::vector<std::vector<float>> mHeightsCPU;
+    //! Priors of each layer, shared with clones and with identical layers of other engines.
+    std::vector<std::shared_ptr<PriorCache>> mPriorCaches;
     std::string mPluginNamespace;
 };
 
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "groupNormalizationPlugin.h"
+
+#include <cmath>
+#include <cuda_fp16.h>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+template <typename T>
+void groupNormForwardHost(T const* input, T* output, T const* gamma, T const* beta, int const B, int const C,
+    int const spatial, int const ldc, int const nbGroups, float const epsilon, bool const silu,
+    bool const channelsLast)
+{
+    int const channelsPerGroup = C / nbGroups;
+    int const groupVolume = channelsPerGroup * spatial;
+    for (int batch = 0; batch < B; ++batch)
+    {
+        for (int group = 0; group < nbGroups; ++group)
+        {
+            int const firstChannel = group * channelsPerGroup;
+            auto offset = [&](int const i) -> size_t {
+                return channelsLast ? (static_cast<size_t>(batch) * spatial + i / channelsPerGroup) * ldc
+                        + firstChannel + i % channelsPerGroup
+                                    : (static_cast<size_t>(batch) * C + firstChannel) * spatial + i;
+            };
+
+            // Two pass statistics in double precision, as the reference for the single pass Welford kernel.
+            double sum{0.0};
+            for (int i = 0; i < groupVolume; ++i)
+            {
+                sum += static_cast<float>(input[offset(i)]);
+            }
+            double const mean = sum / groupVolume;
+            double m2{0.0};
+            for (int i = 0; i < groupVolume; ++i)
+            {
+                double const delta = static_cast<float>(input[offset(i)]) - mean;
+                m2 += delta * delta;
+            }
+            double const rstd = 1.0 / std::sqrt(m2 / groupVolume + epsilon);
+
+            for (int i = 0; i < groupVolume; ++i)
+            {
+                int const channel = firstChannel + (channelsLast ? i % channelsPerGroup : i / spatial);
+                double y = (static_cast<float>(input[offset(i)]) - mean) * rstd * static_cast<float>(gamma[channel])
+                    + static_cast<float>(beta[channel]);
+                if (silu)
+                {
+                    y = y / (1.0 + std::exp(-y));
+                }
+                output[offset(i)] = static_cast<T>(static_cast<float>(y));
+            }
+        }
+    }
+}
+
+template void groupNormForwardHost<float>(float const* input, float* output, float const* gamma, float const* beta,
+    int const B, int const C, int const spatial, int const ldc, int const nbGroups, float const epsilon,
+    bool const silu, bool const channelsLast);
+template void groupNormForwardHost<half>(half const* input, half* output, half const* gamma, half const* beta,
+    int const B, int const C, int const spatial, int const ldc, int const nbGroups, float const epsilon,
+    bool const silu, bool const channelsLast);
+
+} // namespace plugin
+} // namespace nvinfer1
@@ -16,6 +16,7 @@
  */
 
 #include "groupNormalizationPlugin.h"
+#include <cuda_fp16.h>
 
 namespace nvinfer1
 {
@@ -59,5 +60,175 @@ cudaError_t scaleShiftChannelsInplace(T* inOut, const int B, const int C, const
 
 template cudaError_t scaleShiftChannelsInplace<float>(float* inOut, const int B, const int C, const int channelVolume, const float* beta,
     const float* gamma, cudaStream_t stream);
+
+template <typename T, unsigned TPB>
+__global__ void siluInplaceKernel(T* inOut, const int n)
+{
+    const int tx = blockIdx.x * TPB + threadIdx.x;
+    if (tx < n)
+    {
+        const float x = static_cast<float>(inOut[tx]);
+        inOut[tx] = static_cast<T>(x / (1.F + __expf(-x)));
+    }
+}
+
+template <typename T>
+cudaError_t siluInplace(T* inOut, const int n, cudaStream_t stream)
+{
+    constexpr int TPB = 256;
+    siluInplaceKernel<T, TPB><<<(n + TPB - 1) / TPB, TPB, 0, stream>>>(inOut, n);
+    return cudaPeekAtLastError();
+}
+
+template cudaError_t siluInplace<float>(float* inOut, const int n, cudaStream_t stream);
+
+// Running statistics of a set of values, combined with Chan's parallel update of Welford's algorithm.
+struct WelfordStats
+{
+    float mean;
+    float m2;
+    float count;
+};
+
+__device__ inline void welfordUpdate(WelfordStats& stats, const float x)
+{
+    stats.count += 1.F;
+    const float delta = x - stats.mean;
+    stats.mean += delta / stats.count;
+    stats.m2 += delta * (x - stats.mean);
+}
+
+__device__ inline void welfordCombine(WelfordStats& a, const WelfordStats& b)
+{
+    const float count = a.count + b.count;
+    if (count == 0.F)
+    {
+        return;
+    }
+    const float delta = b.mean - a.mean;
+    const float ratio = b.count / count;
+    a.mean += delta * ratio;
+    a.m2 += b.m2 + delta * delta * a.count * ratio;
+    a.count = count;
+}
+
+constexpr unsigned kWARP_SIZE = 32;
+
+template <unsigned TPB>
+__device__ WelfordStats welfordBlockReduce(WelfordStats stats)
+{
+    __shared__ WelfordStats warpStats[TPB / kWARP_SIZE];
+
+    for (unsigned offset = kWARP_SIZE / 2; offset > 0; offset /= 2)
+    {
+        WelfordStats other;
+        other.mean = __shfl_down_sync(0xFFFFFFFF, stats.mean, offset);
+        other.m2 = __shfl_down_sync(0xFFFFFFFF, stats.m2, offset);
+        other.count = __shfl_down_sync(0xFFFFFFFF, stats.count, offset);
+        welfordCombine(stats, other);
+    }
+    const unsigned warp = threadIdx.x / kWARP_SIZE;
+    const unsigned lane = threadIdx.x % kWARP_SIZE;
+    if (lane == 0)
+    {
+        warpStats[warp] = stats;
+    }
+    __syncthreads();
+    if (threadIdx.x == 0)
+    {
+        for (unsigned w = 1; w < TPB / kWARP_SIZE; ++w)
+        {
+            welfordCombine(stats, warpStats[w]);
+        }
+        warpStats[0] = stats;
+    }
+    __syncthreads();
+    return warpStats[0];
+}
+
+// One block normalizes one group of one sample.
+// In the linear layout, a group is a contiguous range of channelsPerGroup x spatial values. In the channels-last
+// layout, the values of a group are the channelsPerGroup consecutive channels of each pixel, which are ldc apart.
+// If cacheInShared is set, the group is staged in shared memory by the statistics pass so that the input is read once.
+template <typename T, unsigned TPB, bool kCHANNELS_LAST>
+__global__ void groupNormKernel(const T* input, T* output, const T* gamma, const T* beta, const int C,
+    const int spatial, const int ldc, const int nbGroups, const float epsilon, const bool silu,
+    const bool cacheInShared)
+{
+    extern __shared__ float groupCache[];
+
+    const int batch = blockIdx.x / nbGroups;
+    const int group = blockIdx.x % nbGroups;
+    const int channelsPerGroup = C / nbGroups;
+    const int groupVolume = channelsPerGroup * spatial;
+    const int firstChannel = group * channelsPerGroup;
+
+    auto offset = [&](const int i) -> size_t {
+        return kCHANNELS_LAST
+            ? (static_cast<size_t>(batch) * spatial + i / channelsPerGroup) * ldc + firstChannel + i % channelsPerGroup
+            : (static_cast<size_t>(batch) * C + firstChannel) * spatial + i;
+    };
+
+    WelfordStats stats{0.F, 0.F, 0.F};
+    for (int i = threadIdx.x; i < groupVolume; i += TPB)
+    {
+        const float x = static_cast<float>(input[offset(i)]);
+        if (cacheInShared)
+        {
+            groupCache[i] = x;
+        }
+        welfordUpdate(stats, x);
+    }
+    stats = welfordBlockReduce<TPB>(stats);
+    const float mean = stats.mean;
+    const float rstd = rsqrtf(stats.m2 / stats.count + epsilon);
+
+    // Each thread reads back the cached values it wrote itself.
+    for (int i = threadIdx.x; i < groupVolume; i += TPB)
+    {
+        const float x = cacheInShared ? groupCache[i] : static_cast<float>(input[offset(i)]);
+        const int channel = firstChannel + (kCHANNELS_LAST ? i % channelsPerGroup : i / spatial);
+        float y = (x - mean) * rstd * static_cast<float>(gamma[channel]) + static_cast<float>(beta[channel]);
+        if (silu)
+        {
+            y = y / (1.F + __expf(-y));
+        }
+        output[offset(i)] = static_cast<T>(y);
+    }
+}
+
+template <typename T>
+cudaError_t groupNormForward(const T* input, T* output, const T* gamma, const T* beta, const int B, const int C,
+    const int spatial, const int ldc, const int nbGroups, const float epsilon, const bool silu,
+    const bool channelsLast, cudaStream_t stream)
+{
+    constexpr int TPB = 512;
+    // Groups that fit in the default shared memory limit, next to the static buffer of welfordBlockReduce, are read
+    // from global memory only once.
+    constexpr size_t kMAX_CACHE_BYTES = 48 * 1024 - sizeof(WelfordStats) * (TPB / kWARP_SIZE);
+    const size_t groupBytes = static_cast<size_t>(C / nbGroups) * spatial * sizeof(float);
+    const bool cacheInShared = groupBytes <= kMAX_CACHE_BYTES;
+    const size_t sharedBytes = cacheInShared ? groupBytes : 0;
+    const dim3 grid(B * nbGroups);
+
+    if (channelsLast)
+    {
+        groupNormKernel<T, TPB, true><<<grid, TPB, sharedBytes, stream>>>(
+            input, output, gamma, beta, C, spatial, ldc, nbGroups, epsilon, silu, cacheInShared);
+    }
+    else
+    {
+        groupNormKernel<T, TPB, false><<<grid, TPB, sharedBytes, stream>>>(
+            input, output, gamma, beta, C, spatial, ldc, nbGroups, epsilon, silu, cacheInShared);
+    }
+    return cudaPeekAtLastError();
+}
+
+template cudaError_t groupNormForward<float>(const float* input, float* output, const float* gamma, const float* beta,
+    const int B, const int C, const int spatial, const int ldc, const int nbGroups, const float epsilon,
+    const bool silu, const bool channelsLast, cudaStream_t stream);
+template cudaError_t groupNormForward<half>(const half* input, half* output, const half* gamma, const half* beta,
+    const int B, const int C, const int spatial, const int ldc, const int nbGroups, const float epsilon,
+    const bool silu, const bool channelsLast, cudaStream_t stream);
 } /* plugin */
 } /* nvinfer1 */
@@ -18,6 +18,8 @@
 #include "groupNormalizationPlugin.h"
 #include "common/dimsHelpers.h"
 
+#include <cuda_fp16.h>
+
 #include <numeric>
 #include <stdexcept>
 
@@ -47,17 +49,26 @@ std::vector<nvinfer1::PluginField> GroupNormalizationPluginCreator::mPluginAttri
 
 REGISTER_TENSORRT_PLUGIN(GroupNormalizationPluginCreator);
 
-GroupNormalizationPlugin::GroupNormalizationPlugin(float epsilon, int nbGroups)
+GroupNormalizationPlugin::GroupNormalizationPlugin(
+    float epsilon, int nbGroups, GroupNormActivation activation, bool useCudnn)
     : mEpsilon(epsilon)
     , mNbGroups(nbGroups)
+    , mActivation(activation)
+    , mUseCudnn(useCudnn)
 {
     PLUGIN_VALIDATE(mEpsilon > 0.0F);
     // Number of groups should be positive
     PLUGIN_VALIDATE(mNbGroups > 0);
+    PLUGIN_VALIDATE(mActivation == GroupNormActivation::kNONE || mActivation == GroupNormActivation::kSILU);
 }
 
 int GroupNormalizationPlugin::initialize() noexcept
 {
+    if (!mUseCudnn)
+    {
+        // The fused kernel does not need the BatchNorm scale and bias.
+        return 0;
+    }
     auto allocScaleBias = [this](std::shared_ptr<CudaBind<float>>& buf, float value) {
         PLUGIN_VALIDATE(mNbScaleBias > 0);
         if (!buf || !buf->mPtr || buf->mSize != mNbScaleBias)
@@ -82,6 +93,15 @@ GroupNormalizationPlugin::GroupNormalizationPlugin(void const* data, size_t leng
     deserialize_value(&data, &length, &mEpsilon);
     deserialize_value(&data, &length, &mNbGroups);
     deserialize_value(&data, &length, &mNbScaleBias);
+    // Engines serialized before the activation and the fused kernel were added end here, and use the cuDNN path.
+    mUseCudnn = true;
+    if (length > 0)
+    {
+        int32_t activation{};
+        deserialize_value(&data, &length, &activation);
+        deserialize_value(&data, &length, &mUseCudnn);
+        mActivation = static_cast<GroupNormActivation>(activation);
+    }
 }
 
 char const* GroupNormalizationPlugin::getPluginType() const noexcept
@@ -128,6 +148,45 @@ void GroupNormalizationPlugin::detachFromContext() noexcept
 int GroupNormalizationPlugin::enqueue(nvinfer1::PluginTensorDesc const* inputDesc,
     nvinfer1::PluginTensorDesc const* outputDesc, void const* const* inputs, void* const* outputs, void* workspace,
     cudaStream_t stream) noexcept
+{
+    if (mUseCudnn)
+    {
+        return enqueueCudnn(inputDesc, inputs, outputs, stream);
+    }
+
+    nvinfer1::Dims const& inputDims = inputDesc[0].dims;
+    int const batchSize = inputDims.d[0];
+    int const nbChannels = inputDims.d[1];
+    if (nbChannels % mNbGroups != 0)
+    {
+        return STATUS_BAD_PARAM;
+    }
+    mChannelVolume = pluginInternal::volume(inputDims, /*start*/ 2, /*stop*/ inputDims.nbDims);
+
+    TensorFormat const format = inputDesc[0].format;
+    bool const channelsLast = format == TensorFormat::kHWC || format == TensorFormat::kHWC8;
+    // kHWC8 pads the channels of each pixel to a multiple of 8.
+    int const ldc = format == TensorFormat::kHWC8 ? (nbChannels + 7) / 8 * 8 : nbChannels;
+    bool const silu = mActivation == GroupNormActivation::kSILU;
+
+    cudaError_t status{cudaSuccess};
+    if (inputDesc[0].type == DataType::kHALF)
+    {
+        status = groupNormForward(static_cast<half const*>(inputs[0]), static_cast<half*>(outputs[0]),
+            static_cast<half const*>(inputs[1]), static_cast<half const*>(inputs[2]), batchSize, nbChannels,
+            mChannelVolume, ldc, mNbGroups, mEpsilon, silu, channelsLast, stream);
+    }
+    else
+    {
+        status = groupNormForward(static_cast<float const*>(inputs[0]), static_cast<float*>(outputs[0]),
+            static_cast<float const*>(inputs[1]), static_cast<float const*>(inputs[2]), batchSize, nbChannels,
+            mChannelVolume, ldc, mNbGroups, mEpsilon, silu, channelsLast, stream);
+    }
+    return status == cudaSuccess ? STATUS_SUCCESS : STATUS_FAILURE;
+}
+
+int GroupNormalizationPlugin::enqueueCudnn(nvinfer1::PluginTensorDesc const* inputDesc, void const* const* inputs,
+    void* const* outputs, cudaStream_t stream) noexcept
 {
     // Get the input dimensions
     nvinfer1::Dims input_dims = inputDesc[0].dims;
@@ -176,13 +235,18 @@ int GroupNormalizationPlugin::enqueue(nvinfer1::PluginTensorDesc const* inputDes
         ));
 
     float* output = static_cast<float*>(outputs[0]);
-    return scaleShiftChannelsInplace(output, batchSize, nbChannels, mChannelVolume,
+    cudaError_t status = scaleShiftChannelsInplace(output, batchSize, nbChannels, mChannelVolume,
         static_cast<float const*>(inputs[2]), static_cast<float const*>(inputs[1]), stream); // mBetaDev, mGammaDev,
+    if (status == cudaSuccess && mActivation == GroupNormActivation::kSILU)
+    {
+        status = siluInplace(output, batchSize * nbChannels * mChannelVolume, stream);
+    }
+    return status;
 }
 
 size_t GroupNormalizationPlugin::getSerializationSize() const noexcept
 {
-    return sizeof(mNbGroups) + sizeof(mEpsilon) + sizeof(mNbScaleBias);
+    return sizeof(mNbGroups) + sizeof(mEpsilon) + sizeof(mNbScaleBias) + sizeof(int32_t) + sizeof(mUseCudnn);
 }
 
 void GroupNormalizationPlugin::serialize(void* buffer) const noexcept
@@ -190,14 +254,35 @@ void GroupNormalizationPlugin::serialize(void* buffer) const noexcept
     serialize_value(&buffer, mEpsilon);
     serialize_value(&buffer, mNbGroups);
     serialize_value(&buffer, mNbScaleBias);
+    serialize_value(&buffer, static_cast<int32_t>(mActivation));
+    serialize_value(&buffer, mUseCudnn);
 }
 
 bool GroupNormalizationPlugin::supportsFormatCombination(
     int pos, nvinfer1::PluginTensorDesc const* inOut, int nbInputs, int nbOutputs) noexcept
 {
     PLUGIN_ASSERT(inOut && pos < (nbInputs + nbOutputs));
-    return ((inOut[pos].type == nvinfer1::DataType::kFLOAT) && inOut[pos].format == nvinfer1::PluginFormat::kLINEAR
-        && inOut[pos].type == inOut[0].type);
+    PluginTensorDesc const& desc = inOut[pos];
+    if (mUseCudnn)
+    {
+        return ((desc.type == nvinfer1::DataType::kFLOAT) && desc.format == nvinfer1::PluginFormat::kLINEAR
+            && desc.type == inOut[0].type);
+    }
+    if (pos == 0)
+    {
+        // Channels-last formats are supported for 4-D inputs: kHWC for FP32 and kHWC8 for FP16.
+        bool const isChannelsLast = desc.dims.nbDims == 4
+            && ((desc.type == nvinfer1::DataType::kFLOAT && desc.format == nvinfer1::PluginFormat::kHWC)
+                || (desc.type == nvinfer1::DataType::kHALF && desc.format == nvinfer1::PluginFormat::kHWC8));
+        return (desc.type == nvinfer1::DataType::kFLOAT || desc.type == nvinfer1::DataType::kHALF)
+            && (desc.format == nvinfer1::PluginFormat::kLINEAR || isChannelsLast);
+    }
+    if (pos < nbInputs)
+    {
+        // Scale and bias
+        return desc.type == inOut[0].type && desc.format == nvinfer1::PluginFormat::kLINEAR;
+    }
+    return desc.type == inOut[0].type && desc.format == inOut[0].format;
 }
 
 void GroupNormalizationPlugin::terminate() noexcept {}
@@ -212,7 +297,7 @@ IPluginV2DynamicExt* GroupNormalizationPlugin::clone() const noexcept
 {
     try
     {
-        auto* plugin = new GroupNormalizationPlugin(mEpsilon, mNbGroups);
+        auto* plugin = new GroupNormalizationPlugin(mEpsilon, mNbGroups, mActivation, mUseCudnn);
         plugin->setPluginNamespace(mPluginNamespace);
         plugin->mNbScaleBias = mNbScaleBias;
         plugin->mBnScales = mBnScales;
@@ -261,6 +346,8 @@ GroupNormalizationPluginCreator::GroupNormalizationPluginCreator()
     mPluginAttributes.clear();
     mPluginAttributes.emplace_back(PluginField("eps", nullptr, PluginFieldType::kFLOAT32, 1));
     mPluginAttributes.emplace_back(PluginField("num_groups", nullptr, PluginFieldType::kINT32, 1));
+    mPluginAttributes.emplace_back(PluginField("activation", nullptr, PluginFieldType::kINT32, 1));
+    mPluginAttributes.emplace_back(PluginField("use_cudnn", nullptr, PluginFieldType::kINT32, 1));
 
     mFC.nbFields = mPluginAttributes.size();
     mFC.fields = mPluginAttributes.data();
@@ -299,6 +386,9 @@ IPluginV2DynamicExt* GroupNormalizationPluginCreator::createPlugin(
         // Set default values
         int nbGroups{1};
         float epsilon{0.00001F};
+        int32_t activation{0};
+        // The fused kernel is the default. Set use_cudnn = 1 for the cuDNN path.
+        int32_t useCudnn{0};
         for (int i = 0; i < fc->nbFields; i++)
         {
             std::string field_name(fc->fields[i].name);
@@ -310,9 +400,18 @@ IPluginV2DynamicExt* GroupNormalizationPluginCreator::createPlugin(
             {
                 nbGroups = *static_cast<int const*>(fc->fields[i].data);
             }
+            if (field_name.compare("activation") == 0)
+            {
+                activation = *static_cast<int32_t const*>(fc->fields[i].data);
+            }
+            if (field_name.compare("use_cudnn") == 0)
+            {
+                useCudnn = *static_cast<int32_t const*>(fc->fields[i].data);
+            }
         }
 
-        GroupNormalizationPlugin* plugin = new GroupNormalizationPlugin(epsilon, nbGroups);
+        GroupNormalizationPlugin* plugin = new GroupNormalizationPlugin(
+            epsilon, nbGroups, static_cast<GroupNormActivation>(activation), useCudnn != 0);
         plugin->setPluginNamespace(mNamespace.c_str());
 
         return plugin;
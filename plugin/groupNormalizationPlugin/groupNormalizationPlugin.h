@@ -37,10 +37,34 @@ template <typename T>
 cudaError_t scaleShiftChannelsInplace(T* inOut, int const B, int const C, int const channelVolume, float const* beta,
     float const* gamma, cudaStream_t stream);
 
+template <typename T>
+cudaError_t siluInplace(T* inOut, int const n, cudaStream_t stream);
+
+// Fused GroupNorm: Welford statistics, normalization, scale and shift, and optional SiLU in a single kernel.
+// spatial is the volume of the dimensions after C. In the channels-last layout, ldc is the distance between pixels,
+// which is C rounded up to the vectorization of the format.
+template <typename T>
+cudaError_t groupNormForward(T const* input, T* output, T const* gamma, T const* beta, int const B, int const C,
+    int const spatial, int const ldc, int const nbGroups, float const epsilon, bool const silu,
+    bool const channelsLast, cudaStream_t stream);
+
+// Host reference of groupNormForward, accumulating in double precision.
+template <typename T>
+void groupNormForwardHost(T const* input, T* output, T const* gamma, T const* beta, int const B, int const C,
+    int const spatial, int const ldc, int const nbGroups, float const epsilon, bool const silu,
+    bool const channelsLast);
+
+enum class GroupNormActivation : int32_t
+{
+    kNONE = 0,
+    kSILU = 1,
+};
+
 class GroupNormalizationPlugin final : public nvinfer1::IPluginV2DynamicExt
 {
 public:
-    GroupNormalizationPlugin(float epsilon, int const nbGroups);
+    GroupNormalizationPlugin(float epsilon, int const nbGroups,
+        GroupNormActivation activation = GroupNormActivation::kNONE, bool useCudnn = false);
 
     GroupNormalizationPlugin(void const* data, size_t length);
 
@@ -97,9 +121,16 @@ private:
     char const* mPluginNamespace;
     std::string mNamespace;
 
+    int enqueueCudnn(nvinfer1::PluginTensorDesc const* inputDesc, void const* const* inputs, void* const* outputs,
+        cudaStream_t stream) noexcept;
+
     float mEpsilon;
     int mNbGroups;
     int mChannelVolume;
+    GroupNormActivation mActivation{GroupNormActivation::kNONE};
+    // Use cudnnBatchNormalizationForwardTraining followed by a scale and shift kernel instead of the fused kernel.
+    // This path only supports FP32 tensors in linear format.
+    bool mUseCudnn{false};
 
     cudnnHandle_t _cudnn_handle;
     // Describes input and output.
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "instanceNormalizationPlugin.h"
+
+#include <cmath>
+#include <cuda_fp16.h>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+template <typename T>
+void instanceNorm3dForwardHost(T const* input, T* output, float const* scale, float const* bias, int32_t n, int32_t c,
+    int32_t volume, float epsilon, int32_t relu, float alpha, bool channelsLast)
+{
+    for (int32_t batch = 0; batch < n; ++batch)
+    {
+        for (int32_t channel = 0; channel < c; ++channel)
+        {
+            auto offset = [&](int32_t i) -> size_t {
+                return channelsLast ? (static_cast<size_t>(batch) * volume + i) * c + channel
+                                    : (static_cast<size_t>(batch) * c + channel) * volume + i;
+            };
+
+            // Two pass statistics in double precision, as the reference for the split Welford kernels.
+            double sum{0.0};
+            for (int32_t i = 0; i < volume; ++i)
+            {
+                sum += static_cast<float>(input[offset(i)]);
+            }
+            double const mean = sum / volume;
+            double m2{0.0};
+            for (int32_t i = 0; i < volume; ++i)
+            {
+                double const delta = static_cast<float>(input[offset(i)]) - mean;
+                m2 += delta * delta;
+            }
+            double const rstd = 1.0 / std::sqrt(m2 / volume + epsilon);
+
+            for (int32_t i = 0; i < volume; ++i)
+            {
+                double y = (static_cast<float>(input[offset(i)]) - mean) * rstd * scale[channel] + bias[channel];
+                if (relu > 0 && y < 0.0)
+                {
+                    y *= alpha;
+                }
+                output[offset(i)] = static_cast<T>(static_cast<float>(y));
+            }
+        }
+    }
+}
+
+template void instanceNorm3dForwardHost<float>(float const* input, float* output, float const* scale,
+    float const* bias, int32_t n, int32_t c, int32_t volume, float epsilon, int32_t relu, float alpha,
+    bool channelsLast);
+template void instanceNorm3dForwardHost<__half>(__half const* input, __half* output, float const* scale,
+    float const* bias, int32_t n, int32_t c, int32_t volume, float epsilon, int32_t relu, float alpha,
+    bool channelsLast);
+
+} // namespace plugin
+} // namespace nvinfer1
@@ -53,6 +53,180 @@ __global__ __launch_bounds__(THREADS_PER_CTA) void in3dReluActivation(
     dst[idx] = (val < 0.F) ? val * alpha : val;
 }
 
+namespace nvinfer1
+{
+namespace plugin
+{
+namespace
+{
+int32_t constexpr kIN3D_THREADS_PER_CTA{256};
+// Every voxel range of a split holds at least this many voxels, up to kIN3D_MAX_SPLITS splits per instance.
+int32_t constexpr kIN3D_VOXELS_PER_SPLIT{16384};
+int32_t constexpr kIN3D_MAX_SPLITS{64};
+
+struct In3dStats
+{
+    float mean;
+    float m2;
+    float count;
+};
+
+__device__ inline void in3dWelfordCombine(In3dStats& a, In3dStats const& b)
+{
+    float const count = a.count + b.count;
+    if (count == 0.F)
+    {
+        return;
+    }
+    float const delta = b.mean - a.mean;
+    float const ratio = b.count / count;
+    a.mean += delta * ratio;
+    a.m2 += b.m2 + delta * delta * a.count * ratio;
+    a.count = count;
+}
+
+int32_t in3dNbSplits(int32_t volume)
+{
+    return std::min(kIN3D_MAX_SPLITS, std::max(1, volume / kIN3D_VOXELS_PER_SPLIT));
+}
+
+// Offset of voxel i of channel c of sample n, in NCDHW or NDHWC.
+template <bool kCHANNELS_LAST>
+__device__ inline size_t in3dOffset(int32_t n, int32_t c, int32_t i, int32_t nbChannels, int32_t volume)
+{
+    return kCHANNELS_LAST ? (static_cast<size_t>(n) * volume + i) * nbChannels + c
+                          : (static_cast<size_t>(n) * nbChannels + c) * volume + i;
+}
+} // namespace
+
+// Grid is splits x channel blocks x N. A CTA covers CHANNELS_PER_CTA channels of one voxel range of one sample. With
+// one channel per CTA (NCDHW) all threads stride over the contiguous volume; with 32 (NDHWC) the 32 threads of a row
+// read adjacent channels of one voxel, so loads stay coalesced, and the rows stride over the voxels.
+template <typename T, int32_t CHANNELS_PER_CTA>
+__global__ __launch_bounds__(kIN3D_THREADS_PER_CTA) void in3dPartialStats(
+    T const* src, In3dStats* partials, int32_t nbChannels, int32_t volume)
+{
+    int32_t constexpr kROWS = kIN3D_THREADS_PER_CTA / CHANNELS_PER_CTA;
+    __shared__ In3dStats smem[kIN3D_THREADS_PER_CTA];
+
+    int32_t const lane = threadIdx.x % CHANNELS_PER_CTA;
+    int32_t const row = threadIdx.x / CHANNELS_PER_CTA;
+    int32_t const c = blockIdx.y * CHANNELS_PER_CTA + lane;
+    int32_t const n = blockIdx.z;
+    int32_t const chunk = (volume + gridDim.x - 1) / gridDim.x;
+    int32_t const begin = blockIdx.x * chunk;
+    int32_t const end = min(volume, begin + chunk);
+
+    In3dStats stats{0.F, 0.F, 0.F};
+    if (c < nbChannels)
+    {
+        for (int32_t i = begin + row; i < end; i += kROWS)
+        {
+            float const x = static_cast<float>(src[in3dOffset<(CHANNELS_PER_CTA > 1)>(n, c, i, nbChannels, volume)]);
+            stats.count += 1.F;
+            float const delta = x - stats.mean;
+            stats.mean += delta / stats.count;
+            stats.m2 += delta * (x - stats.mean);
+        }
+    }
+    smem[threadIdx.x] = stats;
+    __syncthreads();
+    for (int32_t stride = kROWS / 2; stride > 0; stride /= 2)
+    {
+        if (row < stride)
+        {
+            in3dWelfordCombine(smem[threadIdx.x], smem[threadIdx.x + stride * CHANNELS_PER_CTA]);
+        }
+        __syncthreads();
+    }
+    if (row == 0 && c < nbChannels)
+    {
+        partials[(static_cast<size_t>(n) * nbChannels + c) * gridDim.x + blockIdx.x] = smem[lane];
+    }
+}
+
+// Same grid as in3dPartialStats. Every thread combines the partial statistics of its channel, then the CTA normalizes
+// its voxel range with the per-channel scale and bias, which are read directly rather than replicated per sample.
+template <typename T, int32_t CHANNELS_PER_CTA>
+__global__ __launch_bounds__(kIN3D_THREADS_PER_CTA) void in3dNormalize(T const* src, T* dst,
+    In3dStats const* partials, float const* scale, float const* bias, int32_t nbChannels, int32_t volume,
+    float epsilon, int32_t relu, float alpha)
+{
+    int32_t constexpr kROWS = kIN3D_THREADS_PER_CTA / CHANNELS_PER_CTA;
+
+    int32_t const lane = threadIdx.x % CHANNELS_PER_CTA;
+    int32_t const row = threadIdx.x / CHANNELS_PER_CTA;
+    int32_t const c = blockIdx.y * CHANNELS_PER_CTA + lane;
+    int32_t const n = blockIdx.z;
+    if (c >= nbChannels)
+    {
+        return;
+    }
+
+    int32_t const nbSplits = gridDim.x;
+    In3dStats stats{0.F, 0.F, 0.F};
+    In3dStats const* channelPartials = partials + (static_cast<size_t>(n) * nbChannels + c) * nbSplits;
+    for (int32_t s = 0; s < nbSplits; ++s)
+    {
+        in3dWelfordCombine(stats, channelPartials[s]);
+    }
+    float const a = scale[c] * rsqrtf(stats.m2 / stats.count + epsilon);
+    float const b = bias[c] - stats.mean * a;
+
+    int32_t const chunk = (volume + gridDim.x - 1) / gridDim.x;
+    int32_t const begin = blockIdx.x * chunk;
+    int32_t const end = min(volume, begin + chunk);
+    for (int32_t i = begin + row; i < end; i += kROWS)
+    {
+        size_t const offset = in3dOffset<(CHANNELS_PER_CTA > 1)>(n, c, i, nbChannels, volume);
+        float y = static_cast<float>(src[offset]) * a + b;
+        if (relu > 0 && y < 0.F)
+        {
+            y *= alpha;
+        }
+        dst[offset] = static_cast<T>(y);
+    }
+}
+
+size_t instanceNorm3dWorkspaceSize(int32_t n, int32_t c, int32_t volume)
+{
+    return static_cast<size_t>(n) * c * in3dNbSplits(volume) * sizeof(In3dStats);
+}
+
+template <typename T>
+cudaError_t instanceNorm3dForward(T const* input, T* output, float const* scale, float const* bias, int32_t n,
+    int32_t c, int32_t volume, float epsilon, int32_t relu, float alpha, bool channelsLast, void* workspace,
+    cudaStream_t stream)
+{
+    auto* partials = static_cast<In3dStats*>(workspace);
+    int32_t const nbSplits = in3dNbSplits(volume);
+    if (channelsLast)
+    {
+        int32_t constexpr kCHANNELS_PER_CTA{32};
+        dim3 const grid(nbSplits, divUp(c, kCHANNELS_PER_CTA), n);
+        in3dPartialStats<T, kCHANNELS_PER_CTA><<<grid, kIN3D_THREADS_PER_CTA, 0, stream>>>(input, partials, c, volume);
+        in3dNormalize<T, kCHANNELS_PER_CTA><<<grid, kIN3D_THREADS_PER_CTA, 0, stream>>>(
+            input, output, partials, scale, bias, c, volume, epsilon, relu, alpha);
+    }
+    else
+    {
+        dim3 const grid(nbSplits, c, n);
+        in3dPartialStats<T, 1><<<grid, kIN3D_THREADS_PER_CTA, 0, stream>>>(input, partials, c, volume);
+        in3dNormalize<T, 1><<<grid, kIN3D_THREADS_PER_CTA, 0, stream>>>(
+            input, output, partials, scale, bias, c, volume, epsilon, relu, alpha);
+    }
+    return cudaPeekAtLastError();
+}
+
+template cudaError_t instanceNorm3dForward<float>(float const* input, float* output, float const* scale,
+    float const* bias, int32_t n, int32_t c, int32_t volume, float epsilon, int32_t relu, float alpha,
+    bool channelsLast, void* workspace, cudaStream_t stream);
+template cudaError_t instanceNorm3dForward<__half>(__half const* input, __half* output, float const* scale,
+    float const* bias, int32_t n, int32_t c, int32_t volume, float epsilon, int32_t relu, float alpha,
+    bool channelsLast, void* workspace, cudaStream_t stream);
+} // namespace plugin
+} // namespace nvinfer1
+
 cudnnStatus_t convertTrt2cudnnDtype(nvinfer1::DataType trt_dtype, cudnnDataType_t* cudnn_dtype)
 {
     switch (trt_dtype)
@@ -203,7 +377,13 @@ size_t InstanceNormalizationPlugin::getWorkspaceSize(nvinfer1::PluginTensorDesc
     nvinfer1::Dims input_dims = inputs[0].dims;
     PLUGIN_ASSERT(input_dims.nbDims == 4 || input_dims.nbDims == 5);
 
-    if (inputs[0].format == nvinfer1::PluginFormat::kLINEAR)
+    if (input_dims.nbDims == 5
+        && (inputs[0].format == nvinfer1::PluginFormat::kLINEAR || inputs[0].format == nvinfer1::PluginFormat::kDHWC))
+    {
+        return instanceNorm3dWorkspaceSize(
+            input_dims.d[0], input_dims.d[1], input_dims.d[2] * input_dims.d[3] * input_dims.d[4]);
+    }
+    else if (inputs[0].format == nvinfer1::PluginFormat::kLINEAR)
     {
         nvinfer1::Dims input_dims = inputs[0].dims;
 
@@ -338,71 +518,30 @@ int32_t InstanceNormalizationPlugin::enqueue(nvinfer1::PluginTensorDesc const* i
     }
     else
     {
-        if (inputDesc[0].format == nvinfer1::PluginFormat::kLINEAR)
+        if (inputDesc[0].format == nvinfer1::PluginFormat::kLINEAR
+            || inputDesc[0].format == nvinfer1::PluginFormat::kDHWC)
         {
-            PLUGIN_CHECK_CUDNN(cudnnSetStream(mCudnnHandle, stream));
             nvinfer1::Dims input_dims = inputDesc[0].dims;
             int32_t n = input_dims.d[0];
             int32_t c = input_dims.d[1];
-            int32_t d = input_dims.d[2];
-            int32_t h = input_dims.d[3];
-            int32_t w = input_dims.d[4];
-            size_t nchan_bytes = c * sizeof(float);
-
-            // Note: We repeat the data for each batch entry so that we can do the full
-            //       computation in a single CUDNN call in enqueue().
-            float* _d_array = (float*) workspace;
-            float* d_scale = &_d_array[0];
-            float* d_bias = &_d_array[n * c];
-            for (int32_t i = 0; i < n; ++i)
-            {
-                PLUGIN_CHECK_CUDA(
-                    cudaMemcpyAsync(d_scale + i * c, mDeviceScale, nchan_bytes, cudaMemcpyDeviceToDevice, stream));
-                PLUGIN_CHECK_CUDA(
-                    cudaMemcpyAsync(d_bias + i * c, mDeviceBias, nchan_bytes, cudaMemcpyDeviceToDevice, stream));
-            }
+            int32_t volume = input_dims.d[2] * input_dims.d[3] * input_dims.d[4];
+            bool const channelsLast = inputDesc[0].format == nvinfer1::PluginFormat::kDHWC;
 
-            int32_t nc_dimA[] = {1, n * c, 1, 1, 1};
-            int32_t nc_strideA[] = {nc_dimA[1] * nc_dimA[2] * nc_dimA[3] * nc_dimA[4],
-                nc_dimA[2] * nc_dimA[3] * nc_dimA[4], nc_dimA[3] * nc_dimA[4], nc_dimA[4], 1};
-            int32_t img_dimA[] = {1, n * c, d, h, w};
-            int32_t img_strideA[] = {img_dimA[1] * img_dimA[2] * img_dimA[3] * img_dimA[4],
-                img_dimA[2] * img_dimA[3] * img_dimA[4], img_dimA[3] * img_dimA[4], img_dimA[4], 1};
-
-            PLUGIN_CHECK_CUDNN(cudnnSetTensorNdDescriptor(mBDescriptor, CUDNN_DATA_FLOAT, 5, nc_dimA, nc_strideA));
-            cudnnDataType_t cudnn_dtype;
-            PLUGIN_CHECK_CUDNN(convertTrt2cudnnDtype(inputDesc[0].type, &cudnn_dtype));
-            PLUGIN_CHECK_CUDNN(cudnnSetTensorNdDescriptor(mXDescriptor, cudnn_dtype, 5, img_dimA, img_strideA));
-            PLUGIN_CHECK_CUDNN(cudnnSetTensorNdDescriptor(mYDescriptor, cudnn_dtype, 5, img_dimA, img_strideA));
-            float alpha = 1;
-            float beta = 0;
-
-            void const* x_ptr = inputs[0];
-            void* y_ptr = outputs[0];
-            // Note: Use of CUDNN_BATCHNORM_SPATIAL_PERSISTENT can cause numerical
-            //       overflows (NaNs) for fp32 data in some circumstances. The lower-
-            //       performance CUDNN_BATCHNORM_SPATIAL should be used if this is not
-            //       acceptable.
-
-            cudnnBatchNormMode_t cudnnBatchNormMode = CUDNN_BATCHNORM_SPATIAL_PERSISTENT;
-
-            cudaStreamCaptureStatus streamStatus;
-            PLUGIN_CHECK_CUDA(cudaStreamIsCapturing(stream, &streamStatus));
-
-            if (streamStatus != cudaStreamCaptureStatusNone && mCudaDriverVersion < 11000)
+            // Scale and bias are broadcast over the batch by the kernel, so no per-sample copies are needed.
+            switch (inputDesc[0].type)
             {
-                gLogVerbose
-                    << "Using CUDNN_BATCHNORM_SPATIAL as a CUDA graph capture is in progress but the CUDA version "
-                       "may have issues with using CUDNN_BATCHNORM_SPATIAL_PERSISTENT"
-                    << std::endl;
-                cudnnBatchNormMode = CUDNN_BATCHNORM_SPATIAL;
+            case nvinfer1::DataType::kFLOAT:
+                PLUGIN_CHECK_CUDA(instanceNorm3dForward(static_cast<float const*>(inputs[0]),
+                    static_cast<float*>(outputs[0]), mDeviceScale, mDeviceBias, n, c, volume, mEpsilon, mRelu, mAlpha,
+                    channelsLast, workspace, stream));
+                break;
+            case nvinfer1::DataType::kHALF:
+                PLUGIN_CHECK_CUDA(instanceNorm3dForward(static_cast<__half const*>(inputs[0]),
+                    static_cast<__half*>(outputs[0]), mDeviceScale, mDeviceBias, n, c, volume, mEpsilon, mRelu, mAlpha,
+                    channelsLast, workspace, stream));
+                break;
+            default: PLUGIN_ASSERT(false && "Unexpected input type");
             }
-
-            PLUGIN_CHECK_CUDNN(cudnnBatchNormalizationForwardTraining(mCudnnHandle, cudnnBatchNormMode,
-                &alpha, &beta, mXDescriptor, x_ptr, mYDescriptor, y_ptr, mBDescriptor, d_scale, d_bias, 1., nullptr,
-                nullptr, mEpsilon, nullptr, nullptr));
-
-            callRelu(y_ptr, n * c * d * h * w, inputDesc[0].type);
         }
         else if (inputDesc[0].format == nvinfer1::PluginFormat::kDHWC8
             || inputDesc[0].format == nvinfer1::PluginFormat::kCDHW32)
@@ -493,8 +632,9 @@ bool InstanceNormalizationPlugin::supportsFormatCombination(
     PLUGIN_ASSERT(pos == 0 || pos == 1);
 
     // For 4-D or 3-D tensor (nbSpatialDims == 1 or 2), only FP32_Linear and FP16_Linear are supported.
-    // For 5-D tensor (nbSpatialDims == 3), FP32_Linear, FP16_Linear, FP16_DHWC8, and INT8_CDHW32 are supported.
-    // This is because we have special InstanceNorm3D kernels for vectorized formats from MLPerf-Inference.
+    // For 5-D tensor (nbSpatialDims == 3), FP32_Linear, FP16_Linear, FP32_DHWC, FP16_DHWC8, and INT8_CDHW32 are
+    // supported. This is because we have special InstanceNorm3D kernels for vectorized formats from MLPerf-Inference,
+    // and a fused kernel for the linear and channel-last formats.
 
     int32_t const nbDims = inOut[pos].dims.nbDims;
     PLUGIN_ASSERT(nbDims >= 3);
@@ -509,6 +649,10 @@ bool InstanceNormalizationPlugin::supportsFormatCombination(
         = (inOut[pos].type == nvinfer1::DataType::kHALF && inOut[pos].format == nvinfer1::PluginFormat::kLINEAR
             && inOut[pos].type == inOut[0].type && inOut[pos].format == inOut[0].format);
 
+    bool const isFP32DHWC
+        = (inOut[pos].type == nvinfer1::DataType::kFLOAT && inOut[pos].format == nvinfer1::PluginFormat::kDHWC
+            && inOut[pos].type == inOut[0].type && inOut[pos].format == inOut[0].format);
+
     bool const isFP16DHWC8
         = (inOut[pos].type == nvinfer1::DataType::kHALF && inOut[pos].format == nvinfer1::PluginFormat::kDHWC8
             && inOut[pos].type == inOut[0].type && inOut[pos].format == inOut[0].format);
@@ -517,7 +661,8 @@ bool InstanceNormalizationPlugin::supportsFormatCombination(
         = (inOut[pos].type == nvinfer1::DataType::kINT8 && inOut[pos].format == nvinfer1::PluginFormat::kCDHW32
             && inOut[pos].type == inOut[0].type && inOut[pos].format == inOut[0].format);
 
-    bool const isFormatOK = isFP32Linear || isFP16Linear || (is3DInstanceNorm && (isFP16DHWC8 || isINT8CDHW32));
+    bool const isFormatOK
+        = isFP32Linear || isFP16Linear || (is3DInstanceNorm && (isFP32DHWC || isFP16DHWC8 || isINT8CDHW32));
 
     // Kernels for vectorized formats only support the case of C % spv == 0.
     int32_t spv{1};
@@ -187,6 +187,20 @@ public:
         char const* name, void const* serialData, size_t serialLength) noexcept override;
 };
 
+// Fused instance normalization of 3-D volumes in NCDHW or NDHWC (channelsLast), with optional leaky relu.
+// Scale and bias hold one value per channel and are broadcast over the batch inside the kernel.
+size_t instanceNorm3dWorkspaceSize(int32_t n, int32_t c, int32_t volume);
+
+template <typename T>
+cudaError_t instanceNorm3dForward(T const* input, T* output, float const* scale, float const* bias, int32_t n,
+    int32_t c, int32_t volume, float epsilon, int32_t relu, float alpha, bool channelsLast, void* workspace,
+    cudaStream_t stream);
+
+// Host reference of instanceNorm3dForward, accumulating in double precision.
+template <typename T>
+void instanceNorm3dForwardHost(T const* input, T* output, float const* scale, float const* bias, int32_t n, int32_t c,
+    int32_t volume, float epsilon, int32_t relu, float alpha, bool channelsLast);
+
 } // namespace plugin
 } // namespace nvinfer1
 
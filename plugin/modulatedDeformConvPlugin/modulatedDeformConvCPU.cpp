@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ **************************************************************************
+ * Modified from mmcv (https://github.com/open-mmlab/mmcv/tree/master/mmcv)
+ * Copyright (c) OpenMMLab. All Rights Reserved.
+ * Licensed under the Apache License, Version 2.0 [see LICENSE for details]
+ * https://github.com/open-mmlab/mmcv/blob/master/LICENSE
+ **************************************************************************
+ */
+
+#include "modulatedDeformConvPlugin.h"
+#include <cmath>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+namespace
+{
+float bilinearHost(float const* input, int32_t height, int32_t width, float h, float w)
+{
+    int32_t const hLow = static_cast<int32_t>(std::floor(h));
+    int32_t const wLow = static_cast<int32_t>(std::floor(w));
+    int32_t const hHigh = hLow + 1;
+    int32_t const wHigh = wLow + 1;
+
+    float const lh = h - hLow;
+    float const lw = w - wLow;
+    float const hh = 1 - lh;
+    float const hw = 1 - lw;
+
+    auto at = [&](int32_t y, int32_t x) {
+        return (y >= 0 && x >= 0 && y <= height - 1 && x <= width - 1) ? input[y * width + x] : 0.F;
+    };
+
+    return hh * hw * at(hLow, wLow) + hh * lw * at(hLow, wHigh) + lh * hw * at(hHigh, wLow)
+        + lh * lw * at(hHigh, wHigh);
+}
+} // namespace
+
+void modulatedDeformableIm2colHost(float const* dataIm, float const* dataOffset, float const* dataMask,
+    int32_t batchSize, int32_t channels, int32_t heightIm, int32_t widthIm, int32_t heightCol, int32_t widthCol,
+    int32_t kernelH, int32_t kernelW, int32_t padH, int32_t padW, int32_t strideH, int32_t strideW, int32_t dilationH,
+    int32_t dilationW, int32_t deformableGroup, float* dataCol)
+{
+    int32_t const channelPerDeformableGroup = channels / deformableGroup;
+    int32_t const kernelSize = kernelH * kernelW;
+    size_t const planeCol = static_cast<size_t>(heightCol) * widthCol;
+
+    for (int32_t b = 0; b < batchSize; ++b)
+    {
+        for (int32_t c = 0; c < channels; ++c)
+        {
+            int32_t const dg = c / channelPerDeformableGroup;
+            float const* im = dataIm + (static_cast<size_t>(b) * channels + c) * heightIm * widthIm;
+            float const* offset
+                = dataOffset + (static_cast<size_t>(b) * deformableGroup + dg) * 2 * kernelSize * planeCol;
+            float const* mask = dataMask + (static_cast<size_t>(b) * deformableGroup + dg) * kernelSize * planeCol;
+            float* col = dataCol + (static_cast<size_t>(b) * channels + c) * kernelSize * planeCol;
+
+            for (int32_t i = 0; i < kernelH; ++i)
+            {
+                for (int32_t j = 0; j < kernelW; ++j)
+                {
+                    int32_t const kIdx = i * kernelW + j;
+                    for (int32_t y = 0; y < heightCol; ++y)
+                    {
+                        for (int32_t x = 0; x < widthCol; ++x)
+                        {
+                            size_t const pos = static_cast<size_t>(y) * widthCol + x;
+                            float const hIm = y * strideH - padH + i * dilationH + offset[2 * kIdx * planeCol + pos];
+                            float const wIm
+                                = x * strideW - padW + j * dilationW + offset[(2 * kIdx + 1) * planeCol + pos];
+                            float val = 0.F;
+                            if (hIm > -1 && wIm > -1 && hIm < heightIm && wIm < widthIm)
+                            {
+                                val = bilinearHost(im, heightIm, widthIm, hIm, wIm);
+                            }
+                            col[kIdx * planeCol + pos] = val * mask[kIdx * planeCol + pos];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace plugin
+} // namespace nvinfer1
@@ -120,3 +120,32 @@ cublasStatus_t cublasGemmWrap<half>(cublasHandle_t handle, cublasOperation_t tra
 {
     return cublasHgemm(handle, transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
+
+template <typename TScalar>
+cublasStatus_t cublasGemmStridedBatchedWrap(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_t transb,
+    int32_t m, int32_t n, int32_t k, TScalar const* alpha, TScalar const* A, int32_t lda, int64_t strideA,
+    TScalar const* B, int32_t ldb, int64_t strideB, TScalar const* beta, TScalar* C, int32_t ldc, int64_t strideC,
+    int32_t batchCount)
+{
+    return CUBLAS_STATUS_INTERNAL_ERROR;
+}
+
+template <>
+cublasStatus_t cublasGemmStridedBatchedWrap<float>(cublasHandle_t handle, cublasOperation_t transa,
+    cublasOperation_t transb, int32_t m, int32_t n, int32_t k, float const* alpha, float const* A, int32_t lda,
+    int64_t strideA, float const* B, int32_t ldb, int64_t strideB, float const* beta, float* C, int32_t ldc,
+    int64_t strideC, int32_t batchCount)
+{
+    return cublasSgemmStridedBatched(
+        handle, transa, transb, m, n, k, alpha, A, lda, strideA, B, ldb, strideB, beta, C, ldc, strideC, batchCount);
+}
+
+template <>
+cublasStatus_t cublasGemmStridedBatchedWrap<half>(cublasHandle_t handle, cublasOperation_t transa,
+    cublasOperation_t transb, int32_t m, int32_t n, int32_t k, half const* alpha, half const* A, int32_t lda,
+    int64_t strideA, half const* B, int32_t ldb, int64_t strideB, half const* beta, half* C, int32_t ldc,
+    int64_t strideC, int32_t batchCount)
+{
+    return cublasHgemmStridedBatched(
+        handle, transa, transb, m, n, k, alpha, A, lda, strideA, B, ldb, strideB, beta, C, ldc, strideC, batchCount);
+}
@@ -26,6 +26,7 @@
 
 #ifndef TRT_MODULATED_DEFORM_CONV_CUDA_HELPER_H
 #define TRT_MODULATED_DEFORM_CONV_CUDA_HELPER_H
+#include <algorithm>
 #include <cstdint>
 #include <cublas_v2.h>
 
@@ -41,6 +42,26 @@ inline int64_t divUp(int64_t m, int32_t n)
     return (m + n - 1) / n;
 }
 
+// Maximum number of images whose deformable columns are built and multiplied together.
+constexpr int32_t kMAX_IM2COL_STEP{32};
+// Soft limit on the column buffer; a single image may still exceed it.
+constexpr int64_t kIM2COL_WORKSPACE_BUDGET{int64_t{256} << 20};
+
+//! Number of images processed per im2col + batched GEMM step, given the column buffer size of one image.
+inline int32_t getIm2colStep(int32_t batch, int64_t columnBytesPerImage)
+{
+    int64_t const budgetStep = kIM2COL_WORKSPACE_BUDGET / std::max(columnBytesPerImage, int64_t{1});
+    return static_cast<int32_t>(std::max<int64_t>(1, std::min<int64_t>({batch, kMAX_IM2COL_STEP, budgetStep})));
+}
+
+//! Column buffer size that covers getIm2colStep() for any batch and image size up to the given maxima.
+inline int64_t getIm2colWorkspaceSize(int32_t maxBatch, int64_t maxColumnBytesPerImage)
+{
+    int64_t const alignedBytes = divUp(maxColumnBytesPerImage, 16) * 16;
+    int64_t const stepBytes = std::min<int64_t>(maxBatch, kMAX_IM2COL_STEP) * alignedBytes;
+    return std::min(stepBytes, std::max(kIM2COL_WORKSPACE_BUDGET, alignedBytes));
+}
+
 template <class TScalar>
 void memcpyPermute(
     TScalar* dst, TScalar const* src, int32_t* src_size, int32_t* permute, int32_t src_dim, cudaStream_t stream = 0);
@@ -50,4 +71,10 @@ cublasStatus_t cublasGemmWrap(cublasHandle_t handle, cublasOperation_t transa, c
     int32_t n, int32_t k, TScalar const* alpha, TScalar const* A, int32_t lda, TScalar const* B, int32_t ldb,
     TScalar const* beta, TScalar* C, int32_t ldc);
 
+template <typename TScalar>
+cublasStatus_t cublasGemmStridedBatchedWrap(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_t transb,
+    int32_t m, int32_t n, int32_t k, TScalar const* alpha, TScalar const* A, int32_t lda, int64_t strideA,
+    TScalar const* B, int32_t ldb, int64_t strideB, TScalar const* beta, TScalar* C, int32_t ldc, int64_t strideC,
+    int32_t batchCount);
+
 #endif // TRT_MODULATED_DEFORM_CONV_CUDA_HELPER_H
@@ -147,15 +147,17 @@ size_t ModulatedDeformableConvPluginDynamic::getWorkspaceSize(nvinfer1::PluginTe
 {
     int32_t sizeofDtype = nvinfer1::plugin::bert::getElementSize(outputs[0].type);
 
+    int32_t batch = inputs[0].dims.d[0];
     int32_t nInputPlane = inputs[0].dims.d[1];
     int32_t outputHeight = outputs[0].dims.d[2];
     int32_t outputWidth = outputs[0].dims.d[3];
     int32_t kH = inputs[3].dims.d[2];
     int32_t kW = inputs[3].dims.d[3];
 
-    int64_t colSize = divUp(nInputPlane * kW * kH * outputHeight * outputWidth * sizeofDtype, 16) * 16;
+    // Columns of up to im2colStep images, so that they share one batched GEMM per group.
+    int64_t colSize = static_cast<int64_t>(nInputPlane) * kW * kH * outputHeight * outputWidth * sizeofDtype;
 
-    return colSize;
+    return getIm2colWorkspaceSize(batch, colSize);
 }
 
 int32_t ModulatedDeformableConvPluginDynamic::enqueue(nvinfer1::PluginTensorDesc const* inputDesc,
@@ -178,7 +180,7 @@ int32_t ModulatedDeformableConvPluginDynamic::enqueue(nvinfer1::PluginTensorDesc
         void const* weight = inputs[3];
         void const* bias = mWithBias ? inputs[4] : nullptr;
         void* output = outputs[0];
-        int32_t im2colStep = std::min(batch, 32);
+        int32_t im2colStep = std::min(batch, kMAX_IM2COL_STEP);
 
         auto data_type = inputDesc[0].type;
         switch (data_type)
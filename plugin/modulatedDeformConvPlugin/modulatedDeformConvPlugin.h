@@ -123,6 +123,13 @@ private:
     std::string mNamespace;
 };
 
+//! Host reference of the deformable im2col used by the plugin. Writes the columns of batch images in the
+//! [batch][channels * kernelH * kernelW][heightCol][widthCol] layout consumed by the batched GEMM.
+void modulatedDeformableIm2colHost(float const* dataIm, float const* dataOffset, float const* dataMask,
+    int32_t batchSize, int32_t channels, int32_t heightIm, int32_t widthIm, int32_t heightCol, int32_t widthCol,
+    int32_t kernelH, int32_t kernelW, int32_t padH, int32_t padW, int32_t strideH, int32_t strideW, int32_t dilationH,
+    int32_t dilationW, int32_t deformableGroup, float* dataCol);
+
 } // namespace plugin
 } // namespace nvinfer1
 
@@ -95,7 +95,10 @@ __global__ void modulatedDeformableIm2colGpuKernel(int32_t const n, T const* dat
         int32_t const hIn = hCol * strideH - padH;
         int32_t const wIn = wCol * strideW - padW;
 
-        T* dataColPtr = dataCol + ((cCol * batchSize + bCol) * heightCol + hCol) * widthCol + wCol;
+        // Columns are stored image-major, [batch][channel * kernelH * kernelW][heightCol][widthCol], so that each
+        // image forms its own GEMM operand.
+        T* dataColPtr
+            = dataCol + ((bCol * numChannels * kernelH * kernelW + cCol) * heightCol + hCol) * widthCol + wCol;
         T const* dataImPtr = dataIm + (bCol * numChannels + cIm) * height * width;
         T const* dataOffsetPtr = dataOffset
             + (bCol * deformableGroup + deformableGroupIndex) * 2 * kernelH * kernelW * heightCol * widthCol;
@@ -121,7 +124,7 @@ __global__ void modulatedDeformableIm2colGpuKernel(int32_t const n, T const* dat
                     val = dmcnIm2colBilinear(dataImPtr, width, height, width, hIm, wIm);
                 }
                 *dataColPtr = val * mask;
-                dataColPtr += batchSize * heightCol * widthCol;
+                dataColPtr += heightCol * widthCol;
             }
         }
     }
@@ -174,9 +177,6 @@ cudaError_t ModulatedDeformConvForwardCUDAKernelLauncher(TScalar const* input, T
 {
     bool withBias = (bias != nullptr);
 
-    im2colStep = std::min(int(batch), im2colStep);
-    assert(batch % im2colStep == 0);
-
     int32_t const heightOut = (height + 2 * padH - (dilationH * (kernelH - 1) + 1)) / strideH + 1;
     int32_t const widthOut = (width + 2 * padW - (dilationW * (kernelW - 1) + 1)) / strideW + 1;
 
@@ -187,23 +187,28 @@ cudaError_t ModulatedDeformConvForwardCUDAKernelLauncher(TScalar const* input, T
     int32_t const maskStep = deformableGroup * kernelH * kernelW * heightOut * widthOut;
     int32_t const outStep = channelsOut * heightOut * widthOut;
     int32_t const outGroupStep = outStep / group;
-    int32_t const colGStep = channels * kernelW * kernelH / group * heightOut * widthOut;
+    int32_t const colStep = channels * kernelW * kernelH * heightOut * widthOut;
+    int32_t const colGStep = colStep / group;
     int32_t const weightGStep = channelsOut / group * channels / group * kernelH * kernelW;
 
+    // The caller sizes the workspace with getIm2colWorkspaceSize(), which covers this step.
+    im2colStep = std::min(im2colStep, getIm2colStep(batch, static_cast<int64_t>(colStep) * sizeof(TScalar)));
+
     int32_t const m = channelsOut / group;
     int32_t const n = heightOut * widthOut;
     int32_t const k = channels / group * kernelH * kernelW;
     TScalar alpha = 1.;
     TScalar beta = 0.;
 
-    for (int32_t b = 0; b < batch; b++)
+    for (int32_t b = 0; b < batch; b += im2colStep)
     {
+        int32_t const step = std::min(im2colStep, batch - b);
         TScalar const* inputStart = input + b * inputStep;
         TScalar const* offsetStart = offset + b * offsetStep;
         TScalar const* maskStart = mask + b * maskStep;
-        trtModulatedDeformableIm2col<TScalar>(inputStart, offsetStart, maskStart, 1, channels, height, width, heightOut,
-            widthOut, kernelH, kernelW, padH, padW, strideH, strideW, dilationH, dilationW, deformableGroup, columns,
-            stream);
+        trtModulatedDeformableIm2col<TScalar>(inputStart, offsetStart, maskStart, step, channels, height, width,
+            heightOut, widthOut, kernelH, kernelW, padH, padW, strideH, strideW, dilationH, dilationW, deformableGroup,
+            columns, stream);
 
         for (int32_t g = 0; g < group; g++)
         {
@@ -211,8 +216,17 @@ cudaError_t ModulatedDeformConvForwardCUDAKernelLauncher(TScalar const* input, T
             TScalar* colStart = columns + g * colGStep;
             TScalar* outBufferStart = output + b * outStep + g * outGroupStep;
 
-            cublasGemmWrap<TScalar>(cublasHandle, CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, &alpha, colStart, n, weightStart,
-                k, &beta, outBufferStart, n);
+            if (step == 1)
+            {
+                cublasGemmWrap<TScalar>(cublasHandle, CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, &alpha, colStart, n,
+                    weightStart, k, &beta, outBufferStart, n);
+            }
+            else
+            {
+                // One GEMM for all images of the step: the weights are shared, columns and outputs advance by image.
+                cublasGemmStridedBatchedWrap<TScalar>(cublasHandle, CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, &alpha, colStart,
+                    n, colStep, weightStart, k, 0, &beta, outBufferStart, n, outStep, step);
+            }
 
             PLUGIN_CHECK_CUDA(cudaPeekAtLastError());
         }
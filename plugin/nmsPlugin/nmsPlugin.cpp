@@ -236,7 +236,8 @@ int DetectionOutput::enqueue(
     pluginStatus_t status = detectionInference(stream, batchSize, C1, C2, param.shareLocation,
         param.varianceEncodedInTarget, param.backgroundLabelId, numPriors, param.numClasses, param.topK, param.keepTopK,
         param.confidenceThreshold, param.nmsThreshold, param.codeType, mType, locData, priorData, mType, confData,
-        keepCount, topDetections, workspace, param.isNormalized, param.confSigmoid, mScoreBits, param.isBatchAgnostic);
+        keepCount, topDetections, workspace, mWorkspacePlanner, param.isNormalized, param.confSigmoid, mScoreBits,
+        param.isBatchAgnostic);
     return status;
 }
 
@@ -255,7 +256,8 @@ int32_t DetectionOutputDynamic::enqueue(PluginTensorDesc const* inputDesc, Plugi
     pluginStatus_t status = detectionInference(stream, inputDesc[0].dims.d[0], C1, C2, param.shareLocation,
         param.varianceEncodedInTarget, param.backgroundLabelId, numPriors, param.numClasses, param.topK, param.keepTopK,
         param.confidenceThreshold, param.nmsThreshold, param.codeType, mType, locData, priorData, mType, confData,
-        keepCount, topDetections, workspace, param.isNormalized, param.confSigmoid, mScoreBits, false);
+        keepCount, topDetections, workspace, mWorkspacePlanner, param.isNormalized, param.confSigmoid, mScoreBits,
+        false);
     return status;
 }
 
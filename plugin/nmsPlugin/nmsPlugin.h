@@ -93,6 +93,8 @@ private:
     DataType mType;
     int32_t mScoreBits;
     std::string mPluginNamespace;
+    //! Re-planned on every enqueue, reusing its storage.
+    WorkspacePlanner mWorkspacePlanner;
 };
 
 class DetectionOutputDynamic : public IPluginV2DynamicExt
@@ -138,6 +140,8 @@ private:
     DataType mType;
     int32_t mScoreBits;
     std::string mPluginNamespace;
+    //! Re-planned on every enqueue, reusing its storage.
+    WorkspacePlanner mWorkspacePlanner;
 };
 
 class NMSBasePluginCreator : public nvinfer1::pluginInternal::BaseCreator
@@ -111,6 +111,7 @@ void PriorBox::setupDeviceMemory() noexcept
     // mAspectRatiosGPU.count is different to mParam.numAspectRatios.
     //
     mAspectRatiosGPU = copyToDevice(&tmpAR[0], tmpAR.size());
+    mPriorAspectRatiosCPU = tmpAR;
 
     // Number of prior boxes per grid cell on the feature map
     // tmpAR already included an aspect ratio of 1.0
@@ -165,9 +166,69 @@ void PriorBox::deserialize(uint8_t const* data, size_t length)
     mH = read<int32_t>(d);
     mW = read<int32_t>(d);
 
+    setupDeviceMemory();
+
+    // Engines serialized before the priors were cached end here; generate their priors instead. Check the sizes
+    // against the remaining bytes before reading, as they come from the serialized data.
+    PLUGIN_VALIDATE(d <= data + length);
+    bool const hasPriors = d < data + length;
+    PLUGIN_VALIDATE(!hasPriors || static_cast<size_t>(data + length - d) >= sizeof(int32_t));
+    int32_t const nbPriorValues = hasPriors ? read<int32_t>(d) : 0;
+    PLUGIN_VALIDATE(nbPriorValues >= 0
+        && static_cast<size_t>(nbPriorValues) <= static_cast<size_t>(data + length - d) / sizeof(float));
+    if (nbPriorValues > 0)
+    {
+        std::vector<float> priors(nbPriorValues);
+        std::memcpy(priors.data(), d, nbPriorValues * sizeof(float));
+        d += nbPriorValues * sizeof(float);
+        mPriorCache = PriorCache::adopt(getPriorCacheKey(), std::move(priors));
+    }
+    else
+    {
+        acquirePriorCache();
+    }
+
     PLUGIN_VALIDATE(d == data + length);
+}
 
-    setupDeviceMemory();
+void PriorBox::acquirePriorCache()
+{
+    // The shape is unknown until getOutputDimensions() or configurePlugin().
+    if (mH <= 0 || mW <= 0)
+    {
+        mPriorCache.reset();
+        return;
+    }
+    mPriorCache
+        = PriorCache::acquire(getPriorCacheKey(), [this](std::vector<float>& priors) { generatePriors(priors); });
+}
+
+std::string PriorBox::getPriorCacheKey() const
+{
+    std::string key{"PriorBox"};
+    PriorCache::appendKey(key, mH);
+    PriorCache::appendKey(key, mW);
+    PriorCache::appendKey(key, mParam.clip);
+    PriorCache::appendKey(key, mParam.variance, 4);
+    PriorCache::appendKey(key, mParam.imgH);
+    PriorCache::appendKey(key, mParam.imgW);
+    PriorCache::appendKey(key, mParam.stepH);
+    PriorCache::appendKey(key, mParam.stepW);
+    PriorCache::appendKey(key, mParam.offset);
+    PriorCache::appendKey(key, mMinSizeCPU.data(), mMinSizeCPU.size());
+    PriorCache::appendKey(key, mMaxSizeCPU.data(), mMaxSizeCPU.size());
+    PriorCache::appendKey(key, mPriorAspectRatiosCPU.data(), mPriorAspectRatiosCPU.size());
+    return key;
+}
+
+void PriorBox::generatePriors(std::vector<float>& priors) const
+{
+    // 2 channels of H * W * numPriors boxes: the box coordinates, then the variances.
+    priors.resize(2 * mH * mW * mNumPriors * 4);
+    PLUGIN_VALIDATE(cpu::priorBoxInference(nullptr, mParam, mH, mW, mNumPriors,
+                        static_cast<int32_t>(mPriorAspectRatiosCPU.size()), mMinSizeCPU.data(), mMaxSizeCPU.data(),
+                        mPriorAspectRatiosCPU.data(), priors.data())
+        == STATUS_SUCCESS);
 }
 
 // Returns the number of output from the plugin layer
@@ -194,7 +255,24 @@ Dims PriorBox::getOutputDimensions(int32_t index, Dims const* inputs, int32_t nb
 
 int32_t PriorBox::initialize() noexcept
 {
-    return STATUS_SUCCESS;
+    try
+    {
+        if (!mPriorCache)
+        {
+            acquirePriorCache();
+        }
+        // Upload the priors now rather than on the first enqueue.
+        if (!mPriorCache || mPriorCache->getDevice() == nullptr)
+        {
+            return STATUS_FAILURE;
+        }
+        return STATUS_SUCCESS;
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+    }
+    return STATUS_FAILURE;
 }
 
 size_t PriorBox::getWorkspaceSize(int32_t /*maxBatchSize*/) const noexcept
@@ -205,19 +283,24 @@ size_t PriorBox::getWorkspaceSize(int32_t /*maxBatchSize*/) const noexcept
 int32_t PriorBox::enqueue(int32_t /*batchSize*/, void const* const* /*inputs*/, void* const* outputs,
     void* /*workspace*/, cudaStream_t stream) noexcept
 {
-    void* outputData = outputs[0];
-    pluginStatus_t status = priorBoxInference(stream, mParam, mH, mW, mNumPriors, mAspectRatiosGPU.count,
-        mMinSizeGPU.values, mMaxSizeGPU.values, mAspectRatiosGPU.values, outputData);
-
-    return status;
+    // The priors only depend on the parameters and the feature-map size, so copy the cached ones.
+    float const* priors = mPriorCache ? mPriorCache->getDevice() : nullptr;
+    if (priors == nullptr
+        || cudaMemcpyAsync(outputs[0], priors, mPriorCache->getSizeInBytes(), cudaMemcpyDeviceToDevice, stream)
+            != cudaSuccess)
+    {
+        return STATUS_FAILURE;
+    }
+    return STATUS_SUCCESS;
 }
 
 // Returns the size of serialized parameters
 size_t PriorBox::getSerializationSize() const noexcept
 {
     // PriorBoxParameters, minSize, maxSize, aspectRatios, mH, mW - the construct parameters
+    // followed by the number of precomputed prior values and the values
     return sizeof(PriorBoxParameters) + sizeof(float) * (mParam.numMinSize + mParam.numMaxSize + mParam.numAspectRatios)
-        + sizeof(int32_t) * 2;
+        + sizeof(int32_t) * 3 + (mPriorCache ? mPriorCache->getSizeInBytes() : 0);
 }
 
 void PriorBox::serialize(void* buffer) const noexcept
@@ -242,6 +325,14 @@ void PriorBox::serialize(void* buffer) const noexcept
     write(d, mH);
     write(d, mW);
 
+    int32_t const nbPriorValues = mPriorCache ? static_cast<int32_t>(mPriorCache->getHost().size()) : 0;
+    write(d, nbPriorValues);
+    if (nbPriorValues > 0)
+    {
+        std::memcpy(d, mPriorCache->getHost().data(), mPriorCache->getSizeInBytes());
+        d += mPriorCache->getSizeInBytes();
+    }
+
     PLUGIN_VALIDATE(d == a + getSerializationSize());
 }
 
@@ -280,6 +371,7 @@ IPluginV2Ext* PriorBox::clone() const noexcept
     try
     {
         PriorBox* obj = new PriorBox(mParam, mH, mW);
+        obj->mPriorCache = mPriorCache;
         obj->setPluginNamespace(mPluginNamespace.c_str());
         return obj;
     }
@@ -349,6 +441,7 @@ void PriorBox::configurePlugin(Dims const* inputDims, int32_t nbInputs, Dims con
         mParam.stepH = static_cast<float>(mParam.imgH) / mH;
         mParam.stepW = static_cast<float>(mParam.imgW) / mW;
     }
+    acquirePriorCache();
 }
 
 // Attach the plugin object to an execution context and grant the plugin the access to some context resource.
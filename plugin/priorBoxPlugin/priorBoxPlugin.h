@@ -18,9 +18,11 @@
 #define TRT_PRIOR_BOX_PLUGIN_H
 #include "common/kernels/kernel.h"
 #include "common/plugin.h"
+#include "common/priorCache.h"
 #include <cstdlib>
 #include <cublas_v2.h>
 #include <cudnn.h>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -90,6 +92,11 @@ private:
     void deserialize(uint8_t const* buffer, size_t length);
     void setupDeviceMemory() noexcept;
 
+    //! Looks up the priors of the current shape and parameters, generating them on the host if needed.
+    void acquirePriorCache();
+    std::string getPriorCacheKey() const;
+    void generatePriors(std::vector<float>& priors) const;
+
     PriorBoxParameters mParam{};
     int32_t mNumPriors{};
     int32_t mH{};
@@ -105,6 +112,11 @@ private:
     std::vector<float> mMinSizeCPU;
     std::vector<float> mMaxSizeCPU;
     std::vector<float> mAspectRatiosCPU;
+    // Aspect ratios after adding 1.0 and the flipped ratios, as uploaded to mAspectRatiosGPU.
+    std::vector<float> mPriorAspectRatiosCPU;
+
+    // Priors for (mH, mW), shared with clones and with identical layers of other engines.
+    std::shared_ptr<PriorCache> mPriorCache;
 
     std::string mPluginNamespace;
 };
@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! benchDetection.cpp
+//! Measures the throughput of detectionInference and nmsInference with the CPU detection backend, in candidate boxes
+//! per second, over the number of boxes per image. Usage: bench_detection [iterations]
+//!
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "common/kernels/kernel.h"
+#include "common/nmsUtils.h"
+#include "logger.h"
+#include "pluginTestUtils.h"
+
+using namespace nvinfer1::plugin;
+using nvinfer1::DataType;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.bench_detection";
+
+constexpr int32_t kBATCH{4};
+constexpr int32_t kNB_CLASSES{21};
+constexpr int32_t kTOP_K{400};
+constexpr int32_t kKEEP_TOP_K{200};
+
+void report(char const* pipeline, int32_t nbBoxes, double ms)
+{
+    sample::gLogInfo << pipeline << ", boxes " << nbBoxes << ": " << ms << " ms, " << kBATCH * nbBoxes / ms * 1e-3
+                     << " M boxes/s" << std::endl;
+}
+
+void benchDetectionInference(int32_t nbPriors, int32_t iterations)
+{
+    int32_t const C1 = nbPriors * 4;
+    int32_t const C2 = nbPriors * kNB_CLASSES;
+    std::vector<float> priors = pluginTest::makeBoxes(nbPriors, 1);
+    for (int32_t i = 0; i < nbPriors; ++i)
+    {
+        priors.insert(priors.end(), {0.1F, 0.1F, 0.2F, 0.2F});
+    }
+    auto const loc = pluginTest::uniformValues(kBATCH * C1, -1.F, 1.F, 3);
+    auto const conf = pluginTest::uniformValues(kBATCH * C2, 0.F, 1.F, 4);
+    std::vector<char> workspace(detectionInferenceWorkspaceSize(
+        true, kBATCH, C1, C2, kNB_CLASSES, nbPriors, kTOP_K, DataType::kFLOAT, DataType::kFLOAT));
+    std::vector<int32_t> keepCount(kBATCH);
+    std::vector<float> detections(kBATCH * kKEEP_TOP_K * 7);
+    WorkspacePlanner planner;
+
+    bool ok{true};
+    double const ms = samplesTest::meanMilliseconds(
+        [&]() {
+            ok &= detectionInference(nullptr, kBATCH, C1, C2, true, false, 0, nbPriors, kNB_CLASSES, kTOP_K,
+                      kKEEP_TOP_K, 0.01F, 0.45F, CodeTypeSSD::CENTER_SIZE, DataType::kFLOAT, loc.data(),
+                      priors.data(), DataType::kFLOAT, conf.data(), keepCount.data(), detections.data(),
+                      workspace.data(), planner)
+                == STATUS_SUCCESS;
+        },
+        iterations);
+    TEST_EXPECT(ok);
+    report("detectionInference", nbPriors, ms);
+}
+
+void benchNmsInference(int32_t nbBoxes, int32_t iterations)
+{
+    int32_t const boxesSize = nbBoxes * 4;
+    int32_t const scoresSize = nbBoxes * kNB_CLASSES;
+    auto const boxes = pluginTest::makeBoxes(kBATCH * nbBoxes, 5);
+    auto const scores = pluginTest::uniformValues(kBATCH * scoresSize, 0.F, 1.F, 6);
+    std::vector<char> workspace(detectionInferenceWorkspaceSize(
+        true, kBATCH, boxesSize, scoresSize, kNB_CLASSES, nbBoxes, kTOP_K, DataType::kFLOAT, DataType::kFLOAT));
+    size_t const nbOutputs = kBATCH * kKEEP_TOP_K;
+    std::vector<int32_t> numDetections(kBATCH);
+    std::vector<float> nmsedBoxes(nbOutputs * 4);
+    std::vector<float> nmsedScores(nbOutputs);
+    std::vector<float> nmsedClasses(nbOutputs);
+    WorkspacePlanner planner;
+
+    bool ok{true};
+    double const ms = samplesTest::meanMilliseconds(
+        [&]() {
+            ok &= nmsInference(nullptr, kBATCH, boxesSize, scoresSize, true, -1, nbBoxes, kNB_CLASSES, kTOP_K,
+                      kKEEP_TOP_K, 0.01F, 0.45F, DataType::kFLOAT, boxes.data(), DataType::kFLOAT, scores.data(),
+                      numDetections.data(), nmsedBoxes.data(), nmsedScores.data(), nmsedClasses.data(),
+                      workspace.data(), planner)
+                == STATUS_SUCCESS;
+        },
+        iterations);
+    TEST_EXPECT(ok);
+    report("nmsInference", nbBoxes, ms);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    int32_t const iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 10;
+    sample::gLogInfo << "Batch " << kBATCH << ", " << kNB_CLASSES << " classes, top " << kTOP_K << ", keep top "
+                     << kKEEP_TOP_K << ", " << iterations << " iterations" << std::endl;
+    setDetectionBackend(DetectionBackend::kCPU);
+    for (int32_t nbBoxes : {1000, 8732, 30000})
+    {
+        benchDetectionInference(nbBoxes, iterations);
+        benchNmsInference(nbBoxes, iterations);
+    }
+    setDetectionBackend(DetectionBackend::kCUDA);
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! benchEfficientNMS.cpp
+//! Measures the throughput of the host reference EfficientNMSHostInference, in anchors per second, over the number
+//! of anchors and of threads, for per class and class agnostic NMS. Usage: bench_efficient_nms [iterations]
+//!
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "efficientNMSPlugin/efficientNMSInference.h"
+#include "logger.h"
+#include "pluginTestUtils.h"
+
+using namespace nvinfer1::plugin;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.bench_efficient_nms";
+
+constexpr int32_t kBATCH{4};
+constexpr int32_t kNB_CLASSES{80};
+
+void benchmark(int32_t nbAnchors, bool classAgnostic, int32_t numThreads, int32_t iterations)
+{
+    EfficientNMSParameters param;
+    param.iouThreshold = 0.5F;
+    param.scoreThreshold = 0.25F;
+    param.numOutputBoxes = 100;
+    param.classAgnostic = classAgnostic;
+    param.batchSize = kBATCH;
+    param.numClasses = kNB_CLASSES;
+    param.numAnchors = nbAnchors;
+    param.numBoxElements = nbAnchors * 4;
+    param.numScoreElements = nbAnchors * kNB_CLASSES;
+
+    auto const boxes = pluginTest::makeBoxes(static_cast<size_t>(kBATCH) * nbAnchors, 1);
+    auto const scores = pluginTest::uniformValues(static_cast<size_t>(kBATCH) * nbAnchors * kNB_CLASSES, 0.F, 1.F, 3);
+    size_t const nbOutputs = static_cast<size_t>(kBATCH) * param.numOutputBoxes;
+    std::vector<int32_t> numDetections(kBATCH);
+    std::vector<float> nmsBoxes(nbOutputs * 4);
+    std::vector<float> nmsScores(nbOutputs);
+    std::vector<int32_t> nmsClasses(nbOutputs);
+
+    bool ok{true};
+    double const ms = samplesTest::meanMilliseconds(
+        [&]() {
+            ok &= EfficientNMSHostInference(param, boxes.data(), scores.data(), nullptr, numDetections.data(),
+                      nmsBoxes.data(), nmsScores.data(), nmsClasses.data(), nullptr, numThreads)
+                == STATUS_SUCCESS;
+        },
+        iterations);
+    TEST_EXPECT(ok);
+    sample::gLogInfo << "anchors " << nbAnchors << (classAgnostic ? ", class agnostic" : ", per class") << ", threads "
+                     << numThreads << ": " << ms << " ms, " << kBATCH * nbAnchors / ms * 1e-3 << " M anchors/s"
+                     << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    int32_t const iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 10;
+    std::vector<int32_t> threadCounts{1};
+    int32_t const maxThreads = static_cast<int32_t>(std::thread::hardware_concurrency());
+    if (maxThreads > 1)
+    {
+        threadCounts.push_back(maxThreads);
+    }
+    sample::gLogInfo << "Batch " << kBATCH << ", " << kNB_CLASSES << " classes, " << iterations << " iterations"
+                     << std::endl;
+    for (int32_t nbAnchors : {1000, 10000, 50000})
+    {
+        for (bool classAgnostic : {false, true})
+        {
+            for (int32_t numThreads : threadCounts)
+            {
+                benchmark(nbAnchors, classAgnostic, numThreads, iterations);
+            }
+        }
+    }
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
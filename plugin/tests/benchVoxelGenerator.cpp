@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! benchVoxelGenerator.cpp
+//! Measures VoxelGeneratorPlugin with dense and sparse voxelization, and the host reference generateVoxelsHost, on
+//! synthetic point clouds of increasing density over a PointPillars sized grid. Reports the time per frame and the
+//! workspace size. Usage: bench_voxel_generator [iterations]
+//!
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "logger.h"
+#include "pluginTestUtils.h"
+#include "voxelGeneratorPlugin/voxelGenerator.h"
+
+using namespace nvinfer1;
+using namespace nvinfer1::plugin;
+using pluginTest::DeviceBuffer;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.bench_voxel_generator";
+
+constexpr int32_t kBATCH{1};
+constexpr int32_t kMAX_PILLARS{12000};
+constexpr int32_t kMAX_POINTS_PER_PILLAR{32};
+constexpr int32_t kPOINT_FEATURE_NUM{4};
+constexpr int32_t kFEATURE_NUM{kPOINT_FEATURE_NUM + 6};
+// A 432 x 496 x 1 grid over [0, 69.12) x [-39.68, 39.68) x [-3, 1).
+constexpr float kRANGE[6]{0.F, -39.68F, -3.F, 69.12F, 39.68F, 1.F};
+constexpr float kPILLAR_SIZE[3]{0.16F, 0.16F, 4.F};
+constexpr int32_t kGRID_X{432};
+constexpr int32_t kGRID_Y{496};
+
+//! nbPoints random points per frame, uniform over the range.
+std::vector<float> makePoints(int32_t nbPoints)
+{
+    size_t const count = static_cast<size_t>(kBATCH) * nbPoints;
+    auto const x = pluginTest::uniformValues(count, kRANGE[0], kRANGE[3], 1);
+    auto const y = pluginTest::uniformValues(count, kRANGE[1], kRANGE[4], 2);
+    auto const z = pluginTest::uniformValues(count, kRANGE[2], kRANGE[5], 3);
+    auto const intensity = pluginTest::uniformValues(count, 0.F, 1.F, 4);
+    std::vector<float> points;
+    points.reserve(count * kPOINT_FEATURE_NUM);
+    for (size_t i = 0; i < count; ++i)
+    {
+        points.insert(points.end(), {x[i], y[i], z[i], intensity[i]});
+    }
+    return points;
+}
+
+void benchmarkPlugin(bool sparse, int32_t nbPoints, std::vector<float> const& points, int32_t iterations)
+{
+    VoxelGeneratorPlugin plugin(kMAX_PILLARS, kMAX_POINTS_PER_PILLAR, kFEATURE_NUM, kRANGE[0], kRANGE[3], kRANGE[1],
+        kRANGE[4], kRANGE[2], kRANGE[5], kPILLAR_SIZE[0], kPILLAR_SIZE[1], kPILLAR_SIZE[2], sparse);
+
+    DynamicPluginTensorDesc in[2]{};
+    DynamicPluginTensorDesc outputs[3]{};
+    in[0].desc.dims = Dims3{kBATCH, nbPoints, kPOINT_FEATURE_NUM};
+    in[0].desc.type = DataType::kFLOAT;
+    in[1].desc.dims = Dims{1, {kBATCH}};
+    in[1].desc.type = DataType::kINT32;
+    plugin.configurePlugin(in, 2, outputs, 3);
+    PluginTensorDesc const inputDesc[2]{in[0].desc, in[1].desc};
+    PluginTensorDesc outputDesc[3]{};
+
+    size_t const workspaceSize = plugin.getWorkspaceSize(inputDesc, 2, outputDesc, 3);
+    auto pointsInput = pluginTest::toDevice(points);
+    auto pointsSizeInput = pluginTest::toDevice(std::vector<uint32_t>(kBATCH, nbPoints));
+    DeviceBuffer features(static_cast<size_t>(kBATCH) * kMAX_PILLARS * kMAX_POINTS_PER_PILLAR * kFEATURE_NUM
+        * sizeof(float));
+    DeviceBuffer coords(static_cast<size_t>(kBATCH) * kMAX_PILLARS * 4 * sizeof(uint32_t));
+    DeviceBuffer params(kBATCH * sizeof(uint32_t));
+    DeviceBuffer workspace(workspaceSize);
+    if (!TEST_EXPECT(pointsInput.get() && pointsSizeInput.get() && features.get() && coords.get() && params.get()
+            && workspace.get()))
+    {
+        return;
+    }
+
+    void const* inputs[2]{pointsInput.get(), pointsSizeInput.get()};
+    void* outputBuffers[3]{features.get(), coords.get(), params.get()};
+    bool ok{true};
+    double const ms = samplesTest::meanMilliseconds(
+        [&]() {
+            ok &= plugin.enqueue(inputDesc, outputDesc, inputs, outputBuffers, workspace.get(), nullptr) == 0;
+            ok &= cudaDeviceSynchronize() == cudaSuccess;
+        },
+        iterations);
+    TEST_EXPECT(ok);
+    sample::gLogInfo << "points " << nbPoints << (sparse ? ", sparse" : ", dense") << ": " << ms << " ms, workspace "
+                     << workspaceSize / (1 << 20) << " MiB" << std::endl;
+}
+
+void benchmarkHost(int32_t nbPoints, std::vector<float> const& points, int32_t iterations)
+{
+    std::vector<uint32_t> const pointsSize(kBATCH, nbPoints);
+    std::vector<float> features(static_cast<size_t>(kBATCH) * kMAX_PILLARS * kMAX_POINTS_PER_PILLAR * kFEATURE_NUM);
+    std::vector<uint32_t> coords(static_cast<size_t>(kBATCH) * kMAX_PILLARS * 4);
+    std::vector<uint32_t> params(kBATCH);
+
+    bool ok{true};
+    double const ms = samplesTest::meanMilliseconds(
+        [&]() {
+            ok &= generateVoxelsHost(kBATCH, nbPoints, points.data(), pointsSize.data(), kRANGE[0], kRANGE[3],
+                      kRANGE[1], kRANGE[4], kRANGE[2], kRANGE[5], kPILLAR_SIZE[0], kPILLAR_SIZE[1], kPILLAR_SIZE[2],
+                      kGRID_X, kGRID_Y, kPOINT_FEATURE_NUM, kMAX_PILLARS, kMAX_POINTS_PER_PILLAR, kFEATURE_NUM,
+                      features.data(), coords.data(), params.data())
+                == 0;
+        },
+        iterations);
+    TEST_EXPECT(ok);
+    sample::gLogInfo << "points " << nbPoints << ", host reference: " << ms << " ms, " << params[0] << " pillars"
+                     << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    int32_t const iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 10;
+    sample::gLogInfo << "Grid " << kGRID_X << " x " << kGRID_Y << ", " << kMAX_PILLARS << " pillars, " << iterations
+                     << " iterations" << std::endl;
+    // From a sparse scan to more points than the grid has pillars, where the plugin falls back to the dense grid.
+    for (int32_t nbPoints : {2000, 20000, 120000, 250000})
+    {
+        auto const points = makePoints(nbPoints);
+        for (bool sparse : {false, true})
+        {
+            benchmarkPlugin(sparse, nbPoints, points, iterations);
+        }
+        benchmarkHost(nbPoints, points, iterations);
+    }
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,522 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TRT_PLUGIN_GOLDEN_IO_H
+#define TRT_PLUGIN_GOLDEN_IO_H
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//!
+//! \file goldenIO.h
+//! \brief Reader for the golden input and output files of the plugins, such as
+//!        efficientNMSPlugin/EfficientNMSPlugin_PluginGoldenIO.json, so that tests can check a host implementation
+//!        against them without a GPU.
+//!
+//! A golden file maps the name of each configuration to a list of cases. Each case has "inputs", "outputs" and
+//! "attributes" objects, whose arrays are stored like polygraphy stores them: as an object with a "polygraphy_class"
+//! of "ndarray" and an "array" string holding a base64 encoded .npy file. The reader throws std::runtime_error on
+//! anything it cannot parse.
+//!
+
+namespace pluginTest
+{
+
+//! A parsed JSON value. Numbers are kept as doubles, which is exact for the integers of the golden files.
+class JsonValue
+{
+public:
+    enum class Type
+    {
+        kNULL,
+        kBOOL,
+        kNUMBER,
+        kSTRING,
+        kARRAY,
+        kOBJECT
+    };
+
+    Type type{Type::kNULL};
+    bool boolean{false};
+    double number{0.0};
+    std::string string;
+    std::vector<JsonValue> array;
+    std::map<std::string, JsonValue> object;
+
+    //! The member of an object. Throws if the value is not an object or has no such member.
+    JsonValue const& operator[](std::string const& key) const
+    {
+        auto const it = object.find(key);
+        if (type != Type::kOBJECT || it == object.end())
+        {
+            throw std::runtime_error("Golden IO: missing member \"" + key + "\"");
+        }
+        return it->second;
+    }
+
+    //! The element of an array. Throws if the value is not an array or the index is out of range.
+    JsonValue const& operator[](size_t index) const
+    {
+        if (type != Type::kARRAY || index >= array.size())
+        {
+            throw std::runtime_error("Golden IO: missing array element " + std::to_string(index));
+        }
+        return array[index];
+    }
+
+    bool has(std::string const& key) const
+    {
+        return type == Type::kOBJECT && object.count(key) != 0;
+    }
+
+    int32_t asInt() const
+    {
+        if (type == Type::kBOOL)
+        {
+            return boolean ? 1 : 0;
+        }
+        if (type != Type::kNUMBER)
+        {
+            throw std::runtime_error("Golden IO: expected a number");
+        }
+        return static_cast<int32_t>(number);
+    }
+};
+
+namespace detail
+{
+
+//! Recursive descent parser for the JSON subset written by polygraphy: no escapes other than the simple ones, and no
+//! \u escapes outside of the ASCII range.
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string const& text)
+        : mText(text)
+    {
+    }
+
+    JsonValue parse()
+    {
+        JsonValue value = parseValue();
+        skipSpace();
+        if (mPos != mText.size())
+        {
+            fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(char const* what) const
+    {
+        throw std::runtime_error(std::string("Golden IO: ") + what + " at offset " + std::to_string(mPos));
+    }
+
+    void skipSpace()
+    {
+        while (mPos < mText.size() && std::isspace(static_cast<unsigned char>(mText[mPos])))
+        {
+            ++mPos;
+        }
+    }
+
+    bool consume(char const* token)
+    {
+        size_t const length = std::strlen(token);
+        if (mText.compare(mPos, length, token) != 0)
+        {
+            return false;
+        }
+        mPos += length;
+        return true;
+    }
+
+    //! Skip a comma between the elements of an array or the members of an object, if there is one.
+    bool consumeSeparator()
+    {
+        skipSpace();
+        return consume(",");
+    }
+
+    void expect(char c)
+    {
+        skipSpace();
+        if (mPos >= mText.size() || mText[mPos] != c)
+        {
+            fail("unexpected character");
+        }
+        ++mPos;
+    }
+
+    JsonValue parseValue()
+    {
+        skipSpace();
+        if (mPos >= mText.size())
+        {
+            fail("unexpected end of input");
+        }
+        JsonValue value;
+        char const c = mText[mPos];
+        if (c == '{')
+        {
+            value.type = JsonValue::Type::kOBJECT;
+            ++mPos;
+            skipSpace();
+            if (mPos < mText.size() && mText[mPos] == '}')
+            {
+                ++mPos;
+                return value;
+            }
+            do
+            {
+                skipSpace();
+                std::string key = parseString();
+                expect(':');
+                value.object[key] = parseValue();
+            } while (consumeSeparator());
+            expect('}');
+        }
+        else if (c == '[')
+        {
+            value.type = JsonValue::Type::kARRAY;
+            ++mPos;
+            skipSpace();
+            if (mPos < mText.size() && mText[mPos] == ']')
+            {
+                ++mPos;
+                return value;
+            }
+            do
+            {
+                value.array.push_back(parseValue());
+            } while (consumeSeparator());
+            expect(']');
+        }
+        else if (c == '"')
+        {
+            value.type = JsonValue::Type::kSTRING;
+            value.string = parseString();
+        }
+        else if (consume("true"))
+        {
+            value.type = JsonValue::Type::kBOOL;
+            value.boolean = true;
+        }
+        else if (consume("false"))
+        {
+            value.type = JsonValue::Type::kBOOL;
+        }
+        else if (consume("null"))
+        {
+            value.type = JsonValue::Type::kNULL;
+        }
+        else
+        {
+            char const* begin = mText.c_str() + mPos;
+            char* end = nullptr;
+            value.type = JsonValue::Type::kNUMBER;
+            value.number = std::strtod(begin, &end);
+            if (end == begin)
+            {
+                fail("invalid value");
+            }
+            mPos += end - begin;
+        }
+        return value;
+    }
+
+    std::string parseString()
+    {
+        if (mPos >= mText.size() || mText[mPos] != '"')
+        {
+            fail("expected a string");
+        }
+        ++mPos;
+        std::string result;
+        while (mPos < mText.size() && mText[mPos] != '"')
+        {
+            char c = mText[mPos++];
+            if (c == '\\')
+            {
+                if (mPos >= mText.size())
+                {
+                    fail("unterminated escape");
+                }
+                char const escaped = mText[mPos++];
+                switch (escaped)
+                {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'u':
+                {
+                    if (mPos + 4 > mText.size())
+                    {
+                        fail("truncated \\u escape");
+                    }
+                    long const code = std::strtol(mText.substr(mPos, 4).c_str(), nullptr, 16);
+                    if (code > 0x7F)
+                    {
+                        fail("non-ASCII \\u escape");
+                    }
+                    c = static_cast<char>(code);
+                    mPos += 4;
+                    break;
+                }
+                default: c = escaped; break;
+                }
+            }
+            result.push_back(c);
+        }
+        if (mPos >= mText.size())
+        {
+            fail("unterminated string");
+        }
+        ++mPos;
+        return result;
+    }
+
+    std::string const& mText;
+    size_t mPos{0};
+};
+
+inline std::vector<uint8_t> decodeBase64(std::string const& text)
+{
+    auto const sextet = [](char c) -> int32_t {
+        if (c >= 'A' && c <= 'Z')
+        {
+            return c - 'A';
+        }
+        if (c >= 'a' && c <= 'z')
+        {
+            return c - 'a' + 26;
+        }
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0' + 52;
+        }
+        if (c == '+')
+        {
+            return 62;
+        }
+        if (c == '/')
+        {
+            return 63;
+        }
+        return -1;
+    };
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(text.size() / 4 * 3);
+    uint32_t buffer{0};
+    int32_t bits{0};
+    for (char const c : text)
+    {
+        if (c == '=')
+        {
+            break;
+        }
+        int32_t const value = sextet(c);
+        if (value < 0)
+        {
+            throw std::runtime_error("Golden IO: invalid base64 character");
+        }
+        buffer = (buffer << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            bytes.push_back(static_cast<uint8_t>((buffer >> bits) & 0xFF));
+        }
+    }
+    return bytes;
+}
+
+//! The text following key in an .npy header, such as "'<f4', 'fortran_order': ..." for "descr".
+inline std::string npyHeaderField(std::string const& header, std::string const& key)
+{
+    size_t const pos = header.find("'" + key + "'");
+    size_t const colon = pos == std::string::npos ? pos : header.find(':', pos);
+    if (colon == std::string::npos)
+    {
+        throw std::runtime_error("Golden IO: .npy header has no " + key);
+    }
+    return header.substr(header.find_first_not_of(' ', colon + 1));
+}
+
+} // namespace detail
+
+//! A dense array decoded from a .npy payload, with its data in C (row major) order.
+struct NpyArray
+{
+    //! The numpy type string, such as "<f4" or "<i4".
+    std::string descr;
+    std::vector<int64_t> shape;
+    std::vector<uint8_t> data;
+
+    size_t count() const
+    {
+        size_t n{1};
+        for (int64_t const d : shape)
+        {
+            n *= static_cast<size_t>(d);
+        }
+        return n;
+    }
+
+    //! The elements converted to T. Only little endian 4 byte floats and integers are supported.
+    template <typename T>
+    std::vector<T> values() const
+    {
+        std::vector<T> result(count());
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            if (descr == "<f4")
+            {
+                float value;
+                std::memcpy(&value, &data[i * 4], sizeof(value));
+                result[i] = static_cast<T>(value);
+            }
+            else if (descr == "<i4")
+            {
+                int32_t value;
+                std::memcpy(&value, &data[i * 4], sizeof(value));
+                result[i] = static_cast<T>(value);
+            }
+            else
+            {
+                throw std::runtime_error("Golden IO: unsupported dtype " + descr);
+            }
+        }
+        return result;
+    }
+};
+
+//! Decode a version 1 or 2 .npy file. Fortran ordered arrays are transposed to C order.
+inline NpyArray parseNpy(std::vector<uint8_t> const& bytes)
+{
+    static char const kMAGIC[] = "\x93NUMPY";
+    if (bytes.size() < 10 || std::memcmp(bytes.data(), kMAGIC, 6) != 0)
+    {
+        throw std::runtime_error("Golden IO: not an .npy payload");
+    }
+    uint8_t const major = bytes[6];
+    size_t const lengthBytes = major == 1 ? 2 : 4;
+    size_t headerLength{0};
+    for (size_t i = 0; i < lengthBytes; ++i)
+    {
+        headerLength |= static_cast<size_t>(bytes[8 + i]) << (8 * i);
+    }
+    size_t const dataOffset = 8 + lengthBytes + headerLength;
+    if (dataOffset > bytes.size())
+    {
+        throw std::runtime_error("Golden IO: truncated .npy header");
+    }
+    std::string const header(bytes.begin() + 8 + lengthBytes, bytes.begin() + dataOffset);
+
+    NpyArray array;
+    std::string const descr = detail::npyHeaderField(header, "descr");
+    size_t const quote = descr.find('\'');
+    array.descr = descr.substr(quote + 1, descr.find('\'', quote + 1) - quote - 1);
+    if (array.descr != "<f4" && array.descr != "<i4")
+    {
+        throw std::runtime_error("Golden IO: unsupported dtype " + array.descr);
+    }
+    bool const fortranOrder = detail::npyHeaderField(header, "fortran_order").compare(0, 4, "True") == 0;
+    std::string const shape = detail::npyHeaderField(header, "shape");
+    std::istringstream dims(shape.substr(shape.find('(') + 1, shape.find(')') - shape.find('(') - 1));
+    std::string dim;
+    while (std::getline(dims, dim, ','))
+    {
+        if (dim.find_first_of("0123456789") != std::string::npos)
+        {
+            array.shape.push_back(std::stoll(dim));
+        }
+    }
+
+    size_t constexpr kELEMENT_SIZE{4};
+    size_t const count = array.count();
+    if (dataOffset + count * kELEMENT_SIZE > bytes.size())
+    {
+        throw std::runtime_error("Golden IO: truncated .npy data");
+    }
+    array.data.assign(bytes.begin() + dataOffset, bytes.begin() + dataOffset + count * kELEMENT_SIZE);
+    if (fortranOrder && array.shape.size() > 1)
+    {
+        // Element i in C order has the same coordinates as element j in Fortran order, where the strides are reversed.
+        std::vector<uint8_t> ordered(array.data.size());
+        size_t const rank = array.shape.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t rest = i;
+            size_t j{0};
+            size_t stride{1};
+            std::vector<size_t> coordinates(rank);
+            for (size_t d = rank; d-- > 0;)
+            {
+                coordinates[d] = rest % array.shape[d];
+                rest /= array.shape[d];
+            }
+            for (size_t d = 0; d < rank; ++d)
+            {
+                j += coordinates[d] * stride;
+                stride *= array.shape[d];
+            }
+            std::memcpy(&ordered[i * kELEMENT_SIZE], &array.data[j * kELEMENT_SIZE], kELEMENT_SIZE);
+        }
+        array.data.swap(ordered);
+    }
+    return array;
+}
+
+//! Parse a golden file.
+inline JsonValue readGoldenIO(std::string const& path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw std::runtime_error("Golden IO: cannot open " + path);
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return detail::JsonParser(text.str()).parse();
+}
+
+//! Decode an array of a golden case, such as case["inputs"]["boxes"].
+inline NpyArray goldenArray(JsonValue const& value)
+{
+    if (!value.has("polygraphy_class") || value["polygraphy_class"].string != "ndarray")
+    {
+        throw std::runtime_error("Golden IO: not an ndarray");
+    }
+    return parseNpy(detail::decodeBase64(value["array"].string));
+}
+
+} // namespace pluginTest
+
+#endif // TRT_PLUGIN_GOLDEN_IO_H
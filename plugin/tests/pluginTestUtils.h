@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TRT_PLUGIN_TEST_UTILS_H
+#define TRT_PLUGIN_TEST_UTILS_H
+
+#include <cuda_runtime_api.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "testUtils.h"
+
+//!
+//! \file pluginTestUtils.h
+//! \brief Device buffers and fixed inputs for the plugin tests, which compare a CUDA implementation with its host
+//!        reference.
+//!
+
+namespace pluginTest
+{
+
+//! Log a failed CUDA call as a failed check and return whether the call succeeded.
+#define TEST_EXPECT_CUDA(call) TEST_EXPECT((call) == cudaSuccess)
+
+//! A device allocation that is freed on destruction.
+class DeviceBuffer
+{
+public:
+    explicit DeviceBuffer(size_t size)
+        : mSize(size)
+    {
+        if (size > 0 && cudaMalloc(&mData, size) != cudaSuccess)
+        {
+            mData = nullptr;
+        }
+    }
+
+    DeviceBuffer(DeviceBuffer const&) = delete;
+    DeviceBuffer& operator=(DeviceBuffer const&) = delete;
+
+    DeviceBuffer(DeviceBuffer&& other) noexcept
+        : mData(other.mData)
+        , mSize(other.mSize)
+    {
+        other.mData = nullptr;
+        other.mSize = 0;
+    }
+
+    ~DeviceBuffer()
+    {
+        cudaFree(mData);
+    }
+
+    void* get() const
+    {
+        return mData;
+    }
+
+    size_t size() const
+    {
+        return mSize;
+    }
+
+private:
+    void* mData{nullptr};
+    size_t mSize{0};
+};
+
+//! Copy a host vector to a new device buffer.
+template <typename T>
+DeviceBuffer toDevice(std::vector<T> const& host)
+{
+    DeviceBuffer device(host.size() * sizeof(T));
+    if (device.get() != nullptr)
+    {
+        TEST_EXPECT_CUDA(cudaMemcpy(device.get(), host.data(), device.size(), cudaMemcpyHostToDevice));
+    }
+    return device;
+}
+
+//! Copy count elements of a device buffer back to the host.
+template <typename T>
+std::vector<T> toHost(DeviceBuffer const& device, size_t count)
+{
+    std::vector<T> host(count);
+    TEST_EXPECT(count * sizeof(T) <= device.size());
+    TEST_EXPECT_CUDA(cudaMemcpy(host.data(), device.get(), count * sizeof(T), cudaMemcpyDeviceToHost));
+    return host;
+}
+
+//! Values drawn uniformly from [low, high), with a fixed seed so that every run sees the same input.
+inline std::vector<float> uniformValues(size_t count, float low, float high, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(low, high);
+    std::vector<float> values(count);
+    for (auto& value : values)
+    {
+        value = distribution(generator);
+    }
+    return values;
+}
+
+//! Distinct values spread evenly over [low, high) in a fixed random order, for scores whose sort order must not depend
+//! on how ties are broken.
+inline std::vector<float> distinctValues(size_t count, float low, float high, uint32_t seed)
+{
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[i] = low + (high - low) * static_cast<float>(i) / static_cast<float>(count);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(seed));
+    return values;
+}
+
+//! Boxes of random size around random centers, so that many of them overlap. The box coding is the one of the
+//! EfficientNMS box_coding attribute: 0 for corners (y1, x1, y2, x2) and 1 for center and size (cx, cy, w, h).
+inline std::vector<float> makeBoxes(size_t count, uint32_t seed, int32_t boxCoding = 0)
+{
+    auto const centers = uniformValues(count * 2, 0.1F, 0.9F, seed);
+    auto const sizes = uniformValues(count * 2, 0.05F, 0.3F, seed + 1);
+    std::vector<float> boxes(count * 4);
+    for (size_t i = 0; i < count; ++i)
+    {
+        float const cy = centers[2 * i];
+        float const cx = centers[2 * i + 1];
+        float const h = sizes[2 * i];
+        float const w = sizes[2 * i + 1];
+        float* box = &boxes[4 * i];
+        if (boxCoding == 0)
+        {
+            box[0] = cy - h / 2;
+            box[1] = cx - w / 2;
+            box[2] = cy + h / 2;
+            box[3] = cx + w / 2;
+        }
+        else
+        {
+            box[0] = cx;
+            box[1] = cy;
+            box[2] = w;
+            box[3] = h;
+        }
+    }
+    return boxes;
+}
+
+} // namespace pluginTest
+
+#endif // TRT_PLUGIN_TEST_UTILS_H
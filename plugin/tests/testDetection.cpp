@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testDetection.cpp
+//! Runs the SSD detection and batched NMS pipelines, detectionInference and nmsInference, with the CUDA and the CPU
+//! detection backends on the same fixed input, and checks that the outputs match.
+//!
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "common/kernels/kernel.h"
+#include "common/nmsUtils.h"
+#include "logger.h"
+#include "pluginTestUtils.h"
+
+using namespace nvinfer1::plugin;
+using nvinfer1::DataType;
+using pluginTest::DeviceBuffer;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_detection";
+
+constexpr int32_t kBATCH{2};
+constexpr int32_t kNB_PRIORS{300};
+constexpr int32_t kNB_CLASSES{5};
+constexpr int32_t kTOP_K{100};
+constexpr int32_t kKEEP_TOP_K{50};
+
+//! Restores the CUDA backend when a test case ends.
+struct BackendGuard
+{
+    explicit BackendGuard(DetectionBackend backend)
+    {
+        setDetectionBackend(backend);
+    }
+    ~BackendGuard()
+    {
+        setDetectionBackend(DetectionBackend::kCUDA);
+    }
+};
+
+//! Runs one pipeline on the host with the CPU backend and on the device with the CUDA backend. Each pipeline gets the
+//! inputs and the outputs as pointers, in the memory of its backend, and the outputs are returned in order.
+template <typename Pipeline>
+void compareBackends(std::vector<std::vector<float>> const& inputs, std::vector<size_t> const& outputSizes,
+    size_t workspaceSize, Pipeline const& pipeline)
+{
+    std::vector<std::vector<float>> host;
+    {
+        BackendGuard guard(DetectionBackend::kCPU);
+        std::vector<void const*> in;
+        for (auto const& input : inputs)
+        {
+            in.push_back(input.data());
+        }
+        std::vector<void*> out;
+        host.reserve(outputSizes.size());
+        for (size_t size : outputSizes)
+        {
+            host.emplace_back(size, -2.F);
+            out.push_back(host.back().data());
+        }
+        std::vector<char> workspace(workspaceSize);
+        if (!TEST_EXPECT(pipeline(in, out, workspace.data()) == STATUS_SUCCESS))
+        {
+            return;
+        }
+    }
+
+    std::vector<DeviceBuffer> deviceInputs;
+    std::vector<void const*> in;
+    for (auto const& input : inputs)
+    {
+        deviceInputs.push_back(pluginTest::toDevice(input));
+        in.push_back(deviceInputs.back().get());
+    }
+    std::vector<DeviceBuffer> deviceOutputs;
+    std::vector<void*> out;
+    for (size_t size : outputSizes)
+    {
+        deviceOutputs.emplace_back(size * sizeof(float));
+        out.push_back(deviceOutputs.back().get());
+    }
+    DeviceBuffer workspace(workspaceSize);
+    bool allocated = workspace.get() != nullptr;
+    for (auto const& buffer : deviceInputs)
+    {
+        allocated = allocated && buffer.get() != nullptr;
+    }
+    for (auto const& buffer : deviceOutputs)
+    {
+        allocated = allocated && buffer.get() != nullptr;
+    }
+    if (!TEST_EXPECT(allocated))
+    {
+        return;
+    }
+    if (!TEST_EXPECT(pipeline(in, out, workspace.get()) == STATUS_SUCCESS)
+        || !TEST_EXPECT_CUDA(cudaDeviceSynchronize()))
+    {
+        return;
+    }
+
+    // The first output is the number of detections per image, and the others are padded to keepTopK per image.
+    auto const counts = pluginTest::toHost<int32_t>(deviceOutputs[0], kBATCH);
+    auto const* hostCounts = reinterpret_cast<int32_t const*>(host[0].data());
+    TEST_EXPECT(std::equal(counts.begin(), counts.end(), hostCounts));
+    TEST_EXPECT(hostCounts[0] > 0 && hostCounts[1] > 0);
+    for (size_t i = 1; i < outputSizes.size(); ++i)
+    {
+        auto const device = pluginTest::toHost<float>(deviceOutputs[i], outputSizes[i]);
+        TEST_EXPECT_NEAR(host[i].data(), device.data(), outputSizes[i], 1e-5);
+    }
+}
+
+//! Checks that the decoded boxes die after kPERMUTE when they are permuted, so that the sort workspace reuses their
+//! slot, and that they live until the end when they are used as they are.
+void expectBBoxSlotReuse(bool shareLocation, int32_t C1, int32_t C2)
+{
+    std::vector<char> workspace(detectionInferenceWorkspaceSize(
+        shareLocation, kBATCH, C1, C2, kNB_CLASSES, kNB_PRIORS, kTOP_K, DataType::kFLOAT, DataType::kFLOAT));
+    WorkspacePlanner planner;
+    DetectionWorkspace buffers;
+    detectionInferenceWorkspaceLayout(shareLocation, kBATCH, C1, C2, kNB_CLASSES, kNB_PRIORS, kTOP_K, DataType::kFLOAT,
+        DataType::kFLOAT, workspace.data(), planner, &buffers);
+    TEST_EXPECT((buffers.sortPerClassWorkspace == buffers.bboxDataRaw) == !shareLocation);
+    TEST_EXPECT(buffers.bboxPermute != buffers.bboxDataRaw);
+}
+
+//! SSD post-processing: decodes center-size boxes against the priors, then runs per-class NMS and keeps the top
+//! detections as [image, class, score, xmin, ymin, xmax, ymax]. Without shareLocation, each class has its own boxes,
+//! which are permuted after decoding.
+void testDetectionInference(bool shareLocation)
+{
+    sample::gLogInfo << "detectionInference" << (shareLocation ? "" : ", per class locations") << std::endl;
+    int32_t const nbLocClasses = shareLocation ? 1 : kNB_CLASSES;
+    int32_t const C1 = kNB_PRIORS * nbLocClasses * 4;
+    int32_t const C2 = kNB_PRIORS * kNB_CLASSES;
+    // Priors followed by their variances, shared by the batch.
+    std::vector<float> priors = pluginTest::makeBoxes(kNB_PRIORS, 1);
+    for (int32_t i = 0; i < kNB_PRIORS; ++i)
+    {
+        priors.insert(priors.end(), {0.1F, 0.1F, 0.2F, 0.2F});
+    }
+    auto const loc = pluginTest::uniformValues(kBATCH * C1, -1.F, 1.F, 3);
+    auto const conf = pluginTest::distinctValues(kBATCH * C2, 0.F, 1.F, 4);
+    size_t const workspaceSize = detectionInferenceWorkspaceSize(
+        shareLocation, kBATCH, C1, C2, kNB_CLASSES, kNB_PRIORS, kTOP_K, DataType::kFLOAT, DataType::kFLOAT);
+    // Shared by both backends, as a plugin reuses its planner across enqueues.
+    WorkspacePlanner planner;
+
+    compareBackends({loc, priors, conf}, {kBATCH, kBATCH * kKEEP_TOP_K * 7}, workspaceSize,
+        [&](std::vector<void const*> const& in, std::vector<void*> const& out, void* workspace) {
+            return detectionInference(nullptr, kBATCH, C1, C2, shareLocation, false, 0, kNB_PRIORS, kNB_CLASSES,
+                kTOP_K, kKEEP_TOP_K, 0.2F, 0.45F, CodeTypeSSD::CENTER_SIZE, DataType::kFLOAT, in[0], in[1],
+                DataType::kFLOAT, in[2], out[0], out[1], workspace, planner);
+        });
+    expectBBoxSlotReuse(shareLocation, C1, C2);
+}
+
+//! Batched NMS: per-class NMS on corner coded boxes, shared by the classes or one per class, with separate box, score
+//! and class outputs.
+void testNmsInference(bool shareLocation)
+{
+    sample::gLogInfo << "nmsInference" << (shareLocation ? "" : ", per class locations") << std::endl;
+    int32_t const nbLocClasses = shareLocation ? 1 : kNB_CLASSES;
+    int32_t const boxesSize = kNB_PRIORS * nbLocClasses * 4;
+    int32_t const scoresSize = kNB_PRIORS * kNB_CLASSES;
+    auto const boxes = pluginTest::makeBoxes(kBATCH * kNB_PRIORS * nbLocClasses, 5);
+    auto const scores = pluginTest::distinctValues(kBATCH * scoresSize, 0.F, 1.F, 6);
+    size_t const workspaceSize = detectionInferenceWorkspaceSize(shareLocation, kBATCH, boxesSize, scoresSize,
+        kNB_CLASSES, kNB_PRIORS, kTOP_K, DataType::kFLOAT, DataType::kFLOAT);
+    // Shared by both backends, as a plugin reuses its planner across enqueues.
+    WorkspacePlanner planner;
+    size_t const nbOutputs = kBATCH * kKEEP_TOP_K;
+
+    compareBackends({boxes, scores}, {kBATCH, nbOutputs * 4, nbOutputs, nbOutputs}, workspaceSize,
+        [&](std::vector<void const*> const& in, std::vector<void*> const& out, void* workspace) {
+            return nmsInference(nullptr, kBATCH, boxesSize, scoresSize, shareLocation, -1, kNB_PRIORS, kNB_CLASSES,
+                kTOP_K, kKEEP_TOP_K, 0.2F, 0.45F, DataType::kFLOAT, in[0], DataType::kFLOAT, in[1], out[0], out[1],
+                out[2], out[3], workspace, planner);
+        });
+    expectBBoxSlotReuse(shareLocation, boxesSize, scoresSize);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    for (bool shareLocation : {true, false})
+    {
+        testDetectionInference(shareLocation);
+        testNmsInference(shareLocation);
+    }
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
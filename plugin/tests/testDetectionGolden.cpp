@@ -0,0 +1,199 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testDetectionGolden.cpp
+//! Runs detectionInference and nmsInference with the CPU detection backend on the cases of
+//! nmsPlugin/DetectionOutput_PluginGoldenIO.json and batchedNMSPlugin/BatchedNMSPlugin_PluginGoldenIO.json, and
+//! checks their outputs against the golden outputs. The golden outputs were computed by a plain reference of SSD
+//! decoding, per class NMS and top-k selection that shares no code with the kernels. The test does not use the GPU.
+//!
+
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "common/kernels/kernel.h"
+#include "common/nmsUtils.h"
+#include "goldenIO.h"
+#include "logger.h"
+#include "pluginTestUtils.h"
+
+using namespace nvinfer1::plugin;
+using nvinfer1::DataType;
+using pluginTest::JsonValue;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_detection_golden";
+
+std::string const kDETECTION_GOLDEN_FILE = PLUGIN_SOURCE_DIR "/nmsPlugin/DetectionOutput_PluginGoldenIO.json";
+std::string const kNMS_GOLDEN_FILE = PLUGIN_SOURCE_DIR "/batchedNMSPlugin/BatchedNMSPlugin_PluginGoldenIO.json";
+
+//! Selects the CPU backend for the lifetime of a test case.
+struct CpuBackend
+{
+    CpuBackend()
+    {
+        setDetectionBackend(DetectionBackend::kCPU);
+    }
+    ~CpuBackend()
+    {
+        setDetectionBackend(DetectionBackend::kCUDA);
+    }
+};
+
+float floatAttribute(JsonValue const& attribute)
+{
+    return pluginTest::goldenArray(attribute).values<float>().at(0);
+}
+
+//! Check one output against its golden value. Every element is compared, the padding included.
+void expectOutput(JsonValue const& outputs, std::string const& name, std::vector<float> const& actual)
+{
+    auto const expected = pluginTest::goldenArray(outputs[name]).values<float>();
+    if (TEST_EXPECT(actual.size() == expected.size()))
+    {
+        TEST_EXPECT_NEAR(actual.data(), expected.data(), actual.size(), 1e-5);
+    }
+}
+
+void expectCounts(JsonValue const& outputs, std::string const& name, std::vector<int32_t> const& actual)
+{
+    TEST_EXPECT(actual == pluginTest::goldenArray(outputs[name]).values<int32_t>());
+}
+
+//! SSD post-processing, as the DetectionOutput (NMS_TRT) plugin runs it.
+void testDetectionCase(std::string const& name, JsonValue const& goldenCase)
+{
+    sample::gLogInfo << "detectionInference " << name << std::endl;
+    JsonValue const& attributes = goldenCase["attributes"];
+    auto const loc = pluginTest::goldenArray(goldenCase["inputs"]["loc"]);
+    auto const conf = pluginTest::goldenArray(goldenCase["inputs"]["conf"]);
+    auto const priors = pluginTest::goldenArray(goldenCase["inputs"]["priors"]);
+    bool const shareLocation = attributes["shareLocation"].asInt() != 0;
+    int32_t const numClasses = attributes["numClasses"].asInt();
+    int32_t const topK = attributes["topK"].asInt();
+    int32_t const keepTopK = attributes["keepTopK"].asInt();
+    int32_t const batch = static_cast<int32_t>(loc.shape.at(0));
+    int32_t const C1 = static_cast<int32_t>(loc.count() / batch);
+    int32_t const C2 = static_cast<int32_t>(conf.count() / batch);
+    int32_t const numPriors = C2 / numClasses;
+
+    CpuBackend backend;
+    WorkspacePlanner planner;
+    std::vector<char> workspace(detectionInferenceWorkspaceSize(
+        shareLocation, batch, C1, C2, numClasses, numPriors, topK, DataType::kFLOAT, DataType::kFLOAT));
+    std::vector<int32_t> keepCount(batch, -1);
+    std::vector<float> detections(static_cast<size_t>(batch) * keepTopK * 7, -2.F);
+    auto const locValues = loc.values<float>();
+    auto const confValues = conf.values<float>();
+    auto const priorValues = priors.values<float>();
+    pluginStatus_t const status = detectionInference(nullptr, batch, C1, C2, shareLocation,
+        attributes["varianceEncodedInTarget"].asInt() != 0, attributes["backgroundLabelId"].asInt(), numPriors,
+        numClasses, topK, keepTopK, floatAttribute(attributes["confidenceThreshold"]),
+        floatAttribute(attributes["nmsThreshold"]), static_cast<CodeTypeSSD>(attributes["codeType"].asInt()),
+        DataType::kFLOAT, locValues.data(), priorValues.data(), DataType::kFLOAT, confValues.data(), keepCount.data(),
+        detections.data(), workspace.data(), planner, attributes["isNormalized"].asInt() != 0);
+    if (!TEST_EXPECT(status == STATUS_SUCCESS))
+    {
+        return;
+    }
+    expectCounts(goldenCase["outputs"], "keep_count", keepCount);
+    expectOutput(goldenCase["outputs"], "detection_out", detections);
+}
+
+//! Batched NMS, as the BatchedNMS_TRT plugin runs it.
+void testNmsCase(std::string const& name, JsonValue const& goldenCase)
+{
+    sample::gLogInfo << "nmsInference " << name << std::endl;
+    JsonValue const& attributes = goldenCase["attributes"];
+    auto const boxes = pluginTest::goldenArray(goldenCase["inputs"]["boxes"]);
+    auto const scores = pluginTest::goldenArray(goldenCase["inputs"]["scores"]);
+    bool const shareLocation = attributes["shareLocation"].asInt() != 0;
+    int32_t const numClasses = attributes["numClasses"].asInt();
+    int32_t const topK = attributes["topK"].asInt();
+    int32_t const keepTopK = attributes["keepTopK"].asInt();
+    // Boxes are [batch, boxes, 1 or classes, 4] and scores [batch, boxes, classes].
+    int32_t const batch = static_cast<int32_t>(boxes.shape.at(0));
+    int32_t const numBoxes = static_cast<int32_t>(boxes.shape.at(1));
+    int32_t const boxesSize = static_cast<int32_t>(boxes.count() / batch);
+    int32_t const scoresSize = static_cast<int32_t>(scores.count() / batch);
+
+    CpuBackend backend;
+    WorkspacePlanner planner;
+    std::vector<char> workspace(detectionInferenceWorkspaceSize(
+        shareLocation, batch, boxesSize, scoresSize, numClasses, numBoxes, topK, DataType::kFLOAT, DataType::kFLOAT));
+    size_t const nbOutputs = static_cast<size_t>(batch) * keepTopK;
+    std::vector<int32_t> numDetections(batch, -1);
+    std::vector<float> nmsedBoxes(nbOutputs * 4, -2.F);
+    std::vector<float> nmsedScores(nbOutputs, -2.F);
+    std::vector<float> nmsedClasses(nbOutputs, -2.F);
+    auto const boxValues = boxes.values<float>();
+    auto const scoreValues = scores.values<float>();
+    pluginStatus_t const status = nmsInference(nullptr, batch, boxesSize, scoresSize, shareLocation,
+        attributes["backgroundLabelId"].asInt(), numBoxes, numClasses, topK, keepTopK,
+        floatAttribute(attributes["scoreThreshold"]), floatAttribute(attributes["iouThreshold"]), DataType::kFLOAT,
+        boxValues.data(), DataType::kFLOAT, scoreValues.data(), numDetections.data(), nmsedBoxes.data(),
+        nmsedScores.data(), nmsedClasses.data(), workspace.data(), planner, attributes["isNormalized"].asInt() != 0,
+        false, attributes["clipBoxes"].asInt() != 0);
+    if (!TEST_EXPECT(status == STATUS_SUCCESS))
+    {
+        return;
+    }
+    expectCounts(goldenCase["outputs"], "num_detections", numDetections);
+    expectOutput(goldenCase["outputs"], "nmsed_boxes", nmsedBoxes);
+    expectOutput(goldenCase["outputs"], "nmsed_scores", nmsedScores);
+    expectOutput(goldenCase["outputs"], "nmsed_classes", nmsedClasses);
+}
+
+//! Run every case of a golden file.
+template <typename TestCase>
+void testGoldenFile(std::string const& path, TestCase const& testCase)
+{
+    try
+    {
+        auto const golden = pluginTest::readGoldenIO(path);
+        TEST_EXPECT(!golden.object.empty());
+        for (auto const& config : golden.object)
+        {
+            for (auto const& goldenCase : config.second.array)
+            {
+                testCase(config.first, goldenCase);
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        sample::gLogError << path << ": " << e.what() << std::endl;
+        TEST_EXPECT(false);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    testGoldenFile(kDETECTION_GOLDEN_FILE, testDetectionCase);
+    testGoldenFile(kNMS_GOLDEN_FILE, testNmsCase);
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,170 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testEfficientNMS.cpp
+//! Runs EfficientNMSInference and its host reference EfficientNMSHostInference on the same fixed boxes and scores,
+//! and checks that they select the same detections.
+//!
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "efficientNMSPlugin/efficientNMSInference.h"
+#include "logger.h"
+#include "pluginTestUtils.h"
+
+using namespace nvinfer1::plugin;
+using pluginTest::DeviceBuffer;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_efficient_nms";
+
+constexpr int32_t kBATCH{2};
+constexpr int32_t kNB_ANCHORS{256};
+constexpr int32_t kNB_CLASSES{4};
+
+struct Detections
+{
+    std::vector<int32_t> numDetections;
+    std::vector<float> boxes;
+    std::vector<float> scores;
+    std::vector<int32_t> classes;
+};
+
+EfficientNMSParameters makeParameters(int32_t boxCoding, bool classAgnostic)
+{
+    EfficientNMSParameters param;
+    param.iouThreshold = 0.5F;
+    param.scoreThreshold = 0.3F;
+    param.numOutputBoxes = 50;
+    param.boxCoding = boxCoding;
+    param.classAgnostic = classAgnostic;
+    param.batchSize = kBATCH;
+    param.numClasses = kNB_CLASSES;
+    param.numAnchors = kNB_ANCHORS;
+    param.numBoxElements = kNB_ANCHORS * 4;
+    param.numScoreElements = kNB_ANCHORS * kNB_CLASSES;
+    param.shareLocation = true;
+    param.datatype = nvinfer1::DataType::kFLOAT;
+    return param;
+}
+
+bool runDevice(EfficientNMSParameters const& param, std::vector<float> const& boxes, std::vector<float> const& scores,
+    Detections& out)
+{
+    size_t const nbOutputs = static_cast<size_t>(kBATCH) * param.numOutputBoxes;
+    auto boxesInput = pluginTest::toDevice(boxes);
+    auto scoresInput = pluginTest::toDevice(scores);
+    DeviceBuffer numDetections(kBATCH * sizeof(int32_t));
+    DeviceBuffer nmsBoxes(nbOutputs * 4 * sizeof(float));
+    DeviceBuffer nmsScores(nbOutputs * sizeof(float));
+    DeviceBuffer nmsClasses(nbOutputs * sizeof(int32_t));
+    DeviceBuffer workspace(
+        EfficientNMSWorkspaceSize(kBATCH, param.numScoreElements, param.numClasses, nvinfer1::DataType::kFLOAT));
+    if (!TEST_EXPECT(boxesInput.get() && scoresInput.get() && numDetections.get() && nmsBoxes.get()
+            && nmsScores.get() && nmsClasses.get() && workspace.get()))
+    {
+        return false;
+    }
+
+    pluginStatus_t const status = EfficientNMSInference(param, boxesInput.get(), scoresInput.get(), nullptr,
+        numDetections.get(), nmsBoxes.get(), nmsScores.get(), nmsClasses.get(), nullptr, workspace.get(), nullptr);
+    if (!TEST_EXPECT(status == STATUS_SUCCESS) || !TEST_EXPECT_CUDA(cudaDeviceSynchronize()))
+    {
+        return false;
+    }
+    out.numDetections = pluginTest::toHost<int32_t>(numDetections, kBATCH);
+    out.boxes = pluginTest::toHost<float>(nmsBoxes, nbOutputs * 4);
+    out.scores = pluginTest::toHost<float>(nmsScores, nbOutputs);
+    out.classes = pluginTest::toHost<int32_t>(nmsClasses, nbOutputs);
+    return true;
+}
+
+bool runHost(EfficientNMSParameters const& param, std::vector<float> const& boxes, std::vector<float> const& scores,
+    int32_t numThreads, Detections& out)
+{
+    size_t const nbOutputs = static_cast<size_t>(kBATCH) * param.numOutputBoxes;
+    out.numDetections.assign(kBATCH, -1);
+    out.boxes.assign(nbOutputs * 4, -1.F);
+    out.scores.assign(nbOutputs, -1.F);
+    out.classes.assign(nbOutputs, -1);
+    pluginStatus_t const status = EfficientNMSHostInference(param, boxes.data(), scores.data(), nullptr,
+        out.numDetections.data(), out.boxes.data(), out.scores.data(), out.classes.data(), nullptr, numThreads);
+    return TEST_EXPECT(status == STATUS_SUCCESS);
+}
+
+//! Compare the detections of each image. Entries past the number of detections are padding and not compared.
+void compare(EfficientNMSParameters const& param, Detections const& actual, Detections const& expected)
+{
+    for (int32_t b = 0; b < kBATCH; ++b)
+    {
+        if (!TEST_EXPECT(actual.numDetections[b] == expected.numDetections[b]))
+        {
+            continue;
+        }
+        TEST_EXPECT(expected.numDetections[b] > 0);
+        size_t const offset = static_cast<size_t>(b) * param.numOutputBoxes;
+        size_t const count = expected.numDetections[b];
+        TEST_EXPECT_NEAR(&actual.boxes[offset * 4], &expected.boxes[offset * 4], count * 4, 1e-5);
+        TEST_EXPECT_NEAR(&actual.scores[offset], &expected.scores[offset], count, 1e-6);
+        TEST_EXPECT(std::equal(&actual.classes[offset], &actual.classes[offset] + count, &expected.classes[offset]));
+    }
+}
+
+void testCase(int32_t boxCoding, bool classAgnostic)
+{
+    sample::gLogInfo << "Box coding " << boxCoding << (classAgnostic ? ", class agnostic" : "") << std::endl;
+    auto const param = makeParameters(boxCoding, classAgnostic);
+    auto const boxes = pluginTest::makeBoxes(kBATCH * kNB_ANCHORS, 1, boxCoding);
+    auto const scores = pluginTest::distinctValues(kBATCH * kNB_ANCHORS * kNB_CLASSES, 0.05F, 0.95F, 3);
+
+    Detections host;
+    if (!runHost(param, boxes, scores, 1, host))
+    {
+        return;
+    }
+    Detections device;
+    if (runDevice(param, boxes, scores, device))
+    {
+        compare(param, host, device);
+    }
+
+    // The host result does not depend on the number of threads.
+    Detections threaded;
+    if (runHost(param, boxes, scores, 4, threaded))
+    {
+        compare(param, threaded, host);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    testCase(0, false);
+    testCase(1, false);
+    testCase(0, true);
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testEfficientNMSGolden.cpp
+//! Runs the host reference EfficientNMSHostInference on the cases of efficientNMSPlugin/
+//! EfficientNMSPlugin_PluginGoldenIO.json and checks its outputs against the golden outputs. The test does not use the
+//! GPU.
+//!
+
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "efficientNMSPlugin/efficientNMSInference.h"
+#include "goldenIO.h"
+#include "logger.h"
+#include "pluginTestUtils.h"
+
+using namespace nvinfer1::plugin;
+using pluginTest::JsonValue;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_efficient_nms_golden";
+
+//! The golden file, in the source tree. The path can be overridden by the first command line argument.
+std::string const kGOLDEN_FILE = PLUGIN_SOURCE_DIR "/efficientNMSPlugin/EfficientNMSPlugin_PluginGoldenIO.json";
+
+//! The parameters of one golden case, from its attributes and the shapes of its inputs.
+EfficientNMSParameters makeParameters(JsonValue const& attributes, pluginTest::NpyArray const& boxes,
+    pluginTest::NpyArray const& scores)
+{
+    EfficientNMSParameters param;
+    param.scoreThreshold = pluginTest::goldenArray(attributes["score_threshold"]).values<float>().at(0);
+    param.iouThreshold = pluginTest::goldenArray(attributes["iou_threshold"]).values<float>().at(0);
+    param.numOutputBoxes = attributes["max_output_boxes"].asInt();
+    param.backgroundClass = attributes["background_class"].asInt();
+    param.scoreSigmoid = attributes["score_activation"].asInt() != 0;
+    param.classAgnostic = attributes["class_agnostic"].asInt() != 0;
+    param.boxCoding = attributes["box_coding"].asInt();
+
+    // Boxes are [batch, anchors, 4], or [batch, anchors, classes or 1, 4] when they are not shared.
+    param.batchSize = static_cast<int32_t>(scores.shape.at(0));
+    param.numAnchors = static_cast<int32_t>(scores.shape.at(1));
+    param.numClasses = static_cast<int32_t>(scores.shape.at(2));
+    param.numScoreElements = param.numAnchors * param.numClasses;
+    param.shareLocation = boxes.shape.size() == 3 || boxes.shape.at(2) == 1;
+    param.numBoxElements = static_cast<int32_t>(boxes.count() / param.batchSize);
+    param.datatype = nvinfer1::DataType::kFLOAT;
+    return param;
+}
+
+void testCase(std::string const& name, JsonValue const& goldenCase)
+{
+    sample::gLogInfo << "Golden case " << name << std::endl;
+    auto const boxes = pluginTest::goldenArray(goldenCase["inputs"]["boxes"]);
+    auto const scores = pluginTest::goldenArray(goldenCase["inputs"]["scores"]);
+    auto const param = makeParameters(goldenCase["attributes"], boxes, scores);
+    auto const expectedNumDetections
+        = pluginTest::goldenArray(goldenCase["outputs"]["num_detections"]).values<int32_t>();
+    auto const expectedBoxes = pluginTest::goldenArray(goldenCase["outputs"]["detection_boxes"]).values<float>();
+
+    size_t const nbOutputs = static_cast<size_t>(param.batchSize) * param.numOutputBoxes;
+    if (!TEST_EXPECT(expectedNumDetections.size() == static_cast<size_t>(param.batchSize))
+        || !TEST_EXPECT(expectedBoxes.size() == nbOutputs * 4))
+    {
+        return;
+    }
+
+    std::vector<int32_t> numDetections(param.batchSize, -1);
+    std::vector<float> nmsBoxes(nbOutputs * 4, -1.F);
+    std::vector<float> nmsScores(nbOutputs, -1.F);
+    std::vector<int32_t> nmsClasses(nbOutputs, -1);
+    auto const boxValues = boxes.values<float>();
+    auto const scoreValues = scores.values<float>();
+    pluginStatus_t const status = EfficientNMSHostInference(param, boxValues.data(), scoreValues.data(), nullptr,
+        numDetections.data(), nmsBoxes.data(), nmsScores.data(), nmsClasses.data(), nullptr);
+    if (!TEST_EXPECT(status == STATUS_SUCCESS))
+    {
+        return;
+    }
+
+    // Both pad the boxes past the number of detections with zeros, so the whole output is compared.
+    TEST_EXPECT(numDetections == expectedNumDetections);
+    TEST_EXPECT_NEAR(nmsBoxes.data(), expectedBoxes.data(), nbOutputs * 4, 1e-6);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    std::string const goldenFile = argc > 1 ? argv[1] : kGOLDEN_FILE;
+    try
+    {
+        auto const golden = pluginTest::readGoldenIO(goldenFile);
+        TEST_EXPECT(!golden.object.empty());
+        for (auto const& config : golden.object)
+        {
+            for (auto const& goldenCase : config.second.array)
+            {
+                testCase(config.first, goldenCase);
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        sample::gLogError << goldenFile << ": " << e.what() << std::endl;
+        TEST_EXPECT(false);
+    }
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testGroupNorm.cpp
+//! Runs the fused GroupNorm kernel, groupNormForward, and its host reference groupNormForwardHost on fixed inputs in
+//! the linear and channels-last layouts, and checks that the outputs match.
+//!
+
+#include <cuda_fp16.h>
+
+#include <string>
+#include <vector>
+
+#include "groupNormalizationPlugin/groupNormalizationPlugin.h"
+#include "logger.h"
+#include "pluginTestUtils.h"
+
+using namespace nvinfer1::plugin;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_group_norm";
+
+template <typename T>
+T fromFloat(float v);
+
+template <>
+float fromFloat<float>(float v)
+{
+    return v;
+}
+
+template <>
+half fromFloat<half>(float v)
+{
+    return __float2half(v);
+}
+
+float toFloat(float v)
+{
+    return v;
+}
+
+float toFloat(half v)
+{
+    return __half2float(v);
+}
+
+template <typename T>
+std::vector<T> convert(std::vector<float> const& values)
+{
+    std::vector<T> converted;
+    for (float v : values)
+    {
+        converted.push_back(fromFloat<T>(v));
+    }
+    return converted;
+}
+
+template <typename T>
+std::vector<float> toFloats(std::vector<T> const& values)
+{
+    std::vector<float> converted;
+    for (T const& v : values)
+    {
+        converted.push_back(toFloat(v));
+    }
+    return converted;
+}
+
+//! Normalizes B x C x spatial values in nbGroups groups. In the channels-last layout each pixel holds ldc >= C values,
+//! and the padding channels are neither read nor written.
+template <typename T>
+void testCase(char const* name, int32_t B, int32_t C, int32_t spatial, int32_t nbGroups, bool channelsLast,
+    int32_t ldc, bool silu, double tolerance)
+{
+    sample::gLogInfo << name << std::endl;
+    size_t const volume = static_cast<size_t>(B) * spatial * (channelsLast ? ldc : C);
+    // An offset mean, so that the statistics are not trivially centered.
+    auto const input = convert<T>(pluginTest::uniformValues(volume, 1.F, 3.F, 1));
+    auto const gamma = convert<T>(pluginTest::uniformValues(C, 0.5F, 1.5F, 2));
+    auto const beta = convert<T>(pluginTest::uniformValues(C, -0.5F, 0.5F, 3));
+    float const epsilon = 1e-5F;
+
+    std::vector<T> expected(volume, fromFloat<T>(0.F));
+    groupNormForwardHost(input.data(), expected.data(), gamma.data(), beta.data(), B, C, spatial, ldc, nbGroups,
+        epsilon, silu, channelsLast);
+
+    auto deviceInput = pluginTest::toDevice(input);
+    auto deviceGamma = pluginTest::toDevice(gamma);
+    auto deviceBeta = pluginTest::toDevice(beta);
+    auto deviceOutput = pluginTest::toDevice(std::vector<T>(volume, fromFloat<T>(0.F)));
+    if (!TEST_EXPECT(deviceInput.get() && deviceGamma.get() && deviceBeta.get() && deviceOutput.get()))
+    {
+        return;
+    }
+    cudaError_t const status = groupNormForward(static_cast<T const*>(deviceInput.get()),
+        static_cast<T*>(deviceOutput.get()), static_cast<T const*>(deviceGamma.get()),
+        static_cast<T const*>(deviceBeta.get()), B, C, spatial, ldc, nbGroups, epsilon, silu, channelsLast, nullptr);
+    if (!TEST_EXPECT_CUDA(status) || !TEST_EXPECT_CUDA(cudaDeviceSynchronize()))
+    {
+        return;
+    }
+    auto const actual = toFloats(pluginTest::toHost<T>(deviceOutput, volume));
+    auto const reference = toFloats(expected);
+    TEST_EXPECT_NEAR(actual.data(), reference.data(), volume, tolerance);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    // Groups of 1024 values are cached in shared memory.
+    testCase<float>("FP32 linear, cached", 2, 32, 256, 8, false, 32, true, 1e-4);
+    // A group of exactly 48 KiB does not fit next to the reduction buffer, and is read twice.
+    testCase<float>("FP32 linear, 48 KiB group", 1, 4, 3072, 1, false, 4, false, 1e-4);
+    testCase<float>("FP32 linear, large groups", 1, 16, 4096, 2, false, 16, true, 1e-4);
+    testCase<float>("FP32 kHWC", 2, 24, 100, 6, true, 24, false, 1e-4);
+    testCase<half>("FP16 linear", 2, 16, 300, 4, false, 16, true, 5e-3);
+    // kHWC8 pads the 20 channels of each pixel to 24.
+    testCase<half>("FP16 kHWC8", 2, 20, 64, 5, true, 24, false, 5e-3);
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testInstanceNorm.cpp
+//! Runs the fused 3-D InstanceNormalization kernels, instanceNorm3dForward, and their host reference
+//! instanceNorm3dForwardHost on fixed inputs in NCDHW and NDHWC, and checks that the outputs match.
+//!
+
+#include <cuda_fp16.h>
+
+#include <string>
+#include <vector>
+
+#include "instanceNormalizationPlugin/instanceNormalizationPlugin.h"
+#include "logger.h"
+#include "pluginTestUtils.h"
+
+using namespace nvinfer1::plugin;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_instance_norm";
+
+template <typename T>
+std::vector<T> convert(std::vector<float> const& values)
+{
+    return std::vector<T>(values.begin(), values.end());
+}
+
+template <>
+std::vector<half> convert<half>(std::vector<float> const& values)
+{
+    std::vector<half> converted;
+    for (float v : values)
+    {
+        converted.push_back(__float2half(v));
+    }
+    return converted;
+}
+
+std::vector<float> toFloats(std::vector<float> const& values)
+{
+    return values;
+}
+
+std::vector<float> toFloats(std::vector<half> const& values)
+{
+    std::vector<float> converted;
+    for (half const& v : values)
+    {
+        converted.push_back(__half2float(v));
+    }
+    return converted;
+}
+
+//! Normalizes N x C instances of volume voxels each, with a leaky relu when relu is set.
+template <typename T>
+void testCase(char const* name, int32_t n, int32_t c, int32_t volume, bool channelsLast, int32_t relu,
+    double tolerance)
+{
+    sample::gLogInfo << name << std::endl;
+    size_t const count = static_cast<size_t>(n) * c * volume;
+    // An offset mean, so that the statistics are not trivially centered.
+    auto const input = convert<T>(pluginTest::uniformValues(count, 1.F, 3.F, 1));
+    auto const scale = pluginTest::uniformValues(c, 0.5F, 1.5F, 2);
+    auto const bias = pluginTest::uniformValues(c, -0.5F, 0.5F, 3);
+    float const epsilon = 1e-5F;
+    float const alpha = 0.1F;
+
+    std::vector<T> expected(count);
+    instanceNorm3dForwardHost(
+        input.data(), expected.data(), scale.data(), bias.data(), n, c, volume, epsilon, relu, alpha, channelsLast);
+
+    auto deviceInput = pluginTest::toDevice(input);
+    auto deviceScale = pluginTest::toDevice(scale);
+    auto deviceBias = pluginTest::toDevice(bias);
+    pluginTest::DeviceBuffer deviceOutput(count * sizeof(T));
+    pluginTest::DeviceBuffer workspace(instanceNorm3dWorkspaceSize(n, c, volume));
+    if (!TEST_EXPECT(deviceInput.get() && deviceScale.get() && deviceBias.get() && deviceOutput.get()
+            && workspace.get()))
+    {
+        return;
+    }
+    cudaError_t const status = instanceNorm3dForward(static_cast<T const*>(deviceInput.get()),
+        static_cast<T*>(deviceOutput.get()), static_cast<float const*>(deviceScale.get()),
+        static_cast<float const*>(deviceBias.get()), n, c, volume, epsilon, relu, alpha, channelsLast,
+        workspace.get(), nullptr);
+    if (!TEST_EXPECT_CUDA(status) || !TEST_EXPECT_CUDA(cudaDeviceSynchronize()))
+    {
+        return;
+    }
+    auto const actual = toFloats(pluginTest::toHost<T>(deviceOutput, count));
+    auto const reference = toFloats(expected);
+    TEST_EXPECT_NEAR(actual.data(), reference.data(), count, tolerance);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    // A volume below 16384 voxels is reduced by one CTA per instance.
+    testCase<float>("FP32 NCDHW, one split", 2, 3, 4 * 8 * 8, false, 0, 1e-4);
+    // 40000 voxels are split over two CTAs, whose partial statistics are combined.
+    testCase<float>("FP32 NCDHW, split volume", 1, 2, 40000, false, 1, 1e-4);
+    // 40 channels cover one full and one partial block of 32 channels.
+    testCase<float>("FP32 NDHWC", 2, 40, 6 * 6 * 6, true, 1, 1e-4);
+    testCase<float>("FP32 NDHWC, split volume", 1, 8, 36000, true, 0, 1e-4);
+    testCase<half>("FP16 NCDHW", 2, 4, 8 * 8 * 8, false, 1, 5e-3);
+    testCase<half>("FP16 NDHWC", 1, 16, 5 * 5 * 5, true, 0, 5e-3);
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
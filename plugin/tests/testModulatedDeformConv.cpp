@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testModulatedDeformConv.cpp
+//! Runs the ModulatedDeformConv forward launcher on fixed inputs and checks it against a host convolution built on the
+//! host im2col reference, modulatedDeformableIm2colHost. The cases cover the batched GEMM over a whole step, a batch
+//! split into steps of different sizes, and a single image.
+//!
+
+#include <cublas_v2.h>
+
+#include <string>
+#include <vector>
+
+#include "logger.h"
+#include "modulatedDeformConvPlugin/modulatedDeformConvPlugin.h"
+#include "pluginTestUtils.h"
+
+void ModulatedDeformConvForwardCUDAKernelLauncherFloat(float const* input, float const* weight, float const* bias,
+    float const* offset, float const* mask, float* output, void* workspace, int32_t batch, int32_t channels,
+    int32_t height, int32_t width, int32_t channelsOut, int32_t kernelW, int32_t kernelH, int32_t strideW,
+    int32_t strideH, int32_t padW, int32_t padH, int32_t dilationW, int32_t dilationH, int32_t group,
+    int32_t deformableGroup, int32_t im2colStep, cublasHandle_t cublasHandle, cudaStream_t stream);
+
+using namespace nvinfer1::plugin;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_modulated_deform_conv";
+
+struct ConvParams
+{
+    char const* name;
+    int32_t batch;
+    int32_t channels;
+    int32_t height;
+    int32_t width;
+    int32_t channelsOut;
+    int32_t kernel;
+    int32_t stride;
+    int32_t pad;
+    int32_t dilation;
+    int32_t group;
+    int32_t deformableGroup;
+    int32_t im2colStep;
+    bool withBias;
+};
+
+//! The deformable convolution on the host: the im2col reference followed by one GEMM per image and group.
+std::vector<float> convolveHost(ConvParams const& p, int32_t heightOut, int32_t widthOut,
+    std::vector<float> const& input, std::vector<float> const& offset, std::vector<float> const& mask,
+    std::vector<float> const& weight, std::vector<float> const& bias)
+{
+    int32_t const plane = heightOut * widthOut;
+    int32_t const k = p.channels / p.group * p.kernel * p.kernel;
+    int32_t const m = p.channelsOut / p.group;
+    std::vector<float> columns(static_cast<size_t>(p.batch) * p.channels * p.kernel * p.kernel * plane);
+    modulatedDeformableIm2colHost(input.data(), offset.data(), mask.data(), p.batch, p.channels, p.height, p.width,
+        heightOut, widthOut, p.kernel, p.kernel, p.pad, p.pad, p.stride, p.stride, p.dilation, p.dilation,
+        p.deformableGroup, columns.data());
+
+    std::vector<float> output(static_cast<size_t>(p.batch) * p.channelsOut * plane);
+    for (int32_t b = 0; b < p.batch; ++b)
+    {
+        for (int32_t g = 0; g < p.group; ++g)
+        {
+            float const* col = columns.data() + (static_cast<size_t>(b) * p.group + g) * k * plane;
+            for (int32_t co = g * m; co < (g + 1) * m; ++co)
+            {
+                for (int32_t pos = 0; pos < plane; ++pos)
+                {
+                    double sum = p.withBias ? bias[co] : 0.0;
+                    for (int32_t i = 0; i < k; ++i)
+                    {
+                        sum += static_cast<double>(weight[static_cast<size_t>(co) * k + i]) * col[i * plane + pos];
+                    }
+                    output[(static_cast<size_t>(b) * p.channelsOut + co) * plane + pos] = static_cast<float>(sum);
+                }
+            }
+        }
+    }
+    return output;
+}
+
+void testCase(ConvParams const& p, cublasHandle_t handle)
+{
+    sample::gLogInfo << p.name << std::endl;
+    int32_t const extent = p.dilation * (p.kernel - 1) + 1;
+    int32_t const heightOut = (p.height + 2 * p.pad - extent) / p.stride + 1;
+    int32_t const widthOut = (p.width + 2 * p.pad - extent) / p.stride + 1;
+    size_t const plane = static_cast<size_t>(heightOut) * widthOut;
+    size_t const kernelArea = static_cast<size_t>(p.kernel) * p.kernel;
+
+    auto const input = pluginTest::uniformValues(static_cast<size_t>(p.batch) * p.channels * p.height * p.width,
+        -1.F, 1.F, 1);
+    // Offsets of up to two pixels move some samples off the image, where they read zeros.
+    auto const offset
+        = pluginTest::uniformValues(p.batch * p.deformableGroup * 2 * kernelArea * plane, -2.F, 2.F, 2);
+    auto const mask = pluginTest::uniformValues(p.batch * p.deformableGroup * kernelArea * plane, 0.F, 1.F, 3);
+    auto const weight
+        = pluginTest::uniformValues(p.channelsOut * (p.channels / p.group) * kernelArea, -0.5F, 0.5F, 4);
+    auto const bias = pluginTest::uniformValues(p.channelsOut, -0.5F, 0.5F, 5);
+    auto const expected = convolveHost(p, heightOut, widthOut, input, offset, mask, weight, bias);
+
+    auto deviceInput = pluginTest::toDevice(input);
+    auto deviceOffset = pluginTest::toDevice(offset);
+    auto deviceMask = pluginTest::toDevice(mask);
+    auto deviceWeight = pluginTest::toDevice(weight);
+    auto deviceBias = pluginTest::toDevice(bias);
+    pluginTest::DeviceBuffer deviceOutput(expected.size() * sizeof(float));
+    int64_t const columnBytes = static_cast<int64_t>(p.channels) * kernelArea * plane * sizeof(float);
+    pluginTest::DeviceBuffer workspace(getIm2colWorkspaceSize(p.batch, columnBytes));
+    if (!TEST_EXPECT(deviceInput.get() && deviceOffset.get() && deviceMask.get() && deviceWeight.get()
+            && deviceBias.get() && deviceOutput.get() && workspace.get()))
+    {
+        return;
+    }
+
+    ModulatedDeformConvForwardCUDAKernelLauncherFloat(static_cast<float const*>(deviceInput.get()),
+        static_cast<float const*>(deviceWeight.get()),
+        p.withBias ? static_cast<float const*>(deviceBias.get()) : nullptr,
+        static_cast<float const*>(deviceOffset.get()), static_cast<float const*>(deviceMask.get()),
+        static_cast<float*>(deviceOutput.get()), workspace.get(), p.batch, p.channels, p.height, p.width,
+        p.channelsOut, p.kernel, p.kernel, p.stride, p.stride, p.pad, p.pad, p.dilation, p.dilation, p.group,
+        p.deformableGroup, p.im2colStep, handle, nullptr);
+    if (!TEST_EXPECT_CUDA(cudaDeviceSynchronize()))
+    {
+        return;
+    }
+    auto const actual = pluginTest::toHost<float>(deviceOutput, expected.size());
+    TEST_EXPECT_NEAR(actual.data(), expected.data(), expected.size(), 1e-3);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    cublasHandle_t handle{nullptr};
+    if (TEST_EXPECT(cublasCreate(&handle) == CUBLAS_STATUS_SUCCESS))
+    {
+        // All five images share one im2col launch and one strided-batched GEMM.
+        testCase({"One step of five images", 5, 4, 7, 9, 8, 3, 1, 1, 1, 1, 2, 5, true}, handle);
+        // Steps of two, two and one image mix the batched and the single image GEMM, here per group.
+        testCase({"Grouped, steps of two images", 5, 4, 11, 10, 6, 3, 2, 2, 2, 2, 1, 2, true}, handle);
+        testCase({"Single image without bias", 1, 6, 8, 8, 4, 3, 1, 0, 1, 1, 3, 1, false}, handle);
+        cublasDestroy(handle);
+    }
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
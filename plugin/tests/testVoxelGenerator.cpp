@@ -0,0 +1,220 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testVoxelGenerator.cpp
+//! Runs VoxelGeneratorPlugin with the dense grid and with sparse voxelization on a fixed batch of point clouds, and
+//! checks both against the host reference generateVoxelsHost.
+//!
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "logger.h"
+#include "pluginTestUtils.h"
+#include "voxelGeneratorPlugin/voxelGenerator.h"
+
+using namespace nvinfer1;
+using namespace nvinfer1::plugin;
+using pluginTest::DeviceBuffer;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_voxel_generator";
+
+constexpr int32_t kBATCH{2};
+constexpr int32_t kMAX_NUM_POINTS{600};
+// Enough pillars for every occupied one, so that no pillar is dropped in an order dependent way.
+constexpr int32_t kMAX_PILLARS{1024};
+constexpr int32_t kMAX_POINTS_PER_PILLAR{32};
+// A 32 x 32 x 1 grid over [0, 16) x [0, 16) x [-2, 2).
+constexpr float kRANGE[6]{0.F, 0.F, -2.F, 16.F, 16.F, 2.F};
+constexpr float kPILLAR_SIZE[3]{0.5F, 0.5F, 4.F};
+// The second frame holds fewer valid points than the input has rows.
+constexpr uint32_t kPOINTS_SIZE[kBATCH]{kMAX_NUM_POINTS, 450};
+
+struct Voxels
+{
+    std::vector<float> features;
+    std::vector<uint32_t> coords;
+    std::vector<uint32_t> params;
+};
+
+//! Points of one frame, keyed by the (y, x) pillar coordinates, with their feature rows sorted. The order of the
+//! pillars and of the points in a pillar depends on the order of the device atomics, so they are compared as sets.
+using Frame = std::map<std::pair<uint32_t, uint32_t>, std::vector<std::vector<float>>>;
+
+Frame getFrame(Voxels const& voxels, int32_t batch, int32_t featureNum)
+{
+    Frame frame;
+    for (uint32_t pillar = 0; pillar < voxels.params[batch]; ++pillar)
+    {
+        size_t const pillarIdx = static_cast<size_t>(batch) * kMAX_PILLARS + pillar;
+        auto& rows = frame[{voxels.coords[pillarIdx * 4 + 2], voxels.coords[pillarIdx * 4 + 3]}];
+        for (int32_t point = 0; point < kMAX_POINTS_PER_PILLAR; ++point)
+        {
+            auto const row = voxels.features.begin() + (pillarIdx * kMAX_POINTS_PER_PILLAR + point) * featureNum;
+            // Padding rows are zero. The point values are not, since w is positive.
+            if (std::any_of(row, row + featureNum, [](float v) { return v != 0.F; }))
+            {
+                rows.emplace_back(row, row + featureNum);
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+    }
+    return frame;
+}
+
+void compare(Voxels const& actual, Voxels const& expected, int32_t featureNum)
+{
+    if (!TEST_EXPECT(std::equal(actual.params.begin(), actual.params.end(), expected.params.begin())))
+    {
+        return;
+    }
+    for (int32_t b = 0; b < kBATCH; ++b)
+    {
+        TEST_EXPECT(expected.params[b] > 0);
+        Frame const actualFrame = getFrame(actual, b, featureNum);
+        Frame const expectedFrame = getFrame(expected, b, featureNum);
+        if (!TEST_EXPECT(actualFrame.size() == expectedFrame.size()))
+        {
+            continue;
+        }
+        for (auto const& pillar : expectedFrame)
+        {
+            auto const found = actualFrame.find(pillar.first);
+            if (!TEST_EXPECT(found != actualFrame.end() && found->second.size() == pillar.second.size()))
+            {
+                continue;
+            }
+            for (size_t i = 0; i < pillar.second.size(); ++i)
+            {
+                TEST_EXPECT_NEAR(found->second[i].data(), pillar.second[i].data(), featureNum, 1e-4);
+            }
+        }
+    }
+}
+
+//! Random points, a few of them outside the range, with positive intensities and timestamps.
+std::vector<float> makePoints(int32_t pointFeatureNum)
+{
+    size_t const nbPoints = static_cast<size_t>(kBATCH) * kMAX_NUM_POINTS;
+    auto const xy = pluginTest::uniformValues(nbPoints * 2, -0.5F, 16.5F, 1);
+    auto const z = pluginTest::uniformValues(nbPoints, -1.9F, 1.9F, 2);
+    auto const extra = pluginTest::uniformValues(nbPoints * 2, 0.1F, 1.F, 3);
+    std::vector<float> points;
+    for (size_t i = 0; i < nbPoints; ++i)
+    {
+        points.insert(points.end(), {xy[2 * i], xy[2 * i + 1], z[i], extra[2 * i]});
+        if (pointFeatureNum == 5)
+        {
+            points.push_back(extra[2 * i + 1]);
+        }
+    }
+    return points;
+}
+
+bool runPlugin(bool sparse, int32_t pointFeatureNum, int32_t featureNum, std::vector<float> const& points,
+    Voxels& out)
+{
+    VoxelGeneratorPlugin plugin(kMAX_PILLARS, kMAX_POINTS_PER_PILLAR, featureNum, kRANGE[0], kRANGE[3], kRANGE[1],
+        kRANGE[4], kRANGE[2], kRANGE[5], kPILLAR_SIZE[0], kPILLAR_SIZE[1], kPILLAR_SIZE[2], sparse);
+
+    DynamicPluginTensorDesc in[2]{};
+    DynamicPluginTensorDesc outputs[3]{};
+    in[0].desc.dims = Dims3{kBATCH, kMAX_NUM_POINTS, pointFeatureNum};
+    in[0].desc.type = DataType::kFLOAT;
+    in[1].desc.dims = Dims{1, {kBATCH}};
+    in[1].desc.type = DataType::kINT32;
+    plugin.configurePlugin(in, 2, outputs, 3);
+    PluginTensorDesc const inputDesc[2]{in[0].desc, in[1].desc};
+    PluginTensorDesc outputDesc[3]{};
+
+    size_t const featuresSize = static_cast<size_t>(kBATCH) * kMAX_PILLARS * kMAX_POINTS_PER_PILLAR * featureNum;
+    size_t const coordsSize = static_cast<size_t>(kBATCH) * kMAX_PILLARS * 4;
+    auto pointsInput = pluginTest::toDevice(points);
+    auto pointsSizeInput = pluginTest::toDevice(std::vector<uint32_t>(kPOINTS_SIZE, kPOINTS_SIZE + kBATCH));
+    DeviceBuffer features(featuresSize * sizeof(float));
+    DeviceBuffer coords(coordsSize * sizeof(uint32_t));
+    DeviceBuffer params(kBATCH * sizeof(uint32_t));
+    DeviceBuffer workspace(plugin.getWorkspaceSize(inputDesc, 2, outputDesc, 3));
+    if (!TEST_EXPECT(pointsInput.get() && pointsSizeInput.get() && features.get() && coords.get() && params.get()
+            && workspace.get()))
+    {
+        return false;
+    }
+
+    void const* inputs[2]{pointsInput.get(), pointsSizeInput.get()};
+    void* outputBuffers[3]{features.get(), coords.get(), params.get()};
+    if (!TEST_EXPECT(plugin.enqueue(inputDesc, outputDesc, inputs, outputBuffers, workspace.get(), nullptr) == 0)
+        || !TEST_EXPECT_CUDA(cudaDeviceSynchronize()))
+    {
+        return false;
+    }
+    out.features = pluginTest::toHost<float>(features, featuresSize);
+    out.coords = pluginTest::toHost<uint32_t>(coords, coordsSize);
+    out.params = pluginTest::toHost<uint32_t>(params, kBATCH);
+    return true;
+}
+
+void testCase(int32_t pointFeatureNum)
+{
+    sample::gLogInfo << pointFeatureNum << " values per point" << std::endl;
+    // The point values, then the offsets to the pillar mean and to the pillar center.
+    int32_t const featureNum = pointFeatureNum + 6;
+    auto const points = makePoints(pointFeatureNum);
+
+    Voxels expected;
+    expected.features.resize(static_cast<size_t>(kBATCH) * kMAX_PILLARS * kMAX_POINTS_PER_PILLAR * featureNum);
+    expected.coords.resize(static_cast<size_t>(kBATCH) * kMAX_PILLARS * 4);
+    expected.params.resize(kBATCH);
+    int32_t const status = generateVoxelsHost(kBATCH, kMAX_NUM_POINTS, points.data(), kPOINTS_SIZE, kRANGE[0],
+        kRANGE[3], kRANGE[1], kRANGE[4], kRANGE[2], kRANGE[5], kPILLAR_SIZE[0], kPILLAR_SIZE[1], kPILLAR_SIZE[2], 32,
+        32, pointFeatureNum, kMAX_PILLARS, kMAX_POINTS_PER_PILLAR, featureNum, expected.features.data(),
+        expected.coords.data(), expected.params.data());
+    if (!TEST_EXPECT(status == 0))
+    {
+        return;
+    }
+
+    for (bool const sparse : {false, true})
+    {
+        sample::gLogInfo << (sparse ? "Sparse" : "Dense") << " voxelization" << std::endl;
+        Voxels actual;
+        if (runPlugin(sparse, pointFeatureNum, featureNum, points, actual))
+        {
+            compare(actual, expected, featureNum);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    testCase(4);
+    testCase(5);
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testWorkspacePlanner.cpp
+//! Checks the slot assignment of WorkspacePlanner, and that a plan reused through reset() matches a new one.
+//!
+
+#include <string>
+
+#include "common/workspacePlanner.h"
+#include "logger.h"
+#include "testUtils.h"
+
+using namespace nvinfer1::plugin;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_workspace_planner";
+
+//! Buffers with disjoint lifetimes share a slot sized for the largest of them, and overlapping ones do not.
+void testAliasing(WorkspacePlanner& planner)
+{
+    planner.reset();
+    int32_t const a = planner.addBuffer(1000, 0, 1);
+    int32_t const b = planner.addBuffer(300, 1, 3);
+    int32_t const c = planner.addBuffer(2000, 2, 2);
+    int32_t const d = planner.addBuffer(10, 3, 3);
+
+    // c reuses the slot of a, and d the slot of a and c, which are both dead at step 3.
+    TEST_EXPECT(planner.getOffset(a) == 0);
+    TEST_EXPECT(planner.getOffset(c) == 0);
+    TEST_EXPECT(planner.getOffset(d) == 0);
+    TEST_EXPECT(planner.getOffset(b) == 2048);
+    TEST_EXPECT(planner.getTotalSize() == 2048 + 512);
+    TEST_EXPECT(planner.getUnaliasedSize() == 1024 + 512 + 2048 + 256);
+}
+
+//! The slots depend only on the lifetimes, so smaller buffers never move a buffer to a later offset.
+void testShrinking(WorkspacePlanner& planner)
+{
+    size_t offsets[2][3];
+    size_t totals[2];
+    size_t const sizes[2][3]{{4096, 4096, 512}, {256, 4096, 256}};
+    for (int32_t i = 0; i < 2; ++i)
+    {
+        planner.reset();
+        int32_t const x = planner.addBuffer(sizes[i][0], 0, 0);
+        int32_t const y = planner.addBuffer(sizes[i][1], 0, 1);
+        int32_t const z = planner.addBuffer(sizes[i][2], 1, 1);
+        offsets[i][0] = planner.getOffset(x);
+        offsets[i][1] = planner.getOffset(y);
+        offsets[i][2] = planner.getOffset(z);
+        totals[i] = planner.getTotalSize();
+    }
+    for (int32_t id = 0; id < 3; ++id)
+    {
+        TEST_EXPECT(offsets[1][id] <= offsets[0][id]);
+        TEST_EXPECT(offsets[1][id] + sizes[1][id] <= totals[0]);
+    }
+    TEST_EXPECT(totals[1] <= totals[0]);
+}
+
+//! A planner reused through reset() lays out the same buffers like a new one.
+void testReset(WorkspacePlanner& planner)
+{
+    WorkspacePlanner fresh;
+    planner.reset();
+    for (int32_t i = 0; i < 6; ++i)
+    {
+        int32_t const first = i % 3;
+        int32_t const id = planner.addBuffer(100 * (i + 1), first, first + i % 2);
+        TEST_EXPECT(fresh.addBuffer(100 * (i + 1), first, first + i % 2) == id);
+        TEST_EXPECT(planner.getOffset(id) == fresh.getOffset(id));
+    }
+    TEST_EXPECT(planner.getTotalSize() == fresh.getTotalSize());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    // One planner for all cases, so that each of them starts from a planner holding an earlier plan.
+    WorkspacePlanner planner;
+    testAliasing(planner);
+    testShrinking(planner);
+    testReset(planner);
+    testAliasing(planner);
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -17,6 +17,7 @@
 
 #include "voxelGenerator.h"
 #include "common/templates.h"
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <iostream>
@@ -34,7 +35,22 @@ namespace
 {
 char const* const kVOXEL_GENERATOR_PLUGIN_VERSION{"1"};
 char const* const kVOXEL_GENERATOR_PLUGIN_NAME{"VoxelGeneratorPlugin"};
-size_t constexpr kSERIALIZATION_SIZE{9 * sizeof(float) + 7 * sizeof(int32_t)};
+// Engines serialized before the sparse_voxelization attribute was added end after the grid sizes.
+size_t constexpr kDENSE_SERIALIZATION_SIZE{9 * sizeof(float) + 7 * sizeof(int32_t)};
+size_t constexpr kSERIALIZATION_SIZE{kDENSE_SERIALIZATION_SIZE + sizeof(int32_t)};
+size_t constexpr kNB_DENSE_WORKSPACES{4};
+size_t constexpr kNB_SPARSE_WORKSPACES{5};
+
+// Smallest power of two that holds twice as many pillar hash slots as points, to keep the load factor at most 0.5.
+uint32_t getPillarHashCapacity(int32_t maxNumPoints)
+{
+    uint32_t capacity{1};
+    while (capacity < 2 * static_cast<uint32_t>(std::max(maxNumPoints, 1)))
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
 } // namespace
 
 // Static class fields initialization
@@ -54,7 +70,8 @@ int32_t npRound(float x)
 }
 
 VoxelGeneratorPlugin::VoxelGeneratorPlugin(int32_t maxVoxels, int32_t maxPoints, int32_t voxelFeatures, float xMin,
-    float xMax, float yMin, float yMax, float zMin, float zMax, float pillarX, float pillarY, float pillarZ)
+    float xMax, float yMin, float yMax, float zMin, float zMax, float pillarX, float pillarY, float pillarZ,
+    bool sparse)
     : mPillarNum(maxVoxels)
     , mPointNum(maxPoints)
     , mFeatureNum(voxelFeatures)
@@ -67,12 +84,13 @@ VoxelGeneratorPlugin::VoxelGeneratorPlugin(int32_t maxVoxels, int32_t maxPoints,
     , mPillarXSize(pillarX)
     , mPillarYSize(pillarY)
     , mPillarZSize(pillarZ)
+    , mSparse(sparse)
 {
 }
 
 VoxelGeneratorPlugin::VoxelGeneratorPlugin(int32_t maxVoxels, int32_t maxPoints, int32_t voxelFeatures, float xMin,
     float xMax, float yMin, float yMax, float zMin, float zMax, float pillarX, float pillarY, float pillarZ,
-    int32_t pointFeatures, int32_t gridX, int32_t gridY, int32_t gridZ)
+    int32_t pointFeatures, int32_t gridX, int32_t gridY, int32_t gridZ, bool sparse)
     : mPillarNum(maxVoxels)
     , mPointNum(maxPoints)
     , mFeatureNum(voxelFeatures)
@@ -89,6 +107,7 @@ VoxelGeneratorPlugin::VoxelGeneratorPlugin(int32_t maxVoxels, int32_t maxPoints,
     , mGridXSize(gridX)
     , mGridYSize(gridY)
     , mGridZSize(gridZ)
+    , mSparse(sparse)
 {
 }
 
@@ -113,6 +132,11 @@ VoxelGeneratorPlugin::VoxelGeneratorPlugin(void const* data, size_t length)
     mGridXSize = readFromBuffer<int32_t>(d);
     mGridYSize = readFromBuffer<int32_t>(d);
     mGridZSize = readFromBuffer<int32_t>(d);
+    mSparse = false;
+    if (length == kSERIALIZATION_SIZE)
+    {
+        mSparse = readFromBuffer<int32_t>(d) != 0;
+    }
     PLUGIN_ASSERT(d == a + length);
 }
 
@@ -122,7 +146,7 @@ nvinfer1::IPluginV2DynamicExt* VoxelGeneratorPlugin::clone() const noexcept
     {
         auto* plugin = new VoxelGeneratorPlugin(mPillarNum, mPointNum, mFeatureNum, mMinXRange, mMaxXRange, mMinYRange,
             mMaxYRange, mMinZRange, mMaxZRange, mPillarXSize, mPillarYSize, mPillarZSize, mPointFeatureNum, mGridXSize,
-            mGridYSize, mGridZSize);
+            mGridYSize, mGridZSize, mSparse);
         plugin->setPluginNamespace(mNamespace.c_str());
         return plugin;
     }
@@ -230,23 +254,49 @@ void VoxelGeneratorPlugin::configurePlugin(nvinfer1::DynamicPluginTensorDesc con
     }
 }
 
+bool VoxelGeneratorPlugin::useSparseVoxelization(int32_t maxNumPoints) const noexcept
+{
+    // Each point occupies at most one pillar, so the pillars can be indexed by a hash of the occupied ones
+    // whenever there are fewer points than pillars in the grid.
+    return mSparse && static_cast<int64_t>(maxNumPoints) < static_cast<int64_t>(mGridZSize) * mGridYSize * mGridXSize;
+}
+
+size_t VoxelGeneratorPlugin::getWorkspaceSizes(int32_t batchSize, int32_t maxNumPoints, size_t* workspaces) const
+    noexcept
+{
+    size_t const densePillarNum = static_cast<size_t>(mGridZSize) * mGridYSize * mGridXSize;
+    if (useSparseVoxelization(maxNumPoints))
+    {
+        size_t const sparsePillarNum = static_cast<size_t>(batchSize) * maxNumPoints;
+        // hash keys, pillar point counters, hash values, voxels, voxel point numbers
+        workspaces[0] = batchSize * getPillarHashCapacity(maxNumPoints) * sizeof(uint32_t);
+        workspaces[1] = sparsePillarNum * sizeof(uint32_t);
+        workspaces[2] = workspaces[0];
+        workspaces[3] = sparsePillarNum * mPointNum * mPointFeatureNum * sizeof(float);
+        workspaces[4] = workspaces[1];
+        return calculateTotalWorkspaceSize(workspaces, kNB_SPARSE_WORKSPACES);
+    }
+    size_t maskSize = batchSize * densePillarNum * sizeof(uint32_t);
+    size_t voxelsSize = batchSize * densePillarNum * mPointNum * mPointFeatureNum * sizeof(float);
+    // the actual max pillar num cannot be determined, use upper bound
+    size_t voxelFeaturesSize = voxelsSize;
+    size_t voxelNumPointsSize = maskSize;
+    workspaces[0] = maskSize;
+    workspaces[1] = voxelsSize;
+    workspaces[2] = voxelFeaturesSize;
+    workspaces[3] = voxelNumPointsSize;
+    return calculateTotalWorkspaceSize(workspaces, kNB_DENSE_WORKSPACES);
+}
+
 size_t VoxelGeneratorPlugin::getWorkspaceSize(nvinfer1::PluginTensorDesc const* inputs, int32_t nbInputs,
     nvinfer1::PluginTensorDesc const* outputs, int32_t nbOutputs) const noexcept
 {
     try
     {
         int32_t batchSize = inputs[0].dims.d[0];
-        size_t maskSize = batchSize * mGridZSize * mGridYSize * mGridXSize * sizeof(uint32_t);
-        size_t voxelsSize = batchSize * mGridZSize * mGridYSize * mGridXSize * mPointNum * mPointFeatureNum * sizeof(float);
-        // the actual max pillar num cannot be determined, use upper bound
-        size_t voxelFeaturesSize = voxelsSize;
-        size_t voxelNumPointsSize = maskSize;
-        size_t workspaces[4];
-        workspaces[0] = maskSize;
-        workspaces[1] = voxelsSize;
-        workspaces[2] = voxelFeaturesSize;
-        workspaces[3] = voxelNumPointsSize;
-        return calculateTotalWorkspaceSize(workspaces, 4);
+        int32_t maxNumPoints = inputs[0].dims.d[1];
+        size_t workspaces[std::max(kNB_DENSE_WORKSPACES, kNB_SPARSE_WORKSPACES)];
+        return getWorkspaceSizes(batchSize, maxNumPoints, workspaces);
     }
     catch (std::exception const& e)
     {
@@ -270,31 +320,50 @@ int32_t VoxelGeneratorPlugin::enqueue(nvinfer1::PluginTensorDesc const* inputDes
         float* pillarFeaturesData = static_cast<float*>(outputs[0]);
         uint32_t* coordsData = static_cast<uint32_t*>(outputs[1]);
         uint32_t* paramsData = static_cast<uint32_t*>(outputs[2]);
-        int32_t densePillarNum = mGridZSize * mGridYSize * mGridXSize;
-        size_t maskSize = batchSize * densePillarNum * sizeof(uint32_t);
-        size_t voxelsSize = batchSize * densePillarNum * mPointNum * mPointFeatureNum * sizeof(float);
-        size_t voxelFeaturesSize = voxelsSize;
-        size_t voxelNumPointsSize = maskSize;
-        size_t workspaces[4];
-        workspaces[0] = maskSize;
-        workspaces[1] = voxelsSize;
-        workspaces[2] = voxelFeaturesSize;
-        workspaces[3] = voxelNumPointsSize;
-        size_t totalWorkspace = calculateTotalWorkspaceSize(workspaces, 4);
-        uint32_t* mask = static_cast<uint32_t*>(workspace);
-        float* voxels = reinterpret_cast<float*>(nextWorkspacePtr(reinterpret_cast<int8_t*>(mask), maskSize));
-        float* voxelFeatures
-            = reinterpret_cast<float*>(nextWorkspacePtr(reinterpret_cast<int8_t*>(voxels), voxelsSize));
-        uint32_t* voxelNumPoints = reinterpret_cast<uint32_t*>(
-            nextWorkspacePtr(reinterpret_cast<int8_t*>(voxelFeatures), voxelFeaturesSize));
-        // Initialize workspace memory
-        PLUGIN_CUASSERT(cudaMemsetAsync(mask, 0, totalWorkspace, stream));
         uint32_t pillarFeaturesDataSize = batchSize * mPillarNum * mPointNum * mFeatureNum * sizeof(float);
         uint32_t coordsDataSize = batchSize * mPillarNum * 4 * sizeof(uint32_t);
         uint32_t paramsDataSize = batchSize * sizeof(uint32_t);
         PLUGIN_CUASSERT(cudaMemsetAsync(pillarFeaturesData, 0, pillarFeaturesDataSize, stream));
         PLUGIN_CUASSERT(cudaMemsetAsync(coordsData, 0, coordsDataSize, stream));
         PLUGIN_CUASSERT(cudaMemsetAsync(paramsData, 0, paramsDataSize, stream));
+        size_t workspaces[std::max(kNB_DENSE_WORKSPACES, kNB_SPARSE_WORKSPACES)];
+        getWorkspaceSizes(batchSize, maxNumPoints, workspaces);
+
+        if (useSparseVoxelization(maxNumPoints))
+        {
+            uint32_t* hashKeys = static_cast<uint32_t*>(workspace);
+            uint32_t* pillarPoints
+                = reinterpret_cast<uint32_t*>(nextWorkspacePtr(reinterpret_cast<int8_t*>(hashKeys), workspaces[0]));
+            uint32_t* hashValues = reinterpret_cast<uint32_t*>(
+                nextWorkspacePtr(reinterpret_cast<int8_t*>(pillarPoints), workspaces[1]));
+            float* voxels
+                = reinterpret_cast<float*>(nextWorkspacePtr(reinterpret_cast<int8_t*>(hashValues), workspaces[2]));
+            uint32_t* voxelNumPoints
+                = reinterpret_cast<uint32_t*>(nextWorkspacePtr(reinterpret_cast<int8_t*>(voxels), workspaces[3]));
+            // Only the hash keys and the point counters need to be cleared, the other buffers are fully written
+            // for the occupied pillars.
+            PLUGIN_CUASSERT(cudaMemsetAsync(hashKeys, 0, calculateTotalWorkspaceSize(workspaces, 2), stream));
+            // pointcloud + pointNum ---> coords_data + params_data + voxels + voxel_num_points
+            generateSparseVoxels_launch(batchSize, maxNumPoints, pointCloud, pointNumPtr, mMinXRange, mMaxXRange,
+                mMinYRange, mMaxYRange, mMinZRange, mMaxZRange, mPillarXSize, mPillarYSize, mGridXSize,
+                mPointFeatureNum, mPointNum, getPillarHashCapacity(maxNumPoints), hashKeys, hashValues, paramsData,
+                mPillarNum, coordsData, maxNumPoints, pillarPoints, voxels, voxelNumPoints, stream);
+            generateFeatures_launch(batchSize, maxNumPoints, voxels, voxelNumPoints, coordsData, paramsData,
+                mPillarXSize, mPillarYSize, mPillarZSize, mMinXRange, mMinYRange, mMinZRange, mFeatureNum, mPointNum,
+                mPillarNum, mPointFeatureNum, pillarFeaturesData, stream);
+            return 0;
+        }
+
+        int32_t densePillarNum = mGridZSize * mGridYSize * mGridXSize;
+        size_t totalWorkspace = calculateTotalWorkspaceSize(workspaces, kNB_DENSE_WORKSPACES);
+        uint32_t* mask = static_cast<uint32_t*>(workspace);
+        float* voxels = reinterpret_cast<float*>(nextWorkspacePtr(reinterpret_cast<int8_t*>(mask), workspaces[0]));
+        float* voxelFeatures
+            = reinterpret_cast<float*>(nextWorkspacePtr(reinterpret_cast<int8_t*>(voxels), workspaces[1]));
+        uint32_t* voxelNumPoints = reinterpret_cast<uint32_t*>(
+            nextWorkspacePtr(reinterpret_cast<int8_t*>(voxelFeatures), workspaces[2]));
+        // Initialize workspace memory
+        PLUGIN_CUASSERT(cudaMemsetAsync(mask, 0, totalWorkspace, stream));
         // pointcloud + pointNum ---> mask_ + voxel_
         generateVoxels_launch(batchSize, maxNumPoints, pointCloud, pointNumPtr, mMinXRange, mMaxXRange, mMinYRange,
             mMaxYRange, mMinZRange, mMaxZRange, mPillarXSize, mPillarYSize, mPillarZSize, mGridYSize, mGridXSize,
@@ -383,6 +452,7 @@ void VoxelGeneratorPlugin::serialize(void* buffer) const noexcept
     writeToBuffer<int32_t>(d, mGridXSize);
     writeToBuffer<int32_t>(d, mGridYSize);
     writeToBuffer<int32_t>(d, mGridZSize);
+    writeToBuffer<int32_t>(d, mSparse ? 1 : 0);
     PLUGIN_ASSERT(d == a + getSerializationSize());
 }
 
@@ -417,6 +487,7 @@ VoxelGeneratorPluginCreator::VoxelGeneratorPluginCreator()
     mPluginAttributes.emplace_back(PluginField("point_cloud_range", nullptr, PluginFieldType::kFLOAT32, 1));
     mPluginAttributes.emplace_back(PluginField("voxel_feature_num", nullptr, PluginFieldType::kINT32, 1));
     mPluginAttributes.emplace_back(PluginField("voxel_size", nullptr, PluginFieldType::kFLOAT32, 1));
+    mPluginAttributes.emplace_back(PluginField("sparse_voxelization", nullptr, PluginFieldType::kINT32, 1));
     mFC.nbFields = mPluginAttributes.size();
     mFC.fields = mPluginAttributes.data();
 }
@@ -448,6 +519,7 @@ IPluginV2* VoxelGeneratorPluginCreator::createPlugin(char const* name, PluginFie
         float pointCloudRange[6]{};
         int32_t voxelFeatureNum = 0;
         float voxelSize[3]{};
+        int32_t sparse = 0;
         for (int32_t i = 0; i < nbFields; ++i)
         {
             char const* attrName = fields[i].name;
@@ -483,10 +555,15 @@ IPluginV2* VoxelGeneratorPluginCreator::createPlugin(char const* name, PluginFie
                 voxelSize[1] = d[1];
                 voxelSize[2] = d[2];
             }
+            else if (!strcmp(attrName, "sparse_voxelization"))
+            {
+                int32_t const* d = static_cast<int32_t const*>(fields[i].data);
+                sparse = d[0];
+            }
         }
         IPluginV2* plugin = new VoxelGeneratorPlugin(maxVoxels, maxPoints, voxelFeatureNum, pointCloudRange[0],
             pointCloudRange[3], pointCloudRange[1], pointCloudRange[4], pointCloudRange[2], pointCloudRange[5],
-            voxelSize[0], voxelSize[1], voxelSize[2]);
+            voxelSize[0], voxelSize[1], voxelSize[2], sparse != 0);
         return plugin;
     }
     catch (std::exception const& e)
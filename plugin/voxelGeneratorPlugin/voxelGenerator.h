@@ -36,10 +36,10 @@ class VoxelGeneratorPlugin : public nvinfer1::IPluginV2DynamicExt
 public:
     VoxelGeneratorPlugin() = delete;
     VoxelGeneratorPlugin(int32_t maxVoxels, int32_t maxPoints, int32_t voxelFeatures, float xMin, float xMax, float yMin,
-        float yMax, float zMin, float zMax, float pillarX, float pillarY, float pillarZ);
+        float yMax, float zMin, float zMax, float pillarX, float pillarY, float pillarZ, bool sparse);
     VoxelGeneratorPlugin(int32_t maxVoxels, int32_t maxPoints, int32_t voxelFeatures, float xMin, float xMax, float yMin,
         float yMax, float zMin, float zMax, float pillarX, float pillarY, float pillarZ, int32_t pointFeatures,
-        int32_t gridX, int32_t gridY, int32_t gridZ);
+        int32_t gridX, int32_t gridY, int32_t gridZ, bool sparse);
     VoxelGeneratorPlugin(void const* data, size_t length);
     // IPluginV2DynamicExt Methods
     nvinfer1::IPluginV2DynamicExt* clone() const noexcept override;
@@ -69,6 +69,12 @@ public:
     char const* getPluginNamespace() const noexcept override;
 
 private:
+    // Whether the pillars are indexed by a hash of the occupied ones instead of a dense grid: when the
+    // sparse_voxelization attribute is set and the frames have fewer points than the grid has pillars.
+    bool useSparseVoxelization(int32_t maxNumPoints) const noexcept;
+    // Fills the sizes of the workspace buffers of the selected voxelization mode and returns the total size.
+    size_t getWorkspaceSizes(int32_t batchSize, int32_t maxNumPoints, size_t* workspaces) const noexcept;
+
     std::string mNamespace;
     // Shape Num for *input*
     int32_t mPillarNum;
@@ -88,8 +94,19 @@ private:
     int32_t mGridXSize;
     int32_t mGridYSize;
     int32_t mGridZSize;
+    bool mSparse;
 };
 
+// Host reference of the voxel generator, for CPU fallback and validation. Produces the same outputs as
+// VoxelGeneratorPlugin::enqueue, with pillars ordered by first occurrence in the point cloud and points in input order.
+// For 5 point values, the features are x, y, z, w, t, the offsets to the pillar mean and the offsets to the pillar
+// center, in that order. Returns 0 on success.
+int32_t generateVoxelsHost(int32_t batchSize, int32_t maxNumPoints, float const* points, uint32_t const* pointsSize,
+    float minXRange, float maxXRange, float minYRange, float maxYRange, float minZRange, float maxZRange,
+    float pillarXSize, float pillarYSize, float pillarZSize, int32_t gridXSize, int32_t gridYSize,
+    int32_t pointFeatureNum, int32_t maxPillarNum, int32_t maxPointsPerPillar, int32_t featureNum, float* features,
+    uint32_t* coords, uint32_t* params);
+
 class VoxelGeneratorPluginCreator : public nvinfer1::IPluginCreator
 {
 public:
@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "voxelGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+namespace
+{
+// Number of features appended to the point values: offsets to the pillar mean and to the pillar center.
+int32_t constexpr kNB_DERIVED_FEATURES{6};
+
+// Open addressing hash table from pillar index to pillar id, as used by the sparse device voxelization.
+class PillarHashTable
+{
+public:
+    explicit PillarHashTable(int32_t maxNumPoints)
+    {
+        uint32_t capacity{1};
+        while (capacity < 2 * static_cast<uint32_t>(std::max(maxNumPoints, 1)))
+        {
+            capacity <<= 1;
+        }
+        mKeys.resize(capacity);
+        mValues.resize(capacity);
+    }
+
+    void clear()
+    {
+        std::fill(mKeys.begin(), mKeys.end(), 0U);
+    }
+
+    // Returns the id of the pillar, assigning nextId if the pillar is new.
+    uint32_t findOrInsert(uint32_t pillarIndex, uint32_t nextId, bool& inserted)
+    {
+        uint32_t const key = pillarIndex + 1;
+        uint32_t const mask = static_cast<uint32_t>(mKeys.size()) - 1;
+        uint32_t slot = (key * 2654435761U) & mask;
+        while (mKeys[slot] != 0U && mKeys[slot] != key)
+        {
+            slot = (slot + 1) & mask;
+        }
+        inserted = mKeys[slot] == 0U;
+        if (inserted)
+        {
+            mKeys[slot] = key;
+            mValues[slot] = nextId;
+        }
+        return mValues[slot];
+    }
+
+private:
+    std::vector<uint32_t> mKeys;
+    std::vector<uint32_t> mValues;
+};
+} // namespace
+
+int32_t generateVoxelsHost(int32_t batchSize, int32_t maxNumPoints, float const* points, uint32_t const* pointsSize,
+    float minXRange, float maxXRange, float minYRange, float maxYRange, float minZRange, float maxZRange,
+    float pillarXSize, float pillarYSize, float pillarZSize, int32_t gridXSize, int32_t gridYSize,
+    int32_t pointFeatureNum, int32_t maxPillarNum, int32_t maxPointsPerPillar, int32_t featureNum, float* features,
+    uint32_t* coords, uint32_t* params)
+{
+    if (batchSize < 1 || maxNumPoints < 0 || maxPillarNum < 1 || maxPointsPerPillar < 1 || pointFeatureNum < 3
+        || featureNum < 1 || gridXSize < 1 || gridYSize < 1)
+    {
+        return -1;
+    }
+
+    std::fill_n(features, static_cast<size_t>(batchSize) * maxPillarNum * maxPointsPerPillar * featureNum, 0.F);
+    std::fill_n(coords, static_cast<size_t>(batchSize) * maxPillarNum * 4, 0U);
+
+    PillarHashTable table(maxNumPoints);
+    // Indices of the points of each pillar, at most maxPointsPerPillar per pillar.
+    std::vector<std::vector<int32_t>> pillarPoints;
+    std::vector<float> pointFeatures(pointFeatureNum + kNB_DERIVED_FEATURES);
+    for (int32_t b = 0; b < batchSize; ++b)
+    {
+        table.clear();
+        pillarPoints.clear();
+        float const* framePoints = points + static_cast<size_t>(b) * maxNumPoints * pointFeatureNum;
+        int32_t const nbPoints = std::min(static_cast<int32_t>(pointsSize[b]), maxNumPoints);
+        for (int32_t p = 0; p < nbPoints; ++p)
+        {
+            float const* point = framePoints + static_cast<size_t>(p) * pointFeatureNum;
+            float const px = point[0];
+            float const py = point[1];
+            float const pz = point[2];
+            if (px < minXRange || px >= maxXRange || py < minYRange || py >= maxYRange || pz < minZRange
+                || pz >= maxZRange)
+            {
+                continue;
+            }
+            int32_t const voxelIdx = static_cast<int32_t>(std::floor((px - minXRange) / pillarXSize));
+            int32_t const voxelIdy = static_cast<int32_t>(std::floor((py - minYRange) / pillarYSize));
+            bool inserted{false};
+            uint32_t const pillarId = table.findOrInsert(
+                voxelIdy * gridXSize + voxelIdx, static_cast<uint32_t>(pillarPoints.size()), inserted);
+            if (inserted)
+            {
+                pillarPoints.emplace_back();
+                if (pillarId < static_cast<uint32_t>(maxPillarNum))
+                {
+                    uint32_t* coord = coords + (static_cast<size_t>(b) * maxPillarNum + pillarId) * 4;
+                    coord[2] = voxelIdy;
+                    coord[3] = voxelIdx;
+                }
+            }
+            if (static_cast<int32_t>(pillarPoints[pillarId].size()) < maxPointsPerPillar)
+            {
+                pillarPoints[pillarId].push_back(p);
+            }
+        }
+
+        int32_t const nbPillars = std::min(static_cast<int32_t>(pillarPoints.size()), maxPillarNum);
+        params[b] = nbPillars;
+        for (int32_t pillarId = 0; pillarId < nbPillars; ++pillarId)
+        {
+            auto const& pointIds = pillarPoints[pillarId];
+            float sum[3]{};
+            for (int32_t p : pointIds)
+            {
+                for (int32_t k = 0; k < 3; ++k)
+                {
+                    sum[k] += framePoints[static_cast<size_t>(p) * pointFeatureNum + k];
+                }
+            }
+            uint32_t const* coord = coords + (static_cast<size_t>(b) * maxPillarNum + pillarId) * 4;
+            float const center[3] = {pillarXSize / 2.0F + coord[3] * pillarXSize + minXRange,
+                pillarYSize / 2.0F + coord[2] * pillarYSize + minYRange,
+                pillarZSize / 2.0F + coord[1] * pillarZSize + minZRange};
+            float const nbValid = static_cast<float>(pointIds.size());
+            for (size_t i = 0; i < pointIds.size(); ++i)
+            {
+                float const* point = framePoints + static_cast<size_t>(pointIds[i]) * pointFeatureNum;
+                std::copy_n(point, pointFeatureNum, pointFeatures.begin());
+                for (int32_t k = 0; k < 3; ++k)
+                {
+                    pointFeatures[pointFeatureNum + k] = point[k] - sum[k] / nbValid;
+                    pointFeatures[pointFeatureNum + 3 + k] = point[k] - center[k];
+                }
+                float* out = features
+                    + ((static_cast<size_t>(b) * maxPillarNum + pillarId) * maxPointsPerPillar + i) * featureNum;
+                std::copy_n(pointFeatures.begin(),
+                    std::min(featureNum, static_cast<int32_t>(pointFeatures.size())), out);
+            }
+        }
+    }
+    return 0;
+}
+
+} // namespace plugin
+} // namespace nvinfer1
@@ -667,6 +667,15 @@ constexpr char const* execute_async_v3 = R"trtdoc(
     :arg stream_handle: The cuda stream on which the inference kernels will be enqueued.
 )trtdoc";
 
+constexpr char const* execute_async_v3_with_addresses = R"trtdoc(
+    Set the addresses of I/O tensors and asynchronously execute inference in a single call.
+
+    This is equivalent to calling :func:`set_tensor_address` for each tensor followed by :func:`execute_async_v3`, but every address is set and inference is enqueued with the GIL released. If any address is rejected, the addresses set by this call are restored to their previous values, inference is not enqueued, and a :class:`ValueError` is raised.
+
+    :arg addresses: Either a :class:`TensorBindingSet` created for the engine of this context, a :class:`dict` mapping tensor names to device addresses, or a :class:`list` with one address per I/O tensor in engine order (see :func:`ICudaEngine.get_tensor_name`). A :class:`TensorBindingSet` resolves tensor names once and is the cheapest to reuse across calls.
+    :arg stream_handle: The cuda stream on which the inference kernels will be enqueued.
+)trtdoc";
+
 constexpr char const* set_aux_streams = R"trtdoc(
     Set the auxiliary streams that TensorRT should launch kernels on in the next execute_async_v3() call.
 
@@ -683,6 +692,41 @@ constexpr char const* set_aux_streams = R"trtdoc(
 
 } // namespace IExecutionContextDoc
 
+namespace TensorBindingSetDoc
+{
+constexpr char const* descr = R"trtdoc(
+    A reusable set of I/O tensor addresses for :func:`IExecutionContext.execute_async_v3_with_addresses` .
+
+    Tensor names are resolved against the engine once, when the set is created. Addresses can then be updated by name or positionally and applied to any execution context of the same engine.
+
+    :ivar names: :class:`List[str]` The tensor names, in the order used by :func:`set_addresses` .
+)trtdoc";
+
+constexpr char const* init = R"trtdoc(
+    :arg engine: The :class:`ICudaEngine` whose I/O tensors are bound.
+    :arg names: The tensor names to bind. Defaults to all I/O tensors of the engine, in engine order.
+)trtdoc";
+
+constexpr char const* set_address = R"trtdoc(
+    Set the device address of a tensor. Raises a :class:`KeyError` if the tensor is not part of the set.
+
+    :arg name: The tensor name.
+    :arg memory: The device address of the tensor.
+)trtdoc";
+
+constexpr char const* get_address = R"trtdoc(
+    Get the device address of a tensor. Raises a :class:`KeyError` if the tensor is not part of the set.
+
+    :arg name: The tensor name.
+)trtdoc";
+
+constexpr char const* set_addresses = R"trtdoc(
+    Set the device addresses of all tensors at once.
+
+    :arg memory: One device address per tensor, in the order of :attr:`names` .
+)trtdoc";
+} // namespace TensorBindingSetDoc
+
 namespace ICudaEngineDoc
 {
 constexpr char const* descr = R"trtdoc(
@@ -1701,7 +1745,15 @@ constexpr char const* init = R"trtdoc(
 constexpr char const* deserialize_cuda_engine = R"trtdoc(
     Deserialize an :class:`ICudaEngine` from a stream.
 
-    :arg serialized_engine: The :class:`buffer` that holds the serialized :class:`ICudaEngine` .
+    :arg serialized_engine: The :class:`buffer` that holds the serialized :class:`ICudaEngine` . Any object supporting the buffer protocol is read in place, so an :class:`mmap.mmap` of a plan file is not copied.
+
+    :returns: The :class:`ICudaEngine`, or None if it could not be deserialized.
+)trtdoc";
+
+constexpr char const* deserialize_cuda_engine_from_file = R"trtdoc(
+    Deserialize an :class:`ICudaEngine` from a plan file. The file is memory-mapped read-only and never copied into a Python object; the GIL is released while the file is mapped and deserialized.
+
+    :arg path: The path to the serialized :class:`ICudaEngine` .
 
     :returns: The :class:`ICudaEngine`, or None if it could not be deserialized.
 )trtdoc";
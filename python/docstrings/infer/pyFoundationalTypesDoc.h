@@ -92,7 +92,8 @@ constexpr const char* init_type = R"trtdoc(
 
 // FIXME: Weird bug occurring here. Cannot provide :arg:
 constexpr const char* init_numpy = R"trtdoc(
-    :a: A numpy array whose values to use. No deep copies are made.
+    :a: A numpy array, or any object supporting the buffer protocol such as a float16 :class:`memoryview`, whose values to use. No deep copies are made of contiguous arrays, which this Weights object keeps alive.
+    :pack: If True, a non-contiguous array (e.g. a slice or a transpose) is packed into a contiguous buffer owned by this Weights object, in parallel and with the GIL released, and the array is not kept alive. Otherwise such arrays are rejected. Default: False
 )trtdoc";
 
 constexpr const char* numpy = R"trtdoc(
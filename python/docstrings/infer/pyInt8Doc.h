@@ -224,4 +224,30 @@ constexpr const char* get_algorithm = R"trtdoc(
 )trtdoc";
 } // namespace IInt8MinMaxCalibratorDoc
 
+namespace NativeCalibratorDoc
+{
+constexpr const char* descr = R"trtdoc(
+    A calibrator that reads calibration data from NumPy arrays instead of calling back into Python.
+
+    Batches are gathered into pinned host buffers on a background thread and copied to the device when TensorRT requests them, so calibration is not limited by the Python interpreter. The arrays are only accessed from Python when the calibrator is constructed, and must not be modified while it is alive.
+    ::
+
+        data = np.load("calibration.npy", mmap_mode="r")
+        calibrator = trt.NativeCalibrator({"input": [data]}, batch_size=8, logger=TRT_LOGGER, cache_file="calibration.cache")
+        config.int8_calibrator = calibrator
+
+    :ivar num_batches: :class:`int` The number of batches that will be provided to TensorRT.
+)trtdoc";
+
+constexpr const char* init = R"trtdoc(
+    :arg inputs: A :class:`dict` mapping each network input name to a C-contiguous array, or to a :class:`list` of C-contiguous arrays such as :class:`numpy.memmap` s. The first dimension of every array indexes samples, and the samples of an input's arrays are used in order. The arrays must already have the input's data type.
+    :arg batch_size: The number of samples in each calibration batch. Trailing samples that do not fill a batch are ignored. All inputs must provide the same number of batches, and at least one.
+    :arg logger: The :class:`ILogger` that reports errors raised while TensorRT requests batches, usually the logger of the builder.
+    :arg algorithm: The calibration algorithm. :class:`CalibrationAlgoType.LEGACY_CALIBRATION` is not supported.
+    :arg cache_file: Path of the calibration cache to read and write. No cache is used if empty.
+    :arg explicit_batch: Whether the network has explicit batch dimensions, in which case :func:`get_batch_size` returns 1 and the batch size must be part of the input shapes.
+    :arg prefetch: The number of batches staged ahead of TensorRT.
+)trtdoc";
+} // namespace NativeCalibratorDoc
+
 } // namespace tensorrt
@@ -25,9 +25,142 @@
 #include "infer/pyCoreDoc.h"
 #include <cuda_runtime_api.h>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace tensorrt
 {
 using namespace nvinfer1;
+
+// Sets the address of every named tensor. If the context rejects one, the addresses already set by this call are
+// restored to their previous values and the index of the rejected tensor is returned, otherwise -1.
+int32_t setTensorAddresses(
+    IExecutionContext& context, std::vector<char const*> const& names, std::vector<void*> const& addresses)
+{
+    std::vector<void*> previous(names.size());
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        previous[i] = const_cast<void*>(context.getTensorAddress(names[i]));
+    }
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        if (!context.setTensorAddress(names[i], addresses[i]))
+        {
+            for (size_t j = 0; j < i; ++j)
+            {
+                context.setTensorAddress(names[j], previous[j]);
+            }
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+// Tensor names resolved once against an engine, each paired with a device address. Applying the set to an execution
+// context does not touch any Python object, so it can run with the GIL released.
+class TensorBindingSet
+{
+public:
+    TensorBindingSet(ICudaEngine const& engine, std::vector<std::string> const& names)
+        : mEngine{&engine}
+    {
+        int32_t const nbIOTensors{engine.getNbIOTensors()};
+        if (names.empty())
+        {
+            for (int32_t i = 0; i < nbIOTensors; ++i)
+            {
+                mNames.push_back(engine.getIOTensorName(i));
+            }
+        }
+        for (auto const& name : names)
+        {
+            char const* resolved{nullptr};
+            for (int32_t i = 0; i < nbIOTensors && resolved == nullptr; ++i)
+            {
+                char const* ioName = engine.getIOTensorName(i);
+                resolved = name == ioName ? ioName : nullptr;
+            }
+            PY_ASSERT_VALUE_ERROR(resolved != nullptr, "The engine has no I/O tensor named " + name);
+            mNames.push_back(resolved);
+        }
+        mAddresses.resize(mNames.size(), nullptr);
+    }
+
+    void setAddress(std::string const& name, size_t memory)
+    {
+        mAddresses[getIndex(name)] = reinterpret_cast<void*>(memory);
+    }
+
+    size_t getAddress(std::string const& name) const
+    {
+        return reinterpret_cast<size_t>(mAddresses[getIndex(name)]);
+    }
+
+    void setAddresses(std::vector<size_t> const& memory)
+    {
+        PY_ASSERT_VALUE_ERROR(memory.size() == mAddresses.size(),
+            "Expected " + std::to_string(mAddresses.size()) + " addresses, got " + std::to_string(memory.size()));
+        for (size_t i = 0; i < memory.size(); ++i)
+        {
+            mAddresses[i] = reinterpret_cast<void*>(memory[i]);
+        }
+    }
+
+    std::vector<std::string> getNames() const
+    {
+        return std::vector<std::string>(mNames.begin(), mNames.end());
+    }
+
+    size_t size() const
+    {
+        return mNames.size();
+    }
+
+    ICudaEngine const& getEngine() const
+    {
+        return *mEngine;
+    }
+
+    //! Returns the index of the first rejected tensor, or -1, as setTensorAddresses does.
+    int32_t apply(IExecutionContext& context) const
+    {
+        return setTensorAddresses(context, mNames, mAddresses);
+    }
+
+    char const* getName(int32_t index) const
+    {
+        return mNames[index];
+    }
+
+private:
+    size_t getIndex(std::string const& name) const
+    {
+        for (size_t i = 0; i < mNames.size(); ++i)
+        {
+            if (name == mNames[i])
+            {
+                return i;
+            }
+        }
+        utils::throwPyError(PyExc_KeyError, name);
+        return 0;
+    }
+
+    ICudaEngine const* mEngine;
+    //! Owned by the engine, which the Python binding set keeps alive.
+    std::vector<char const*> mNames;
+    std::vector<void*> mAddresses;
+};
+
 // Long lambda functions should go here rather than being inlined into the bindings (1 liners are OK).
 namespace lambdas
 {
@@ -128,6 +261,86 @@ bool execute_async_v3(IExecutionContext& self, size_t streamHandle)
     return self.enqueueV3(reinterpret_cast<cudaStream_t>(streamHandle));
 }
 
+// The execute_async_v3_with_addresses overloads convert their arguments with the GIL held, then set every address and
+// enqueue with it released. If an address is rejected, the previous addresses are restored and nothing is enqueued.
+void throwRejectedAddress(char const* name)
+{
+    utils::throwPyError(
+        PyExc_ValueError, std::string{"The execution context rejected the address of tensor "} + name + ".");
+}
+
+bool execute_async_v3_with_binding_set(IExecutionContext& self, TensorBindingSet const& bindings, size_t streamHandle)
+{
+    PY_ASSERT_VALUE_ERROR(&bindings.getEngine() == &self.getEngine(),
+        "The binding set was created for a different engine than the one of this execution context.");
+    int32_t rejected{-1};
+    {
+        py::gil_scoped_release releaseGil{};
+        rejected = bindings.apply(self);
+        if (rejected < 0)
+        {
+            return self.enqueueV3(reinterpret_cast<cudaStream_t>(streamHandle));
+        }
+    }
+    throwRejectedAddress(bindings.getName(rejected));
+    return false;
+}
+
+bool execute_async_v3_with_address_list(
+    IExecutionContext& self, std::vector<size_t> const& addresses, size_t streamHandle)
+{
+    ICudaEngine const& engine = self.getEngine();
+    PY_ASSERT_VALUE_ERROR(static_cast<int32_t>(addresses.size()) == engine.getNbIOTensors(),
+        "Expected one address per I/O tensor of the engine (" + std::to_string(engine.getNbIOTensors()) + "), got "
+            + std::to_string(addresses.size()));
+    std::vector<char const*> names;
+    std::vector<void*> memory;
+    for (size_t i = 0; i < addresses.size(); ++i)
+    {
+        names.push_back(engine.getIOTensorName(static_cast<int32_t>(i)));
+        memory.push_back(reinterpret_cast<void*>(addresses[i]));
+    }
+    int32_t rejected{-1};
+    {
+        py::gil_scoped_release releaseGil{};
+        rejected = setTensorAddresses(self, names, memory);
+        if (rejected < 0)
+        {
+            return self.enqueueV3(reinterpret_cast<cudaStream_t>(streamHandle));
+        }
+    }
+    throwRejectedAddress(names[rejected]);
+    return false;
+}
+
+bool execute_async_v3_with_address_dict(IExecutionContext& self, py::dict const& addresses, size_t streamHandle)
+{
+    std::vector<std::string> nameStrings;
+    std::vector<void*> memory;
+    nameStrings.reserve(addresses.size());
+    for (auto const& item : addresses)
+    {
+        nameStrings.emplace_back(item.first.cast<std::string>());
+        memory.push_back(reinterpret_cast<void*>(item.second.cast<size_t>()));
+    }
+    std::vector<char const*> names;
+    for (auto const& name : nameStrings)
+    {
+        names.push_back(name.c_str());
+    }
+    int32_t rejected{-1};
+    {
+        py::gil_scoped_release releaseGil{};
+        rejected = setTensorAddresses(self, names, memory);
+        if (rejected < 0)
+        {
+            return self.enqueueV3(reinterpret_cast<cudaStream_t>(streamHandle));
+        }
+    }
+    throwRejectedAddress(names[rejected]);
+    return false;
+}
+
 bool set_tensor_address(IExecutionContext& self, char const* tensor_name, size_t memory)
 {
     return self.setTensorAddress(tensor_name, reinterpret_cast<void*>(memory));
@@ -173,12 +386,117 @@ void set_aux_streams(IExecutionContext& self, std::vector<size_t> streamHandle)
     self.setAuxStreams(reinterpret_cast<cudaStream_t*>(streamHandle.data()), static_cast<int32_t>(streamHandle.size()));
 }
 
+// Read-only memory mapping of a whole file. Does not touch any Python object, so it may be used without the GIL.
+class MappedFile
+{
+public:
+    explicit MappedFile(std::string const& path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+        LARGE_INTEGER fileSize{};
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        {
+            mMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mMapping != nullptr)
+            {
+                mData = MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+                mSize = mData != nullptr ? static_cast<size_t>(fileSize.QuadPart) : 0;
+            }
+        }
+        CloseHandle(file);
+#else
+        int32_t const fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return;
+        }
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+        {
+            void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                mData = data;
+                mSize = static_cast<size_t>(fileStat.st_size);
+                // The plan is read front to back exactly once.
+                madvise(mData, mSize, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if (mData != nullptr)
+        {
+            UnmapViewOfFile(mData);
+        }
+        if (mMapping != nullptr)
+        {
+            CloseHandle(mMapping);
+        }
+#else
+        if (mData != nullptr)
+        {
+            munmap(mData, mSize);
+        }
+#endif
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    void const* data() const
+    {
+        return mData;
+    }
+
+    size_t size() const
+    {
+        return mSize;
+    }
+
+private:
+    void* mData{nullptr};
+    size_t mSize{0};
+#ifdef _WIN32
+    HANDLE mMapping{nullptr};
+#endif
+};
+
 // For IRuntime
 static const auto runtime_deserialize_cuda_engine = [](IRuntime& self, py::buffer& serializedEngine) {
+    // The buffer must be requested with the GIL held. Objects such as mmap.mmap expose their memory directly, so the
+    // plan is read in place without a copy.
     py::buffer_info info = serializedEngine.request();
+    py::gil_scoped_release releaseGil{};
     return self.deserializeCudaEngine(info.ptr, info.size * info.itemsize);
 };
 
+static const auto runtime_deserialize_cuda_engine_from_file = [](IRuntime& self, std::string const& path) {
+    ICudaEngine* engine{nullptr};
+    bool mapped{false};
+    {
+        py::gil_scoped_release releaseGil{};
+        MappedFile plan{path};
+        mapped = plan.data() != nullptr;
+        if (mapped)
+        {
+            engine = self.deserializeCudaEngine(plan.data(), plan.size());
+        }
+    }
+    PY_ASSERT_RUNTIME_ERROR(mapped, "Could not map engine file: " + path);
+    return engine;
+};
+
 // For ICudaEngine
 bool engine_binding_is_input(ICudaEngine& self, std::string const& name)
 {
@@ -814,6 +1132,17 @@ void bindCore(py::module& m)
         .def("clear", &IErrorRecorder::clear, IErrorRecorderDoc::clear)
         .def("report_error", &IErrorRecorder::reportError, IErrorRecorderDoc::report_error);
 
+    py::class_<TensorBindingSet>(m, "TensorBindingSet", TensorBindingSetDoc::descr, py::module_local())
+        .def(py::init<ICudaEngine const&, std::vector<std::string> const&>(), "engine"_a,
+            "names"_a = std::vector<std::string>{}, TensorBindingSetDoc::init, py::keep_alive<1, 2>{})
+        .def("set_address", &TensorBindingSet::setAddress, "name"_a, "memory"_a, TensorBindingSetDoc::set_address)
+        .def("get_address", &TensorBindingSet::getAddress, "name"_a, TensorBindingSetDoc::get_address)
+        .def("set_addresses", &TensorBindingSet::setAddresses, "memory"_a, TensorBindingSetDoc::set_addresses)
+        .def("__setitem__", &TensorBindingSet::setAddress)
+        .def("__getitem__", &TensorBindingSet::getAddress)
+        .def("__len__", &TensorBindingSet::size)
+        .def_property_readonly("names", &TensorBindingSet::getNames);
+
     py::class_<IExecutionContext>(m, "IExecutionContext", IExecutionContextDoc::descr, py::module_local())
         .def("execute", utils::deprecate(lambdas::execute, "execute_v2"), "batch_size"_a = 1, "bindings"_a,
             IExecutionContextDoc::execute, py::call_guard<py::gil_scoped_release>{})
@@ -870,6 +1199,12 @@ void bindCore(py::module& m)
             py::call_guard<py::gil_scoped_release>{})
         .def("execute_async_v3", lambdas::execute_async_v3, "stream_handle"_a, IExecutionContextDoc::execute_async_v3,
             py::call_guard<py::gil_scoped_release>{})
+        .def("execute_async_v3_with_addresses", lambdas::execute_async_v3_with_binding_set, "addresses"_a,
+            "stream_handle"_a, IExecutionContextDoc::execute_async_v3_with_addresses)
+        .def("execute_async_v3_with_addresses", lambdas::execute_async_v3_with_address_dict, "addresses"_a,
+            "stream_handle"_a)
+        .def("execute_async_v3_with_addresses", lambdas::execute_async_v3_with_address_list, "addresses"_a,
+            "stream_handle"_a)
         // End of enqueueV3 related APIs.
         .def_property_readonly("all_binding_shapes_specified", &IExecutionContext::allInputDimensionsSpecified)
         .def_property_readonly("all_shape_inputs_specified", &IExecutionContext::allInputShapesSpecified)
@@ -1222,7 +1557,9 @@ void bindCore(py::module& m)
     py::class_<IRuntime>(m, "Runtime", RuntimeDoc::descr, py::module_local())
         .def(py::init(&nvinfer1::createInferRuntime), "logger"_a, RuntimeDoc::init, py::keep_alive<1, 2>{})
         .def("deserialize_cuda_engine", lambdas::runtime_deserialize_cuda_engine, "serialized_engine"_a,
-            RuntimeDoc::deserialize_cuda_engine, py::call_guard<py::gil_scoped_release>{}, py::keep_alive<0, 1>{})
+            RuntimeDoc::deserialize_cuda_engine, py::keep_alive<0, 1>{})
+        .def("deserialize_cuda_engine_from_file", lambdas::runtime_deserialize_cuda_engine_from_file, "path"_a,
+            RuntimeDoc::deserialize_cuda_engine_from_file, py::keep_alive<0, 1>{})
         .def_property("DLA_core", &IRuntime::getDLACore, &IRuntime::setDLACore)
         .def_property_readonly("num_DLA_cores", &IRuntime::getNbDLACores)
         .def_property("gpu_allocator", nullptr, py::cpp_function(&IRuntime::setGpuAllocator, py::keep_alive<1, 2>{}))
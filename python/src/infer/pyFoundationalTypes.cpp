@@ -22,25 +22,153 @@
 #include <pybind11/stl.h>
 
 #include "infer/pyFoundationalTypesDoc.h"
+#include <algorithm>
+#include <cstring>
 #include <cuda_runtime_api.h>
+#include <memory>
+#include <thread>
 
 namespace tensorrt
 {
 using namespace nvinfer1;
 
+// Holder of the Python Weights class. Weights packed by the bindings own their values through the deleter, so the
+// buffer lives exactly as long as the Python object, which layers keep alive through their network.
+struct WeightsDeleter
+{
+    std::shared_ptr<uint8_t> values;
+
+    void operator()(Weights* weights) const
+    {
+        delete weights;
+    }
+};
+using WeightsHolder = std::unique_ptr<Weights, WeightsDeleter>;
+
+namespace
+{
+// Strided arrays smaller than this are packed on the calling thread.
+size_t constexpr kPACK_BYTES_PER_THREAD{1 << 20};
+
+// Copies a strided array into a C-contiguous buffer. Splits the rows (all dimensions but the last) across threads.
+// Does not touch any Python object, so it may be called without the GIL.
+void packStrided(uint8_t const* src, std::vector<py::ssize_t> const& shape, std::vector<py::ssize_t> const& strides,
+    size_t itemSize, uint8_t* dst)
+{
+    size_t const nbDims = shape.size();
+    size_t const rowLength = nbDims == 0 ? 1 : static_cast<size_t>(shape.back());
+    py::ssize_t const innerStride = nbDims == 0 ? static_cast<py::ssize_t>(itemSize) : strides.back();
+    size_t nbRows{1};
+    for (size_t d = 0; d + 1 < nbDims; ++d)
+    {
+        nbRows *= static_cast<size_t>(shape[d]);
+    }
+    size_t const rowBytes = rowLength * itemSize;
+    if (nbRows == 0 || rowBytes == 0)
+    {
+        return;
+    }
+
+    auto packRows = [&](size_t rowBegin, size_t rowEnd) {
+        // Multi-index of rowBegin over the outer dimensions, advanced like an odometer.
+        std::vector<py::ssize_t> index(nbDims > 0 ? nbDims - 1 : 0);
+        py::ssize_t offset{0};
+        size_t remainder = rowBegin;
+        for (size_t d = index.size(); d-- > 0;)
+        {
+            index[d] = static_cast<py::ssize_t>(remainder % static_cast<size_t>(shape[d]));
+            remainder /= static_cast<size_t>(shape[d]);
+            offset += index[d] * strides[d];
+        }
+        for (size_t row = rowBegin; row < rowEnd; ++row)
+        {
+            uint8_t const* srcRow = src + offset;
+            uint8_t* dstRow = dst + row * rowBytes;
+            if (innerStride == static_cast<py::ssize_t>(itemSize))
+            {
+                std::memcpy(dstRow, srcRow, rowBytes);
+            }
+            else
+            {
+                for (size_t i = 0; i < rowLength; ++i)
+                {
+                    std::memcpy(dstRow + i * itemSize, srcRow + static_cast<py::ssize_t>(i) * innerStride, itemSize);
+                }
+            }
+            for (size_t d = index.size(); d-- > 0;)
+            {
+                offset += strides[d];
+                if (++index[d] < shape[d])
+                {
+                    break;
+                }
+                offset -= index[d] * strides[d];
+                index[d] = 0;
+            }
+        }
+    };
+
+    size_t const maxThreads = std::max(1U, std::thread::hardware_concurrency());
+    size_t const nbThreads
+        = std::min({maxThreads, nbRows, std::max<size_t>(1, nbRows * rowBytes / kPACK_BYTES_PER_THREAD)});
+    std::vector<std::thread> workers;
+    size_t const rowsPerThread = (nbRows + nbThreads - 1) / nbThreads;
+    for (size_t t = 1; t < nbThreads; ++t)
+    {
+        size_t const rowBegin = t * rowsPerThread;
+        if (rowBegin < nbRows)
+        {
+            workers.emplace_back(packRows, rowBegin, std::min(nbRows, rowBegin + rowsPerThread));
+        }
+    }
+    packRows(0, std::min(nbRows, rowsPerThread));
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+} // namespace
+
 namespace lambdas
 {
 // For Weights
 static const auto weights_datatype_constructor = [](DataType const& type) { return new Weights{type, nullptr, 0}; };
 
-static const auto weights_numpy_constructor = [](py::array& arr) {
-    arr = py::array::ensure(arr);
-    // In order to construct a weights object, we must have a contiguous C-style array.
+static const auto weights_numpy_constructor = [](py::buffer& buffer, bool pack) {
+    // Any buffer, e.g. a memoryview of float16 values, is viewed as a NumPy array without copying it.
+    py::array arr = py::array::ensure(buffer);
     PY_ASSERT_VALUE_ERROR(arr,
         "Could not convert NumPy array to Weights. Is it using a data type supported by TensorRT?");
-    PY_ASSERT_VALUE_ERROR((arr.flags() & py::array::c_style),
-        "Could not convert non-contiguous NumPy array to Weights. Please use numpy.ascontiguousarray() to fix this.");
-    return new Weights{utils::type(arr.dtype()), arr.data(), arr.size()};
+    DataType const type = utils::type(arr.dtype());
+    if (arr.flags() & py::array::c_style)
+    {
+        return WeightsHolder{new Weights{type, arr.data(), arr.size()}};
+    }
+    PY_ASSERT_VALUE_ERROR(pack,
+        "Could not convert non-contiguous NumPy array to Weights. Please pass pack=True or use "
+        "numpy.ascontiguousarray() to fix this.");
+
+    size_t const itemSize = static_cast<size_t>(arr.itemsize());
+    std::vector<py::ssize_t> const shape(arr.shape(), arr.shape() + arr.ndim());
+    std::vector<py::ssize_t> const strides(arr.strides(), arr.strides() + arr.ndim());
+    std::shared_ptr<uint8_t> values{new uint8_t[std::max<size_t>(arr.nbytes(), 1)], std::default_delete<uint8_t[]>()};
+    {
+        py::gil_scoped_release releaseGil{};
+        packStrided(static_cast<uint8_t const*>(arr.data()), shape, strides, itemSize, values.get());
+    }
+    return WeightsHolder{new Weights{type, values.get(), arr.size()}, WeightsDeleter{values}};
+};
+
+// Weights(a, pack=False), written as a new-style constructor rather than with py::init so that the Weights keep the
+// buffer alive only when they view it. Packed Weights own a copy and must not pin the source array.
+static const auto weights_numpy_init = [](py::detail::value_and_holder& self, py::buffer& buffer, bool pack) {
+    WeightsHolder weights = weights_numpy_constructor(buffer, pack);
+    bool const viewsBuffer = weights.get_deleter().values == nullptr;
+    py::detail::initimpl::construct<py::class_<Weights, WeightsHolder>>(self, std::move(weights), false);
+    if (viewsBuffer)
+    {
+        py::detail::keep_alive_impl(reinterpret_cast<PyObject*>(self.inst), buffer);
+    }
 };
 
 // Helper to compare dims with any kind of Python Iterable.
@@ -199,12 +327,14 @@ void bindFoundationalTypes(py::module& m)
         .value("ANY", WeightsRole::kANY, WeightsRoleDoc::ANY); // WeightsRole
 
     // Weights
-    py::class_<Weights>(m, "Weights", WeightsDoc::descr, py::module_local())
+    py::class_<Weights, WeightsHolder>(m, "Weights", WeightsDoc::descr, py::module_local())
         // Can construct an empty weights object with type. Defaults to float32.
         .def(py::init(lambdas::weights_datatype_constructor), "type"_a = DataType::kFLOAT, WeightsDoc::init_type)
-        // Allows for construction through any contiguous numpy array. It then keeps a pointer to that buffer
-        // (zero-copy).
-        .def(py::init(lambdas::weights_numpy_constructor), "a"_a, py::keep_alive<1, 2>(), WeightsDoc::init_numpy)
+        // Allows for construction through any contiguous numpy array or buffer. It then keeps a pointer to that buffer
+        // (zero-copy) and keeps the buffer alive. Non-contiguous arrays are packed into a buffer owned by the Weights
+        // if pack is set.
+        .def("__init__", lambdas::weights_numpy_init, py::detail::is_new_style_constructor(), "a"_a,
+            "pack"_a = false, WeightsDoc::init_numpy)
         // Expose numpy-like attributes.
         .def_property_readonly("dtype", [](Weights const& self) -> DataType { return self.type; })
         .def_property_readonly("size", [](Weights const& self) { return self.count; })
@@ -21,6 +21,17 @@
 #include "utils.h"
 #include <pybind11/stl.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <cuda_runtime_api.h>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 using namespace nvinfer1;
 
 namespace tensorrt
@@ -248,6 +259,306 @@ public:
     }
 };
 
+// Calibrator fed from NumPy arrays. Batches are gathered into pinned buffers on a worker thread and copied to the
+// device in getBatch(), so Python is only touched when the calibrator is created and destroyed. Errors raised while
+// TensorRT requests batches are reported through the logger of the builder.
+class NativeCalibrator : public IInt8Calibrator
+{
+public:
+    NativeCalibrator(py::dict const& inputs, int32_t batchSize, ILogger& logger, CalibrationAlgoType algorithm,
+        std::string const& cacheFile, bool explicitBatch, int32_t prefetch)
+        : mLogger{logger}
+        , mBatchSize{batchSize}
+        , mAlgorithm{algorithm}
+        , mCacheFile{cacheFile}
+        , mExplicitBatch{explicitBatch}
+        , mNbSlots{prefetch}
+    {
+        PY_ASSERT_VALUE_ERROR(batchSize > 0, "batch_size must be positive");
+        PY_ASSERT_VALUE_ERROR(prefetch > 0, "prefetch must be positive");
+        PY_ASSERT_VALUE_ERROR(algorithm != CalibrationAlgoType::kLEGACY_CALIBRATION,
+            "NativeCalibrator does not support LEGACY_CALIBRATION");
+        PY_ASSERT_VALUE_ERROR(inputs.size() > 0, "inputs must name at least one network input");
+
+        for (auto const& item : inputs)
+        {
+            Input input{};
+            input.name = item.first.cast<std::string>();
+            py::handle arrays = item.second;
+            if (py::isinstance<py::list>(arrays) || py::isinstance<py::tuple>(arrays))
+            {
+                for (py::handle array : arrays)
+                {
+                    addArray(input, array);
+                }
+            }
+            else
+            {
+                addArray(input, arrays);
+            }
+            PY_ASSERT_VALUE_ERROR(input.nbSamples > 0, "No calibration samples for input " + input.name);
+
+            int64_t const nbBatches = input.nbSamples / mBatchSize;
+            PY_ASSERT_VALUE_ERROR(nbBatches > 0, "Input " + input.name + " has fewer samples than batch_size");
+            PY_ASSERT_VALUE_ERROR(mInputs.empty() || nbBatches == mNbBatches,
+                "All inputs must provide the same number of calibration batches");
+            mNbBatches = nbBatches;
+            mInputIndices[input.name] = mInputs.size();
+            mInputs.emplace_back(std::move(input));
+        }
+
+        cudaStream_t stream{nullptr};
+        PY_ASSERT_RUNTIME_ERROR(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking) == cudaSuccess,
+            "Failed to create a CUDA stream for calibration");
+        mStream.reset(stream);
+        for (auto& input : mInputs)
+        {
+            size_t const batchBytes = input.sampleBytes * mBatchSize;
+            void* device{nullptr};
+            PY_ASSERT_RUNTIME_ERROR(cudaMalloc(&device, batchBytes) == cudaSuccess,
+                "Failed to allocate device memory for calibration input " + input.name);
+            input.device.reset(device);
+            for (int32_t slot = 0; slot < mNbSlots; ++slot)
+            {
+                void* staging{nullptr};
+                PY_ASSERT_RUNTIME_ERROR(cudaMallocHost(&staging, batchBytes) == cudaSuccess,
+                    "Failed to allocate pinned memory for calibration input " + input.name);
+                input.staging.emplace_back(staging, &cudaFreeHost);
+            }
+        }
+
+        mWorker = std::thread(&NativeCalibrator::stage, this);
+    }
+
+    ~NativeCalibrator() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+        if (mWorker.joinable())
+        {
+            mWorker.join();
+        }
+    }
+
+    int32_t getBatchSize() const noexcept override
+    {
+        // With explicit batch dimensions the batch is part of the input shapes.
+        return mExplicitBatch ? 1 : mBatchSize;
+    }
+
+    CalibrationAlgoType getAlgorithm() noexcept override
+    {
+        return mAlgorithm;
+    }
+
+    bool getBatch(void* bindings[], char const* names[], int32_t nbBindings) noexcept override
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            if (mNext >= mNbBatches)
+            {
+                return false;
+            }
+            mCondition.wait(lock, [this] { return mStaged > mNext || mStop; });
+            if (mStop)
+            {
+                return false;
+            }
+            int32_t const slot = static_cast<int32_t>(mNext % mNbSlots);
+            lock.unlock();
+
+            for (int32_t i = 0; i < nbBindings; ++i)
+            {
+                auto const it = mInputIndices.find(names[i]);
+                if (it == mInputIndices.end())
+                {
+                    logError(std::string{"NativeCalibrator has no data for input: "} + names[i]);
+                    return false;
+                }
+                Input& input = mInputs[it->second];
+                if (cudaMemcpyAsync(input.device.get(), input.staging[slot].get(), input.sampleBytes * mBatchSize,
+                        cudaMemcpyHostToDevice, mStream.get())
+                    != cudaSuccess)
+                {
+                    logError(std::string{"Failed to copy calibration batch for input: "} + names[i]);
+                    return false;
+                }
+                bindings[i] = input.device.get();
+            }
+            bool const copied = cudaStreamSynchronize(mStream.get()) == cudaSuccess;
+
+            lock.lock();
+            ++mNext;
+            lock.unlock();
+            mCondition.notify_all();
+            return copied;
+        }
+        catch (std::exception const& e)
+        {
+            logError(std::string{"Exception caught in get_batch(): "} + e.what());
+        }
+        return false;
+    }
+
+    void const* readCalibrationCache(std::size_t& length) noexcept override
+    {
+        length = 0;
+        if (mCacheFile.empty())
+        {
+            return nullptr;
+        }
+        std::ifstream file(mCacheFile, std::ios::binary);
+        if (!file)
+        {
+            return nullptr;
+        }
+        mCache.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        length = mCache.size();
+        return mCache.empty() ? nullptr : mCache.data();
+    }
+
+    void writeCalibrationCache(void const* ptr, std::size_t length) noexcept override
+    {
+        if (mCacheFile.empty())
+        {
+            return;
+        }
+        std::ofstream file(mCacheFile, std::ios::binary);
+        file.write(static_cast<char const*>(ptr), length);
+        if (!file)
+        {
+            logError("Failed to write calibration cache: " + mCacheFile);
+        }
+    }
+
+    int64_t getNbBatches() const
+    {
+        return mNbBatches;
+    }
+
+private:
+    struct Chunk
+    {
+        uint8_t const* data;
+        int64_t nbSamples;
+    };
+
+    struct Input
+    {
+        std::string name;
+        // Samples are laid out back to back across the chunks.
+        std::vector<Chunk> chunks;
+        size_t sampleBytes{0};
+        int64_t nbSamples{0};
+        std::unique_ptr<void, cudaError_t (*)(void*)> device{nullptr, &cudaFree};
+        std::vector<std::unique_ptr<void, cudaError_t (*)(void*)>> staging;
+    };
+
+    void logError(std::string const& message) const noexcept
+    {
+        mLogger.log(ILogger::Severity::kERROR, message.c_str());
+    }
+
+    void addArray(Input& input, py::handle array)
+    {
+        py::buffer buffer = py::reinterpret_borrow<py::buffer>(array);
+        py::buffer_info info = buffer.request();
+        PY_ASSERT_VALUE_ERROR(info.ndim >= 1, "Calibration arrays must have a leading sample dimension");
+
+        // The worker reads the arrays without the GIL, so they must be contiguous and outlive the calibrator.
+        ssize_t expectedStride = info.itemsize;
+        for (ssize_t d = info.ndim - 1; d >= 0; --d)
+        {
+            PY_ASSERT_VALUE_ERROR(info.shape[d] <= 1 || info.strides[d] == expectedStride,
+                "Calibration arrays for input " + input.name + " must be C-contiguous");
+            expectedStride *= info.shape[d];
+        }
+        size_t const sampleBytes
+            = info.shape[0] > 0 ? static_cast<size_t>(info.size / info.shape[0] * info.itemsize) : 0;
+        PY_ASSERT_VALUE_ERROR(input.chunks.empty() || sampleBytes == input.sampleBytes,
+            "All calibration arrays for input " + input.name + " must have the same sample size");
+        input.sampleBytes = sampleBytes;
+        input.chunks.push_back(Chunk{static_cast<uint8_t const*>(info.ptr), info.shape[0]});
+        input.nbSamples += info.shape[0];
+        mArrays.emplace_back(buffer);
+    }
+
+    // Copies the samples of a batch into dst, walking the chunks of the input.
+    void gather(Input const& input, int64_t batch, uint8_t* dst) const
+    {
+        int64_t sample = batch * mBatchSize;
+        int64_t remaining = mBatchSize;
+        for (auto const& chunk : input.chunks)
+        {
+            if (remaining == 0)
+            {
+                break;
+            }
+            if (sample >= chunk.nbSamples)
+            {
+                sample -= chunk.nbSamples;
+                continue;
+            }
+            int64_t const count = std::min(remaining, chunk.nbSamples - sample);
+            std::memcpy(dst, chunk.data + sample * input.sampleBytes, count * input.sampleBytes);
+            dst += count * input.sampleBytes;
+            remaining -= count;
+            sample = 0;
+        }
+    }
+
+    void stage()
+    {
+        for (int64_t batch = 0; batch < mNbBatches; ++batch)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [&] { return batch - mNext < mNbSlots || mStop; });
+                if (mStop)
+                {
+                    return;
+                }
+            }
+            int32_t const slot = static_cast<int32_t>(batch % mNbSlots);
+            for (auto const& input : mInputs)
+            {
+                gather(input, batch, static_cast<uint8_t*>(input.staging[slot].get()));
+            }
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStaged = batch + 1;
+            }
+            mCondition.notify_all();
+        }
+    }
+
+    //! Kept alive by the Python binding.
+    ILogger& mLogger;
+    int32_t mBatchSize;
+    CalibrationAlgoType mAlgorithm;
+    std::string mCacheFile;
+    bool mExplicitBatch;
+    int32_t mNbSlots;
+    int64_t mNbBatches{0};
+
+    std::vector<py::object> mArrays;
+    std::vector<Input> mInputs;
+    std::unordered_map<std::string, size_t> mInputIndices;
+    std::vector<char> mCache;
+    std::unique_ptr<CUstream_st, cudaError_t (*)(cudaStream_t)> mStream{nullptr, &cudaStreamDestroy};
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    int64_t mStaged{0};
+    int64_t mNext{0};
+    bool mStop{false};
+    std::thread mWorker;
+};
+
 // NOTE: Fake bindings are provided for some of the application-implemented functions here.
 // These are solely for documentation purposes. The user is meant to override these functions
 // in their own code, and the bindings here will never be called.
@@ -336,5 +647,12 @@ void bindInt8(py::module& m)
         .def("write_calibration_cache", docWriteCalibrationCache<IInt8MinMaxCalibrator>, "cache"_a,
             IInt8CalibratorDoc::write_calibration_cache);
 
+    py::class_<NativeCalibrator, IInt8Calibrator>(m, "NativeCalibrator", NativeCalibratorDoc::descr, py::module_local())
+        .def(py::init<py::dict const&, int32_t, ILogger&, CalibrationAlgoType, std::string const&, bool, int32_t>(),
+            "inputs"_a, "batch_size"_a, "logger"_a, "algorithm"_a = CalibrationAlgoType::kENTROPY_CALIBRATION_2,
+            "cache_file"_a = "", "explicit_batch"_a = true, "prefetch"_a = 2, NativeCalibratorDoc::init,
+            py::keep_alive<1, 4>{})
+        .def_property_readonly("num_batches", &NativeCalibrator::getNbBatches);
+
 } // Int8
 } // namespace tensorrt
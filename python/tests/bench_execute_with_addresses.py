@@ -0,0 +1,107 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""
+Benchmarks the host overhead of binding tensor addresses and enqueueing from Python.
+
+The execution context is a mock of a real model's: its engine copies many one-element inputs to outputs, so its GPU
+time is negligible and the measured time is the cost of the calls themselves. Each way of binding is timed over the same iterations:
+    - one set_tensor_address call per tensor, then execute_async_v3
+    - execute_async_v3_with_addresses with a dict of addresses
+    - execute_async_v3_with_addresses with a list of addresses
+    - execute_async_v3_with_addresses with a TensorBindingSet
+
+Usage: python3 bench_execute_with_addresses.py [--pairs 32] [--iterations 2000]
+"""
+
+import argparse
+import time
+
+import numpy as np
+import tensorrt as trt
+from cuda import cudart
+
+
+def cuda_call(call):
+    err, *result = call
+    assert err == cudart.cudaError_t.cudaSuccess, err
+    return result[0] if len(result) == 1 else result
+
+
+def build_engine(pairs):
+    logger = trt.Logger(trt.Logger.ERROR)
+    builder = trt.Builder(logger)
+    network = builder.create_network(1 << int(trt.NetworkDefinitionCreationFlag.EXPLICIT_BATCH))
+    for i in range(pairs):
+        identity = network.add_identity(network.add_input(f"input_{i}", trt.float32, (1,)))
+        identity.get_output(0).name = f"output_{i}"
+        network.mark_output(identity.get_output(0))
+    serialized = builder.build_serialized_network(network, builder.create_builder_config())
+    return trt.Runtime(logger).deserialize_cuda_engine(serialized)
+
+
+def time_per_call(iterations, stream, call):
+    call()
+    cuda_call(cudart.cudaStreamSynchronize(stream))
+    start = time.perf_counter()
+    for _ in range(iterations):
+        call()
+    cuda_call(cudart.cudaStreamSynchronize(stream))
+    return (time.perf_counter() - start) / iterations * 1e6
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--pairs", type=int, default=32, help="Number of input and output tensor pairs")
+    parser.add_argument("--iterations", type=int, default=2000, help="Number of timed enqueues per method")
+    args = parser.parse_args()
+
+    engine = build_engine(args.pairs)
+    context = engine.create_execution_context()
+    names = [engine.get_tensor_name(i) for i in range(engine.num_io_tensors)]
+    nbytes = np.dtype(np.float32).itemsize
+    addresses = [int(cuda_call(cudart.cudaMalloc(nbytes))) for _ in names]
+    by_name = dict(zip(names, addresses))
+    bindings = trt.TensorBindingSet(engine)
+    bindings.set_addresses(addresses)
+    stream = cuda_call(cudart.cudaStreamCreate())
+
+    def per_tensor():
+        for name, address in by_name.items():
+            context.set_tensor_address(name, address)
+        context.execute_async_v3(stream)
+
+    methods = {
+        "set_tensor_address + execute_async_v3": per_tensor,
+        "execute_async_v3_with_addresses(dict)": lambda: context.execute_async_v3_with_addresses(by_name, stream),
+        "execute_async_v3_with_addresses(list)": lambda: context.execute_async_v3_with_addresses(addresses, stream),
+        "execute_async_v3_with_addresses(TensorBindingSet)": lambda: context.execute_async_v3_with_addresses(
+            bindings, stream
+        ),
+    }
+    try:
+        print(f"{len(names)} I/O tensors, {args.iterations} iterations")
+        for label, call in methods.items():
+            print(f"{label:<52} {time_per_call(args.iterations, stream, call):8.1f} us/call")
+    finally:
+        cuda_call(cudart.cudaStreamDestroy(stream))
+        for address in addresses:
+            cuda_call(cudart.cudaFree(address))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+import pytest
+import tensorrt as trt
+
+cuda = pytest.importorskip("cuda")
+from cuda import cudart
+
+SHAPE = (4,)
+
+
+def cuda_call(call):
+    err, *result = call
+    assert err == cudart.cudaError_t.cudaSuccess, err
+    return result[0] if len(result) == 1 else result
+
+
+@pytest.fixture(scope="module")
+def engine():
+    logger = trt.Logger(trt.Logger.ERROR)
+    builder = trt.Builder(logger)
+    network = builder.create_network(1 << int(trt.NetworkDefinitionCreationFlag.EXPLICIT_BATCH))
+    inp = network.add_input("input", trt.float32, SHAPE)
+    identity = network.add_identity(inp)
+    identity.get_output(0).name = "output"
+    network.mark_output(identity.get_output(0))
+    serialized = builder.build_serialized_network(network, builder.create_builder_config())
+    return trt.Runtime(logger).deserialize_cuda_engine(serialized)
+
+
+class DeviceBuffers:
+    """A device input filled with known values and a device output, for one identity inference."""
+
+    def __init__(self, seed):
+        self.host_input = np.arange(np.prod(SHAPE), dtype=np.float32) + seed
+        self.nbytes = self.host_input.nbytes
+        self.input = cuda_call(cudart.cudaMalloc(self.nbytes))
+        self.output = cuda_call(cudart.cudaMalloc(self.nbytes))
+        kind = cudart.cudaMemcpyKind.cudaMemcpyHostToDevice
+        cuda_call(cudart.cudaMemcpy(self.input, self.host_input.ctypes.data, self.nbytes, kind))
+
+    def read_output(self):
+        host_output = np.empty_like(self.host_input)
+        kind = cudart.cudaMemcpyKind.cudaMemcpyDeviceToHost
+        cuda_call(cudart.cudaMemcpy(host_output.ctypes.data, self.output, self.nbytes, kind))
+        return host_output
+
+    def free(self):
+        cuda_call(cudart.cudaFree(self.input))
+        cuda_call(cudart.cudaFree(self.output))
+
+
+@pytest.fixture
+def buffers():
+    allocated = [DeviceBuffers(seed) for seed in (0, 100)]
+    yield allocated
+    for buffer in allocated:
+        buffer.free()
+
+
+def run(context, addresses, buffer):
+    stream = cuda_call(cudart.cudaStreamCreate())
+    try:
+        assert context.execute_async_v3_with_addresses(addresses, stream)
+        cuda_call(cudart.cudaStreamSynchronize(stream))
+    finally:
+        cuda_call(cudart.cudaStreamDestroy(stream))
+    assert np.array_equal(buffer.read_output(), buffer.host_input)
+
+
+def test_address_dict(engine, buffers):
+    context = engine.create_execution_context()
+    for buffer in buffers:
+        run(context, {"input": int(buffer.input), "output": int(buffer.output)}, buffer)
+
+
+def test_address_list(engine, buffers):
+    context = engine.create_execution_context()
+    for buffer in buffers:
+        run(context, [int(buffer.input), int(buffer.output)], buffer)
+
+
+def test_binding_set(engine, buffers):
+    context = engine.create_execution_context()
+    bindings = trt.TensorBindingSet(engine)
+    assert bindings.names == ["input", "output"]
+    for buffer in buffers:
+        bindings.set_addresses([int(buffer.input), int(buffer.output)])
+        assert bindings["output"] == int(buffer.output)
+        run(context, bindings, buffer)
+
+
+def test_binding_set_rejects_unknown_names(engine):
+    with pytest.raises(ValueError):
+        trt.TensorBindingSet(engine, ["missing"])
+    with pytest.raises(KeyError):
+        trt.TensorBindingSet(engine).set_address("missing", 0)
+
+
+def test_rejected_address_restores_previous_addresses(engine, buffers):
+    context = engine.create_execution_context()
+    first, second = buffers
+    assert context.set_tensor_address("input", int(first.input))
+    assert context.set_tensor_address("output", int(first.output))
+
+    # The second tensor is rejected after the first one has been set.
+    with pytest.raises(ValueError):
+        context.execute_async_v3_with_addresses({"input": int(second.input), "missing": int(second.output)}, 0)
+    assert context.get_tensor_address("input") == int(first.input)
+    assert context.get_tensor_address("output") == int(first.output)
+
+    with pytest.raises(ValueError):
+        context.execute_async_v3_with_addresses([int(second.input)], 0)
+    assert context.get_tensor_address("input") == int(first.input)
@@ -0,0 +1,103 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import struct
+
+import numpy as np
+import pytest
+import tensorrt as trt
+
+# The calibrator allocates device and pinned memory, so the tests need a GPU.
+pytest.importorskip("cuda")
+
+BATCH = 4
+SAMPLE_SHAPE = (8,)
+LOGGER = trt.Logger(trt.Logger.ERROR)
+
+
+def calibration_chunks(nb_batches, chunk_samples):
+    """Random samples split into arrays of chunk_samples samples, so that batches straddle the arrays. The largest
+    magnitude is in the last batch, so that it only shows in the calibration cache if every batch was delivered."""
+    rng = np.random.default_rng(0)
+    data = rng.uniform(-1.0, 1.0, size=(nb_batches * BATCH,) + SAMPLE_SHAPE).astype(np.float32)
+    data[-1, 0] = 10.0
+    return [data[i : i + chunk_samples] for i in range(0, len(data), chunk_samples)], 10.0
+
+
+def build_int8(calibrator):
+    builder = trt.Builder(LOGGER)
+    network = builder.create_network(1 << int(trt.NetworkDefinitionCreationFlag.EXPLICIT_BATCH))
+    inp = network.add_input("input", trt.float32, (BATCH,) + SAMPLE_SHAPE)
+    relu = network.add_activation(inp, trt.ActivationType.RELU)
+    relu.get_output(0).name = "output"
+    network.mark_output(relu.get_output(0))
+    config = builder.create_builder_config()
+    config.set_flag(trt.BuilderFlag.INT8)
+    config.int8_calibrator = calibrator
+    return builder.build_serialized_network(network, config)
+
+
+def cache_amax(cache_file, tensor):
+    """The dynamic range of a tensor in a calibration cache, whose lines hold the big endian hex of the scale."""
+    with open(cache_file) as f:
+        for line in f.read().splitlines()[1:]:
+            name, scale = line.split(": ")
+            if name == tensor:
+                return struct.unpack(">f", bytes.fromhex(scale))[0] * 127.0
+    raise KeyError(tensor)
+
+
+@pytest.mark.parametrize("prefetch", [1, 2, 5])
+def test_every_batch_is_delivered(tmp_path, prefetch):
+    """TensorRT requests every batch through the worker handshake, whatever the number of staging slots."""
+    nb_batches = 6
+    chunks, amax = calibration_chunks(nb_batches, chunk_samples=3)
+    cache_file = str(tmp_path / "calibration.cache")
+    calibrator = trt.NativeCalibrator(
+        {"input": chunks},
+        batch_size=BATCH,
+        logger=LOGGER,
+        algorithm=trt.CalibrationAlgoType.MINMAX_CALIBRATION,
+        cache_file=cache_file,
+        prefetch=prefetch,
+    )
+    assert calibrator.num_batches == nb_batches
+    assert build_int8(calibrator) is not None
+    assert cache_amax(cache_file, "input") == pytest.approx(amax, rel=1e-3)
+
+
+def test_destroyed_before_calibration():
+    """The worker waits for free staging slots; destroying the calibrator must stop it rather than hang."""
+    chunks, _ = calibration_chunks(nb_batches=16, chunk_samples=BATCH)
+    calibrator = trt.NativeCalibrator({"input": chunks}, batch_size=BATCH, logger=LOGGER, prefetch=1)
+    assert calibrator.num_batches == 16
+    del calibrator
+
+
+def test_rejects_inputs_without_a_full_batch():
+    data = np.zeros((BATCH - 1,) + SAMPLE_SHAPE, dtype=np.float32)
+    with pytest.raises(ValueError, match="fewer samples than batch_size"):
+        trt.NativeCalibrator({"input": data}, batch_size=BATCH, logger=LOGGER)
+
+
+def test_rejects_inputs_with_different_batch_counts():
+    inputs = {
+        "a": np.zeros((2 * BATCH,) + SAMPLE_SHAPE, dtype=np.float32),
+        "b": np.zeros((3 * BATCH,) + SAMPLE_SHAPE, dtype=np.float32),
+    }
+    with pytest.raises(ValueError, match="same number of calibration batches"):
+        trt.NativeCalibrator(inputs, batch_size=BATCH, logger=LOGGER)
@@ -0,0 +1,83 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import gc
+import weakref
+
+import numpy as np
+import pytest
+import tensorrt as trt
+
+
+def is_alive(ref):
+    gc.collect()
+    return ref() is not None
+
+
+@pytest.mark.parametrize("pack", [False, True])
+def test_contiguous_array_is_viewed_and_kept_alive(pack):
+    array = np.arange(12, dtype=np.float32)
+    ref = weakref.ref(array)
+    weights = trt.Weights(array, pack=pack)
+    assert weights.dtype == trt.float32
+    assert weights.size == array.size
+
+    # No copy is made, so the weights see later writes to the array.
+    array[0] = 42.0
+    assert weights.numpy()[0] == 42.0
+
+    del array
+    assert is_alive(ref)
+    del weights
+    assert not is_alive(ref)
+
+
+def test_strided_array_without_pack_is_rejected():
+    strided = np.arange(16, dtype=np.float32).reshape(4, 4)[:, ::2]
+    with pytest.raises(ValueError):
+        trt.Weights(strided)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float16, np.int32])
+def test_strided_array_with_pack_is_copied(dtype):
+    strided = np.arange(60, dtype=dtype).reshape(3, 4, 5).transpose(2, 0, 1)[:, 1:, ::2]
+    assert not strided.flags.c_contiguous
+    ref = weakref.ref(strided)
+    weights = trt.Weights(strided, pack=True)
+    assert weights.size == strided.size
+    assert weights.nbytes == strided.nbytes
+    assert np.array_equal(weights.numpy(), strided.ravel())
+
+    # The weights own their values, so they neither see later writes nor keep the array alive.
+    expected = strided.ravel()
+    strided[...] = 0
+    assert np.array_equal(weights.numpy(), expected)
+    del strided
+    assert not is_alive(ref)
+
+
+def test_fp16_memoryview():
+    values = np.linspace(-1.0, 1.0, 10, dtype=np.float16)
+    view = memoryview(values)
+    ref = weakref.ref(view)
+    weights = trt.Weights(view)
+    assert weights.dtype == trt.float16
+    assert weights.size == values.size
+    assert np.array_equal(weights.numpy(), values)
+
+    del view
+    assert is_alive(ref)
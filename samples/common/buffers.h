@@ -20,14 +20,17 @@
 #include "NvInfer.h"
 #include "common.h"
 #include "half.h"
+#include <array>
 #include <cassert>
 #include <cuda_runtime_api.h>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <numeric>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace samplesCommon
@@ -213,8 +216,206 @@ public:
     }
 };
 
+class PinnedHostAllocator
+{
+public:
+    bool operator()(void** ptr, size_t size) const
+    {
+        return cudaMallocHost(ptr, size) == cudaSuccess;
+    }
+};
+
+class PinnedHostFree
+{
+public:
+    void operator()(void* ptr) const
+    {
+        cudaFreeHost(ptr);
+    }
+};
+
+//!
+//! \brief  The MemoryPool class caches freed memory blocks for reuse.
+//!
+//! \details Requested sizes are rounded up to a power-of-two size class, and freed blocks are kept in one free list
+//!          per size class, so that repeatedly allocating and freeing buffers of similar sizes does not go back to
+//!          the underlying allocator. This matters for page-locked memory, whose allocation is expensive.
+//!          The template parameters AllocFunc and FreeFunc follow the same rules as for GenericBuffer.
+//!          All methods are thread-safe.
+//!
+template <typename AllocFunc, typename FreeFunc>
+class MemoryPool
+{
+public:
+    //! The smallest size class in bytes.
+    static constexpr size_t kMIN_BLOCK_SIZE{4096};
+
+    MemoryPool() = default;
+    MemoryPool(MemoryPool const&) = delete;
+    MemoryPool& operator=(MemoryPool const&) = delete;
+
+    ~MemoryPool()
+    {
+        release();
+    }
+
+    //!
+    //! \brief Return the size of the block allocated for a request of size bytes.
+    //!
+    static size_t getBlockSize(size_t size)
+    {
+        size_t blockSize{kMIN_BLOCK_SIZE};
+        while (blockSize < size)
+        {
+            blockSize *= 2;
+        }
+        return blockSize;
+    }
+
+    //!
+    //! \brief Allocate a block of at least size bytes, reusing a freed block of the same size class if possible.
+    //!        Returns nullptr if size is 0 or if the allocation fails.
+    //!
+    void* allocate(size_t size)
+    {
+        if (size == 0)
+        {
+            return nullptr;
+        }
+        size_t const blockSize = getBlockSize(size);
+        std::lock_guard<std::mutex> lock(mMutex);
+        void* ptr{nullptr};
+        auto& freeBlocks = mFreeBlocks[blockSize];
+        if (!freeBlocks.empty())
+        {
+            ptr = freeBlocks.back();
+            freeBlocks.pop_back();
+            mCachedBytes -= blockSize;
+            ++mNbReuses;
+        }
+        else
+        {
+            if (!allocFn(&ptr, blockSize))
+            {
+                return nullptr;
+            }
+            ++mNbAllocations;
+        }
+        mLiveBlocks[ptr] = blockSize;
+        return ptr;
+    }
+
+    //!
+    //! \brief Return a block obtained from allocate() to its free list. It must work with nullptr input.
+    //!
+    void deallocate(void* ptr)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto const block = mLiveBlocks.find(ptr);
+        assert(block != mLiveBlocks.end() && "Pointer was not allocated by this pool");
+        mFreeBlocks[block->second].push_back(ptr);
+        mCachedBytes += block->second;
+        mLiveBlocks.erase(block);
+    }
+
+    //!
+    //! \brief Free all the cached blocks. Blocks still in use are not affected.
+    //!
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& freeBlocks : mFreeBlocks)
+        {
+            for (auto* ptr : freeBlocks.second)
+            {
+                freeFn(ptr);
+            }
+        }
+        mFreeBlocks.clear();
+        mCachedBytes = 0;
+    }
+
+    //! Returns the number of blocks obtained from the underlying allocator.
+    size_t getNbAllocations() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mNbAllocations;
+    }
+
+    //! Returns the number of allocations served from a free list.
+    size_t getNbReuses() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mNbReuses;
+    }
+
+    //! Returns the number of bytes held in the free lists.
+    size_t getCachedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCachedBytes;
+    }
+
+private:
+    mutable std::mutex mMutex;
+    std::unordered_map<size_t, std::vector<void*>> mFreeBlocks; //!< Free lists keyed by block size
+    std::unordered_map<void*, size_t> mLiveBlocks;              //!< Block sizes of the blocks in use
+    size_t mNbAllocations{0};
+    size_t mNbReuses{0};
+    size_t mCachedBytes{0};
+    AllocFunc allocFn;
+    FreeFunc freeFn;
+};
+
+using PinnedHostMemoryPool = MemoryPool<PinnedHostAllocator, PinnedHostFree>;
+
+//!
+//! \brief Returns the process-wide pool of page-locked host memory.
+//!
+//! \details The pool is a static object, destroyed after main() returns, when the CUDA runtime may already be torn
+//!          down. Call releasePinnedHostMemoryPool() once the pinned buffers are destroyed, and before CUDA is torn
+//!          down, so that the cached blocks are not freed at exit.
+//!
+inline PinnedHostMemoryPool& getPinnedHostMemoryPool()
+{
+    static PinnedHostMemoryPool pool;
+    return pool;
+}
+
+//!
+//! \brief Free the blocks cached by the process-wide pool of page-locked host memory.
+//!
+inline void releasePinnedHostMemoryPool()
+{
+    getPinnedHostMemoryPool().release();
+}
+
+class PooledPinnedHostAllocator
+{
+public:
+    bool operator()(void** ptr, size_t size) const
+    {
+        *ptr = getPinnedHostMemoryPool().allocate(size);
+        return *ptr != nullptr || size == 0;
+    }
+};
+
+class PooledPinnedHostFree
+{
+public:
+    void operator()(void* ptr) const
+    {
+        getPinnedHostMemoryPool().deallocate(ptr);
+    }
+};
+
 using DeviceBuffer = GenericBuffer<DeviceAllocator, DeviceFree>;
 using HostBuffer = GenericBuffer<HostAllocator, HostFree>;
+using PinnedHostBuffer = GenericBuffer<PooledPinnedHostAllocator, PooledPinnedHostFree>;
 
 //!
 //! \brief  The ManagedBuffer class groups together a pair of corresponding device and host buffers.
@@ -226,6 +427,26 @@ public:
     HostBuffer hostBuffer;
 };
 
+//!
+//! \enum HostMemoryMode
+//!
+//! \brief How BufferManager allocates the host buffers.
+//!
+enum class HostMemoryMode
+{
+    //! One pageable host buffer per binding.
+    kPAGEABLE,
+
+    //! Page-locked host buffers from the pinned memory pool. The buffers of all inputs, and of all outputs, are laid
+    //! out contiguously so that the copies of adjacent bindings are coalesced. Call releasePinnedHostMemoryPool()
+    //! before CUDA is torn down.
+    kPINNED,
+
+    //! Like kPINNED, with two sets of host buffers so that one set can be filled or read while the copies of the
+    //! other set are in flight. See BufferManager::swapHostBuffers().
+    kPINNED_DOUBLE_BUFFERED
+};
+
 //!
 //! \brief  The BufferManager class handles host and device buffer allocation and deallocation.
 //!
@@ -239,18 +460,36 @@ class BufferManager
 public:
     static const size_t kINVALID_SIZE_VALUE = ~size_t(0);
 
+    //! Alignment of each binding within the contiguous buffers used in the pinned modes.
+    static constexpr size_t kBINDING_ALIGNMENT{256};
+
     //!
     //! \brief Create a BufferManager for handling buffer interactions with engine.
     //!
     BufferManager(std::shared_ptr<nvinfer1::ICudaEngine> engine, const int batchSize = 0,
-        const nvinfer1::IExecutionContext* context = nullptr)
+        const nvinfer1::IExecutionContext* context = nullptr,
+        HostMemoryMode hostMemoryMode = HostMemoryMode::kPAGEABLE)
         : mEngine(engine)
         , mBatchSize(batchSize)
+        , mNbHostBufferSets(hostMemoryMode == HostMemoryMode::kPINNED_DOUBLE_BUFFERED ? 2 : 1)
     {
         // Full Dims implies no batch size.
         assert(engine->hasImplicitBatchDimension() || mBatchSize == 0);
-        // Create host and device buffers
-        for (int i = 0; i < mEngine->getNbBindings(); i++)
+        int const nbBindings = mEngine->getNbBindings();
+        mHostBindings.resize(mNbHostBufferSets);
+        for (auto& hostBindings : mHostBindings)
+        {
+            hostBindings.resize(nbBindings, nullptr);
+        }
+        mDeviceBindings.resize(nbBindings, nullptr);
+        mBindingSizes.resize(nbBindings, 0);
+
+        // Compute binding sizes, and their offsets in the contiguous input and output buffers of the pinned modes.
+        std::vector<nvinfer1::DataType> types(nbBindings);
+        std::vector<size_t> volumes(nbBindings);
+        std::vector<size_t> offsets(nbBindings);
+        std::array<size_t, 2> slabSizes{0, 0};
+        for (int i = 0; i < nbBindings; i++)
         {
             auto dims = context ? context->getBindingDimensions(i) : mEngine->getBindingDimensions(i);
             size_t vol = context || !mBatchSize ? 1 : static_cast<size_t>(mBatchSize);
@@ -263,14 +502,58 @@ public:
                 vol *= scalarsPerVec;
             }
             vol *= samplesCommon::volume(dims);
-            std::unique_ptr<ManagedBuffer> manBuf{new ManagedBuffer()};
-            manBuf->deviceBuffer = DeviceBuffer(vol, type);
-            manBuf->hostBuffer = HostBuffer(vol, type);
-            mDeviceBindings.emplace_back(manBuf->deviceBuffer.data());
-            mManagedBuffers.emplace_back(std::move(manBuf));
+            types[i] = type;
+            volumes[i] = vol;
+            mBindingSizes[i] = vol * samplesCommon::getElementSize(type);
+            auto& slabSize = slabSizes[mEngine->bindingIsInput(i) ? 0 : 1];
+            offsets[i] = slabSize;
+            slabSize += roundUp(mBindingSizes[i], kBINDING_ALIGNMENT);
+        }
+
+        if (hostMemoryMode == HostMemoryMode::kPAGEABLE)
+        {
+            // Create host and device buffers
+            for (int i = 0; i < nbBindings; i++)
+            {
+                std::unique_ptr<ManagedBuffer> manBuf{new ManagedBuffer()};
+                manBuf->deviceBuffer = DeviceBuffer(volumes[i], types[i]);
+                manBuf->hostBuffer = HostBuffer(volumes[i], types[i]);
+                mDeviceBindings[i] = manBuf->deviceBuffer.data();
+                mHostBindings[0][i] = manBuf->hostBuffer.data();
+                mManagedBuffers.emplace_back(std::move(manBuf));
+            }
+            return;
+        }
+
+        // Allocate one device buffer and one pinned host buffer per direction, and per host buffer set.
+        for (size_t slab = 0; slab < slabSizes.size(); ++slab)
+        {
+            mDeviceSlabs[slab] = DeviceBuffer(slabSizes[slab], nvinfer1::DataType::kINT8);
+        }
+        mHostSlabs.reserve(mNbHostBufferSets * slabSizes.size());
+        for (int set = 0; set < mNbHostBufferSets; ++set)
+        {
+            for (size_t slab = 0; slab < slabSizes.size(); ++slab)
+            {
+                mHostSlabs.emplace_back(slabSizes[slab], nvinfer1::DataType::kINT8);
+            }
+            CHECK(cudaEventCreateWithFlags(&mHostBufferSetEvents[set], cudaEventDisableTiming));
+        }
+        for (int i = 0; i < nbBindings; i++)
+        {
+            size_t const slab = mEngine->bindingIsInput(i) ? 0 : 1;
+            mDeviceBindings[i] = static_cast<char*>(mDeviceSlabs[slab].data()) + offsets[i];
+            for (int set = 0; set < mNbHostBufferSets; ++set)
+            {
+                mHostBindings[set][i]
+                    = static_cast<char*>(mHostSlabs[set * slabSizes.size() + slab].data()) + offsets[i];
+            }
         }
     }
 
+    BufferManager(BufferManager const&) = delete;
+    BufferManager& operator=(BufferManager const&) = delete;
+
     //!
     //! \brief Returns a vector of device buffers that you can use directly as
     //!        bindings for the execute and enqueue methods of IExecutionContext.
@@ -298,7 +581,7 @@ public:
     }
 
     //!
-    //! \brief Returns the host buffer corresponding to tensorName.
+    //! \brief Returns the host buffer corresponding to tensorName in the current host buffer set.
     //!        Returns nullptr if no such tensor can be found.
     //!
     void* getHostBuffer(const std::string& tensorName) const
@@ -315,7 +598,7 @@ public:
         int index = mEngine->getBindingIndex(tensorName.c_str());
         if (index == -1)
             return kINVALID_SIZE_VALUE;
-        return mManagedBuffers[index]->hostBuffer.nbBytes();
+        return mBindingSizes[index];
     }
 
     //!
@@ -379,7 +662,41 @@ public:
         memcpyBuffers(false, true, true, stream);
     }
 
-    ~BufferManager() = default;
+    //!
+    //! \brief Switch to the next set of host buffers in HostMemoryMode::kPINNED_DOUBLE_BUFFERED mode.
+    //!
+    //! \details Blocks until the asynchronous copies previously issued on the next set have completed, so that its
+    //!          outputs can be read and its inputs overwritten while the copies of the current set are in flight.
+    //!          This is a no-op in the other modes.
+    //!
+    void swapHostBuffers()
+    {
+        if (mNbHostBufferSets > 1)
+        {
+            mHostBufferSet = (mHostBufferSet + 1) % mNbHostBufferSets;
+            CHECK(cudaEventSynchronize(mHostBufferSetEvents[mHostBufferSet]));
+        }
+    }
+
+    //!
+    //! \brief Returns the number of host-device copies issued so far. Coalesced bindings count as one copy.
+    //!
+    size_t getNbCopies() const
+    {
+        return mNbCopies;
+    }
+
+    ~BufferManager()
+    {
+        if (!mHostSlabs.empty())
+        {
+            for (int set = 0; set < mNbHostBufferSets; ++set)
+            {
+                cudaEventSynchronize(mHostBufferSetEvents[set]);
+                cudaEventDestroy(mHostBufferSetEvents[set]);
+            }
+        }
+    }
 
 private:
     void* getBuffer(const bool isHost, const std::string& tensorName) const
@@ -387,33 +704,81 @@ private:
         int index = mEngine->getBindingIndex(tensorName.c_str());
         if (index == -1)
             return nullptr;
-        return (isHost ? mManagedBuffers[index]->hostBuffer.data() : mManagedBuffers[index]->deviceBuffer.data());
+        return (isHost ? mHostBindings[mHostBufferSet][index] : mDeviceBindings[index]);
     }
 
     void memcpyBuffers(const bool copyInput, const bool deviceToHost, const bool async, const cudaStream_t& stream = 0)
     {
+        auto const& hostBindings = mHostBindings[mHostBufferSet];
+        const cudaMemcpyKind memcpyType = deviceToHost ? cudaMemcpyDeviceToHost : cudaMemcpyHostToDevice;
+        auto const copy = [&](void* hostPtr, void* devicePtr, size_t byteSize) {
+            void* dstPtr = deviceToHost ? hostPtr : devicePtr;
+            const void* srcPtr = deviceToHost ? devicePtr : hostPtr;
+            if (async)
+                CHECK(cudaMemcpyAsync(dstPtr, srcPtr, byteSize, memcpyType, stream));
+            else
+                CHECK(cudaMemcpy(dstPtr, srcPtr, byteSize, memcpyType));
+            ++mNbCopies;
+        };
+
+        // In the pinned modes, coalesce the copies of bindings that are adjacent, up to alignment padding, in both host
+        // and device memory. Separate allocations of the pageable mode may happen to be equally spaced, but the gaps
+        // between them are not ours to write, so they are always copied one binding at a time.
+        bool const coalesce = !mHostSlabs.empty();
+        char* hostStart{nullptr};
+        char* deviceStart{nullptr};
+        size_t byteSize{0};
         for (int i = 0; i < mEngine->getNbBindings(); i++)
         {
-            void* dstPtr
-                = deviceToHost ? mManagedBuffers[i]->hostBuffer.data() : mManagedBuffers[i]->deviceBuffer.data();
-            const void* srcPtr
-                = deviceToHost ? mManagedBuffers[i]->deviceBuffer.data() : mManagedBuffers[i]->hostBuffer.data();
-            const size_t byteSize = mManagedBuffers[i]->hostBuffer.nbBytes();
-            const cudaMemcpyKind memcpyType = deviceToHost ? cudaMemcpyDeviceToHost : cudaMemcpyHostToDevice;
             if ((copyInput && mEngine->bindingIsInput(i)) || (!copyInput && !mEngine->bindingIsInput(i)))
             {
-                if (async)
-                    CHECK(cudaMemcpyAsync(dstPtr, srcPtr, byteSize, memcpyType, stream));
-                else
-                    CHECK(cudaMemcpy(dstPtr, srcPtr, byteSize, memcpyType));
+                auto* hostPtr = static_cast<char*>(hostBindings[i]);
+                auto* devicePtr = static_cast<char*>(mDeviceBindings[i]);
+                bool const adjacent = coalesce && hostStart != nullptr && hostPtr >= hostStart + byteSize
+                    && hostPtr < hostStart + byteSize + kBINDING_ALIGNMENT
+                    && hostPtr - hostStart == devicePtr - deviceStart;
+                if (adjacent)
+                {
+                    byteSize = hostPtr - hostStart + mBindingSizes[i];
+                    continue;
+                }
+                if (byteSize != 0)
+                {
+                    copy(hostStart, deviceStart, byteSize);
+                }
+                hostStart = hostPtr;
+                deviceStart = devicePtr;
+                byteSize = mBindingSizes[i];
             }
         }
+        if (byteSize != 0)
+        {
+            copy(hostStart, deviceStart, byteSize);
+        }
+
+        if (async && !mHostSlabs.empty())
+        {
+            CHECK(cudaEventRecord(mHostBufferSetEvents[mHostBufferSet], stream));
+        }
+    }
+
+    static size_t roundUp(size_t size, size_t alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
     }
 
     std::shared_ptr<nvinfer1::ICudaEngine> mEngine;              //!< The pointer to the engine
     int mBatchSize;                                              //!< The batch size for legacy networks, 0 otherwise.
     std::vector<std::unique_ptr<ManagedBuffer>> mManagedBuffers; //!< The vector of pointers to managed buffers
     std::vector<void*> mDeviceBindings;                          //!< The vector of device buffers needed for engine execution
+    std::vector<std::vector<void*>> mHostBindings;               //!< The host buffers of each host buffer set
+    std::vector<size_t> mBindingSizes;                           //!< The size in bytes of each binding
+    std::array<DeviceBuffer, 2> mDeviceSlabs;                    //!< Contiguous input and output device buffers in pinned modes
+    std::vector<PinnedHostBuffer> mHostSlabs;                    //!< Contiguous input and output host buffers of each set in pinned modes
+    std::array<cudaEvent_t, 2> mHostBufferSetEvents{};           //!< Completion of the last copies of each host buffer set
+    int mNbHostBufferSets{1};                                    //!< 2 in double-buffered mode, 1 otherwise
+    int mHostBufferSet{0};                                       //!< The current host buffer set
+    size_t mNbCopies{0};                                         //!< The number of host-device copies issued
 };
 
 } // namespace samplesCommon
@@ -404,6 +404,103 @@ std::vector<size_t> argMagnitudeSort(Iter begin, Iter end)
     return indices;
 }
 
+//! Number of consecutive elements scanned at once by argMagnitudeTopK() and argMax().
+constexpr size_t kSCAN_BLOCK{16};
+
+//! Return the indices of the k largest magnitudes of a sequence in descending order of magnitude, lowest index first
+//! among equal magnitudes. Unlike argMagnitudeSort(), runs in O(n log k): a heap holds the best k candidates, and the
+//! blocks with no magnitude above the worst candidate are skipped after a branchless, vectorizable scan.
+template <class Iter>
+std::vector<size_t> argMagnitudeTopK(Iter begin, Iter end, size_t k)
+{
+    using Magnitude = decltype(std::abs(*begin));
+    using Candidate = std::pair<Magnitude, size_t>;
+    size_t const n = static_cast<size_t>(end - begin);
+    k = std::min(k, n);
+    if (k == 0)
+    {
+        return {};
+    }
+
+    // The front of the heap is the worst candidate.
+    auto const better = [](Candidate const& a, Candidate const& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+    std::vector<Candidate> heap;
+    heap.reserve(k);
+    for (size_t i = 0; i < k; ++i)
+    {
+        heap.emplace_back(std::abs(begin[i]), i);
+    }
+    std::make_heap(heap.begin(), heap.end(), better);
+
+    for (size_t i = k; i < n; i += kSCAN_BLOCK)
+    {
+        size_t const blockEnd = std::min(i + kSCAN_BLOCK, n);
+        Magnitude const threshold = heap.front().first;
+        bool candidate{false};
+        for (size_t j = i; j < blockEnd; ++j)
+        {
+            candidate |= std::abs(begin[j]) > threshold;
+        }
+        if (!candidate)
+        {
+            continue;
+        }
+        for (size_t j = i; j < blockEnd; ++j)
+        {
+            Magnitude const m = std::abs(begin[j]);
+            if (m > heap.front().first)
+            {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = Candidate(m, j);
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), better);
+    std::vector<size_t> indices(k);
+    std::transform(heap.begin(), heap.end(), indices.begin(), [](Candidate const& c) { return c.second; });
+    return indices;
+}
+
+//! Return the index of the largest value of a sequence, the first one if several are equal, 0 if empty.
+template <typename T>
+size_t argMax(T const* values, size_t n)
+{
+    if (n == 0)
+    {
+        return 0;
+    }
+    // Find the maximum, then its first position. Keeping one maximum per lane of a block makes the scan element-wise,
+    // so the compiler can vectorize it without reassociating a reduction.
+    T maxValue = values[0];
+    size_t i = 0;
+    if (n >= kSCAN_BLOCK)
+    {
+        T lanes[kSCAN_BLOCK];
+        std::copy(values, values + kSCAN_BLOCK, lanes);
+        for (i = kSCAN_BLOCK; i + kSCAN_BLOCK <= n; i += kSCAN_BLOCK)
+        {
+            for (size_t l = 0; l < kSCAN_BLOCK; ++l)
+            {
+                lanes[l] = values[i + l] > lanes[l] ? values[i + l] : lanes[l];
+            }
+        }
+        for (auto lane : lanes)
+        {
+            maxValue = lane > maxValue ? lane : maxValue;
+        }
+    }
+    for (; i < n; ++i)
+    {
+        maxValue = values[i] > maxValue ? values[i] : maxValue;
+    }
+    auto const* match = std::find(values, values + n, maxValue);
+    return match == values + n ? 0 : static_cast<size_t>(match - values);
+}
+
 inline bool readReferenceFile(const std::string& fileName, std::vector<std::string>& refVector)
 {
     std::ifstream infile(fileName);
@@ -427,12 +524,12 @@ template <typename T>
 std::vector<std::string> classify(
     const std::vector<std::string>& refVector, const std::vector<T>& output, const size_t topK)
 {
-    const auto inds = samplesCommon::argMagnitudeSort(output.cbegin(), output.cend());
+    const auto inds = samplesCommon::argMagnitudeTopK(output.cbegin(), output.cend(), topK);
     std::vector<std::string> result;
-    result.reserve(topK);
-    for (size_t k = 0; k < topK; ++k)
+    result.reserve(inds.size());
+    for (auto i : inds)
     {
-        result.push_back(refVector[inds[k]]);
+        result.push_back(refVector[i]);
     }
     return result;
 }
@@ -441,9 +538,7 @@ std::vector<std::string> classify(
 template <typename T>
 std::vector<size_t> topKMagnitudes(const std::vector<T>& v, const size_t k)
 {
-    std::vector<size_t> indices = samplesCommon::argMagnitudeSort(v.cbegin(), v.cend());
-    indices.resize(k);
-    return indices;
+    return samplesCommon::argMagnitudeTopK(v.cbegin(), v.cend(), k);
 }
 
 template <typename T>
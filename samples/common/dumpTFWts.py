@@ -16,8 +16,9 @@
 # limitations under the License.
 #
 
-# Script to dump TensorFlow weights in TRT v1 and v2 dump format.
+# Script to dump TensorFlow weights in TRT v1, v2 and v3 dump format.
 # The V1 format is for TensorRT 4.0. The V2 format is for TensorRT 4.0 and later.
+# The V3 format is an indexed binary container read by sample::WeightsFile.
 
 import sys
 import struct
@@ -40,10 +41,17 @@ parser.add_argument(
 )
 parser.add_argument("-o", "--output", required=True, help="The weight file to dump all the weights to.")
 parser.add_argument("-1", "--wtsv1", required=False, default=False, type=bool, help="Dump the weights in the wts v1.")
+parser.add_argument("-3", "--wtsv3", required=False, default=False, type=bool, help="Dump the weights in the wts v3.")
 
 opt = parser.parse_args()
 
-if opt.wtsv1:
+if opt.wtsv3:
+    print("Outputting the trained weights in TensorRT's wts v3 format. This format is documented as:")
+    print("Header: 'WTS3' <uint32 number of buffers> <uint32 payload alignment> <uint32 0>")
+    print("Index, sorted by name: <uint64 name offset> <uint64 data offset> <uint64 data size> <uint32 name size>")
+    print("                       <int32 buffer type> <int32 number of dims> <int32 dims[8]> <int32 0>")
+    print("Names, then payloads at offsets aligned to the payload alignment. All values are little-endian.")
+elif opt.wtsv1:
     print("Outputting the trained weights in TensorRT's wts v1 format. This format is documented as:")
     print("Line 0: <number of buffers in the file>")
     print("Line 1-Num: [buffer name] [buffer type] [buffer size] <hex values>")
@@ -73,42 +81,86 @@ def getTRTType(tensor):
     sys.exit()
 
 
+WTS3_HEADER = struct.Struct("<4sIII")
+WTS3_ENTRY = struct.Struct("<QQQIii8ii")
+WTS3_ALIGNMENT = 64
+
+
+def align(offset, alignment):
+    return (offset + alignment - 1) // alignment * alignment
+
+
+def writeWtsV3(outputFile, tensors):
+    # tensors is a list of (name, tensor) pairs. The index is sorted by the bytes of the names, so that the
+    # reader can binary search it without parsing the file.
+    entries = sorted(((name.encode("utf-8"), tensor) for name, tensor in tensors), key=lambda entry: entry[0])
+    namesOffset = WTS3_HEADER.size + WTS3_ENTRY.size * len(entries)
+    dataOffset = align(namesOffset + sum(len(name) for name, _ in entries), WTS3_ALIGNMENT)
+
+    outputFile.write(WTS3_HEADER.pack(b"WTS3", len(entries), WTS3_ALIGNMENT, 0))
+    nameOffset = namesOffset
+    for name, tensor in entries:
+        if len(tensor.shape) > 8:
+            raise ValueError("Tensor %s has more than 8 dimensions" % (name.decode("utf-8")))
+        dims = list(tensor.shape) + [0] * (8 - len(tensor.shape))
+        typeOfElem = getTRTType(tensor)
+        outputFile.write(
+            WTS3_ENTRY.pack(nameOffset, dataOffset, tensor.nbytes, len(name), typeOfElem, len(tensor.shape), *dims, 0)
+        )
+        nameOffset += len(name)
+        dataOffset = align(dataOffset + tensor.nbytes, WTS3_ALIGNMENT)
+
+    for name, _ in entries:
+        outputFile.write(name)
+    for _, tensor in entries:
+        outputFile.write(b"\0" * (align(outputFile.tell(), WTS3_ALIGNMENT) - outputFile.tell()))
+        outputFile.write(tensor.astype(tensor.dtype.newbyteorder("<")).tobytes())
+
+
 try:
     # Open output file
-    if opt.wtsv1:
+    if opt.wtsv3:
+        outputFileName = outputbase + ".wts3"
+    elif opt.wtsv1:
         outputFileName = outputbase + ".wts"
     else:
         outputFileName = outputbase + ".wts2"
-    outputFile = open(outputFileName, "w")
+    outputFile = open(outputFileName, "wb" if opt.wtsv3 else "w")
 
     # read vars from checkpoint
     reader = pywrap_tensorflow.NewCheckpointReader(inputbase)
     var_to_shape_map = reader.get_variable_to_shape_map()
 
-    # Record count of weights
-    count = 0
-    for key in sorted(var_to_shape_map):
-        count += 1
-    outputFile.write("%s\n" % (count))
-
-    # Dump the weights in either v1 or v2 format
-    for key in sorted(var_to_shape_map):
-        tensor = reader.get_tensor(key)
-        file_key = key.replace("/", "_")
-        typeOfElem = getTRTType(tensor)
-        val = tensor.shape
-        if opt.wtsv1:
-            val = tensor.size
-        print("%s %s %s " % (file_key, typeOfElem, val))
-        flat_tensor = tensor.flatten()
-        outputFile.write("%s 0 %s " % (file_key, val))
-        if opt.wtsv1:
-            for weight in flat_tensor:
-                hexval = float_to_hex(float(weight))
-                outputFile.write("%s " % (hexval[2:]))
-        else:
-            outputFile.write(flat_tensor.tobytes())
-        outputFile.write("\n")
+    if opt.wtsv3:
+        tensors = [(key.replace("/", "_"), reader.get_tensor(key)) for key in sorted(var_to_shape_map)]
+        for name, tensor in tensors:
+            print("%s %s %s " % (name, getTRTType(tensor), tensor.shape))
+        writeWtsV3(outputFile, tensors)
+    else:
+        # Record count of weights
+        count = 0
+        for key in sorted(var_to_shape_map):
+            count += 1
+        outputFile.write("%s\n" % (count))
+
+        # Dump the weights in either v1 or v2 format
+        for key in sorted(var_to_shape_map):
+            tensor = reader.get_tensor(key)
+            file_key = key.replace("/", "_")
+            typeOfElem = getTRTType(tensor)
+            val = tensor.shape
+            if opt.wtsv1:
+                val = tensor.size
+            print("%s %s %s " % (file_key, typeOfElem, val))
+            flat_tensor = tensor.flatten()
+            outputFile.write("%s 0 %s " % (file_key, val))
+            if opt.wtsv1:
+                for weight in flat_tensor:
+                    hexval = float_to_hex(float(weight))
+                    outputFile.write("%s " % (hexval[2:]))
+            else:
+                outputFile.write(flat_tensor.tobytes())
+            outputFile.write("\n")
     outputFile.close()
 
 except Exception as e:  # pylint: disable=broad-except
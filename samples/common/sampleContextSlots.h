@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_SAMPLE_CONTEXT_SLOTS_H
+#define TRT_SAMPLE_CONTEXT_SLOTS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "logger.h"
+
+namespace sample
+{
+
+//!
+//! \class ContextSlots
+//! \brief Bookkeeping of the contexts of a ContextPool: which are leased, their device memory, and which to evict.
+//!
+//! A slot is a context of an Owner (an InferenceEnvironment in ContextPool) at a stream index. Idle slots are
+//! evicted in least recently used order when the memory of all the slots exceeds the budget. The owner frees the
+//! context of an evicted slot in the callback passed to add() and release(). The class is not thread safe.
+//!
+template <typename Owner>
+class ContextSlots
+{
+public:
+    struct Slot
+    {
+        Owner* owner{nullptr};
+        std::string key;
+        int32_t streamIdx{-1};
+        size_t memorySize{0};
+        bool inUse{false};
+        uint64_t lastUsed{0};
+    };
+
+    //!
+    //! \param memoryBudget Device memory budget in bytes, or 0 for no limit.
+    //!
+    explicit ContextSlots(size_t memoryBudget = 0)
+        : mMemoryBudget(memoryBudget)
+    {
+    }
+
+    //!
+    //! \brief Lease the idle slot with the key, if there is one.
+    //!
+    //! \return The leased slot, or nullptr if there is no idle slot with the key.
+    //!
+    Slot const* acquire(std::string const& key)
+    {
+        ++mTick;
+        auto const idle
+            = std::find_if(mSlots.begin(), mSlots.end(), [&key](Slot const& s) { return !s.inUse && s.key == key; });
+        if (idle == mSlots.end())
+        {
+            return nullptr;
+        }
+        idle->inUse = true;
+        idle->lastUsed = mTick;
+        return &*idle;
+    }
+
+    //!
+    //! \brief Add a leased slot, first evicting idle slots until its memory fits in the budget.
+    //!
+    template <typename OnEvict>
+    void add(Owner* owner, std::string const& key, int32_t streamIdx, size_t memorySize, OnEvict&& onEvict)
+    {
+        evict(memorySize, onEvict);
+        Slot slot;
+        slot.owner = owner;
+        slot.key = key;
+        slot.streamIdx = streamIdx;
+        slot.memorySize = memorySize;
+        slot.inUse = true;
+        slot.lastUsed = mTick;
+        mMemoryUsage += memorySize;
+        mPeakMemoryUsage = std::max(mPeakMemoryUsage, mMemoryUsage);
+        mSlots.push_back(std::move(slot));
+    }
+
+    //!
+    //! \brief Return a leased slot, then evict idle slots if adding it had to exceed the budget.
+    //!
+    template <typename OnEvict>
+    void release(Owner const* owner, int32_t streamIdx, OnEvict&& onEvict)
+    {
+        auto const slot = std::find_if(mSlots.begin(), mSlots.end(),
+            [owner, streamIdx](Slot const& s) { return s.owner == owner && s.streamIdx == streamIdx; });
+        if (slot != mSlots.end())
+        {
+            slot->inUse = false;
+            evict(0, onEvict);
+        }
+    }
+
+    size_t getMemoryBudget() const
+    {
+        return mMemoryBudget;
+    }
+
+    size_t getMemoryUsage() const
+    {
+        return mMemoryUsage;
+    }
+
+    size_t getPeakMemoryUsage() const
+    {
+        return mPeakMemoryUsage;
+    }
+
+    int64_t getNbEvictions() const
+    {
+        return mNbEvictions;
+    }
+
+    std::vector<Slot> const& getSlots() const
+    {
+        return mSlots;
+    }
+
+private:
+    //! Evict idle slots, least recently used first, until requiredSize more bytes fit in the budget.
+    template <typename OnEvict>
+    void evict(size_t requiredSize, OnEvict& onEvict)
+    {
+        if (mMemoryBudget == 0)
+        {
+            return;
+        }
+        while (mMemoryUsage + requiredSize > mMemoryBudget)
+        {
+            auto lru = mSlots.end();
+            for (auto s = mSlots.begin(); s != mSlots.end(); ++s)
+            {
+                if (!s->inUse && (lru == mSlots.end() || s->lastUsed < lru->lastUsed))
+                {
+                    lru = s;
+                }
+            }
+            if (lru == mSlots.end())
+            {
+                sample::gLogWarning << "Context pool exceeds its memory budget of " << mMemoryBudget
+                                    << " bytes, but all the pooled contexts are in use." << std::endl;
+                return;
+            }
+            onEvict(*lru);
+            mMemoryUsage -= lru->memorySize;
+            ++mNbEvictions;
+            mSlots.erase(lru);
+        }
+    }
+
+    size_t mMemoryBudget{0};
+    size_t mMemoryUsage{0};
+    size_t mPeakMemoryUsage{0};
+    int64_t mNbEvictions{0};
+    uint64_t mTick{0};
+    std::vector<Slot> mSlots;
+};
+
+} // namespace sample
+
+#endif // TRT_SAMPLE_CONTEXT_SLOTS_H
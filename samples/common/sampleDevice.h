@@ -535,6 +535,20 @@ inline void setCudaDevice(int device, std::ostream& os)
     // clang-format on
 }
 
+//!
+//! \brief NUMA node closest to the PCIe root of a device, -1 if unknown or if the system has a single node
+//!
+inline int32_t getDeviceNumaNode(int32_t device)
+{
+    constexpr int32_t kPCI_BUS_ID_LENGTH{32};
+    char pciBusId[kPCI_BUS_ID_LENGTH]{};
+    if (cudaDeviceGetPCIBusId(pciBusId, kPCI_BUS_ID_LENGTH, device) != cudaSuccess)
+    {
+        return -1;
+    }
+    return getPciNumaNode(pciBusId);
+}
+
 inline int32_t getCudaDriverVersion()
 {
     int32_t version{-1};
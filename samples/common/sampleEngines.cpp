@@ -21,9 +21,12 @@
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <mutex>
 #include <random>
 #include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -1385,6 +1388,215 @@ bool getEngineBuildEnv(
     return true;
 }
 
+namespace
+{
+
+//!
+//! \class SharedTimingCache
+//! \brief Timing cache shared by concurrent builds, which start from a copy and merge their cache back
+//!
+class SharedTimingCache
+{
+public:
+    //! Create the cache from a serialized cache, or empty if there is none.
+    bool init(std::vector<char> const& serialized)
+    {
+        mBuilder.reset(createBuilder());
+        if (mBuilder == nullptr)
+        {
+            return false;
+        }
+        mConfig.reset(mBuilder->createBuilderConfig());
+        if (mConfig == nullptr)
+        {
+            return false;
+        }
+        mCache.reset(mConfig->createTimingCache(serialized.data(), serialized.size()));
+        return mCache != nullptr;
+    }
+
+    //! Serialized copy of the cache.
+    std::vector<char> snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::unique_ptr<IHostMemory> blob{mCache->serialize()};
+        if (blob == nullptr)
+        {
+            return {};
+        }
+        auto const* data = static_cast<char const*>(blob->data());
+        return std::vector<char>(data, data + blob->size());
+    }
+
+    //! Merge a cache. Returns the growth of the serialized cache in bytes.
+    size_t merge(ITimingCache const& other)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        size_t const before = serializedSize();
+        mCache->combine(other, false);
+        size_t const after = serializedSize();
+        return after > before ? after - before : 0;
+    }
+
+    ITimingCache const* get() const
+    {
+        return mCache.get();
+    }
+
+private:
+    size_t serializedSize() const
+    {
+        std::unique_ptr<IHostMemory> blob{mCache->serialize()};
+        return blob == nullptr ? 0 : blob->size();
+    }
+
+    std::unique_ptr<IBuilder> mBuilder;
+    std::unique_ptr<IBuilderConfig> mConfig;
+    std::unique_ptr<ITimingCache> mCache;
+    mutable std::mutex mMutex;
+};
+
+//!
+//! \brief Build and save the engine of one variant, parsing its network from the in-memory model
+//!
+bool buildVariant(std::vector<char> const& modelData, ModelOptions const& model, BuildOptions const& build,
+    SystemOptions const& sys, SharedTimingCache& sharedCache, VariantBuildResult& result, std::ostream& err)
+{
+    std::unique_ptr<IBuilder> builder{createBuilder()};
+    SMP_RETVAL_IF_FALSE(builder != nullptr, "Builder creation failed", false, err);
+    builder->setErrorRecorder(&gRecorder);
+    for (auto const& pluginPath : sys.dynamicPlugins)
+    {
+        builder->getPluginRegistry().loadLibrary(pluginPath.c_str());
+    }
+
+    auto const networkFlags = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
+    std::unique_ptr<INetworkDefinition> network{builder->createNetworkV2(networkFlags)};
+    SMP_RETVAL_IF_FALSE(network != nullptr, "Network creation failed", false, err);
+    std::unique_ptr<nvonnxparser::IParser> parser{createONNXParser(*network)};
+    SMP_RETVAL_IF_FALSE(parser != nullptr, "Parser creation failed", false, err);
+    SMP_RETVAL_IF_FALSE(parser->parse(modelData.data(), modelData.size(), model.baseModel.model.c_str()),
+        "Parsing model failed", false, err);
+
+    std::unique_ptr<IBuilderConfig> config{builder->createBuilderConfig()};
+    std::unique_ptr<nvinfer1::IInt8Calibrator> calibrator;
+    std::vector<std::vector<int8_t>> sparseWeights;
+    SMP_RETVAL_IF_FALSE(config != nullptr, "Config creation failed", false, err);
+    SMP_RETVAL_IF_FALSE(setupNetworkAndConfig(build, sys, *builder, *network, *config, calibrator, err, sparseWeights),
+        "Network And Config setup failed", false, err);
+
+    std::unique_ptr<ITimingCache> timingCache{nullptr};
+    if (build.timingCacheMode != TimingCacheMode::kDISABLE)
+    {
+        std::vector<char> const snapshot = sharedCache.snapshot();
+        result.cacheStartBytes = snapshot.size();
+        timingCache.reset(config->createTimingCache(snapshot.data(), snapshot.size()));
+        SMP_RETVAL_IF_FALSE(timingCache != nullptr, "TimingCache creation failed", false, err);
+        config->setTimingCache(*timingCache, false);
+    }
+
+    // CUDA stream used for profiling by the builder.
+    auto profileStream = samplesCommon::makeCudaStream();
+    SMP_RETVAL_IF_FALSE(profileStream != nullptr, "Cuda stream creation failed", false, err);
+    config->setProfileStream(*profileStream);
+
+    std::unique_ptr<IHostMemory> serializedEngine{builder->buildSerializedNetwork(*network, *config)};
+    SMP_RETVAL_IF_FALSE(serializedEngine != nullptr, "Engine could not be created from network", false, err);
+
+    if (timingCache != nullptr)
+    {
+        result.cacheAddedBytes = sharedCache.merge(*config->getTimingCache());
+    }
+
+    std::ofstream engineFile(build.engine, std::ios::binary);
+    engineFile.write(static_cast<char const*>(serializedEngine->data()), serializedEngine->size());
+    SMP_RETVAL_IF_FALSE(!engineFile.fail(), "Saving engine to file failed.", false, err);
+    result.engineBytes = serializedEngine->size();
+    return true;
+}
+
+} // namespace
+
+bool buildVariants(ModelOptions const& model, std::vector<BuildOptions> const& variants, SystemOptions const& sys,
+    int32_t workers, std::vector<VariantBuildResult>& results, std::ostream& err)
+{
+    SMP_RETVAL_IF_FALSE(!variants.empty(), "No build variants", false, err);
+    std::ifstream modelFile(model.baseModel.model, std::ios::binary);
+    std::vector<char> const modelData{std::istreambuf_iterator<char>(modelFile), std::istreambuf_iterator<char>()};
+    SMP_RETVAL_IF_FALSE(!modelData.empty(), "Cannot read model file " + model.baseModel.model, false, err);
+
+    // The variants share one timing cache, backed by the timing cache file they all name.
+    auto const global = std::find_if(variants.begin(), variants.end(),
+        [](BuildOptions const& b) { return b.timingCacheMode == TimingCacheMode::kGLOBAL; });
+    bool const globalCache = global != variants.end();
+    std::string const cacheFile = globalCache ? global->timingCacheFile : std::string{};
+    SMP_RETVAL_IF_FALSE(std::all_of(variants.begin(), variants.end(),
+                            [&](BuildOptions const& b) {
+                                return b.timingCacheMode != TimingCacheMode::kGLOBAL || b.timingCacheFile == cacheFile;
+                            }),
+        "The build variants use different timing cache files", false, err);
+    SharedTimingCache sharedCache;
+    std::vector<char> const loadedCache
+        = globalCache ? samplesCommon::loadTimingCacheFile(cacheFile) : std::vector<char>{};
+    SMP_RETVAL_IF_FALSE(sharedCache.init(loadedCache), "TimingCache creation failed", false, err);
+
+    results.assign(variants.size(), VariantBuildResult{});
+    std::mutex mutex;
+    size_t next{0};
+    auto const worker = [&]() {
+        // The device is per thread.
+        cudaCheck(cudaSetDevice(sys.device));
+        while (true)
+        {
+            size_t v{0};
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (next == variants.size())
+                {
+                    return;
+                }
+                v = next++;
+            }
+            auto& result = results[v];
+            result.name = variants[v].engine;
+            sample::gLogInfo << "Building variant " << v << ": " << result.name << std::endl;
+
+            // Errors are buffered so that the messages of concurrent builds do not interleave.
+            std::ostringstream variantErr;
+            auto const start = std::chrono::high_resolution_clock::now();
+            result.succeeded = buildVariant(modelData, model, variants[v], sys, sharedCache, result, variantErr);
+            auto const end = std::chrono::high_resolution_clock::now();
+            result.buildMs = std::chrono::duration<float, std::milli>(end - start).count();
+            if (!result.succeeded)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                err << "Building variant " << v << " (" << result.name << ") failed:" << std::endl << variantErr.str();
+            }
+        }
+    };
+
+    int32_t const nbWorkers = std::max(1, std::min(workers, static_cast<int32_t>(variants.size())));
+    sample::gLogInfo << "Building " << variants.size() << " variants of " << model.baseModel.model << " with "
+                     << nbWorkers << " workers." << std::endl;
+    std::vector<std::thread> threads;
+    for (int32_t w = 0; w < nbWorkers; ++w)
+    {
+        threads.emplace_back(worker);
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    // The shared cache holds the tactics of every variant by now, so it is saved once.
+    if (globalCache)
+    {
+        samplesCommon::updateTimingCacheFile(cacheFile, sharedCache.get());
+    }
+
+    return std::all_of(results.begin(), results.end(), [](VariantBuildResult const& r) { return r.succeeded; });
+}
+
 // There is not a getWeightsName API, so we need to use WeightsRole.
 std::vector<std::pair<WeightsRole, Weights>> getAllRefitWeightsForLayer(const ILayer& l)
 {
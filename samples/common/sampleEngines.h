@@ -250,6 +250,33 @@ bool saveEngine(nvinfer1::ICudaEngine const& engine, std::string const& fileName
 bool getEngineBuildEnv(
     ModelOptions const& model, BuildOptions const& build, SystemOptions& sys, BuildEnvironment& env, std::ostream& err);
 
+//!
+//! \struct VariantBuildResult
+//! \brief Outcome of the build of one variant by buildVariants()
+//!
+struct VariantBuildResult
+{
+    std::string name;          //!< Engine file of the variant
+    bool succeeded{false};
+    float buildMs{0.F};        //!< From parsing the in-memory model to saving the engine
+    size_t cacheStartBytes{0}; //!< Size of the shared timing cache the build started from, 0 if disabled
+    size_t cacheAddedBytes{0}; //!< Growth of the shared timing cache when the variant was merged into it
+    size_t engineBytes{0};
+};
+
+//!
+//! \brief Build and save the engines of several variants of an ONNX model on a pool of worker threads
+//!
+//! The model file is read once and each variant parses its own network from memory, as the network is modified by
+//! its build options. The variants start from a snapshot of a shared timing cache and merge their timing cache into
+//! it once built. The shared cache is loaded from the timing cache file of the variants, which must all name the same
+//! one, and is saved back to it once all the workers are done.
+//!
+//! \return Whether all the variants were built and saved
+//!
+bool buildVariants(ModelOptions const& model, std::vector<BuildOptions> const& variants, SystemOptions const& sys,
+    int32_t workers, std::vector<VariantBuildResult>& results, std::ostream& err);
+
 //!
 //! \brief Create a serialized network
 //!
@@ -18,15 +18,19 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <cuda_profiler_api.h>
 #include <functional>
 #include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <numeric>
 #include <set>
 #include <sstream>
 #include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -196,7 +200,13 @@ void FillBindingClosure<nvinfer1::safe::ICudaEngine, nvinfer1::safe::IExecutionC
     tensorInfo.dataType = engine->getTensorDataType(name);
 }
 
-bool setUpInference(InferenceEnvironment& iEnv, InferenceOptions const& inference, SystemOptions const& system)
+namespace
+{
+
+//!
+//! \brief Whether bindings should use managed memory on the current device
+//!
+bool shouldUseManagedMemory(InferenceOptions const& inference)
 {
     int32_t device{};
     cudaCheck(cudaGetDevice(&device));
@@ -205,53 +215,32 @@ bool setUpInference(InferenceEnvironment& iEnv, InferenceOptions const& inferenc
     cudaCheck(cudaGetDeviceProperties(&properties, device));
     // Use managed memory on integrated devices when transfers are skipped
     // and when it is explicitly requested on the commandline.
-    bool useManagedMemory{(inference.skipTransfers && properties.integrated) || inference.useManaged};
-    using FillSafeBindings = FillBindingClosure<nvinfer1::safe::ICudaEngine, nvinfer1::safe::IExecutionContext>;
-    if (iEnv.safe)
-    {
-        ASSERT(sample::hasSafeRuntime());
-
-        auto* safeEngine = iEnv.engine.getSafe();
-        SMP_RETVAL_IF_FALSE(safeEngine != nullptr, "Got invalid safeEngine!", false, sample::gLogError);
-
-        // Release serialized blob to save memory space.
-        iEnv.engine.releaseBlob();
-
-        for (int32_t s = 0; s < inference.infStreams; ++s)
-        {
-            auto ec = safeEngine->createExecutionContext();
-            if (ec == nullptr)
-            {
-                sample::gLogError << "Unable to create execution context for stream " << s << "." << std::endl;
-                return false;
-            }
-            iEnv.safeContexts.emplace_back(ec);
-            iEnv.bindings.emplace_back(new Bindings(useManagedMemory));
-        }
-        int32_t const nbBindings = safeEngine->getNbBindings();
-        auto const* safeContext = iEnv.safeContexts.front().get();
-        // batch is set to 1 because safety only support explicit batch.
-        return FillSafeBindings(safeEngine, safeContext, inference.inputs, iEnv.bindings, 1, nbBindings)();
-    }
+    return (inference.skipTransfers && properties.integrated) || inference.useManaged;
+}
 
+//!
+//! \brief Create the execution contexts [firstContext, firstContext + nbContexts) of a standard engine, set their
+//!        input shapes and create their bindings.
+//!
+//! Slots in iEnv.contexts and iEnv.bindings are added as needed, and existing slots in the range are replaced.
+//!
+bool setUpContexts(InferenceEnvironment& iEnv, InferenceOptions const& inference, int32_t firstContext,
+    int32_t nbContexts, bool useManagedMemory, int32_t profile = 0)
+{
     using FillStdBindings = FillBindingClosure<nvinfer1::ICudaEngine, nvinfer1::IExecutionContext>;
 
     auto* engine = iEnv.engine.get();
     SMP_RETVAL_IF_FALSE(engine != nullptr, "Got invalid engine!", false, sample::gLogError);
 
-    bool const hasDLA = system.DLACore >= 0;
-    if (engine->hasImplicitBatchDimension() && hasDLA && inference.batch != engine->getMaxBatchSize())
+    int32_t const endContext = firstContext + nbContexts;
+    if (static_cast<int32_t>(iEnv.contexts.size()) < endContext)
     {
-        sample::gLogError << "When using DLA with an implicit batch engine, the inference batch size must be the same "
-                             "as the engine's maximum batch size. Please specify the batch size by adding: '--batch="
-                          << engine->getMaxBatchSize() << "' to your command." << std::endl;
-        return false;
+        iEnv.contexts.resize(endContext);
+        iEnv.bindings.resize(endContext);
     }
 
-    // Release serialized blob to save memory space.
-    iEnv.engine.releaseBlob();
-
-    for (int32_t s = 0; s < inference.infStreams; ++s)
+    std::vector<std::unique_ptr<Bindings>> newBindings;
+    for (int32_t s = firstContext; s < endContext; ++s)
     {
         auto ec = engine->createExecutionContext();
         if (ec == nullptr)
@@ -266,24 +255,25 @@ bool setUpInference(InferenceEnvironment& iEnv, InferenceOptions const& inferenc
         sample::gLogInfo << "Setting persistentCacheLimit to " << persistentCacheLimit << " bytes." << std::endl;
         ec->setPersistentCacheLimit(persistentCacheLimit);
 
-        iEnv.contexts.emplace_back(ec);
-        iEnv.bindings.emplace_back(new Bindings(useManagedMemory));
-    }
-    if (iEnv.profiler)
-    {
-        iEnv.contexts.front()->setProfiler(iEnv.profiler.get());
-        // Always run reportToProfiler() after enqueue launch
-        iEnv.contexts.front()->setEnqueueEmitsProfile(false);
+        if (profile != 0)
+        {
+            TrtCudaStream stream;
+            if (!ec->setOptimizationProfileAsync(profile, stream.get()))
+            {
+                sample::gLogError << "Unable to select optimization profile " << profile << " for stream " << s << "."
+                                  << std::endl;
+                return false;
+            }
+            stream.synchronize();
+        }
+
+        iEnv.contexts[s].reset(ec);
+        newBindings.emplace_back(new Bindings(useManagedMemory));
     }
 
     int32_t const nbOptProfiles = engine->getNbOptimizationProfiles();
     int32_t const endBindingIndex = engine->getNbIOTensors();
 
-    if (nbOptProfiles > 1)
-    {
-        sample::gLogWarning << "Multiple profiles are currently not supported. Running with one profile." << std::endl;
-    }
-
     // Make sure that the tensor names provided in command-line args actually exist in any of the engine bindings
     // to avoid silent typos.
     if (!validateTensorNames(inference.shapes, engine, endBindingIndex))
@@ -298,13 +288,14 @@ bool setUpInference(InferenceEnvironment& iEnv, InferenceOptions const& inferenc
     {
         sample::gLogVerbose << "Using enqueueV3." << std::endl;
     }
+    auto const newContexts = iEnv.contexts.begin() + firstContext;
     for (int32_t b = 0; b < endBindingIndex; ++b)
     {
         auto const& name = engine->getIOTensorName(b);
         auto const& mode = engine->getTensorIOMode(name);
         if (mode == TensorIOMode::kINPUT)
         {
-            Dims const dims = iEnv.contexts.front()->getTensorShape(name);
+            Dims const dims = (*newContexts)->getTensorShape(name);
             bool isShapeInferenceIO{false};
             if (useEnqueueV3)
             {
@@ -367,20 +358,20 @@ bool setUpInference(InferenceEnvironment& iEnv, InferenceOptions const& inferenc
                     shapeTensorData = iEnv.inputShapeTensorValues.back().data();
                 }
 
-                for (auto& c : iEnv.contexts)
+                for (auto c = newContexts; c != newContexts + nbContexts; ++c)
                 {
                     if (useEnqueueV3)
                     {
                         if (isShapeInferenceIO)
                         {
-                            if (!c->setTensorAddress(name, shapeTensorData))
+                            if (!(*c)->setTensorAddress(name, shapeTensorData))
                             {
                                 return false;
                             }
                         }
                         else
                         {
-                            if (!c->setInputShape(name, toDims(shapeData)))
+                            if (!(*c)->setInputShape(name, toDims(shapeData)))
                             {
                                 return false;
                             }
@@ -390,14 +381,14 @@ bool setUpInference(InferenceEnvironment& iEnv, InferenceOptions const& inferenc
                     {
                         if (isShapeInferenceIO)
                         {
-                            if (!c->setInputShapeBinding(b, shapeTensorData))
+                            if (!(*c)->setInputShapeBinding(b, shapeTensorData))
                             {
                                 return false;
                             }
                         }
                         else
                         {
-                            if (!c->setBindingDimensions(b, toDims(shapeData)))
+                            if (!(*c)->setBindingDimensions(b, toDims(shapeData)))
                             {
                                 return false;
                             }
@@ -408,9 +399,9 @@ bool setUpInference(InferenceEnvironment& iEnv, InferenceOptions const& inferenc
             else if (nbOptProfiles && shape != inference.shapes.end())
             {
                 // Check if the provided shape matches the static dimensions in the engine.
-                for (auto& c : iEnv.contexts)
+                for (auto c = newContexts; c != newContexts + nbContexts; ++c)
                 {
-                    if (!c->setInputShape(name, toDims(shape->second)))
+                    if (!(*c)->setInputShape(name, toDims(shape->second)))
                     {
                         return false;
                     }
@@ -419,13 +410,188 @@ bool setUpInference(InferenceEnvironment& iEnv, InferenceOptions const& inferenc
         }
     }
 
-    auto const* context = iEnv.contexts.front().get();
+    auto const* context = newContexts->get();
     int32_t const batch = engine->hasImplicitBatchDimension() ? inference.batch : 1;
-    return FillStdBindings(engine, context, inference.inputs, iEnv.bindings, batch, endBindingIndex)();
+    if (!FillStdBindings(engine, context, inference.inputs, newBindings, batch, endBindingIndex)())
+    {
+        return false;
+    }
+    std::move(newBindings.begin(), newBindings.end(), iEnv.bindings.begin() + firstContext);
+    return true;
+}
+
+//!
+//! \class ScopedThreadAffinity
+//! \brief Restricts the calling thread to a set of CPUs until destruction, then restores its previous affinity
+//!
+class ScopedThreadAffinity
+{
+public:
+    explicit ScopedThreadAffinity(std::vector<int32_t> const& cpus)
+    {
+        if (!cpus.empty())
+        {
+            mPrevious = getThreadAffinity();
+            mApplied = setThreadAffinity(cpus);
+        }
+    }
+
+    ~ScopedThreadAffinity()
+    {
+        if (mApplied && !mPrevious.empty())
+        {
+            setThreadAffinity(mPrevious);
+        }
+    }
+
+    ScopedThreadAffinity(ScopedThreadAffinity const&) = delete;
+    ScopedThreadAffinity& operator=(ScopedThreadAffinity const&) = delete;
+
+    bool applied() const
+    {
+        return mApplied;
+    }
+
+private:
+    std::vector<int32_t> mPrevious;
+    bool mApplied{false};
+};
+
+//! Map the input datasets, with the sample sizes of the input bindings.
+bool setUpDataset(InferenceEnvironment& iEnv, InferenceOptions const& inference)
+{
+    iEnv.dataset.reset();
+    if (inference.dataset.empty())
+    {
+        return true;
+    }
+
+    auto const& bindings = *iEnv.bindings.front();
+    auto const inputs = bindings.getInputBindings();
+    std::unique_ptr<InputDataset> dataset(new InputDataset);
+    for (auto const& input : inference.dataset)
+    {
+        size_t size{0};
+        if (inputs.find(input.first) == inputs.end() || bindings.getDeviceBuffer(input.first, size) == nullptr)
+        {
+            sample::gLogError << "Cannot feed " << input.first << " from a dataset: it is not an input with a known "
+                              << "shape." << std::endl;
+            return false;
+        }
+        if (!dataset->addInput(input.first, input.second, size))
+        {
+            return false;
+        }
+    }
+    sample::gLogInfo << "Input dataset: " << dataset->getNbSamples() << " samples of " << inference.dataset.size()
+                     << " inputs." << std::endl;
+    iEnv.dataset = std::move(dataset);
+    return true;
+}
+
+} // namespace
+
+bool setUpInference(
+    InferenceEnvironment& iEnv, InferenceOptions const& inference, SystemOptions const& system, int32_t profile)
+{
+    iEnv.placement.deviceNumaNode = getDeviceNumaNode(system.device);
+    iEnv.placement.hostNumaNode = numaNodeDisabled;
+    int32_t const hostNumaNode
+        = inference.hostNumaNode == numaNodeAuto ? iEnv.placement.deviceNumaNode : inference.hostNumaNode;
+    std::vector<int32_t> hostCpus;
+    if (inference.hostNumaNode != numaNodeDisabled)
+    {
+        hostCpus = getNumaNodeCpus(hostNumaNode);
+        if (hostCpus.empty())
+        {
+            sample::gLogWarning << "The CPUs of NUMA node " << hostNumaNode << " are unknown, the host buffers are "
+                                << "allocated without placement." << std::endl;
+        }
+    }
+    // Pinned host memory is backed when it is allocated and the input bindings are filled on this thread, so setting
+    // up while running on the CPUs of a node places the host buffers on that node under the default memory policy.
+    ScopedThreadAffinity const hostAffinity(hostCpus);
+    if (hostAffinity.applied())
+    {
+        iEnv.placement.hostNumaNode = hostNumaNode;
+    }
+
+    bool const useManagedMemory = shouldUseManagedMemory(inference);
+    using FillSafeBindings = FillBindingClosure<nvinfer1::safe::ICudaEngine, nvinfer1::safe::IExecutionContext>;
+    if (iEnv.safe)
+    {
+        ASSERT(sample::hasSafeRuntime());
+
+        auto* safeEngine = iEnv.engine.getSafe();
+        SMP_RETVAL_IF_FALSE(safeEngine != nullptr, "Got invalid safeEngine!", false, sample::gLogError);
+
+        // Release serialized blob to save memory space.
+        iEnv.engine.releaseBlob();
+
+        for (int32_t s = 0; s < inference.infStreams; ++s)
+        {
+            auto ec = safeEngine->createExecutionContext();
+            if (ec == nullptr)
+            {
+                sample::gLogError << "Unable to create execution context for stream " << s << "." << std::endl;
+                return false;
+            }
+            iEnv.safeContexts.emplace_back(ec);
+            iEnv.bindings.emplace_back(new Bindings(useManagedMemory));
+        }
+        int32_t const nbBindings = safeEngine->getNbBindings();
+        auto const* safeContext = iEnv.safeContexts.front().get();
+        // batch is set to 1 because safety only support explicit batch.
+        if (!FillSafeBindings(safeEngine, safeContext, inference.inputs, iEnv.bindings, 1, nbBindings)())
+        {
+            return false;
+        }
+        return setUpDataset(iEnv, inference);
+    }
+
+    auto* engine = iEnv.engine.get();
+    SMP_RETVAL_IF_FALSE(engine != nullptr, "Got invalid engine!", false, sample::gLogError);
+
+    bool const hasDLA = system.DLACore >= 0;
+    if (engine->hasImplicitBatchDimension() && hasDLA && inference.batch != engine->getMaxBatchSize())
+    {
+        sample::gLogError << "When using DLA with an implicit batch engine, the inference batch size must be the same "
+                             "as the engine's maximum batch size. Please specify the batch size by adding: '--batch="
+                          << engine->getMaxBatchSize() << "' to your command." << std::endl;
+        return false;
+    }
+
+    if (!inference.shapeSequence.empty() && engine->hasImplicitBatchDimension())
+    {
+        sample::gLogError << "--shapeSequence requires an engine with explicit batch dimensions." << std::endl;
+        return false;
+    }
+
+    // Release serialized blob to save memory space.
+    iEnv.engine.releaseBlob();
+
+    if (engine->getNbOptimizationProfiles() > 1)
+    {
+        sample::gLogInfo << "Running with optimization profile " << profile << " of "
+                         << engine->getNbOptimizationProfiles() << "." << std::endl;
+    }
+
+    if (!setUpContexts(iEnv, inference, 0, inference.infStreams, useManagedMemory, profile))
+    {
+        return false;
+    }
+
+    if (iEnv.profiler)
+    {
+        iEnv.contexts.front()->setProfiler(iEnv.profiler.get());
+        // Always run reportToProfiler() after enqueue launch
+        iEnv.contexts.front()->setEnqueueEmitsProfile(false);
+    }
+    return setUpDataset(iEnv, inference);
 }
 
-TaskInferenceEnvironment::TaskInferenceEnvironment(
-    std::string engineFile, InferenceOptions inference, int32_t deviceId, int32_t DLACore, int32_t bs)
+TaskInferenceEnvironment::TaskInferenceEnvironment(std::string engineFile, InferenceOptions inference, int32_t deviceId,
+    int32_t DLACore, int32_t bs, int32_t profile)
     : iOptions(inference)
     , device(deviceId)
     , batch(bs)
@@ -439,11 +605,156 @@ TaskInferenceEnvironment::TaskInferenceEnvironment(
     SystemOptions system{};
     system.device = device;
     system.DLACore = DLACore;
-    if (!setUpInference(*iEnv, iOptions, system))
+    if (!setUpInference(*iEnv, iOptions, system, profile))
     {
         sample::gLogError << "Inference set up failed" << std::endl;
     }
 }
+
+TaskInferenceEnvironment::TaskInferenceEnvironment(ContextPool& contextPool, std::string const& engineFile,
+    InferenceOptions inference, int32_t deviceId, int32_t DLACore, int32_t bs, int32_t profile)
+    : iOptions(inference)
+    , device(deviceId)
+    , batch(bs)
+{
+    auto const lease = contextPool.acquire(engineFile, iOptions, device, DLACore, profile);
+    if (!lease.iEnv)
+    {
+        sample::gLogError << "Inference set up failed" << std::endl;
+        return;
+    }
+    iEnv = lease.iEnv;
+    streamIdx = lease.streamIdx;
+    pool = &contextPool;
+}
+
+TaskInferenceEnvironment::~TaskInferenceEnvironment()
+{
+    if (pool != nullptr)
+    {
+        pool->release({iEnv, streamIdx});
+    }
+}
+
+namespace
+{
+
+//!
+//! \brief Key of a pooled context: everything that affects the state of a context and its bindings.
+//!
+std::string getContextKey(InferenceOptions const& inference, int32_t profile)
+{
+    std::map<std::string, std::vector<int32_t>> const shapes(inference.shapes.begin(), inference.shapes.end());
+    std::map<std::string, std::string> const inputs(inference.inputs.begin(), inference.inputs.end());
+    std::ostringstream key;
+    key << "profile=" << profile << ";batch=" << inference.batch << ";managed=" << shouldUseManagedMemory(inference)
+        << ";persistentCacheRatio=" << inference.persistentCacheRatio;
+    for (auto const& shape : shapes)
+    {
+        key << ";shape:" << shape.first << "=" << shape.second;
+    }
+    for (auto const& input : inputs)
+    {
+        key << ";input:" << input.first << "=" << input.second;
+    }
+    return key.str();
+}
+
+} // namespace
+
+ContextPool::Lease ContextPool::acquire(
+    std::string const& engineFile, InferenceOptions const& inference, int32_t device, int32_t DLACore, int32_t profile)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    cudaCheck(cudaSetDevice(device));
+
+    std::string const engineKey
+        = engineFile + ";device=" + std::to_string(device) + ";DLACore=" + std::to_string(DLACore);
+    std::string const contextKey = engineKey + ";" + getContextKey(inference, profile);
+
+    if (auto const* idle = mSlots.acquire(contextKey))
+    {
+        ++mStatistics.hits;
+        return {mEngines.at(engineKey).iEnv, idle->streamIdx};
+    }
+    ++mStatistics.misses;
+
+    auto& engineEntry = mEngines[engineKey];
+    if (!engineEntry.iEnv)
+    {
+        BuildEnvironment bEnv(
+            /* isSafe */ false, /* versionCompatible */ false, DLACore, "", getTempfileControlDefaults());
+        if (!loadEngineToBuildEnv(engineFile, false, bEnv, sample::gLogError))
+        {
+            mEngines.erase(engineKey);
+            return {};
+        }
+        std::shared_ptr<InferenceEnvironment> iEnv(new InferenceEnvironment(bEnv));
+        if (iEnv->engine.get() == nullptr)
+        {
+            mEngines.erase(engineKey);
+            return {};
+        }
+        // Release serialized blob to save memory space.
+        iEnv->engine.releaseBlob();
+        engineEntry.iEnv = std::move(iEnv);
+        ++mStatistics.engineLoads;
+    }
+    auto& iEnv = *engineEntry.iEnv;
+
+    int32_t streamIdx = static_cast<int32_t>(iEnv.contexts.size());
+    if (!engineEntry.freeStreams.empty())
+    {
+        streamIdx = engineEntry.freeStreams.back();
+        engineEntry.freeStreams.pop_back();
+    }
+    if (!setUpContexts(iEnv, inference, streamIdx, 1, shouldUseManagedMemory(inference), profile))
+    {
+        // Drop the partly set up context, so that a later lease of the stream index starts afresh.
+        iEnv.contexts[streamIdx].reset();
+        iEnv.bindings[streamIdx].reset();
+        engineEntry.freeStreams.push_back(streamIdx);
+        return {};
+    }
+
+    size_t const memorySize
+        = iEnv.engine.get()->getDeviceMemorySize() + iEnv.bindings[streamIdx]->getDeviceMemorySize();
+    mSlots.add(&iEnv, contextKey, streamIdx, memorySize,
+        [this](ContextSlots<InferenceEnvironment>::Slot const& slot) { freeContext(slot); });
+    return {engineEntry.iEnv, streamIdx};
+}
+
+void ContextPool::release(Lease const& lease)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSlots.release(lease.iEnv.get(), lease.streamIdx,
+        [this](ContextSlots<InferenceEnvironment>::Slot const& slot) { freeContext(slot); });
+}
+
+void ContextPool::freeContext(ContextSlots<InferenceEnvironment>::Slot const& slot)
+{
+    slot.owner->contexts[slot.streamIdx].reset();
+    slot.owner->bindings[slot.streamIdx].reset();
+    for (auto& engine : mEngines)
+    {
+        if (engine.second.iEnv.get() == slot.owner)
+        {
+            engine.second.freeStreams.push_back(slot.streamIdx);
+        }
+    }
+}
+
+ContextPoolStatistics ContextPool::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto statistics = mStatistics;
+    statistics.evictions = mSlots.getNbEvictions();
+    statistics.memoryUsage = mSlots.getMemoryUsage();
+    statistics.peakMemoryUsage = mSlots.getPeakMemoryUsage();
+    statistics.memoryBudget = mSlots.getMemoryBudget();
+    return statistics;
+}
+
 namespace
 {
 
@@ -631,13 +942,242 @@ public:
         return false;
     }
 
-    nvinfer1::safe::IExecutionContext& mContext;
-private:
-    Bindings const& mBindings;
+    nvinfer1::safe::IExecutionContext& mContext;
+private:
+    Bindings const& mBindings;
+};
+
+using EnqueueFunction = std::function<bool(TrtCudaStream&)>;
+
+//!
+//! \class GraphCache
+//! \brief CUDA graphs of one stream keyed by input shapes, evicted in least recently used order beyond a capacity
+//!
+class GraphCache
+{
+public:
+    explicit GraphCache(int32_t capacity)
+        : mCapacity(static_cast<size_t>(capacity))
+    {
+    }
+
+    //! Graph captured for key, nullptr if there is none. Counts a hit or a miss.
+    TrtCudaGraph* find(std::string const& key)
+    {
+        auto const match = mGraphs.find(key);
+        if (match == mGraphs.end())
+        {
+            ++mStatistics.misses;
+            return nullptr;
+        }
+        ++mStatistics.hits;
+        match->second.lastUsed = ++mTick;
+        return match->second.graph.get();
+    }
+
+    //! Capture the work enqueued by enqueue on stream as the graph of key. The work is not executed.
+    void capture(std::string const& key, TrtCudaStream& stream, EnqueueFunction const& enqueue)
+    {
+        if (mUncapturable.count(key) != 0)
+        {
+            return;
+        }
+        auto const start = getCurrentTime();
+        std::unique_ptr<TrtCudaGraph> graph(new TrtCudaGraph);
+        graph->beginCapture(stream);
+        if (!enqueue(stream))
+        {
+            graph->endCaptureOnError(stream);
+            // Ensure any CUDA error has been cleaned up.
+            cudaCheck(cudaGetLastError());
+            sample::gLogWarning << "Shape " << key << " contains operations that are not permitted under CUDA graph "
+                                << "capture mode and will be launched without using CUDA graph launch." << std::endl;
+            mUncapturable.insert(key);
+            ++mStatistics.captureFailures;
+            return;
+        }
+        graph->endCapture(stream);
+        mStatistics.captureMs += std::chrono::duration<float, std::milli>(getCurrentTime() - start).count();
+        ++mStatistics.captures;
+
+        if (mGraphs.size() >= mCapacity)
+        {
+            auto const lru = std::min_element(mGraphs.begin(), mGraphs.end(),
+                [](GraphMap::value_type const& a, GraphMap::value_type const& b) {
+                    return a.second.lastUsed < b.second.lastUsed;
+                });
+            // A graph still in flight is released by CUDA when its launch completes.
+            mGraphs.erase(lru);
+            ++mStatistics.evictions;
+        }
+        mGraphs[key] = Entry{std::move(graph), ++mTick};
+    }
+
+    GraphCacheStatistics const& getStatistics() const
+    {
+        return mStatistics;
+    }
+
+private:
+    struct Entry
+    {
+        std::unique_ptr<TrtCudaGraph> graph;
+        uint64_t lastUsed{0};
+    };
+    using GraphMap = std::unordered_map<std::string, Entry>;
+
+    size_t mCapacity{1};
+    uint64_t mTick{0};
+    GraphMap mGraphs;
+    std::set<std::string> mUncapturable;
+    GraphCacheStatistics mStatistics;
+};
+
+//!
+//! \class DatasetFeeder
+//! \brief Stages the dataset samples of one stream in pinned host buffers from a prefetch thread
+//!
+//! Stream s of S reads samples s, s + S, s + 2S, ... in turn, wrapping around the dataset. The samples are copied
+//! from the mapped files into depth + 1 slots ahead of the iterations, so reading the files and faulting their pages
+//! in happens outside the measured transfers. The slot of a transfer is refilled once the iteration that issued it
+//! has been synchronized, which is known when its depth is reused.
+//!
+class DatasetFeeder
+{
+public:
+    DatasetFeeder(InputDataset const& dataset, Bindings const& bindings, int32_t streamId, int32_t nbStreams,
+        int32_t depth)
+        : mDataset(dataset)
+        , mStreamId(streamId)
+        , mNbStreams(nbStreams)
+        , mDepth(depth)
+        , mSlots(depth + 1)
+    {
+        for (auto const& input : dataset.getInputs())
+        {
+            size_t size{0};
+            void* device = bindings.getDeviceBuffer(input.first, size);
+            mInputs.push_back(Input{input.first, device, std::min(size, input.second)});
+            for (auto& slot : mSlots)
+            {
+                slot.emplace_back(input.second);
+            }
+        }
+        mPrefetch = std::thread(&DatasetFeeder::prefetch, this);
+    }
+
+    ~DatasetFeeder()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+        mPrefetch.join();
+    }
+
+    DatasetFeeder(DatasetFeeder const&) = delete;
+    DatasetFeeder& operator=(DatasetFeeder const&) = delete;
+
+    //! True if the input is fed from the dataset rather than from its binding.
+    bool feeds(std::string const& name) const
+    {
+        return std::any_of(mInputs.begin(), mInputs.end(), [&name](Input const& i) { return i.name == name; });
+    }
+
+    //! Copy the next sample to the device on stream, waiting for it to be staged if needed.
+    void transfer(TrtCudaStream& stream)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        int64_t const next = mConsumed++;
+        // The transfer issued mDepth iterations ago has completed, as its iteration was synchronized.
+        mReleased = std::max(mReleased, next - mDepth + 1);
+        mCondition.notify_all();
+        if (mFilled <= next)
+        {
+            ++mStalls;
+            mCondition.wait(lock, [this, next] { return mFilled > next; });
+        }
+        lock.unlock();
+
+        auto const& slot = mSlots[next % mSlots.size()];
+        for (size_t i = 0; i < mInputs.size(); ++i)
+        {
+            cudaCheck(cudaMemcpyAsync(
+                mInputs[i].device, slot[i].get(), mInputs[i].size, cudaMemcpyHostToDevice, stream.get()));
+        }
+    }
+
+    //! Release the slots of all the transfers issued, once they are known to have completed.
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mReleased = mConsumed;
+        }
+        mCondition.notify_all();
+    }
+
+    //! Number of transfers that waited for their sample to be staged.
+    int64_t getStalls() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStalls;
+    }
+
+private:
+    struct Input
+    {
+        std::string name;
+        void* device{nullptr};
+        size_t size{0};
+    };
+
+    void prefetch()
+    {
+        int64_t const nbSamples = mDataset.getNbSamples();
+        int64_t const nbSlots = static_cast<int64_t>(mSlots.size());
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true)
+        {
+            mCondition.wait(lock, [this, nbSlots] { return mStop || mFilled - mReleased < nbSlots; });
+            if (mStop)
+            {
+                return;
+            }
+            int64_t const next = mFilled;
+            lock.unlock();
+
+            auto& slot = mSlots[next % nbSlots];
+            int64_t const sample = (mStreamId + next * mNbStreams) % nbSamples;
+            for (size_t i = 0; i < mInputs.size(); ++i)
+            {
+                std::memcpy(slot[i].get(), mDataset.getSample(mInputs[i].name, sample), mInputs[i].size);
+            }
+
+            lock.lock();
+            ++mFilled;
+            mCondition.notify_all();
+        }
+    }
+
+    InputDataset const& mDataset;
+    int64_t mStreamId{0};
+    int64_t mNbStreams{1};
+    int64_t mDepth{1};
+    std::vector<Input> mInputs;
+    std::vector<std::vector<TrtHostBuffer>> mSlots; //!< Staging buffers per slot, in the order of mInputs
+
+    mutable std::mutex mMutex;
+    std::condition_variable mCondition;
+    int64_t mFilled{0};   //!< Samples staged by the prefetch thread
+    int64_t mConsumed{0}; //!< Transfers issued
+    int64_t mReleased{0}; //!< Transfers known to have completed
+    int64_t mStalls{0};
+    bool mStop{false};
+    std::thread mPrefetch;
 };
 
-using EnqueueFunction = std::function<bool(TrtCudaStream&)>;
-
 enum class StreamType : int32_t
 {
     kINPUT = 0,
@@ -672,7 +1212,8 @@ class Iteration
 {
 
 public:
-    Iteration(int32_t id, InferenceOptions const& inference, ContextType& context, Bindings& bindings)
+    Iteration(int32_t id, InferenceOptions const& inference, ContextType& context, Bindings& bindings,
+        InputDataset const* dataset = nullptr)
         : mBindings(bindings)
         , mStreamId(id)
         , mDepth(1 + inference.overlap)
@@ -689,6 +1230,10 @@ public:
             }
         }
         createEnqueueFunction(inference, context, bindings);
+        if (dataset)
+        {
+            mFeeder.reset(new DatasetFeeder(*dataset, bindings, id, inference.infStreams, mDepth));
+        }
     }
 
     bool query(bool skipTransfers)
@@ -765,11 +1310,24 @@ public:
 
     void setInputData(bool sync)
     {
-        mBindings.transferInputToDevice(getStream(StreamType::kINPUT));
+        if (mFeeder)
+        {
+            mBindings.transferInputToDevice(
+                getStream(StreamType::kINPUT), [this](std::string const& name) { return !mFeeder->feeds(name); });
+            mFeeder->transfer(getStream(StreamType::kINPUT));
+        }
+        else
+        {
+            mBindings.transferInputToDevice(getStream(StreamType::kINPUT));
+        }
         // additional sync to avoid overlapping with inference execution.
         if (sync)
         {
             getStream(StreamType::kINPUT).synchronize();
+            if (mFeeder)
+            {
+                mFeeder->release();
+            }
         }
     }
 
@@ -783,6 +1341,16 @@ public:
         }
     }
 
+    GraphCacheStatistics getGraphCacheStatistics() const
+    {
+        return mGraphCache ? mGraphCache->getStatistics() : GraphCacheStatistics{};
+    }
+
+    int64_t getDatasetStalls() const
+    {
+        return mFeeder ? mFeeder->getStalls() : 0;
+    }
+
 private:
     void moveNext()
     {
@@ -848,6 +1416,11 @@ private:
         {
             mEnqueue = EnqueueFunction(EnqueueExplicit(context, mBindings));
         }
+        if (!inference.shapeSequence.empty())
+        {
+            createShapeSequence(inference, context);
+            return;
+        }
         if (inference.graph)
         {
             TrtCudaStream& stream = getStream(StreamType::kCOMPUTE);
@@ -880,6 +1453,62 @@ private:
         }
     }
 
+    //! Enqueue the iterations with the input shapes of the sequence in turn, from a graph per shape if enabled.
+    void createShapeSequence(InferenceOptions const& inference, nvinfer1::IExecutionContext& context)
+    {
+        for (auto const& step : inference.shapeSequence)
+        {
+            std::vector<std::pair<std::string, nvinfer1::Dims>> shapes;
+            for (auto const& s : step)
+            {
+                shapes.emplace_back(s.first, toDims(s.second));
+            }
+            std::sort(shapes.begin(), shapes.end(),
+                [](std::pair<std::string, nvinfer1::Dims> const& a, std::pair<std::string, nvinfer1::Dims> const& b) {
+                    return a.first < b.first;
+                });
+            std::ostringstream key;
+            for (auto const& s : shapes)
+            {
+                key << (key.tellp() == 0 ? "" : ",") << s.first << ":" << s.second;
+            }
+            mShapeSequence.emplace_back(std::move(shapes));
+            mShapeKeys.emplace_back(key.str());
+        }
+        if (inference.graph)
+        {
+            mGraphCache.reset(new GraphCache(inference.graphCacheSize));
+        }
+
+        mEnqueueDirect = std::move(mEnqueue);
+        mEnqueue = [this, &context](TrtCudaStream& stream) {
+            size_t const step = mShapeStep;
+            mShapeStep = (mShapeStep + 1) % mShapeSequence.size();
+            for (auto const& s : mShapeSequence[step])
+            {
+                if (!context.setInputShape(s.first.c_str(), s.second))
+                {
+                    return false;
+                }
+            }
+            if (!mGraphCache)
+            {
+                return mEnqueueDirect(stream);
+            }
+            if (auto* graph = mGraphCache->find(mShapeKeys[step]))
+            {
+                return EnqueueGraph(context, *graph)(stream);
+            }
+            // The first iteration of a shape runs directly, which also avoids capturing its initialization calls.
+            if (!mEnqueueDirect(stream))
+            {
+                return false;
+            }
+            mGraphCache->capture(mShapeKeys[step], stream, mEnqueueDirect);
+            return true;
+        };
+    }
+
     void createEnqueueFunction(InferenceOptions const& inference, nvinfer1::safe::IExecutionContext& context, Bindings&)
     {
         mEnqueue = EnqueueFunction(EnqueueSafe(context, mBindings));
@@ -901,6 +1530,14 @@ private:
     TrtCudaGraph mGraph;
     EnqueueFunction mEnqueue;
 
+    std::vector<std::vector<std::pair<std::string, nvinfer1::Dims>>> mShapeSequence;
+    std::vector<std::string> mShapeKeys;
+    size_t mShapeStep{0};
+    EnqueueFunction mEnqueueDirect;
+    std::unique_ptr<GraphCache> mGraphCache;
+
+    std::unique_ptr<DatasetFeeder> mFeeder;
+
     int32_t mStreamId{0};
     int32_t mNext{0};
     int32_t mDepth{2}; // default to double buffer to hide DMA transfers
@@ -964,13 +1601,25 @@ void inferenceExecution(InferenceOptions const& inference, InferenceEnvironment&
 
     cudaCheck(cudaSetDevice(device));
 
+    // Each thread only updates its own entry, the list itself is sized before the threads start.
+    if (static_cast<size_t>(threadIdx) < iEnv.placement.threadCpus.size())
+    {
+        auto& cpus = iEnv.placement.threadCpus[threadIdx];
+        if (!cpus.empty() && !setThreadAffinity(cpus))
+        {
+            sample::gLogWarning << "Unable to pin inference thread " << threadIdx << " to CPUs "
+                                << cpuListToString(cpus) << "." << std::endl;
+            cpus.clear();
+        }
+    }
+
     std::vector<std::unique_ptr<Iteration<ContextType>>> iStreams;
 
     for (int32_t s = 0; s < streamsPerThread; ++s)
     {
         int32_t const streamId{threadIdx * streamsPerThread + s};
-        auto* iteration = new Iteration<ContextType>(
-            streamId, inference, *iEnv.template getContext<ContextType>(streamId), *iEnv.bindings[streamId]);
+        auto* iteration = new Iteration<ContextType>(streamId, inference,
+            *iEnv.template getContext<ContextType>(streamId), *iEnv.bindings[streamId], iEnv.dataset.get());
         if (inference.skipTransfers)
         {
             iteration->setInputData(true);
@@ -983,6 +1632,13 @@ void inferenceExecution(InferenceOptions const& inference, InferenceEnvironment&
         s->wait(sync.gpuStart);
     }
 
+    HostUsage usage;
+    double cpuStartMs{0.0};
+    int64_t voluntaryStart{0};
+    int64_t involuntaryStart{0};
+    bool const measured = getThreadUsage(cpuStartMs, voluntaryStart, involuntaryStart);
+    auto const loopStart = getCurrentTime();
+
     std::vector<InferenceTrace> localTrace;
     if (!inferenceLoop(iStreams, sync.cpuStart, sync.gpuStart, inference.iterations, durationMs, warmupMs, localTrace,
             inference.skipTransfers, inference.idle))
@@ -990,6 +1646,19 @@ void inferenceExecution(InferenceOptions const& inference, InferenceEnvironment&
         iEnv.error = true;
     }
 
+    double cpuEndMs{0.0};
+    int64_t voluntaryEnd{0};
+    int64_t involuntaryEnd{0};
+    if (measured && getThreadUsage(cpuEndMs, voluntaryEnd, involuntaryEnd))
+    {
+        usage.threads = 1;
+        usage.queries = static_cast<int64_t>(localTrace.size());
+        usage.cpuMs = cpuEndMs - cpuStartMs;
+        usage.wallMs = std::chrono::duration<double, std::milli>(getCurrentTime() - loopStart).count();
+        usage.voluntarySwitches = voluntaryEnd - voluntaryStart;
+        usage.involuntarySwitches = involuntaryEnd - involuntaryStart;
+    }
+
     if (inference.skipTransfers)
     {
         for (auto& s : iStreams)
@@ -998,8 +1667,24 @@ void inferenceExecution(InferenceOptions const& inference, InferenceEnvironment&
         }
     }
 
+    int64_t stalls{0};
+    for (auto& s : iStreams)
+    {
+        stalls += s->getDatasetStalls();
+    }
+    if (stalls > 0)
+    {
+        sample::gLogWarning << "Inference thread " << threadIdx << " waited " << stalls << " times for dataset samples "
+                            << "to be staged, the host to device times may include reading the dataset." << std::endl;
+    }
+
     sync.mutex.lock();
     trace.insert(trace.end(), localTrace.begin(), localTrace.end());
+    for (auto& s : iStreams)
+    {
+        iEnv.graphCacheStatistics += s->getGraphCacheStatistics();
+    }
+    iEnv.hostUsage += usage;
     sync.mutex.unlock();
 }
 
@@ -1018,6 +1703,61 @@ inline std::thread makeThread(InferenceOptions const& inference, InferenceEnviro
         std::ref(sync), threadIdx, streamsPerThread, device, std::ref(trace));
 }
 
+//!
+//! \class ResidentSetSampler
+//! \brief Samples the resident set size of the process from a thread until destruction and keeps its peak
+//!
+class ResidentSetSampler
+{
+public:
+    ResidentSetSampler()
+        : mPeak(getResidentSetSize())
+        , mSampler(&ResidentSetSampler::sample, this)
+    {
+    }
+
+    ~ResidentSetSampler()
+    {
+        stop();
+    }
+
+    ResidentSetSampler(ResidentSetSampler const&) = delete;
+    ResidentSetSampler& operator=(ResidentSetSampler const&) = delete;
+
+    //! Stop sampling and return the peak, in bytes.
+    int64_t stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+        if (mSampler.joinable())
+        {
+            mSampler.join();
+        }
+        return std::max(mPeak, getResidentSetSize());
+    }
+
+private:
+    void sample()
+    {
+        // Frequent enough to catch the allocations of a run, rare enough not to compete with the inference threads.
+        constexpr std::chrono::milliseconds kSAMPLING_PERIOD{10};
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (!mCondition.wait_for(lock, kSAMPLING_PERIOD, [this] { return mStop; }))
+        {
+            mPeak = std::max(mPeak, getResidentSetSize());
+        }
+    }
+
+    int64_t mPeak{0};
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStop{false};
+    std::thread mSampler;
+};
+
 } // namespace
 
 bool runInference(
@@ -1026,6 +1766,8 @@ bool runInference(
     cudaCheck(cudaProfilerStart());
 
     trace.resize(0);
+    iEnv.graphCacheStatistics = GraphCacheStatistics{};
+    iEnv.hostUsage = HostUsage{};
 
     SyncStruct sync;
     sync.sleep = inference.sleep;
@@ -1039,6 +1781,27 @@ bool runInference(
     int32_t const numThreads = inference.threads ? inference.infStreams : 1;
     int32_t const streamsPerThread = inference.threads ? 1 : inference.infStreams;
 
+    // The CPU lists are assigned to the threads in turn.
+    iEnv.placement.threadCpus.assign(numThreads, {});
+    if (inference.threadCpusLocal)
+    {
+        auto const cpus = getNumaNodeCpus(getDeviceNumaNode(device));
+        if (cpus.empty())
+        {
+            sample::gLogWarning << "The NUMA node of device " << device << " is unknown, the inference threads are "
+                                << "not pinned." << std::endl;
+        }
+        iEnv.placement.threadCpus.assign(numThreads, cpus);
+    }
+    else if (!inference.threadCpus.empty())
+    {
+        for (int32_t threadIdx = 0; threadIdx < numThreads; ++threadIdx)
+        {
+            iEnv.placement.threadCpus[threadIdx] = inference.threadCpus[threadIdx % inference.threadCpus.size()];
+        }
+    }
+
+    ResidentSetSampler residentSet;
     std::vector<std::thread> threads;
     for (int32_t threadIdx = 0; threadIdx < numThreads; ++threadIdx)
     {
@@ -1048,6 +1811,7 @@ bool runInference(
     {
         th.join();
     }
+    iEnv.hostUsage.peakRss = residentSet.stop();
 
     cudaCheck(cudaProfilerStop());
 
@@ -1057,8 +1821,227 @@ bool runInference(
     return !iEnv.error;
 }
 
+namespace
+{
+
+//! Relative throughput gain below which the autotuner stops adding streams.
+constexpr float kAUTOTUNE_MIN_GAIN{0.02F};
+
+//!
+//! \class AutotuneSearch
+//! \brief Runs the configurations visited by runAutotune(), measuring each one once
+//!
+class AutotuneSearch
+{
+public:
+    AutotuneSearch(InferenceOptions const& inference, SystemOptions const& system, InferenceEnvironment& iEnv,
+        AutotuneResult& result)
+        : mInference(inference)
+        , mSystem(system)
+        , mIEnv(iEnv)
+        , mResult(result)
+    {
+        auto const* engine = iEnv.engine.get();
+        mImplicitBatch = engine->hasImplicitBatchDimension();
+        if (mImplicitBatch)
+        {
+            mMaxBatch = engine->getMaxBatchSize();
+        }
+        else
+        {
+            // The batch dimension is the leading runtime dimension of the inputs, bounded by the first profile.
+            mMaxBatch = std::numeric_limits<int32_t>::max();
+            for (int32_t b = 0, n = engine->getNbIOTensors(); b < n; ++b)
+            {
+                auto const* name = engine->getIOTensorName(b);
+                Dims const dims = engine->getTensorShape(name);
+                if (engine->getTensorIOMode(name) != TensorIOMode::kINPUT || engine->isShapeInferenceIO(name)
+                    || dims.nbDims == 0 || dims.d[0] != -1)
+                {
+                    continue;
+                }
+                auto const shape = inference.shapes.find(name);
+                Dims const opt = engine->getProfileShape(name, 0, OptProfileSelector::kOPT);
+                mBatchInputs[name] = shape != inference.shapes.end() ? shape->second
+                                                                     : std::vector<int32_t>(opt.d, opt.d + opt.nbDims);
+                mMaxBatch = std::min(mMaxBatch, engine->getProfileShape(name, 0, OptProfileSelector::kMAX).d[0]);
+            }
+            if (mBatchInputs.empty())
+            {
+                mMaxBatch = 1;
+            }
+        }
+        if (inference.autotuneMaxBatch > 0)
+        {
+            mMaxBatch = std::min(mMaxBatch, inference.autotuneMaxBatch);
+        }
+    }
+
+    int32_t getMaxBatch() const
+    {
+        return mMaxBatch;
+    }
+
+    //! Returns the point of a configuration, running it if it was not measured yet.
+    AutotunePoint measure(int32_t batch, int32_t streams, bool threads)
+    {
+        auto const key = std::make_tuple(batch, streams, threads);
+        auto const measured = mMeasured.find(key);
+        if (measured != mMeasured.end())
+        {
+            return mResult.points[measured->second];
+        }
+
+        AutotunePoint point;
+        point.batch = batch;
+        point.infStreams = streams;
+        point.threads = threads;
+
+        InferenceOptions options = mInference;
+        options.infStreams = streams;
+        options.threads = threads;
+        if (mImplicitBatch)
+        {
+            options.batch = batch;
+        }
+        for (auto const& input : mBatchInputs)
+        {
+            auto& shape = options.shapes[input.first];
+            shape = input.second;
+            shape[0] = batch;
+        }
+
+        // Release the contexts of the previous configuration before creating the new ones.
+        mIEnv.contexts.clear();
+        mIEnv.bindings.clear();
+        mIEnv.inputShapeTensorValues.clear();
+        mIEnv.error = false;
+
+        std::vector<InferenceTrace> trace;
+        point.succeeded
+            = setUpInference(mIEnv, options, mSystem) && runInference(options, mIEnv, mSystem.device, trace);
+        if (point.succeeded)
+        {
+            summarizeAutotuneTrace(trace, options.warmup, point);
+        }
+        point.withinBudget = point.succeeded && point.latencyPercentile <= mResult.latencyBudget;
+        sample::gLogInfo << "Autotune: batch = " << batch << ", streams = " << streams
+                         << ", threads = " << (threads ? "enabled" : "disabled");
+        if (point.succeeded)
+        {
+            sample::gLogInfo << ": throughput = " << point.throughput << " qps, percentile(" << kAUTOTUNE_PERCENTILE
+                             << "%) latency = " << point.latencyPercentile << " ms" << std::endl;
+        }
+        else
+        {
+            sample::gLogInfo << ": failed" << std::endl;
+        }
+
+        mMeasured[key] = static_cast<int32_t>(mResult.points.size());
+        mResult.points.push_back(point);
+        return point;
+    }
+
+    //!
+    //! \brief Largest batch in [1, maxBatch] within the latency budget, or 0 if there is none.
+    //!
+    //! Latency grows with the batch size, so the batch is doubled until the budget is exceeded and the last interval
+    //! is bisected.
+    //!
+    int32_t findMaxBatch(int32_t streams, bool threads, int32_t maxBatch)
+    {
+        if (!measure(1, streams, threads).withinBudget)
+        {
+            return 0;
+        }
+        int32_t good{1};
+        int32_t bad{maxBatch + 1};
+        for (int32_t probe = 2; probe <= maxBatch; probe = probe > maxBatch / 2 ? maxBatch + 1 : probe * 2)
+        {
+            if (!measure(probe, streams, threads).withinBudget)
+            {
+                bad = probe;
+                break;
+            }
+            good = probe;
+        }
+        while (bad - good > 1)
+        {
+            int32_t const mid = good + (bad - good) / 2;
+            if (measure(mid, streams, threads).withinBudget)
+            {
+                good = mid;
+            }
+            else
+            {
+                bad = mid;
+            }
+        }
+        return good;
+    }
+
+private:
+    InferenceOptions const& mInference;
+    SystemOptions const& mSystem;
+    InferenceEnvironment& mIEnv;
+    AutotuneResult& mResult;
+    bool mImplicitBatch{false};
+    int32_t mMaxBatch{1};
+    //! Inputs whose first dimension is the batch dimension, with the shape used for the other dimensions.
+    std::map<std::string, std::vector<int32_t>> mBatchInputs;
+    //! Index in mResult.points of each measured (batch, streams, threads).
+    std::map<std::tuple<int32_t, int32_t, bool>, int32_t> mMeasured;
+};
+
+} // namespace
+
+bool runAutotune(InferenceOptions const& inference, SystemOptions const& system, InferenceEnvironment& iEnv,
+    AutotuneResult& result)
+{
+    SMP_RETVAL_IF_FALSE(!iEnv.safe && iEnv.engine.get() != nullptr, "Got invalid engine!", false, sample::gLogError);
+
+    result = AutotuneResult{};
+    result.latencyBudget = inference.autotuneLatency;
+    AutotuneSearch search(inference, system, iEnv, result);
+
+    // Bisect the batch size on one stream first. More streams only add queueing latency, so the largest batch within
+    // the budget does not grow with the number of streams and bounds the search of the next stream count.
+    int32_t const batch = search.findMaxBatch(1, false, search.getMaxBatch());
+    float bestThroughput = batch > 0 ? search.measure(batch, 1, false).throughput : 0.F;
+    std::array<int32_t, 2> batchLimits{batch, batch};
+    for (int32_t streams = 2; batch > 0 && streams <= inference.autotuneMaxStreams; streams *= 2)
+    {
+        float streamsThroughput{0.F};
+        for (bool threads : {false, true})
+        {
+            int32_t& limit = batchLimits[threads];
+            limit = limit > 0 ? search.findMaxBatch(streams, threads, limit) : 0;
+            if (limit > 0)
+            {
+                streamsThroughput = std::max(streamsThroughput, search.measure(limit, streams, threads).throughput);
+            }
+        }
+        // Stop once doubling the streams no longer pays off.
+        if (streamsThroughput < bestThroughput * (1.F + kAUTOTUNE_MIN_GAIN))
+        {
+            break;
+        }
+        bestThroughput = streamsThroughput;
+    }
+
+    selectAutotuneResult(result);
+    return true;
+}
+
 bool runMultiTasksInference(std::vector<std::unique_ptr<TaskInferenceEnvironment>>& tEnvList)
 {
+    if (std::any_of(tEnvList.begin(), tEnvList.end(),
+            [](std::unique_ptr<TaskInferenceEnvironment>& tEnv) { return tEnv->iEnv == nullptr; }))
+    {
+        sample::gLogError << "Cannot run a task whose inference set up failed" << std::endl;
+        return false;
+    }
+
     cudaCheck(cudaProfilerStart());
     cudaSetDeviceFlags(cudaDeviceScheduleSpin);
 
@@ -1072,8 +2055,8 @@ bool runMultiTasksInference(std::vector<std::unique_ptr<TaskInferenceEnvironment
     for (size_t i = 0; i < tEnvList.size(); ++i)
     {
         auto& tEnv = tEnvList[i];
-        threads.emplace_back(makeThread(
-            tEnv->iOptions, *(tEnv->iEnv), sync, /*threadIdx*/ 0, /*streamsPerThread*/ 1, tEnv->device, tEnv->trace));
+        threads.emplace_back(makeThread(tEnv->iOptions, *(tEnv->iEnv), sync, /*threadIdx*/ tEnv->streamIdx,
+            /*streamsPerThread*/ 1, tEnv->device, tEnv->trace));
     }
     for (auto& th : threads)
     {
@@ -1092,6 +2075,45 @@ bool runMultiTasksInference(std::vector<std::unique_ptr<TaskInferenceEnvironment
         [](std::unique_ptr<TaskInferenceEnvironment>& tEnv) { return tEnv->iEnv->error; });
 }
 
+InferenceOptions getTaskInferenceOptions(InferenceOptions const& inference, TaskInferenceOptions const& task)
+{
+    InferenceOptions taskInference = inference;
+    taskInference.infStreams = 1;
+    taskInference.threads = false;
+    taskInference.graph = task.graph;
+    taskInference.persistentCacheRatio = task.persistentCacheRatio;
+    if (task.batch != batchNotProvided)
+    {
+        taskInference.batch = task.batch;
+    }
+    return taskInference;
+}
+
+bool runPooledTasks(std::vector<TaskInferenceOptions> const& tasks, InferenceOptions const& inference,
+    std::vector<std::vector<InferenceTrace>>& traces, ContextPoolStatistics& statistics)
+{
+    ContextPool pool(static_cast<size_t>(inference.contextPoolBudget * 1.0_MiB));
+    bool pass{true};
+    traces.assign(tasks.size(), {});
+    for (int32_t round = 0; round < inference.taskRounds && pass; ++round)
+    {
+        // The task environments release their leases when the list goes out of scope, at the end of the round.
+        std::vector<std::unique_ptr<TaskInferenceEnvironment>> tEnvList;
+        for (auto const& task : tasks)
+        {
+            tEnvList.emplace_back(new TaskInferenceEnvironment(pool, task.engine,
+                getTaskInferenceOptions(inference, task), task.device, task.DLACore, task.batch, task.profile));
+        }
+        pass = runMultiTasksInference(tEnvList);
+        for (size_t t = 0; t < tEnvList.size(); ++t)
+        {
+            traces[t] = std::move(tEnvList[t]->trace);
+        }
+    }
+    statistics = pool.getStatistics();
+    return pass;
+}
+
 namespace
 {
 size_t reportGpuMemory()
@@ -1391,6 +2413,18 @@ void Bindings::transferInputToDevice(TrtCudaStream& stream)
     }
 }
 
+void Bindings::transferInputToDevice(
+    TrtCudaStream& stream, std::function<bool(std::string const&)> const& predicate)
+{
+    for (auto& b : mNames)
+    {
+        if (mBindings[b.second].isInput && predicate(b.first))
+        {
+            mBindings[b.second].buffer->hostToDevice(stream);
+        }
+    }
+}
+
 void Bindings::transferOutputToHost(TrtCudaStream& stream)
 {
     for (auto& b : mNames)
@@ -1613,6 +2647,94 @@ bool Bindings::setTensorAddresses(nvinfer1::IExecutionContext& context) const
     return true;
 }
 
+size_t Bindings::getDeviceMemorySize() const
+{
+    size_t size{0};
+    for (auto const& binding : mBindings)
+    {
+        if (binding.buffer != nullptr)
+        {
+            size += binding.buffer->getSize();
+        }
+    }
+    return size;
+}
+
+void* Bindings::getDeviceBuffer(std::string const& name, size_t& size) const
+{
+    auto const match = mNames.find(name);
+    if (match == mNames.end() || mBindings[match->second].buffer == nullptr)
+    {
+        size = 0;
+        return nullptr;
+    }
+    size = mBindings[match->second].buffer->getSize();
+    return mBindings[match->second].buffer->getDeviceBuffer();
+}
+
+bool InputDataset::addInput(std::string const& name, std::string const& path, size_t sampleSize)
+{
+    Input input;
+    input.sampleSize = sampleSize;
+    int64_t nbSamples{0};
+    if (isDirectory(path))
+    {
+        for (auto const& file : listFiles(path))
+        {
+            std::unique_ptr<MappedFile> mapped(new MappedFile(file));
+            if (mapped->size() != sampleSize)
+            {
+                sample::gLogError << "Sample " << file << " of input " << name << " has " << mapped->size()
+                                  << " bytes, expected " << sampleSize << " bytes." << std::endl;
+                return false;
+            }
+            input.files.emplace_back(std::move(mapped));
+        }
+        nbSamples = static_cast<int64_t>(input.files.size());
+    }
+    else
+    {
+        std::unique_ptr<MappedFile> mapped(new MappedFile(path));
+        if (sampleSize == 0 || mapped->size() == 0 || mapped->size() % sampleSize != 0)
+        {
+            sample::gLogError << "Dataset " << path << " of input " << name << " has " << mapped->size()
+                              << " bytes, expected a multiple of " << sampleSize << " bytes." << std::endl;
+            return false;
+        }
+        nbSamples = static_cast<int64_t>(mapped->size() / sampleSize);
+        input.files.emplace_back(std::move(mapped));
+        input.packed = true;
+    }
+    if (nbSamples == 0)
+    {
+        sample::gLogError << "Dataset " << path << " of input " << name << " has no samples." << std::endl;
+        return false;
+    }
+    mNbSamples = mInputs.empty() ? nbSamples : std::min(mNbSamples, nbSamples);
+    mInputs[name] = std::move(input);
+    return true;
+}
+
+std::vector<std::pair<std::string, size_t>> InputDataset::getInputs() const
+{
+    std::vector<std::pair<std::string, size_t>> inputs;
+    for (auto const& input : mInputs)
+    {
+        inputs.emplace_back(input.first, input.second.sampleSize);
+    }
+    return inputs;
+}
+
+void const* InputDataset::getSample(std::string const& name, int64_t index) const
+{
+    auto const& input = mInputs.at(name);
+    if (input.packed)
+    {
+        return static_cast<char const*>(input.files.front()->data()) + index * input.sampleSize;
+    }
+    return input.files[index]->data();
+}
+
 bool Bindings::setSafeTensorAddresses(nvinfer1::safe::IExecutionContext& context) const
 {
     for (auto const& b : mNames)
@@ -18,6 +18,7 @@
 #ifndef TRT_SAMPLE_INFERENCE_H
 #define TRT_SAMPLE_INFERENCE_H
 
+#include "sampleContextSlots.h"
 #include "sampleEngines.h"
 #include "sampleReporting.h"
 #include "sampleUtils.h"
@@ -26,7 +27,9 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "NvInfer.h"
@@ -35,6 +38,42 @@
 namespace sample
 {
 
+//!
+//! \class InputDataset
+//! \brief Memory-mapped samples of input tensors, read in turn by the inference streams.
+//!
+//! The samples of an input are either packed in one file, which must hold a whole number of samples, or stored one
+//! per file in a directory, in file name order. The dataset has as many samples as its smallest input.
+//!
+class InputDataset
+{
+public:
+    //! Map the samples of an input. Returns false if they cannot be mapped or do not match sampleSize bytes.
+    bool addInput(std::string const& name, std::string const& path, size_t sampleSize);
+
+    int64_t getNbSamples() const
+    {
+        return mNbSamples;
+    }
+
+    //! Names of the inputs and their sample size in bytes.
+    std::vector<std::pair<std::string, size_t>> getInputs() const;
+
+    //! Bytes of a sample of an input.
+    void const* getSample(std::string const& name, int64_t index) const;
+
+private:
+    struct Input
+    {
+        std::vector<std::unique_ptr<MappedFile>> files; //!< One packed file, or one file per sample
+        size_t sampleSize{0};
+        bool packed{false};
+    };
+
+    std::unordered_map<std::string, Input> mInputs;
+    int64_t mNbSamples{0};
+};
+
 struct InferenceEnvironment
 {
     InferenceEnvironment() = delete;
@@ -49,6 +88,10 @@ struct InferenceEnvironment
     std::vector<std::unique_ptr<nvinfer1::IExecutionContext>> contexts;
     std::vector<std::unique_ptr<Bindings>> bindings;
     bool error{false};
+    HostPlacement placement;
+    GraphCacheStatistics graphCacheStatistics; //!< Of the last run with a shape sequence and CUDA graphs
+    HostUsage hostUsage;                       //!< Of the last run
+    std::unique_ptr<InputDataset> dataset;     //!< Inputs rotated across iterations, nullptr to reuse the bindings
 
     bool safe{false};
     std::vector<std::unique_ptr<nvinfer1::safe::IExecutionContext>> safeContexts;
@@ -81,9 +124,10 @@ inline nvinfer1::safe::IExecutionContext* InferenceEnvironment::getContext(int32
 }
 
 //!
-//! \brief Set up contexts and bindings for inference
+//! \brief Set up contexts and bindings for inference, on the given optimization profile
 //!
-bool setUpInference(InferenceEnvironment& iEnv, InferenceOptions const& inference, SystemOptions const& system);
+bool setUpInference(
+    InferenceEnvironment& iEnv, InferenceOptions const& inference, SystemOptions const& system, int32_t profile = 0);
 
 //!
 //! \brief Deserialize the engine and time how long it takes.
@@ -96,6 +140,13 @@ bool timeDeserialize(InferenceEnvironment& iEnv, SystemOptions const& sys);
 bool runInference(
     InferenceOptions const& inference, InferenceEnvironment& iEnv, int32_t device, std::vector<InferenceTrace>& trace);
 
+//!
+//! \brief Search the batch size, number of streams and threading for the highest throughput whose p99 latency is
+//!        within inference.autotuneLatency, reusing the engine of iEnv. The contexts and bindings of iEnv are replaced.
+//!
+bool runAutotune(InferenceOptions const& inference, SystemOptions const& system, InferenceEnvironment& iEnv,
+    AutotuneResult& result);
+
 //!
 //! \brief Get layer information of the engine.
 //!
@@ -152,6 +203,9 @@ public:
 
     void transferInputToDevice(TrtCudaStream& stream);
 
+    //! Transfer the inputs whose name satisfies predicate.
+    void transferInputToDevice(TrtCudaStream& stream, std::function<bool(std::string const&)> const& predicate);
+
     void transferOutputToHost(TrtCudaStream& stream);
 
     void fill(int binding, std::string const& fileName)
@@ -239,6 +293,12 @@ public:
 
     bool setSafeTensorAddresses(nvinfer1::safe::IExecutionContext& context) const;
 
+    //! Returns the size in bytes of the device memory allocated for the bindings with known shapes.
+    size_t getDeviceMemorySize() const;
+
+    //! Returns the device buffer of a binding with a known shape and its size in bytes, or nullptr if there is none.
+    void* getDeviceBuffer(std::string const& name, size_t& size) const;
+
 private:
     std::unordered_map<std::string, int32_t> mNames;
     std::vector<Binding> mBindings;
@@ -246,19 +306,108 @@ private:
     bool mUseManaged{false};
 };
 
+//!
+//! \class ContextPool
+//! \brief Pool of execution contexts and their bindings, reused across tasks that run the same engine.
+//!
+//! Engines are deserialized once per (engine file, device, DLA core). Each pooled context belongs to the
+//! InferenceEnvironment of its engine, at a stream index handed out with the lease, and is keyed by optimization
+//! profile, batch, input shapes and input files. Idle contexts are evicted in least recently used order when the
+//! device memory of the pooled contexts and bindings exceeds the budget.
+//!
+//! acquire() and release() must not be called while inference runs on contexts of the pool.
+//!
+class ContextPool
+{
+public:
+    //!
+    //! \brief A context leased from the pool, i.e. iEnv->contexts[streamIdx] and iEnv->bindings[streamIdx].
+    //!
+    struct Lease
+    {
+        std::shared_ptr<InferenceEnvironment> iEnv;
+        int32_t streamIdx{-1};
+    };
+
+    //!
+    //! \param memoryBudget Device memory budget in bytes for the pooled contexts and bindings, or 0 for no limit.
+    //!
+    explicit ContextPool(size_t memoryBudget = 0)
+        : mSlots(memoryBudget)
+    {
+    }
+
+    ContextPool(ContextPool const&) = delete;
+    ContextPool& operator=(ContextPool const&) = delete;
+
+    //!
+    //! \brief Lease an idle context matching the engine and the inference options, creating it if there is none.
+    //!
+    //! \return A lease with a null iEnv if the engine could not be loaded or the context could not be set up.
+    //!
+    Lease acquire(std::string const& engineFile, InferenceOptions const& inference, int32_t device, int32_t DLACore,
+        int32_t profile = 0);
+
+    //!
+    //! \brief Return a leased context to the pool.
+    //!
+    void release(Lease const& lease);
+
+    ContextPoolStatistics getStatistics() const;
+
+private:
+    struct EngineEntry
+    {
+        std::shared_ptr<InferenceEnvironment> iEnv;
+        std::vector<int32_t> freeStreams; //!< Stream indices of evicted contexts
+    };
+
+    //! Free the context of an evicted slot and hand its stream index back to its engine.
+    void freeContext(ContextSlots<InferenceEnvironment>::Slot const& slot);
+
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, EngineEntry> mEngines;
+    ContextSlots<InferenceEnvironment> mSlots;
+    ContextPoolStatistics mStatistics;
+};
+
 struct TaskInferenceEnvironment
 {
     TaskInferenceEnvironment(std::string engineFile, InferenceOptions inference, int32_t deviceId = 0,
-        int32_t DLACore = -1, int32_t bs = batchNotProvided);
+        int32_t DLACore = -1, int32_t bs = batchNotProvided, int32_t profile = 0);
+    //!
+    //! \brief Lease the context of this task from a pool, which must outlive the task.
+    //!
+    TaskInferenceEnvironment(ContextPool& contextPool, std::string const& engineFile, InferenceOptions inference,
+        int32_t deviceId = 0, int32_t DLACore = -1, int32_t bs = batchNotProvided, int32_t profile = 0);
+    TaskInferenceEnvironment(TaskInferenceEnvironment const&) = delete;
+    TaskInferenceEnvironment& operator=(TaskInferenceEnvironment const&) = delete;
+    ~TaskInferenceEnvironment();
     InferenceOptions iOptions{};
     int32_t device{defaultDevice};
     int32_t batch{batchNotProvided};
-    std::unique_ptr<InferenceEnvironment> iEnv;
+    std::shared_ptr<InferenceEnvironment> iEnv;
+    int32_t streamIdx{0};               //!< Index of the context and bindings of this task in iEnv
+    ContextPool* pool{nullptr};         //!< The pool the context is leased from, if any
     std::vector<InferenceTrace> trace;
 };
 
 bool runMultiTasksInference(std::vector<std::unique_ptr<TaskInferenceEnvironment>>& tEnvList);
 
+//!
+//! \brief Inference options of a task: the common inference options with the overrides of the task, on one stream.
+//!
+InferenceOptions getTaskInferenceOptions(InferenceOptions const& inference, TaskInferenceOptions const& task);
+
+//!
+//! \brief Run the tasks concurrently inference.taskRounds times, leasing their contexts from a ContextPool.
+//!
+//! The leases are returned after each round, so that the next rounds reuse the pooled contexts. traces receives the
+//! timing trace of each task in the last round, and statistics the usage of the pool over all the rounds.
+//!
+bool runPooledTasks(std::vector<TaskInferenceOptions> const& tasks, InferenceOptions const& inference,
+    std::vector<std::vector<InferenceTrace>>& traces, ContextPoolStatistics& statistics);
+
 } // namespace sample
 
 #endif // TRT_SAMPLE_INFERENCE_H
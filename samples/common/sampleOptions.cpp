@@ -20,6 +20,7 @@
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -1165,6 +1166,11 @@ void BuildOptions::parse(Arguments& arguments)
     }
 
     getAndDelOption(arguments, "--maxAuxStreams", maxAuxStreams);
+    getAndDelOption(arguments, "--buildWorkers", buildWorkers);
+    if (buildWorkers < 1)
+    {
+        throw std::invalid_argument("Invalid --buildWorkers: it must be a positive integer.");
+    }
 
     std::string previewFeaturesBuf;
     getAndDelOption(arguments, "--preview", previewFeaturesBuf);
@@ -1295,14 +1301,110 @@ void InferenceOptions::parse(Arguments& arguments)
     getAndDelOption(arguments, "--timeDeserialize", timeDeserialize);
     getAndDelOption(arguments, "--timeRefit", timeRefit);
     getAndDelOption(arguments, "--persistentCacheRatio", persistentCacheRatio);
+    getAndDelOption(arguments, "--autotune", autotuneLatency);
+    getAndDelOption(arguments, "--autotuneMaxBatch", autotuneMaxBatch);
+    getAndDelOption(arguments, "--autotuneMaxStreams", autotuneMaxStreams);
+    if (autotuneLatency < 0.F)
+    {
+        throw std::invalid_argument("Invalid --autotune: the latency budget must be positive.");
+    }
+    if (autotuneMaxBatch < 0 || autotuneMaxStreams < 1)
+    {
+        throw std::invalid_argument("Invalid --autotuneMaxBatch or --autotuneMaxStreams.");
+    }
+
+    std::string cpuAffinity;
+    getAndDelOption(arguments, "--cpuAffinity", cpuAffinity);
+    if (cpuAffinity == "auto")
+    {
+        threadCpusLocal = true;
+    }
+    else if (!cpuAffinity.empty())
+    {
+        for (auto const& cpus : splitToStringVec(cpuAffinity, ':'))
+        {
+            threadCpus.push_back(parseCpuList(cpus));
+        }
+    }
+    std::string hostNuma;
+    getAndDelOption(arguments, "--hostNuma", hostNuma);
+    if (hostNuma == "auto")
+    {
+        hostNumaNode = numaNodeAuto;
+    }
+    else if (!hostNuma.empty())
+    {
+        hostNumaNode = stringToValue<int32_t>(hostNuma);
+        if (hostNumaNode < 0)
+        {
+            throw std::invalid_argument("Invalid --hostNuma: " + hostNuma + ". It must be auto or a NUMA node.");
+        }
+    }
 
     std::string list;
     getAndDelOption(arguments, "--loadInputs", list);
     std::vector<std::string> inputsList{splitToStringVec(list, ',')};
     splitInsertKeyValue(inputsList, inputs);
 
+    std::string datasetList;
+    getAndDelOption(arguments, "--inputDataset", datasetList);
+    std::vector<std::string> datasetSpecs{splitToStringVec(datasetList, ',')};
+    splitInsertKeyValue(datasetSpecs, dataset);
+
     getShapesInference(arguments, shapes, "--shapes");
     getAndDelOption(arguments, "--batch", batch);
+
+    std::vector<std::string> sequence;
+    getAndDelRepeatedOption(arguments, "--shapeSequence", sequence);
+    for (auto const& spec : sequence)
+    {
+        ShapeProfile step;
+        for (auto const& s : splitToStringVec(spec, ','))
+        {
+            auto nameDimsPair = splitNameAndValue<std::vector<int32_t>>(s);
+            step[removeSingleQuotationMarks(nameDimsPair.first)] = nameDimsPair.second;
+        }
+        auto const sameInputs = [&step](ShapeProfile const& other) {
+            return other.size() == step.size()
+                && std::all_of(step.begin(), step.end(), [&other](ShapeProfile::value_type const& s) {
+                       auto const match = other.find(s.first);
+                       return match != other.end() && match->second.size() == s.second.size();
+                   });
+        };
+        if (step.empty() || (!shapeSequence.empty() && !sameInputs(shapeSequence.front())))
+        {
+            throw std::invalid_argument("Invalid --shapeSequence: " + spec
+                + ". Each step must set the shapes of the same inputs, with the same ranks.");
+        }
+        shapeSequence.push_back(std::move(step));
+    }
+    // The bindings are allocated for the element-wise largest shapes of the sequence, which the contexts are set up
+    // with, and every step fits in them.
+    for (auto const& step : shapeSequence)
+    {
+        for (auto const& s : step)
+        {
+            auto& dims = shapes[s.first];
+            if (dims.size() != s.second.size())
+            {
+                dims = s.second;
+                continue;
+            }
+            std::transform(dims.begin(), dims.end(), s.second.begin(), dims.begin(),
+                [](int32_t a, int32_t b) { return std::max(a, b); });
+        }
+    }
+    getAndDelOption(arguments, "--graphCacheSize", graphCacheSize);
+    if (graphCacheSize < 1)
+    {
+        throw std::invalid_argument("Invalid --graphCacheSize: it must be a positive integer.");
+    }
+    getAndDelOption(arguments, "--taskRounds", taskRounds);
+    getAndDelOption(arguments, "--contextPoolBudget", contextPoolBudget);
+    if (taskRounds < 1 || contextPoolBudget < 0)
+    {
+        throw std::invalid_argument("Invalid --taskRounds or --contextPoolBudget.");
+    }
 }
 
 void ReportingOptions::parse(Arguments& arguments)
@@ -1313,11 +1415,37 @@ void ReportingOptions::parse(Arguments& arguments)
     getAndDelOption(arguments, "--dumpOutput", output);
     getAndDelOption(arguments, "--dumpRawBindingsToFile", dumpRawBindings);
     getAndDelOption(arguments, "--dumpProfile", profile);
+    getAndDelOption(arguments, "--streamingProfile", streamingProfile);
     getAndDelOption(arguments, "--dumpLayerInfo", layerInfo);
     getAndDelOption(arguments, "--exportTimes", exportTimes);
     getAndDelOption(arguments, "--exportOutput", exportOutput);
     getAndDelOption(arguments, "--exportProfile", exportProfile);
+    getAndDelOption(arguments, "--exportProfileTrace", exportProfileTrace);
+    getAndDelOption(arguments, "--profileTraceSampling", profileTraceSampling);
+    if (profileTraceSampling <= 0)
+    {
+        throw std::invalid_argument(std::string("Invalid --profileTraceSampling: ") + std::to_string(profileTraceSampling)
+            + ". It must be a positive integer.");
+    }
     getAndDelOption(arguments, "--exportLayerInfo", exportLayerInfo);
+    getAndDelOption(arguments, "--exportAutotune", exportAutotune);
+    getAndDelOption(arguments, "--timeSeriesWindow", timeSeriesWindow);
+    if (timeSeriesWindow < 0.F)
+    {
+        throw std::invalid_argument(std::string("Invalid --timeSeriesWindow: ") + std::to_string(timeSeriesWindow)
+            + ". It must be a non-negative duration in ms.");
+    }
+    getAndDelOption(arguments, "--timeSeriesDeviation", timeSeriesDeviation);
+    if (timeSeriesDeviation <= 0.F)
+    {
+        throw std::invalid_argument(std::string("Invalid --timeSeriesDeviation: ")
+            + std::to_string(timeSeriesDeviation) + ". It must be a positive percentage.");
+    }
+    getAndDelOption(arguments, "--exportTimeSeries", exportTimeSeries);
+    if (!exportTimeSeries.empty() && timeSeriesWindow == timeSeriesDisabled)
+    {
+        timeSeriesWindow = defaultTimeSeriesWindow;
+    }
 
     std::string percentileString;
     getAndDelOption(arguments, "--percentile", percentileString);
@@ -1351,6 +1479,13 @@ bool parseHelp(Arguments& arguments)
 
 void AllOptions::parse(Arguments& arguments)
 {
+    // Each variant is parsed from the other arguments overridden by its own.
+    std::vector<std::string> variantSpecs;
+    getAndDelRepeatedOption(arguments, "--buildVariant", variantSpecs);
+    std::vector<std::string> taskSpecs;
+    getAndDelRepeatedOption(arguments, "--task", taskSpecs);
+    Arguments const baseArguments = arguments;
+
     model.parse(arguments);
     build.parse(arguments);
     system.parse(arguments);
@@ -1376,6 +1511,19 @@ void AllOptions::parse(Arguments& arguments)
         throw std::invalid_argument("--timeRefit requires --useRuntime=full.");
     }
 
+    if (!inference.shapeSequence.empty() && build.safe)
+    {
+        throw std::invalid_argument("--shapeSequence cannot be used with --safe.");
+    }
+    if (!inference.dataset.empty() && !inference.shapeSequence.empty())
+    {
+        throw std::invalid_argument("--inputDataset cannot be used with --shapeSequence.");
+    }
+    if (inference.autotuneLatency != autotuneDisabled && (build.safe || inference.timeDeserialize))
+    {
+        throw std::invalid_argument("--autotune cannot be used with --safe or --timeDeserialize.");
+    }
+
     // If batch and/or maxBatch is not set and the engine has implicit batch dim, set them to default values.
     if (!detectedExplicitBatch)
     {
@@ -1456,6 +1604,101 @@ void AllOptions::parse(Arguments& arguments)
             }
         }
     }
+
+    if (!variantSpecs.empty())
+    {
+        if (model.baseModel.format != ModelFormat::kONNX || build.load || build.safe || build.versionCompatible)
+        {
+            throw std::invalid_argument("--buildVariant requires an ONNX model and cannot be used with --loadEngine, "
+                                        "--safe or --versionCompatible.");
+        }
+        std::set<std::string> engines;
+        for (auto const& spec : variantSpecs)
+        {
+            Arguments variantArguments = baseArguments;
+            std::set<std::string> keys;
+            for (auto const& token : splitToStringVec(spec, ' '))
+            {
+                if (token.empty())
+                {
+                    continue;
+                }
+                auto const equal = token.find('=');
+                std::string const key = token.substr(0, equal);
+                if (key.compare(0, 2, "--") != 0 || key == "--onnx" || key == "--loadEngine")
+                {
+                    throw std::invalid_argument("Invalid --buildVariant: " + spec + ". It must be a list of build "
+                                                "options separated by spaces, and cannot change the model.");
+                }
+                // The options of the variant replace the ones of the same name, repeated ones included.
+                if (keys.insert(key).second)
+                {
+                    variantArguments.erase(key);
+                }
+                variantArguments.emplace(key, equal == std::string::npos ? "" : token.substr(equal + 1));
+            }
+
+            AllOptions variant;
+            variant.parse(variantArguments);
+            for (auto const& key : keys)
+            {
+                if (variantArguments.count(key) != 0)
+                {
+                    throw std::invalid_argument("Unknown option " + key + " in --buildVariant: " + spec);
+                }
+            }
+            if (!variant.build.save || !engines.insert(variant.build.engine).second)
+            {
+                throw std::invalid_argument("Invalid --buildVariant: " + spec + ". Each variant must save its engine "
+                                            "to its own file with --saveEngine.");
+            }
+            buildVariants.push_back(variant.build);
+        }
+
+        // The variants share one timing cache, which is loaded from and saved to a single file.
+        std::set<std::string> cacheFiles;
+        for (auto const& variant : buildVariants)
+        {
+            if (variant.timingCacheMode == TimingCacheMode::kGLOBAL)
+            {
+                cacheFiles.insert(variant.timingCacheFile);
+            }
+        }
+        if (cacheFiles.size() > 1)
+        {
+            throw std::invalid_argument("The --buildVariant options set different --timingCacheFile values, but the "
+                                        "variants share one timing cache.");
+        }
+    }
+
+    if (!taskSpecs.empty() && !variantSpecs.empty())
+    {
+        throw std::invalid_argument("--task cannot be used with --buildVariant.");
+    }
+    for (auto const& spec : taskSpecs)
+    {
+        Arguments taskArguments;
+        for (auto const& token : splitToStringVec(spec, ' '))
+        {
+            if (token.empty())
+            {
+                continue;
+            }
+            auto const equal = token.find('=');
+            taskArguments.emplace(token.substr(0, equal), equal == std::string::npos ? "" : token.substr(equal + 1));
+        }
+        TaskInferenceOptions task;
+        task.parse(taskArguments);
+        if (!taskArguments.empty())
+        {
+            throw std::invalid_argument("Unknown option " + taskArguments.begin()->first + " in --task: " + spec);
+        }
+        if (task.engine.empty())
+        {
+            throw std::invalid_argument("Invalid --task: " + spec + ". Each task must set engine=<file>.");
+        }
+        tasks.push_back(task);
+    }
 }
 
 void TaskInferenceOptions::parse(Arguments& arguments)
@@ -1466,6 +1709,7 @@ void TaskInferenceOptions::parse(Arguments& arguments)
     getAndDelOption(arguments, "DLACore", DLACore);
     getAndDelOption(arguments, "graph", graph);
     getAndDelOption(arguments, "persistentCacheRatio", persistentCacheRatio);
+    getAndDelOption(arguments, "profile", profile);
 }
 
 void SafeBuilderOptions::parse(Arguments& arguments)
@@ -1885,6 +2129,14 @@ std::ostream& operator<<(std::ostream& os, const InferenceOptions& options)
                           os << "Explicit"                                << std::endl;
     }
     printShapes(os, "inference", options.shapes);
+    for (size_t step = 0; step < options.shapeSequence.size(); ++step)
+    {
+        printShapes(os, ("sequence step " + std::to_string(step)).c_str(), options.shapeSequence[step]);
+    }
+    if (!options.shapeSequence.empty())
+    {
+        os << "Graph cache size: " << options.graphCacheSize << std::endl;
+    }
     os << "Iterations: "                << options.iterations                                   << std::endl <<
           "Duration: "                  << options.duration   << "s (+ "
                                         << options.warmup     << "ms warm up)"                  << std::endl <<
@@ -1902,18 +2154,81 @@ std::ostream& operator<<(std::ostream& os, const InferenceOptions& options)
           "NVTX verbosity: "            << static_cast<int32_t>(options.nvtxVerbosity)          << std::endl <<
           "Persistent Cache Ratio: "    << static_cast<float>(options.persistentCacheRatio)   << std::endl;
     // clang-format on
+    os << "Autotune: ";
+    if (options.autotuneLatency == autotuneDisabled)
+    {
+        os << "Disabled" << std::endl;
+    }
+    else
+    {
+        os << "p99 latency <= " << options.autotuneLatency << "ms, max batch = ";
+        if (options.autotuneMaxBatch == 0)
+        {
+            os << "engine limit";
+        }
+        else
+        {
+            os << options.autotuneMaxBatch;
+        }
+        os << ", max streams = " << options.autotuneMaxStreams << std::endl;
+    }
+
+    os << "CPU affinity: ";
+    if (options.threadCpusLocal)
+    {
+        os << "CPUs of the device NUMA node" << std::endl;
+    }
+    else if (options.threadCpus.empty())
+    {
+        os << "Disabled" << std::endl;
+    }
+    else
+    {
+        std::vector<std::string> lists;
+        for (auto const& cpus : options.threadCpus)
+        {
+            lists.push_back(cpuListToString(cpus));
+        }
+        os << joinValuesToString(lists, ":") << std::endl;
+    }
+    os << "Host buffers NUMA node: ";
+    if (options.hostNumaNode == numaNodeDisabled)
+    {
+        os << "Disabled" << std::endl;
+    }
+    else if (options.hostNumaNode == numaNodeAuto)
+    {
+        os << "device node" << std::endl;
+    }
+    else
+    {
+        os << options.hostNumaNode << std::endl;
+    }
 
     os << "Inputs:" << std::endl;
     for (const auto& input : options.inputs)
     {
         os << input.first << "<-" << input.second << std::endl;
     }
+    os << "Input dataset:" << std::endl;
+    for (auto const& input : options.dataset)
+    {
+        os << input.first << "<-" << input.second << std::endl;
+    }
 
     return os;
 }
 
 std::ostream& operator<<(std::ostream& os, const ReportingOptions& options)
 {
+    std::string timeSeries{"Disabled"};
+    if (options.timeSeriesWindow != timeSeriesDisabled)
+    {
+        std::ostringstream window;
+        window << options.timeSeriesWindow << " ms, flag deviations above " << options.timeSeriesDeviation << "%";
+        timeSeries = window.str();
+    }
+
     // clang-format off
     os << "=== Reporting Options ==="                                                     << std::endl <<
           "Verbose: "                     << boolToEnabled(options.verbose)               << std::endl <<
@@ -1922,9 +2237,14 @@ std::ostream& operator<<(std::ostream& os, const ReportingOptions& options)
           "Dump refittable layers:"       << boolToEnabled(options.refit)                 << std::endl <<
           "Dump output: "                 << boolToEnabled(options.output)                << std::endl <<
           "Profile: "                     << boolToEnabled(options.profile)               << std::endl <<
+          "Streaming profile: "           << boolToEnabled(options.streamingProfile)      << std::endl <<
           "Export timing to JSON file: "  << options.exportTimes                          << std::endl <<
           "Export output to JSON file: "  << options.exportOutput                         << std::endl <<
-          "Export profile to JSON file: " << options.exportProfile                        << std::endl;
+          "Export profile to JSON file: " << options.exportProfile                        << std::endl <<
+          "Export profile trace to JSON file: " << options.exportProfileTrace             << std::endl <<
+          "Export autotune results to JSON file: " << options.exportAutotune              << std::endl <<
+          "Time series window: "          << timeSeries                                   << std::endl <<
+          "Export time series to file: "  << options.exportTimeSeries                     << std::endl;
     // clang-format on
 
     return os;
@@ -1933,6 +2253,37 @@ std::ostream& operator<<(std::ostream& os, const ReportingOptions& options)
 std::ostream& operator<<(std::ostream& os, const AllOptions& options)
 {
     os << options.model << options.build << options.system << options.inference << options.reporting << std::endl;
+    if (!options.buildVariants.empty())
+    {
+        os << "=== Build Variants ===" << std::endl;
+        os << "Workers: " << options.build.buildWorkers << std::endl;
+        for (auto const& variant : options.buildVariants)
+        {
+            os << variant.engine << ": precision ";
+            printPrecision(os, variant) << ", timingCacheMode ";
+            printTimingCache(os, variant.timingCacheMode) << std::endl;
+        }
+        os << std::endl;
+    }
+    if (!options.tasks.empty())
+    {
+        os << "=== Tasks ===" << std::endl;
+        os << "Rounds: " << options.inference.taskRounds << ", context pool budget: ";
+        if (options.inference.contextPoolBudget == 0)
+        {
+            os << "unlimited" << std::endl;
+        }
+        else
+        {
+            os << options.inference.contextPoolBudget << " MiB" << std::endl;
+        }
+        for (auto const& task : options.tasks)
+        {
+            os << task.engine << ": device " << task.device << ", DLACore " << task.DLACore << ", profile "
+               << task.profile << ", CUDA graph " << boolToEnabled(task.graph) << std::endl;
+        }
+        os << std::endl;
+    }
     return os;
 }
 
@@ -2160,6 +2511,13 @@ void BuildOptions::help(std::ostream& os)
           "  --maxAuxStreams=N                  Set maximum number of auxiliary streams per inference stream that TRT is allowed to use to run "    "\n"
           "                                     kernels in parallel if the network contains ops that can run in parallel, with the cost of more "   "\n"
           "                                     memory usage. Set this to 0 for optimal memory usage. (default = using heuristics)"                 "\n"
+          "  --buildVariant=\"options\"         Build a variant of the ONNX model with the given build options, separated by spaces, in place of"   "\n"
+          "                                     the same options of the command line. Repeat for each variant; each must set its own"               "\n"
+          "                                     --saveEngine. The model file is read once, the variants are built concurrently and share"           "\n"
+          "                                     one timing cache, and the program exits after the builds."                                          "\n"
+          R"(                                   Example: --buildVariant="--fp16 --saveEngine=model_fp16.plan")"                                     "\n"
+          "  --buildWorkers=N                   Number of variants built concurrently (default = " << defaultBuildWorkers << "). The shared timing" "\n"
+          "                                     cache is saved to --timingCacheFile once all the variants are built."                               "\n"
           ;
     // clang-format on
     os << std::flush;
@@ -2196,10 +2554,22 @@ void InferenceOptions::help(std::ostream& os)
           "                              value is the dimensions (including the batch dimension) to be used for that input."         << std::endl <<
           "                              Each key-value pair has the key and value separated using a colon (:)."                     << std::endl <<
           "                              Multiple input shapes can be provided via comma-separated key-value pairs."                 << std::endl <<
+          "  --shapeSequence=spec        Set the input shapes of successive iterations, using the --shapes format. Repeat the"       << std::endl <<
+          "                              option for each step; the steps are cycled and must set the same inputs. The bindings"      << std::endl <<
+          "                              are allocated for the largest shapes. With --useCudaGraph, a graph is captured per shape"   << std::endl <<
+          "                              on first use (default = disabled)"                                                          << std::endl <<
+          "  --graphCacheSize=N          Number of CUDA graphs kept per stream with --shapeSequence, least recently used first "
+                                                                                      "(default = " << defaultGraphCacheSize << ")"  << std::endl <<
           "  --loadInputs=spec           Load input values from files (default = generate random inputs). Input names can be "
                                                                                        "wrapped with single quotes (ex: 'Input:0')"  << std::endl <<
           R"(                            Input values spec ::= Ival[","spec])"                                                       << std::endl <<
           R"(                                         Ival ::= name":"file)"                                                         << std::endl <<
+          "  --inputDataset=spec         Feed the inputs from memory-mapped datasets, a sample per iteration in turn, staged"        << std::endl <<
+          "                              into pinned buffers ahead of the transfers. A dataset is a file of packed samples or"       << std::endl <<
+          "                              a directory with a file per sample, in name order. Stream s of S reads samples s,"          << std::endl <<
+          "                              s+S, ... (default = disabled)"                                                              << std::endl <<
+          R"(                            Input dataset spec ::= Dval[","spec])"                                                      << std::endl <<
+          R"(                                          Dval ::= name":"(file|directory))"                                            << std::endl <<
           "  --iterations=N              Run at least N inference iterations (default = "               << defaultIterations << ")"  << std::endl <<
           "  --warmUp=N                  Run for N milliseconds to warmup before measuring performance (default = "
                                                                                                             << defaultWarmUp << ")"  << std::endl <<
@@ -2226,7 +2596,30 @@ void InferenceOptions::help(std::ostream& os)
           "  --skipInference             Exit after the engine has been built and skip inference perf measurement "
                                                                                                              "(default = disabled)"  << std::endl <<
           "  --persistentCacheRatio      Set the persistentCacheLimit in ratio, 0.5 represent half of max persistent L2 size "
-                                                                                                                    "(default = 0)"  << std::endl;
+                                                                                                                    "(default = 0)"  << std::endl <<
+          "  --autotune=N                Search the batch size (--batch, or the first dimension of the --shapes inputs), the"        << std::endl <<
+          "                              number of streams and --threads for the highest throughput with a p99 latency of at"        << std::endl <<
+          "                              most N milliseconds, then report it and exit. Each configuration runs for --duration"       << std::endl <<
+          "                              (default = disabled)"                                                                       << std::endl <<
+          "  --autotuneMaxBatch=N        Largest batch size tried by --autotune (default = engine or profile limit)"                 << std::endl <<
+          "  --autotuneMaxStreams=N      Largest number of streams tried by --autotune (default = "
+                                                                                                << defaultAutotuneMaxStreams << ")"  << std::endl <<
+          "  --cpuAffinity=spec          Pin the inference threads to CPUs (default = disabled)"                                     << std::endl <<
+          R"(                              Spec ::= "auto" | cpus[":"cpus]*)"                                                          << std::endl <<
+          R"(                              cpus ::= N|N-M[","N|N-M]*, e.g. 0-3,8)"                                                     << std::endl <<
+          "                              The lists are assigned to the threads in turn; auto uses the CPUs of the NUMA node"         << std::endl <<
+          "                              closest to the device"                                                                      << std::endl <<
+          "  --hostNuma=N|auto           Allocate the host buffers on NUMA node N, or on the node closest to the device with auto"   << std::endl <<
+          "                              (default = disabled)"                                                                       << std::endl <<
+          R"(  --task="options"            Run a task on a serialized engine, concurrently with the other tasks, in place of the)"    << std::endl <<
+          "                              model of the command line. Repeat the option for each task; the task options are"           << std::endl <<
+          "                              separated by spaces, see Task Inference Options. The execution contexts are leased"         << std::endl <<
+          "                              from a pool that is shared by the tasks (default = disabled)"                               << std::endl <<
+          R"(                              Example: --task="engine=a.plan profile=1" --task="engine=b.plan graph=1")"                  << std::endl <<
+          "  --taskRounds=N              Run the tasks N times; the contexts are returned to the pool after each round and"          << std::endl <<
+          "                              reused by the next one (default = " << defaultTaskRounds << ")"                             << std::endl <<
+          "  --contextPoolBudget=N       Device memory budget of the pooled contexts and bindings in MiB; idle contexts are"         << std::endl <<
+          "                              evicted least recently used first (default = 0, unlimited)"                                 << std::endl;
     // clang-format on
 }
 
@@ -2247,14 +2640,33 @@ void ReportingOptions::help(std::ostream& os)
           "  --dumpRawBindingsToFile     Print the input/output tensor(s) of the last inference iteration to file"
                                                                                   "(default = disabled)" << std::endl <<
           "  --dumpProfile               Print profile information per layer (default = disabled)"       << std::endl <<
+          "  --streamingProfile          Aggregate the per-layer profile into fixed-memory running statistics instead of "
+                                        "storing every sample;"                                          << std::endl <<
+          "                              medians are estimated (default = disabled)"                     << std::endl <<
           "  --dumpLayerInfo             Print layer information of the engine to console "
                                                                                 "(default = disabled)"   << std::endl <<
           "  --exportTimes=<file>        Write the timing results in a json file (default = disabled)"   << std::endl <<
           "  --exportOutput=<file>       Write the output tensors to a json file (default = disabled)"   << std::endl <<
           "  --exportProfile=<file>      Write the profile information per layer in a json file "
                                                                               "(default = disabled)"     << std::endl <<
+          "  --exportProfileTrace=<file> Write the per-layer timelines of sampled iterations in a Chrome trace json "
+                                        "file (default = disabled)"                                      << std::endl <<
+          "  --profileTraceSampling=N    Record every N-th profiled iteration in the profile trace, up to 100 iterations "
+                                        "(default = " << defaultProfileTraceSampling << ")"              << std::endl <<
           "  --exportLayerInfo=<file>    Write the layer information of the engine in a json file "
-                                                                              "(default = disabled)"     << std::endl;
+                                                                              "(default = disabled)"     << std::endl <<
+          "  --exportAutotune=<file>     Write the configurations measured by --autotune and their Pareto frontier "
+                                        "in a json file (default = disabled)"                            << std::endl <<
+          "  --timeSeriesWindow=<ms>     Also report throughput and latency percentiles per window of this many ms of "
+                                        "the timing run and"                                             << std::endl <<
+          "                              flag windows that deviate from steady state (default = disabled)" << std::endl <<
+          "  --timeSeriesDeviation=<%>   Deviation of the throughput or p99 latency of a window from the median of all "
+                                        "windows"                                                        << std::endl <<
+          "                              that flags it (default = " << defaultTimeSeriesDeviation << "%)" << std::endl <<
+          "  --exportTimeSeries=<file>   Write the time series in a csv file if the name ends with .csv, else in a json "
+                                        "file;"                                                          << std::endl <<
+          "                              enables a " << defaultTimeSeriesWindow << " ms window if "
+                                        "--timeSeriesWindow is not given (default = disabled)"           << std::endl;
     // clang-format on
 }
 
@@ -2268,7 +2680,8 @@ void TaskInferenceOptions::help(std::ostream& os)
           "  batch=N                     Set batch size for implicit batch engines (default = "              << defaultBatch << ")"  << std::endl <<
           "                              This option should not be used for explicit batch engines"                                  << std::endl <<
           "  graph=1                     Use cuda graph for this task"                                                               << std::endl <<
-          "  persistentCacheRatio=[0-1]  Set the persistentCacheLimit ratio for this task                            (default = 0)"  << std::endl;
+          "  persistentCacheRatio=[0-1]  Set the persistentCacheLimit ratio for this task                            (default = 0)"  << std::endl <<
+          "  profile=N                   Select the optimization profile for this task                               (default = 0)"  << std::endl;
     // clang-format on
 }
 
@@ -2288,6 +2701,8 @@ void AllOptions::help(std::ostream& os)
     os << std::endl;
     InferenceOptions::help(os);
     os << std::endl;
+    TaskInferenceOptions::help(os);
+    os << std::endl;
     // clang-format off
     os << "=== Build and Inference Batch Options ==="                                                                   << std::endl <<
           "                              When using implicit batch, the max batch size of the engine, if not given, "   << std::endl <<
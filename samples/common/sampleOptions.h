@@ -38,6 +38,7 @@ constexpr int32_t defaultMinTiming{1};
 constexpr int32_t defaultAvgTiming{8};
 constexpr int32_t defaultMaxAuxStreams{-1};
 constexpr int32_t defaultBuilderOptimizationLevel{3};
+constexpr int32_t defaultBuildWorkers{2};
 
 // System default params
 constexpr int32_t defaultDevice{0};
@@ -52,10 +53,20 @@ constexpr float defaultDuration{3.F};
 constexpr float defaultSleep{};
 constexpr float defaultIdle{};
 constexpr float defaultPersistentCacheRatio{0};
+constexpr float autotuneDisabled{0.F};
+constexpr int32_t defaultAutotuneMaxStreams{8};
+constexpr int32_t defaultGraphCacheSize{8};
+constexpr int32_t defaultTaskRounds{1};
+constexpr int32_t numaNodeDisabled{-1};
+constexpr int32_t numaNodeAuto{-2};
 
 // Reporting default params
 constexpr int32_t defaultAvgRuns{10};
 constexpr std::array<float, 3> defaultPercentiles{90, 95, 99};
+constexpr int32_t defaultProfileTraceSampling{10};
+constexpr float timeSeriesDisabled{0.F};
+constexpr float defaultTimeSeriesWindow{1000.F};
+constexpr float defaultTimeSeriesDeviation{10.F};
 
 enum class PrecisionConstraints
 {
@@ -238,6 +249,7 @@ public:
     RuntimeMode useRuntime{RuntimeMode::kFULL};
     std::string leanDLLPath{};
     int32_t maxAuxStreams{defaultMaxAuxStreams};
+    int32_t buildWorkers{defaultBuildWorkers}; //!< Concurrent builds of the --buildVariant engines
 
     void parse(Arguments& arguments) override;
 
@@ -280,9 +292,20 @@ public:
     bool rerun{false};
     bool timeDeserialize{false};
     bool timeRefit{false};
+    float autotuneLatency{autotuneDisabled}; //!< p99 latency budget of the autotuner in ms, 0 if disabled
+    int32_t autotuneMaxBatch{0};             //!< Largest batch tried by the autotuner, 0 for the engine limit
+    int32_t autotuneMaxStreams{defaultAutotuneMaxStreams};
+    std::vector<std::vector<int32_t>> threadCpus; //!< CPUs of each inference thread, round robin; empty if not pinned
+    bool threadCpusLocal{false};                  //!< Pin the inference threads to the CPUs of the device NUMA node
+    int32_t hostNumaNode{numaNodeDisabled};       //!< NUMA node of the host buffers, numaNodeAuto for the device node
     std::unordered_map<std::string, std::string> inputs;
+    std::unordered_map<std::string, std::string> dataset; //!< Dataset file or directory of the rotated inputs
     using ShapeProfile = std::unordered_map<std::string, std::vector<int32_t>>;
     ShapeProfile shapes;
+    std::vector<ShapeProfile> shapeSequence; //!< Input shapes of successive iterations, cycled; empty if fixed
+    int32_t graphCacheSize{defaultGraphCacheSize}; //!< CUDA graphs kept per stream with a shape sequence
+    int32_t taskRounds{defaultTaskRounds};         //!< Times the --task list is run, reusing the pooled contexts
+    double contextPoolBudget{0};                   //!< Device memory budget of the task context pool in MiB, 0 if none
     nvinfer1::ProfilingVerbosity nvtxVerbosity{nvinfer1::ProfilingVerbosity::kLAYER_NAMES_ONLY};
 
     void parse(Arguments& arguments) override;
@@ -300,11 +323,18 @@ public:
     bool output{false};
     bool dumpRawBindings{false};
     bool profile{false};
+    bool streamingProfile{false};
     bool layerInfo{false};
     std::string exportTimes;
     std::string exportOutput;
     std::string exportProfile;
+    std::string exportProfileTrace;
+    int32_t profileTraceSampling{defaultProfileTraceSampling};
     std::string exportLayerInfo;
+    std::string exportAutotune;
+    float timeSeriesWindow{timeSeriesDisabled}; //!< Width of the time series windows in ms, 0 if disabled
+    float timeSeriesDeviation{defaultTimeSeriesDeviation}; //!< Deviation from steady state in % that flags a window
+    std::string exportTimeSeries;
 
     void parse(Arguments& arguments) override;
 
@@ -337,6 +367,20 @@ public:
     static void printHelp(std::ostream& out);
 };
 
+class TaskInferenceOptions : public Options
+{
+public:
+    std::string engine;
+    int32_t device{defaultDevice};
+    int32_t DLACore{-1};
+    int32_t batch{batchNotProvided};
+    bool graph{false};
+    float persistentCacheRatio{defaultPersistentCacheRatio};
+    int32_t profile{0};
+    void parse(Arguments& arguments) override;
+    static void help(std::ostream& out);
+};
+
 class AllOptions : public Options
 {
 public:
@@ -345,6 +389,8 @@ public:
     SystemOptions system;
     InferenceOptions inference;
     ReportingOptions reporting;
+    std::vector<BuildOptions> buildVariants; //!< Build options of each --buildVariant, empty for a single build
+    std::vector<TaskInferenceOptions> tasks; //!< Options of each --task, empty for a single inference
     bool helps{false};
 
     void parse(Arguments& arguments) override;
@@ -352,19 +398,6 @@ public:
     static void help(std::ostream& out);
 };
 
-class TaskInferenceOptions : public Options
-{
-public:
-    std::string engine;
-    int32_t device{defaultDevice};
-    int32_t DLACore{-1};
-    int32_t batch{batchNotProvided};
-    bool graph{false};
-    float persistentCacheRatio{defaultPersistentCacheRatio};
-    void parse(Arguments& arguments) override;
-    static void help(std::ostream& out);
-};
-
 Arguments argsToArgumentsMap(int32_t argc, char* argv[]);
 
 bool parseHelp(Arguments& arguments);
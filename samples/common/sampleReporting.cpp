@@ -16,6 +16,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <exception>
 #include <fstream>
 #include <iomanip>
@@ -161,6 +162,14 @@ void printMetricExplanations(std::ostream& os)
     os << "Enqueue Time: the host latency to enqueue a query. If this is longer than GPU Compute Time, the GPU may be "
           "under-utilized."
        << std::endl;
+    os << "Host CPU Time: the user and system CPU time of the inference threads divided by the number of queries, "
+          "warmups included. The cores busy are the CPU time divided by the host walltime of the inference loop."
+       << std::endl;
+    os << "Context Switches: the voluntary (waiting) and involuntary (preempted) context switches of the inference "
+          "threads per query. Frequent involuntary switches suggest that more CPUs should be given to the threads."
+       << std::endl;
+    os << "Peak Host Memory: the peak resident set size of the process, sampled during the inference run."
+       << std::endl;
     os << "H2D Latency: the latency for host-to-device data transfers for input tensors of a single query."
        << std::endl;
     os << "D2H Latency: the latency for device-to-host data transfers for output tensors of a single query."
@@ -192,7 +201,8 @@ PerformanceResult getPerformanceResult(std::vector<InferenceTime> const& timings
 }
 
 void printEpilog(std::vector<InferenceTime> const& timings, float walltimeMs, std::vector<float> const& percentiles,
-    int32_t batchSize, int32_t infStreams, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose)
+    int32_t batchSize, int32_t infStreams, HostUsage const& hostUsage, std::ostream& osInfo, std::ostream& osWarning,
+    std::ostream& osVerbose)
 {
     float const throughput = batchSize * timings.size() / walltimeMs * 1000;
 
@@ -227,6 +237,18 @@ void printEpilog(std::vector<InferenceTime> const& timings, float walltimeMs, st
     osInfo << "Throughput: " << throughput << " qps" << std::endl;
     osInfo << "Latency: " << toPerfString(latencyResult) << std::endl;
     osInfo << "Enqueue Time: " << toPerfString(enqueueResult) << std::endl;
+    if (hostUsage.threads > 0 && hostUsage.queries > 0)
+    {
+        auto const perQuery = [&hostUsage](int64_t count) { return static_cast<double>(count) / hostUsage.queries; };
+        osInfo << "Host CPU Time: " << hostUsage.cpuMsPerQuery() << " ms per query, " << hostUsage.cores()
+               << " cores busy over " << hostUsage.threads << " threads" << std::endl;
+        osInfo << "Context Switches: " << perQuery(hostUsage.voluntarySwitches) << " voluntary, "
+               << perQuery(hostUsage.involuntarySwitches) << " involuntary per query" << std::endl;
+    }
+    if (hostUsage.peakRss > 0)
+    {
+        osInfo << "Peak Host Memory: " << hostUsage.peakRss / 1.0_MiB << " MiB" << std::endl;
+    }
     osInfo << "H2D Latency: " << toPerfString(h2dResult) << std::endl;
     osInfo << "GPU Compute Time: " << toPerfString(gpuComputeResult) << std::endl;
     osInfo << "D2H Latency: " << toPerfString(d2hResult) << std::endl;
@@ -284,7 +306,8 @@ void printEpilog(std::vector<InferenceTime> const& timings, float walltimeMs, st
 }
 
 void printPerformanceReport(std::vector<InferenceTrace> const& trace, ReportingOptions const& reportingOpts,
-    InferenceOptions const& infOpts, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose)
+    InferenceOptions const& infOpts, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose,
+    HostUsage const& hostUsage)
 {
     int32_t batchSize = infOpts.batch;
     float const warmupMs = infOpts.warmup;
@@ -301,13 +324,506 @@ void printPerformanceReport(std::vector<InferenceTrace> const& trace, ReportingO
     std::vector<InferenceTime> timings(trace.size() - warmups);
     std::transform(noWarmup, trace.end(), timings.begin(), traceToTiming);
     printTiming(timings, reportingOpts.avgs, osInfo);
-    printEpilog(
-        timings, benchTime, reportingOpts.percentiles, batchSize, infOpts.infStreams, osInfo, osWarning, osVerbose);
+    printEpilog(timings, benchTime, reportingOpts.percentiles, batchSize, infOpts.infStreams, hostUsage, osInfo,
+        osWarning, osVerbose);
 
     if (!reportingOpts.exportTimes.empty())
     {
         exportJSONTrace(trace, reportingOpts.exportTimes, warmups);
     }
+
+    if (reportingOpts.timeSeriesWindow != timeSeriesDisabled)
+    {
+        TimeSeries series;
+        computeTimeSeries(trace, warmupMs, batchSize, reportingOpts.timeSeriesWindow,
+            reportingOpts.timeSeriesDeviation, series);
+        printTimeSeries(series, osInfo, osWarning);
+        if (!reportingOpts.exportTimeSeries.empty())
+        {
+            exportTimeSeries(series, reportingOpts.exportTimeSeries);
+        }
+    }
+}
+
+void printContextPoolReport(ContextPoolStatistics const& statistics, std::ostream& os)
+{
+    os << std::endl;
+    os << "=== Context pool summary ===" << std::endl;
+    os << "Leases: " << statistics.hits + statistics.misses << ", hits = " << statistics.hits
+       << ", misses = " << statistics.misses << ", hit rate = " << statistics.hitRate() << "%" << std::endl;
+    os << "Engines loaded: " << statistics.engineLoads << ", contexts evicted: " << statistics.evictions << std::endl;
+    os << "Device memory: current = " << statistics.memoryUsage / 1.0_MiB << " MiB, peak = "
+       << statistics.peakMemoryUsage / 1.0_MiB << " MiB, budget = ";
+    if (statistics.memoryBudget == 0)
+    {
+        os << "unlimited" << std::endl;
+    }
+    else
+    {
+        os << statistics.memoryBudget / 1.0_MiB << " MiB" << std::endl;
+    }
+}
+
+void printGraphCacheReport(GraphCacheStatistics const& statistics, std::ostream& os)
+{
+    os << std::endl;
+    os << "=== CUDA graph cache summary ===" << std::endl;
+    os << "Launches: " << statistics.hits + statistics.misses << ", hits = " << statistics.hits
+       << ", misses = " << statistics.misses << ", hit rate = " << statistics.hitRate() << "%" << std::endl;
+    os << "Graphs captured: " << statistics.captures << ", capture failures = " << statistics.captureFailures
+       << ", evictions = " << statistics.evictions << std::endl;
+    os << "Capture time: total = " << statistics.captureMs << " ms, mean = "
+       << (statistics.captures == 0 ? 0.F : statistics.captureMs / statistics.captures) << " ms" << std::endl;
+}
+
+void printHostPlacement(HostPlacement const& placement, std::ostream& os)
+{
+    os << std::endl;
+    os << "=== Host placement ===" << std::endl;
+    os << "Device NUMA node: ";
+    if (placement.deviceNumaNode < 0)
+    {
+        os << "unknown" << std::endl;
+    }
+    else
+    {
+        os << placement.deviceNumaNode << std::endl;
+    }
+    os << "Host buffers NUMA node: ";
+    if (placement.hostNumaNode < 0)
+    {
+        os << "not placed" << std::endl;
+    }
+    else
+    {
+        os << placement.hostNumaNode << std::endl;
+    }
+    for (size_t t = 0; t < placement.threadCpus.size(); ++t)
+    {
+        auto const& cpus = placement.threadCpus[t];
+        os << "Inference thread " << t << " CPUs: " << (cpus.empty() ? "not pinned" : cpuListToString(cpus))
+           << std::endl;
+    }
+}
+
+void printBuildVariantsReport(std::vector<VariantBuildResult> const& results, std::ostream& os)
+{
+    os << std::endl;
+    os << "=== Build variants summary ===" << std::endl;
+    float totalMs{0.F};
+    for (auto const& r : results)
+    {
+        os << r.name << ": ";
+        if (!r.succeeded)
+        {
+            os << "failed after " << r.buildMs << " ms" << std::endl;
+            continue;
+        }
+        totalMs += r.buildMs;
+        os << "built in " << r.buildMs << " ms, engine = " << r.engineBytes / 1.0_MiB << " MiB, timing cache "
+           << "reused = " << r.cacheStartBytes / 1.0_KiB << " KiB, added = " << r.cacheAddedBytes / 1.0_KiB << " KiB"
+           << std::endl;
+    }
+    os << "Sum of the build times: " << totalMs << " ms" << std::endl;
+}
+
+void summarizeAutotuneTrace(std::vector<InferenceTrace> const& trace, float warmupMs, AutotunePoint& point)
+{
+    auto const isNotWarmup = [&warmupMs](InferenceTrace const& a) { return a.computeStart >= warmupMs; };
+    auto const noWarmup = std::find_if(trace.begin(), trace.end(), isNotWarmup);
+    if (noWarmup == trace.end())
+    {
+        point.succeeded = false;
+        return;
+    }
+    float const benchTime = trace.back().d2hEnd - noWarmup->h2dStart;
+    std::vector<InferenceTime> timings(trace.end() - noWarmup);
+    std::transform(noWarmup, trace.end(), timings.begin(), traceToTiming);
+
+    auto const getLatency = [](InferenceTime const& t) { return t.latency(); };
+    auto const latencyResult = getPerformanceResult(timings, getLatency, {kAUTOTUNE_PERCENTILE});
+    point.throughput = point.batch * timings.size() / benchTime * 1000;
+    point.latencyPercentile = latencyResult.percentiles.front();
+    point.latencyMedian = latencyResult.median;
+}
+
+void selectAutotuneResult(AutotuneResult& result)
+{
+    result.best = -1;
+    result.paretoFrontier.clear();
+    std::vector<int32_t> measured;
+    for (int32_t i = 0, n = static_cast<int32_t>(result.points.size()); i < n; ++i)
+    {
+        auto& p = result.points[i];
+        p.withinBudget = p.succeeded && p.latencyPercentile <= result.latencyBudget;
+        if (p.withinBudget && (result.best < 0 || p.throughput > result.points[result.best].throughput))
+        {
+            result.best = i;
+        }
+        if (p.succeeded)
+        {
+            measured.push_back(i);
+        }
+    }
+
+    // A point is on the frontier if no other point has both a lower latency and a higher throughput.
+    auto const byLatency = [&result](int32_t a, int32_t b) {
+        auto const& pa = result.points[a];
+        auto const& pb = result.points[b];
+        return pa.latencyPercentile < pb.latencyPercentile
+            || (pa.latencyPercentile == pb.latencyPercentile && pa.throughput > pb.throughput);
+    };
+    std::sort(measured.begin(), measured.end(), byLatency);
+    float maxThroughput{-1.F};
+    for (auto i : measured)
+    {
+        if (result.points[i].throughput > maxThroughput)
+        {
+            maxThroughput = result.points[i].throughput;
+            result.paretoFrontier.push_back(i);
+        }
+    }
+}
+
+namespace
+{
+
+std::string autotunePointToString(AutotunePoint const& p)
+{
+    std::stringstream s;
+    s << "batch = " << p.batch << ", streams = " << p.infStreams
+      << ", threads = " << (p.threads ? "enabled" : "disabled");
+    if (!p.succeeded)
+    {
+        s << ": failed";
+        return s.str();
+    }
+    s << ": throughput = " << p.throughput << " qps, percentile(" << kAUTOTUNE_PERCENTILE
+      << "%) latency = " << p.latencyPercentile << " ms, median latency = " << p.latencyMedian << " ms";
+    return s.str();
+}
+
+void exportJSONAutotunePoint(std::ostream& os, AutotunePoint const& p)
+{
+    // clang-format off
+    os << "{ \"batch\" : "              << p.batch                                << ", "
+       << "\"infStreams\" : "           << p.infStreams                           << ", "
+       << "\"threads\" : "              << (p.threads ? "true" : "false")         << ", "
+       << "\"succeeded\" : "            << (p.succeeded ? "true" : "false")       << ", "
+       << "\"throughputQps\" : "        << p.throughput                           << ", "
+       << "\"latencyPercentileMs\" : "  << p.latencyPercentile                    << ", "
+       << "\"latencyMedianMs\" : "      << p.latencyMedian                        << ", "
+       << "\"withinBudget\" : "         << (p.withinBudget ? "true" : "false")    << " }";
+    // clang-format on
+}
+
+} // namespace
+
+void printAutotuneReport(AutotuneResult const& result, std::ostream& os)
+{
+    os << std::endl;
+    os << "=== Autotune summary ===" << std::endl;
+    os << "Latency budget: percentile(" << kAUTOTUNE_PERCENTILE << "%) latency <= " << result.latencyBudget << " ms"
+       << std::endl;
+    os << "Measured " << result.points.size() << " configurations:" << std::endl;
+    for (auto const& p : result.points)
+    {
+        os << "  " << autotunePointToString(p);
+        if (p.succeeded)
+        {
+            os << (p.withinBudget ? " (within budget)" : " (over budget)");
+        }
+        os << std::endl;
+    }
+    if (result.best < 0)
+    {
+        os << "No configuration met the latency budget." << std::endl;
+    }
+    else
+    {
+        os << "Best configuration: " << autotunePointToString(result.points[result.best]) << std::endl;
+    }
+    os << "Pareto frontier:" << std::endl;
+    for (auto i : result.paretoFrontier)
+    {
+        os << "  " << autotunePointToString(result.points[i]) << std::endl;
+    }
+}
+
+//! Printed format:
+//! { "latencyBudgetMs" : budget, "percentile" : percentile, "best" : point or null,
+//!   "paretoFrontier" : [ point, ...], "measurements" : [ point, ...] }
+//! point ::= { "batch" : batch, "infStreams" : streams, "threads" : bool, "succeeded" : bool,
+//!             "throughputQps" : throughput, "latencyPercentileMs" : time, "latencyMedianMs" : time,
+//!             "withinBudget" : bool }
+//!
+void exportJSONAutotune(AutotuneResult const& result, std::string const& fileName)
+{
+    std::ofstream os(fileName, std::ofstream::trunc);
+    os << "{ \"latencyBudgetMs\" : " << result.latencyBudget << ", \"percentile\" : " << kAUTOTUNE_PERCENTILE << ","
+       << std::endl;
+    os << "  \"best\" : ";
+    if (result.best < 0)
+    {
+        os << "null";
+    }
+    else
+    {
+        exportJSONAutotunePoint(os, result.points[result.best]);
+    }
+    os << "," << std::endl;
+
+    auto const exportList = [&os, &result](char const* name, std::vector<int32_t> const& indices) {
+        os << "  \"" << name << "\" : [" << std::endl;
+        char const* sep = "    ";
+        for (auto i : indices)
+        {
+            os << sep;
+            sep = ",\n    ";
+            exportJSONAutotunePoint(os, result.points[i]);
+        }
+        os << std::endl << "  ]";
+    };
+    exportList("paretoFrontier", result.paretoFrontier);
+    os << "," << std::endl;
+    std::vector<int32_t> all(result.points.size());
+    std::iota(all.begin(), all.end(), 0);
+    exportList("measurements", all);
+    os << std::endl << "}" << std::endl;
+}
+
+namespace
+{
+
+float medianOf(std::vector<float> values)
+{
+    if (values.empty())
+    {
+        return 0.F;
+    }
+    auto const mid = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), mid, values.end());
+    if (values.size() % 2)
+    {
+        return *mid;
+    }
+    return (*mid + *std::max_element(values.begin(), mid)) / 2;
+}
+
+float deviationOf(float value, float steady)
+{
+    return steady > 0.F ? (value - steady) / steady * 100.F : 0.F;
+}
+
+//! Renders values as a row of characters of increasing height, averaging adjacent values beyond the width.
+std::string sparkline(std::vector<float> const& values, float minValue, float maxValue)
+{
+    constexpr char kLEVELS[]{" .:-=+*#%@"};
+    constexpr int32_t kNB_LEVELS{sizeof(kLEVELS) - 1};
+    constexpr int32_t kMAX_WIDTH{64};
+    int32_t const n = static_cast<int32_t>(values.size());
+    int32_t const group = (n + kMAX_WIDTH - 1) / kMAX_WIDTH;
+    std::string line;
+    for (int32_t i = 0; i < n; i += group)
+    {
+        int32_t const end = std::min(i + group, n);
+        float const value = std::accumulate(values.begin() + i, values.begin() + end, 0.F) / (end - i);
+        float const scaled = maxValue > minValue ? (value - minValue) / (maxValue - minValue) : 1.F;
+        line += kLEVELS[std::min(static_cast<int32_t>(scaled * kNB_LEVELS), kNB_LEVELS - 1)];
+    }
+    return line;
+}
+
+std::string timeSeriesWindowToString(TimeSeriesWindow const& w)
+{
+    std::stringstream s;
+    s << "[" << w.startMs << ", " << w.endMs << ") ms: throughput = " << w.throughput << " qps ("
+      << std::showpos << w.throughputDeviation << std::noshowpos << "%)";
+    if (w.queries > 0)
+    {
+        s << ", percentile(" << kTIME_SERIES_PERCENTILE << "%) latency = " << w.latencyPercentile << " ms ("
+          << std::showpos << w.latencyDeviation << std::noshowpos << "%)";
+    }
+    else
+    {
+        s << ", no query completed";
+    }
+    return s.str();
+}
+
+} // namespace
+
+void computeTimeSeries(std::vector<InferenceTrace> const& trace, float warmupMs, int32_t batchSize, float windowMs,
+    float deviationThreshold, TimeSeries& series)
+{
+    series = TimeSeries{};
+    series.windowMs = windowMs;
+    series.deviationThreshold = deviationThreshold;
+    auto const isNotWarmup = [&warmupMs](InferenceTrace const& a) { return a.computeStart >= warmupMs; };
+    auto const noWarmup = std::find_if(trace.begin(), trace.end(), isNotWarmup);
+    if (noWarmup == trace.end() || windowMs <= 0.F)
+    {
+        return;
+    }
+
+    // Queries are assigned to the window in which they complete. A trailing remainder shorter than half a window is
+    // merged into the last window so that no window throughput is computed over a few milliseconds.
+    float const startMs = noWarmup->h2dStart;
+    float endMs = startMs;
+    for (auto it = noWarmup; it != trace.end(); ++it)
+    {
+        endMs = std::max(endMs, it->d2hEnd);
+    }
+    float const benchTime = endMs - startMs;
+    int32_t const nbWindows = std::max(static_cast<int32_t>(benchTime / windowMs + 0.5F), 1);
+    std::vector<std::vector<InferenceTime>> timings(nbWindows);
+    for (auto it = noWarmup; it != trace.end(); ++it)
+    {
+        int32_t const w = static_cast<int32_t>((it->d2hEnd - startMs) / windowMs);
+        timings[std::min(std::max(w, 0), nbWindows - 1)].push_back(traceToTiming(*it));
+    }
+
+    auto const getLatency = [](InferenceTime const& t) { return t.latency(); };
+    std::vector<float> throughputs;
+    std::vector<float> latencies;
+    for (int32_t w = 0; w < nbWindows; ++w)
+    {
+        TimeSeriesWindow window;
+        window.startMs = w * windowMs;
+        window.endMs = w + 1 == nbWindows ? benchTime : (w + 1) * windowMs;
+        window.queries = static_cast<int32_t>(timings[w].size());
+        float const durationMs = window.endMs - window.startMs;
+        window.throughput = durationMs > 0.F ? batchSize * window.queries / durationMs * 1000 : 0.F;
+        throughputs.push_back(window.throughput);
+        if (window.queries > 0)
+        {
+            auto const latencyResult = getPerformanceResult(timings[w], getLatency, {kTIME_SERIES_PERCENTILE});
+            window.latencyMedian = latencyResult.median;
+            window.latencyPercentile = latencyResult.percentiles.front();
+            latencies.push_back(window.latencyPercentile);
+        }
+        series.windows.push_back(window);
+    }
+
+    series.steadyThroughput = medianOf(throughputs);
+    series.steadyLatencyPercentile = medianOf(latencies);
+    for (auto& w : series.windows)
+    {
+        w.throughputDeviation = deviationOf(w.throughput, series.steadyThroughput);
+        w.latencyDeviation = w.queries > 0 ? deviationOf(w.latencyPercentile, series.steadyLatencyPercentile) : 0.F;
+        w.deviates = std::abs(w.throughputDeviation) > deviationThreshold
+            || std::abs(w.latencyDeviation) > deviationThreshold;
+    }
+}
+
+void printTimeSeries(TimeSeries const& series, std::ostream& osInfo, std::ostream& osWarning)
+{
+    if (series.windows.empty())
+    {
+        return;
+    }
+
+    std::vector<float> throughputs;
+    std::vector<float> latencies;
+    std::vector<float> deviations;
+    for (auto const& w : series.windows)
+    {
+        throughputs.push_back(w.throughput);
+        latencies.push_back(w.latencyPercentile);
+        deviations.push_back(w.deviates ? 1.F : 0.F);
+    }
+    auto const throughputRange = std::minmax_element(throughputs.begin(), throughputs.end());
+    auto const latencyRange = std::minmax_element(latencies.begin(), latencies.end());
+
+    osInfo << std::endl;
+    osInfo << "=== Time series ===" << std::endl;
+    osInfo << series.windows.size() << " windows of " << series.windowMs << " ms, steady state: throughput = "
+           << series.steadyThroughput << " qps, percentile(" << kTIME_SERIES_PERCENTILE
+           << "%) latency = " << series.steadyLatencyPercentile << " ms" << std::endl;
+    osInfo << "Throughput: |" << sparkline(throughputs, *throughputRange.first, *throughputRange.second)
+           << "| min = " << *throughputRange.first << " qps, max = " << *throughputRange.second << " qps" << std::endl;
+    osInfo << "Latency:    |" << sparkline(latencies, *latencyRange.first, *latencyRange.second)
+           << "| min = " << *latencyRange.first << " ms, max = " << *latencyRange.second << " ms" << std::endl;
+    osInfo << "Deviations: |" << sparkline(deviations, 0.F, 1.F) << "|" << std::endl;
+
+    int32_t const nbDeviating = static_cast<int32_t>(std::count_if(
+        series.windows.begin(), series.windows.end(), [](TimeSeriesWindow const& w) { return w.deviates; }));
+    if (nbDeviating == 0)
+    {
+        osInfo << "No window deviates more than " << series.deviationThreshold << "% from steady state." << std::endl;
+        return;
+    }
+
+    constexpr int32_t kMAX_REPORTED_WINDOWS{10};
+    osWarning << "* " << nbDeviating << " of " << series.windows.size() << " windows deviate more than "
+              << series.deviationThreshold << "% from steady state:" << std::endl;
+    int32_t reported{0};
+    for (auto const& w : series.windows)
+    {
+        if (w.deviates && reported++ < kMAX_REPORTED_WINDOWS)
+        {
+            osWarning << "  " << timeSeriesWindowToString(w) << std::endl;
+        }
+    }
+    if (nbDeviating > kMAX_REPORTED_WINDOWS)
+    {
+        osWarning << "  ... and " << nbDeviating - kMAX_REPORTED_WINDOWS << " more, see --exportTimeSeries."
+                  << std::endl;
+    }
+    osWarning << "  Deviations late in the run may come from thermal throttling or clock changes; locking the GPU "
+              << "clock frequency may improve the stability." << std::endl;
+}
+
+//! Printed format, JSON:
+//! { "windowMs" : time, "percentile" : percentile, "deviationThresholdPct" : threshold,
+//!   "steadyThroughputQps" : throughput, "steadyLatencyPercentileMs" : time, "windows" : [ window, ...] }
+//! window ::= { "startMs" : time, "endMs" : time, "queries" : count, "throughputQps" : throughput,
+//!              "latencyMedianMs" : time, "latencyPercentileMs" : time, "throughputDeviationPct" : deviation,
+//!              "latencyDeviationPct" : deviation, "deviates" : bool }
+//! CSV: a header line with the same window fields, then one line per window.
+//!
+void exportTimeSeries(TimeSeries const& series, std::string const& fileName)
+{
+    std::string const csvExtension{".csv"};
+    bool const csv = fileName.size() >= csvExtension.size()
+        && fileName.compare(fileName.size() - csvExtension.size(), csvExtension.size(), csvExtension) == 0;
+    std::ofstream os(fileName, std::ofstream::trunc);
+    if (csv)
+    {
+        os << "startMs,endMs,queries,throughputQps,latencyMedianMs,latencyPercentileMs,throughputDeviationPct,"
+           << "latencyDeviationPct,deviates" << std::endl;
+        for (auto const& w : series.windows)
+        {
+            os << w.startMs << "," << w.endMs << "," << w.queries << "," << w.throughput << "," << w.latencyMedian
+               << "," << w.latencyPercentile << "," << w.throughputDeviation << "," << w.latencyDeviation << ","
+               << (w.deviates ? 1 : 0) << std::endl;
+        }
+        return;
+    }
+
+    os << "{ \"windowMs\" : " << series.windowMs << ", \"percentile\" : " << kTIME_SERIES_PERCENTILE
+       << ", \"deviationThresholdPct\" : " << series.deviationThreshold << "," << std::endl;
+    os << "  \"steadyThroughputQps\" : " << series.steadyThroughput
+       << ", \"steadyLatencyPercentileMs\" : " << series.steadyLatencyPercentile << "," << std::endl;
+    os << "  \"windows\" : [" << std::endl;
+    char const* sep = "    ";
+    for (auto const& w : series.windows)
+    {
+        os << sep;
+        sep = ",\n    ";
+        // clang-format off
+        os << "{ \"startMs\" : "              << w.startMs                         << ", "
+           << "\"endMs\" : "                  << w.endMs                           << ", "
+           << "\"queries\" : "                << w.queries                         << ", "
+           << "\"throughputQps\" : "          << w.throughput                      << ", "
+           << "\"latencyMedianMs\" : "        << w.latencyMedian                   << ", "
+           << "\"latencyPercentileMs\" : "    << w.latencyPercentile               << ", "
+           << "\"throughputDeviationPct\" : " << w.throughputDeviation             << ", "
+           << "\"latencyDeviationPct\" : "    << w.latencyDeviation                << ", "
+           << "\"deviates\" : "               << (w.deviates ? "true" : "false")   << " }";
+        // clang-format on
+    }
+    os << std::endl << "  ]" << std::endl << "}" << std::endl;
 }
 
 //! Printed format:
@@ -340,12 +856,156 @@ void exportJSONTrace(std::vector<InferenceTrace> const& trace, std::string const
     os << "]" << std::endl;
 }
 
+StreamingQuantile::StreamingQuantile(float quantile)
+    : mQuantile(quantile)
+    , mIncrements{0.F, quantile / 2.F, quantile, (1.F + quantile) / 2.F, 1.F}
+{
+}
+
+void StreamingQuantile::add(float value) noexcept
+{
+    if (mCount < kNB_MARKERS)
+    {
+        mHeights[mCount++] = value;
+        if (mCount == kNB_MARKERS)
+        {
+            std::sort(mHeights.begin(), mHeights.end());
+            for (int32_t i = 0; i < kNB_MARKERS; ++i)
+            {
+                mPositions[i] = i;
+                mDesired[i] = (kNB_MARKERS - 1) * mIncrements[i];
+            }
+        }
+        return;
+    }
+
+    // Find the cell containing the new value, extending the extreme markers if needed.
+    int32_t cell{0};
+    if (value < mHeights[0])
+    {
+        mHeights[0] = value;
+    }
+    else if (value >= mHeights[kNB_MARKERS - 1])
+    {
+        mHeights[kNB_MARKERS - 1] = value;
+        cell = kNB_MARKERS - 2;
+    }
+    else
+    {
+        while (value >= mHeights[cell + 1])
+        {
+            ++cell;
+        }
+    }
+
+    for (int32_t i = cell + 1; i < kNB_MARKERS; ++i)
+    {
+        ++mPositions[i];
+    }
+    for (int32_t i = 0; i < kNB_MARKERS; ++i)
+    {
+        mDesired[i] += mIncrements[i];
+    }
+
+    // Move the middle markers towards their desired positions.
+    for (int32_t i = 1; i < kNB_MARKERS - 1; ++i)
+    {
+        float const d = mDesired[i] - mPositions[i];
+        if ((d >= 1.F && mPositions[i + 1] - mPositions[i] > 1) || (d <= -1.F && mPositions[i - 1] - mPositions[i] < -1))
+        {
+            int32_t const step = d > 0.F ? 1 : -1;
+            float const height = parabolic(i, static_cast<float>(step));
+            if (mHeights[i - 1] < height && height < mHeights[i + 1])
+            {
+                mHeights[i] = height;
+            }
+            else
+            {
+                mHeights[i] = linear(i, step);
+            }
+            mPositions[i] += step;
+        }
+    }
+    ++mCount;
+}
+
+float StreamingQuantile::get() const noexcept
+{
+    if (mCount == 0)
+    {
+        return 0.F;
+    }
+    if (mCount >= kNB_MARKERS)
+    {
+        return mHeights[kNB_MARKERS / 2];
+    }
+    std::array<float, kNB_MARKERS> values = mHeights;
+    std::sort(values.begin(), values.begin() + mCount);
+    float const rank = mQuantile * (mCount - 1);
+    int32_t const lower = static_cast<int32_t>(rank);
+    int32_t const upper = std::min(lower + 1, static_cast<int32_t>(mCount - 1));
+    return values[lower] + (rank - lower) * (values[upper] - values[lower]);
+}
+
+float StreamingQuantile::parabolic(int32_t i, float d) const noexcept
+{
+    float const n = mPositions[i];
+    float const nPrev = mPositions[i - 1];
+    float const nNext = mPositions[i + 1];
+    return mHeights[i]
+        + d / (nNext - nPrev)
+        * ((n - nPrev + d) * (mHeights[i + 1] - mHeights[i]) / (nNext - n)
+            + (nNext - n - d) * (mHeights[i] - mHeights[i - 1]) / (n - nPrev));
+}
+
+float StreamingQuantile::linear(int32_t i, int32_t d) const noexcept
+{
+    return mHeights[i] + d * (mHeights[i + d] - mHeights[i]) / (mPositions[i + d] - mPositions[i]);
+}
+
+void LayerStatistics::add(float timeMs) noexcept
+{
+    ++count;
+    totalMs += timeMs;
+    minMs = std::min(minMs, timeMs);
+    maxMs = std::max(maxMs, timeMs);
+    medianMs.add(timeMs);
+}
+
+Profiler::Profiler(bool streaming, int32_t traceSampling)
+    : mStreaming(streaming)
+    , mTraceSampling(traceSampling)
+{
+}
+
+void Profiler::startIteration() noexcept
+{
+    if (mUpdatesCount > 0)
+    {
+        mIterationStats.add(mIterationTimeMs);
+    }
+    mIterationTimeMs = 0.F;
+    mTracing = mTraceSampling > 0 && mUpdatesCount % mTraceSampling == 0
+        && static_cast<int32_t>(mTrace.size()) < kMAX_TRACE_ITERATIONS;
+    if (mTracing)
+    {
+        mTrace.emplace_back();
+        mTrace.back().iteration = mUpdatesCount;
+        mTrace.back().timeMs.reserve(mLayers.size());
+    }
+    ++mUpdatesCount;
+}
+
 void Profiler::reportLayerTime(char const* layerName, float timeMs) noexcept
 {
     if (mIterator == mLayers.end())
     {
+        // Layer names are only compared at iteration boundaries; within an iteration layers are tracked by index.
         bool const first = !mLayers.empty() && mLayers.begin()->name == layerName;
-        mUpdatesCount += mLayers.empty() || first;
+        if (mLayers.empty() || first)
+        {
+            startIteration();
+        }
         if (first)
         {
             mIterator = mLayers.begin();
@@ -358,7 +1018,16 @@ void Profiler::reportLayerTime(char const* layerName, float timeMs) noexcept
         }
     }
 
-    mIterator->timeMs.push_back(timeMs);
+    if (!mStreaming)
+    {
+        mIterator->timeMs.push_back(timeMs);
+    }
+    mIterator->stats.add(timeMs);
+    mIterationTimeMs += timeMs;
+    if (mTracing)
+    {
+        mTrace.back().timeMs.push_back(timeMs);
+    }
     ++mIterator;
 }
 
@@ -367,7 +1036,7 @@ void Profiler::print(std::ostream& os) const noexcept
     std::string const nameHdr("Layer");
     std::string const timeHdr("   Time (ms)");
     std::string const avgHdr("   Avg. Time (ms)");
-    std::string const medHdr("   Median Time (ms)");
+    std::string const medHdr(mStreaming ? "   Est. Median Time (ms)" : "   Median Time (ms)");
     std::string const percentageHdr("   Time %");
 
     float const totalTimeMs = getTotalTime();
@@ -386,7 +1055,7 @@ void Profiler::print(std::ostream& os) const noexcept
 
     for (auto const& p : mLayers)
     {
-        if (p.timeMs.empty() || getTotalTime(p) == 0.F)
+        if (p.stats.count == 0 || getTotalTime(p) == 0.F)
         {
             // there is no point to print profiling for layer that didn't run at all
             continue;
@@ -422,6 +1091,8 @@ void Profiler::exportJSONProfile(std::string const& fileName) const noexcept
                        R"(, "timeMs" : )"     << getTotalTime(l)
            <<          R"(, "averageMs" : )"  << getAvgTime(l)
            <<          R"(, "medianMs" : )"  << getMedianTime(l)
+           <<          R"(, "minMs" : )"      << l.stats.minMs
+           <<          R"(, "maxMs" : )"      << l.stats.maxMs
            <<          R"(, "percentage" : )" << getTotalTime(l) / totalTimeMs * 100
            << " }"  << std::endl;
         // clang-format on
@@ -429,6 +1100,45 @@ void Profiler::exportJSONProfile(std::string const& fileName) const noexcept
     os << "]" << std::endl;
 }
 
+//! Printed format (Chrome trace event format, loadable by chrome://tracing and Perfetto):
+//! { "displayTimeUnit" : "ms", "traceEvents" : [ event, ...] }
+//! event ::= { "name" : name, "cat" : "iteration" | "layer", "ph" : "X", "pid" : 0, "tid" : 0, "ts" : time,
+//!             "dur" : time, "args" : { "iteration" : N } }
+//!
+//! Times are in microseconds. The profiler only reports layer durations, so the timeline is reconstructed by placing
+//! the layers of an iteration back to back, and the recorded iterations one after another.
+//!
+void Profiler::exportChromeTrace(std::string const& fileName) const noexcept
+{
+    constexpr double kUS_PER_MS{1000.0};
+    std::ofstream os(fileName, std::ofstream::trunc);
+    os << R"({ "displayTimeUnit" : "ms", "traceEvents" : [)" << std::endl;
+
+    auto const printEvent = [&os](char const* sep, std::string const& name, char const* category, int32_t iteration,
+                                double startMs, double durationMs) {
+        // clang-format off
+        os << sep << R"({ "name" : ")" << name << R"(", "cat" : ")" << category << R"(", "ph" : "X")"
+           << R"(, "pid" : 0, "tid" : 0, "ts" : )" << startMs * kUS_PER_MS << R"(, "dur" : )" << durationMs * kUS_PER_MS
+           << R"(, "args" : { "iteration" : )" << iteration << " } }" << std::endl;
+        // clang-format on
+    };
+
+    char const* sep = "  ";
+    double startMs{0.0};
+    for (auto const& t : mTrace)
+    {
+        double const iterationMs = std::accumulate(t.timeMs.begin(), t.timeMs.end(), 0.0);
+        printEvent(sep, "Iteration " + std::to_string(t.iteration), "iteration", t.iteration, startMs, iterationMs);
+        sep = ", ";
+        for (size_t l = 0; l < t.timeMs.size() && l < mLayers.size(); ++l)
+        {
+            printEvent(sep, mLayers[l].name, "layer", t.iteration, startMs, t.timeMs[l]);
+            startMs += t.timeMs[l];
+        }
+    }
+    os << "] }" << std::endl;
+}
+
 void dumpInputs(nvinfer1::IExecutionContext const& context, Bindings const& bindings, std::ostream& os)
 {
     os << "Input Tensors:" << std::endl;
@@ -516,9 +1226,13 @@ void printPerformanceProfile(ReportingOptions const& reporting, InferenceEnviron
     {
         iEnv.profiler->exportJSONProfile(reporting.exportProfile);
     }
+    if (!reporting.exportProfileTrace.empty())
+    {
+        iEnv.profiler->exportChromeTrace(reporting.exportProfileTrace);
+    }
 
     // Print an warning about total per-layer latency when auxiliary streams are used.
-    if (!iEnv.safe && (reporting.profile || !reporting.exportProfile.empty()))
+    if (!iEnv.safe && (reporting.profile || !reporting.exportProfile.empty() || !reporting.exportProfileTrace.empty()))
     {
         int32_t const nbAuxStreams = iEnv.engine.get()->getNbAuxStreams();
         if (nbAuxStreams > 0)
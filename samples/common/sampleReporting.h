@@ -18,8 +18,11 @@
 #ifndef TRT_SAMPLE_REPORTING_H
 #define TRT_SAMPLE_REPORTING_H
 
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <numeric>
 
 #include "NvInfer.h"
@@ -128,6 +131,208 @@ struct PerformanceResult
     float coeffVar{0.F}; // coefficient of variation
 };
 
+//!
+//! \struct ContextPoolStatistics
+//! \brief Usage of a ContextPool
+//!
+struct ContextPoolStatistics
+{
+    int64_t hits{0};          //!< Number of leases served by an idle pooled context
+    int64_t misses{0};        //!< Number of leases that created a context
+    int64_t evictions{0};     //!< Number of contexts evicted to stay within the memory budget
+    int64_t engineLoads{0};   //!< Number of engines deserialized
+    size_t memoryUsage{0};    //!< Device memory of the pooled contexts and bindings, in bytes
+    size_t peakMemoryUsage{0};
+    size_t memoryBudget{0};   //!< 0 if the pool has no budget
+
+    float hitRate() const
+    {
+        int64_t const leases = hits + misses;
+        return leases == 0 ? 0.F : 100.F * hits / leases;
+    }
+};
+
+//!
+//! \struct GraphCacheStatistics
+//! \brief Usage of the per-shape CUDA graph caches of the inference streams
+//!
+struct GraphCacheStatistics
+{
+    int64_t hits{0};             //!< Number of iterations launched from a cached graph
+    int64_t misses{0};           //!< Number of iterations enqueued directly because their shape had no graph
+    int64_t captures{0};         //!< Number of graphs captured
+    int64_t captureFailures{0};  //!< Number of shapes that could not be captured and always run without a graph
+    int64_t evictions{0};        //!< Number of graphs evicted to stay within the cache size
+    float captureMs{0.F};        //!< Host time spent capturing and instantiating graphs
+
+    float hitRate() const
+    {
+        int64_t const launches = hits + misses;
+        return launches == 0 ? 0.F : 100.F * hits / launches;
+    }
+
+    GraphCacheStatistics& operator+=(GraphCacheStatistics const& other)
+    {
+        hits += other.hits;
+        misses += other.misses;
+        captures += other.captures;
+        captureFailures += other.captureFailures;
+        evictions += other.evictions;
+        captureMs += other.captureMs;
+        return *this;
+    }
+};
+
+//!
+//! \struct HostPlacement
+//! \brief CPUs and NUMA nodes used by an inference run
+//!
+struct HostPlacement
+{
+    int32_t deviceNumaNode{-1};                   //!< NUMA node closest to the device, -1 if unknown
+    int32_t hostNumaNode{-1};                     //!< NUMA node of the host buffers, -1 if not placed
+    std::vector<std::vector<int32_t>> threadCpus; //!< CPUs of each inference thread, empty if not pinned
+};
+
+//!
+//! \struct HostUsage
+//! \brief Host resources used by the inference threads over a run, warmups included
+//!
+struct HostUsage
+{
+    int32_t threads{0};              //!< Inference threads measured, 0 if unsupported
+    int64_t queries{0};              //!< Queries enqueued by the measured threads
+    double cpuMs{0.0};               //!< User and system CPU time of the measured threads
+    double wallMs{0.0};              //!< Longest inference loop of the measured threads
+    int64_t voluntarySwitches{0};    //!< Mostly waits for the GPU or for another thread
+    int64_t involuntarySwitches{0};  //!< Preemptions, a sign of too few CPUs for the threads
+    int64_t peakRss{0};              //!< Peak resident set size of the process sampled during the run, in bytes
+
+    double cpuMsPerQuery() const
+    {
+        return queries == 0 ? 0.0 : cpuMs / queries;
+    }
+
+    //! Average number of CPUs busy with inference threads.
+    double cores() const
+    {
+        return wallMs == 0.0 ? 0.0 : cpuMs / wallMs;
+    }
+
+    //! Sum the usage of concurrent threads: the longest loop and the highest peak are kept.
+    HostUsage& operator+=(HostUsage const& other)
+    {
+        threads += other.threads;
+        queries += other.queries;
+        cpuMs += other.cpuMs;
+        wallMs = std::max(wallMs, other.wallMs);
+        voluntarySwitches += other.voluntarySwitches;
+        involuntarySwitches += other.involuntarySwitches;
+        peakRss = std::max(peakRss, other.peakRss);
+        return *this;
+    }
+};
+
+//! Latency percentile bounded by the latency budget of the autotuner.
+constexpr float kAUTOTUNE_PERCENTILE{99.F};
+
+//!
+//! \struct AutotunePoint
+//! \brief One configuration measured by the autotuner
+//!
+struct AutotunePoint
+{
+    int32_t batch{1};              //!< --batch, or the first dimension of the dynamic inputs for explicit batch engines
+    int32_t infStreams{1};
+    bool threads{false};
+    bool succeeded{false};         //!< Whether the configuration could be set up and run
+    float throughput{0.F};         //!< Inputs per second, counting every item of a batch
+    float latencyPercentile{0.F};  //!< Latency at kAUTOTUNE_PERCENTILE in ms
+    float latencyMedian{0.F};      //!< Median latency in ms
+    bool withinBudget{false};
+};
+
+//!
+//! \struct AutotuneResult
+//! \brief Configurations measured by the autotuner, the best one within the latency budget and the Pareto frontier
+//!
+struct AutotuneResult
+{
+    float latencyBudget{0.F};
+    std::vector<AutotunePoint> points;     //!< In measurement order
+    int32_t best{-1};                      //!< Index in points, -1 if no configuration met the budget
+    std::vector<int32_t> paretoFrontier;   //!< Indices in points, by increasing latency and throughput
+};
+
+//!
+//! \brief Fill the throughput and latencies of an autotuner point from the trace of its run
+//!
+void summarizeAutotuneTrace(std::vector<InferenceTrace> const& trace, float warmupMs, AutotunePoint& point);
+
+//!
+//! \brief Select the best point within the latency budget and compute the Pareto frontier of the measured points
+//!
+void selectAutotuneResult(AutotuneResult& result);
+
+//!
+//! \brief Print the configurations measured by the autotuner and its selection
+//!
+void printAutotuneReport(AutotuneResult const& result, std::ostream& os);
+
+//!
+//! \brief Export the configurations measured by the autotuner and its selection to JSON file
+//!
+void exportJSONAutotune(AutotuneResult const& result, std::string const& fileName);
+
+//! Latency percentile reported per window of the time series.
+constexpr float kTIME_SERIES_PERCENTILE{99.F};
+
+//!
+//! \struct TimeSeriesWindow
+//! \brief Throughput and latencies of the queries completed in one window of the timing run
+//!
+struct TimeSeriesWindow
+{
+    float startMs{0.F};              //!< Relative to the start of the timing run
+    float endMs{0.F};                //!< Shorter than a full window for the last one
+    int32_t queries{0};
+    float throughput{0.F};           //!< Queries per second, counting every item of a batch
+    float latencyMedian{0.F};        //!< Median latency in ms, 0 if no query completed
+    float latencyPercentile{0.F};    //!< Latency at kTIME_SERIES_PERCENTILE in ms, 0 if no query completed
+    float throughputDeviation{0.F};  //!< Relative to the steady state in %
+    float latencyDeviation{0.F};     //!< Relative to the steady state in %
+    bool deviates{false};
+};
+
+//!
+//! \struct TimeSeries
+//! \brief Windowed aggregation of a timing trace. The steady state is the median of the windows.
+//!
+struct TimeSeries
+{
+    float windowMs{0.F};
+    float deviationThreshold{0.F};   //!< In %
+    float steadyThroughput{0.F};
+    float steadyLatencyPercentile{0.F};
+    std::vector<TimeSeriesWindow> windows;
+};
+
+//!
+//! \brief Split the timed part of a trace into windows by query completion time and flag the windows that deviate
+//!
+void computeTimeSeries(std::vector<InferenceTrace> const& trace, float warmupMs, int32_t batchSize, float windowMs,
+    float deviationThreshold, TimeSeries& series);
+
+//!
+//! \brief Print a summary of a time series with a sparkline of its throughput and latency and the deviating windows
+//!
+void printTimeSeries(TimeSeries const& series, std::ostream& osInfo, std::ostream& osWarning);
+
+//!
+//! \brief Export a time series to CSV file if its name ends with .csv, else to JSON file
+//!
+void exportTimeSeries(TimeSeries const& series, std::string const& fileName);
+
 //!
 //! \brief Print benchmarking time and number of traces collected
 //!
@@ -159,7 +364,28 @@ void printMetricExplanations(std::ostream& os);
 //! \brief Print and summarize a timing trace
 //!
 void printPerformanceReport(std::vector<InferenceTrace> const& trace, ReportingOptions const& reportingOpts,
-    InferenceOptions const& infOpts, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose);
+    InferenceOptions const& infOpts, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose,
+    HostUsage const& hostUsage = HostUsage{});
+
+//!
+//! \brief Print the usage summary of a context pool
+//!
+void printContextPoolReport(ContextPoolStatistics const& statistics, std::ostream& os);
+
+//!
+//! \brief Print the usage summary of the CUDA graph caches
+//!
+void printGraphCacheReport(GraphCacheStatistics const& statistics, std::ostream& os);
+
+//!
+//! \brief Print the CPUs and NUMA nodes used by an inference run
+//!
+void printHostPlacement(HostPlacement const& placement, std::ostream& os);
+
+//!
+//! \brief Print the build time, timing cache reuse and engine size of each build variant
+//!
+void printBuildVariantsReport(std::vector<VariantBuildResult> const& results, std::ostream& os);
 
 //!
 //! \brief Export a timing trace to JSON file
@@ -189,6 +415,49 @@ void exportJSONOutput(
     ContextType const& context, Bindings const& bindings, std::string const& fileName, int32_t batch);
 
 
+//!
+//! \class StreamingQuantile
+//! \brief Estimate a quantile of a stream of values in constant memory using the P-square algorithm
+//!
+class StreamingQuantile
+{
+public:
+    explicit StreamingQuantile(float quantile = 0.5F);
+
+    void add(float value) noexcept;
+
+    //! Return the estimated quantile, which is exact if fewer than five values were added.
+    float get() const noexcept;
+
+private:
+    static constexpr int32_t kNB_MARKERS{5};
+
+    float parabolic(int32_t i, float d) const noexcept;
+    float linear(int32_t i, int32_t d) const noexcept;
+
+    float mQuantile{0.5F};
+    int64_t mCount{0};
+    std::array<float, kNB_MARKERS> mHeights{};
+    std::array<int64_t, kNB_MARKERS> mPositions{};
+    std::array<float, kNB_MARKERS> mDesired{};
+    std::array<float, kNB_MARKERS> mIncrements{};
+};
+
+//!
+//! \struct LayerStatistics
+//! \brief Running statistics of a sequence of times, using a fixed amount of memory
+//!
+struct LayerStatistics
+{
+    int64_t count{0};
+    double totalMs{0.0};
+    float minMs{std::numeric_limits<float>::max()};
+    float maxMs{0.F};
+    StreamingQuantile medianMs{0.5F};
+
+    void add(float timeMs) noexcept;
+};
+
 //!
 //! \struct LayerProfile
 //! \brief Layer profile information
@@ -196,17 +465,31 @@ void exportJSONOutput(
 struct LayerProfile
 {
     std::string name;
-    std::vector<float> timeMs;
+    std::vector<float> timeMs; //!< Every reported time. Empty when the profiler is streaming.
+    LayerStatistics stats;
 };
 
 //!
 //! \class Profiler
 //! \brief Collect per-layer profile information, assuming times are reported in the same order
 //!
+//! By default every reported time is kept so that exact medians can be computed. In streaming mode only fixed-size
+//! statistics are kept per layer and the median is estimated, so memory does not grow with the number of iterations.
+//! A subset of iterations can optionally be recorded to export per-layer timelines.
+//!
 class Profiler : public nvinfer1::IProfiler
 {
 
 public:
+    Profiler() = default;
+
+    //!
+    //! \param streaming Aggregate layer times into fixed-memory statistics instead of keeping every sample.
+    //! \param traceSampling Record the layer times of every traceSampling-th iteration for exportChromeTrace(), or
+    //!        disable recording if it is 0.
+    //!
+    Profiler(bool streaming, int32_t traceSampling);
+
     void reportLayerTime(char const* layerName, float timeMs) noexcept override;
 
     void print(std::ostream& os) const noexcept;
@@ -216,11 +499,31 @@ public:
     //!
     void exportJSONProfile(std::string const& fileName) const noexcept;
 
+    //!
+    //! \brief Export the per-layer timelines of the recorded iterations to a Chrome trace JSON file
+    //!
+    void exportChromeTrace(std::string const& fileName) const noexcept;
+
 private:
+    //! Maximum number of iterations recorded for exportChromeTrace().
+    static constexpr int32_t kMAX_TRACE_ITERATIONS{100};
+
+    //!
+    //! \struct TraceIteration
+    //! \brief Layer times of one recorded iteration, in the order of mLayers
+    //!
+    struct TraceIteration
+    {
+        int32_t iteration{0};
+        std::vector<float> timeMs;
+    };
+
+    void startIteration() noexcept;
+
     float getTotalTime() const noexcept
     {
         auto const plusLayerTime = [](float accumulator, LayerProfile const& lp) {
-            return accumulator + std::accumulate(lp.timeMs.begin(), lp.timeMs.end(), 0.F, std::plus<float>());
+            return accumulator + static_cast<float>(lp.stats.totalMs);
         };
         return std::accumulate(mLayers.begin(), mLayers.end(), 0.0F, plusLayerTime);
     }
@@ -231,6 +534,16 @@ private:
         {
             return 0.F;
         }
+        if (mStreaming)
+        {
+            // The last iteration is only accounted for once the next one starts, so add it here if it is complete.
+            auto iterationTimes = mIterationStats;
+            if (mIterator == mLayers.end())
+            {
+                iterationTimes.add(mIterationTimeMs);
+            }
+            return iterationTimes.medianMs.get();
+        }
         std::vector<float> totalTime;
         for (size_t run = 0; run < mLayers[0].timeMs.size(); ++run)
         {
@@ -244,7 +557,7 @@ private:
 
     float getMedianTime(LayerProfile const& p) const noexcept
     {
-        return median(p.timeMs);
+        return mStreaming ? p.stats.medianMs.get() : median(p.timeMs);
     }
 
     static float median(std::vector<float> vals)
@@ -264,18 +577,26 @@ private:
     //! return the total runtime of given layer profile
     float getTotalTime(LayerProfile const& p) const noexcept
     {
-        auto const& vals = p.timeMs;
-        return std::accumulate(vals.begin(), vals.end(), 0.F, std::plus<float>());
+        return static_cast<float>(p.stats.totalMs);
     }
 
     float getAvgTime(LayerProfile const& p) const noexcept
     {
-        return getTotalTime(p) / p.timeMs.size();
+        return getTotalTime(p) / p.stats.count;
     }
 
+    bool mStreaming{false};
+    int32_t mTraceSampling{0};
+
     std::vector<LayerProfile> mLayers;
     std::vector<LayerProfile>::iterator mIterator{mLayers.begin()};
     int32_t mUpdatesCount{0};
+
+    LayerStatistics mIterationStats; //!< Statistics of the total time of completed iterations.
+    float mIterationTimeMs{0.F};     //!< Total time of the current iteration so far.
+
+    std::vector<TraceIteration> mTrace;
+    bool mTracing{false}; //!< Whether the current iteration is recorded in mTrace.
 };
 
 //!
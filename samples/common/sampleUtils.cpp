@@ -18,6 +18,31 @@
 #include "sampleUtils.h"
 #include "half.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <sstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
 using namespace nvinfer1;
 
 namespace sample
@@ -116,6 +141,380 @@ std::vector<std::string> splitToStringVec(std::string const& s, char separator)
     return splitted;
 }
 
+MappedFile::MappedFile(std::string const& fileName, bool copyOnWrite)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+    LARGE_INTEGER fileSize{};
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        mMapping = CreateFileMappingA(file, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+        if (mMapping != nullptr)
+        {
+            mData = MapViewOfFile(mMapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+            mSize = mData != nullptr ? static_cast<size_t>(fileSize.QuadPart) : 0;
+        }
+    }
+    CloseHandle(file);
+#else
+    int32_t const fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        int32_t const protection = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), protection, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            mData = data;
+            mSize = static_cast<size_t>(fileStat.st_size);
+        }
+    }
+    close(fd);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(_WIN32)
+    if (mData != nullptr)
+    {
+        UnmapViewOfFile(mData);
+    }
+    if (mMapping != nullptr)
+    {
+        CloseHandle(mMapping);
+    }
+#else
+    if (mData != nullptr)
+    {
+        munmap(mData, mSize);
+    }
+#endif
+}
+
+namespace
+{
+
+constexpr char kWTS_MAGIC[4]{'W', 'T', 'S', '3'};
+constexpr size_t kWTS_HEADER_SIZE{16};
+
+static_assert(sizeof(WeightsFile::WtsIndexEntry) == 72, "wts v3 index entries are 72 bytes");
+
+} // namespace
+
+WeightsFile::WeightsFile(std::string const& fileName)
+    : mFile(fileName, true)
+{
+    if (mFile.size() < kWTS_HEADER_SIZE || std::memcmp(mFile.data(), kWTS_MAGIC, sizeof(kWTS_MAGIC)) != 0)
+    {
+        return;
+    }
+    auto const* header = static_cast<uint8_t const*>(mFile.data());
+    uint32_t count{0};
+    uint32_t alignment{0};
+    std::memcpy(&count, header + 4, sizeof(count));
+    std::memcpy(&alignment, header + 8, sizeof(alignment));
+    if (alignment == 0 || (mFile.size() - kWTS_HEADER_SIZE) / sizeof(WtsIndexEntry) < count)
+    {
+        return;
+    }
+    mCount = count;
+    mAlignment = alignment;
+}
+
+WeightsFile::WtsIndexEntry const* WeightsFile::find(std::string const& name) const
+{
+    auto const* base = static_cast<char const*>(mFile.data());
+    auto const* index = reinterpret_cast<WtsIndexEntry const*>(base + kWTS_HEADER_SIZE);
+    size_t const size = mFile.size();
+
+    size_t first{0};
+    size_t last{mCount};
+    while (first < last)
+    {
+        size_t const middle = first + (last - first) / 2;
+        WtsIndexEntry const& entry = index[middle];
+        if (entry.nameOffset > size || entry.nameLength > size - entry.nameOffset)
+        {
+            return nullptr;
+        }
+
+        // Names are compared as bytes, a prefix before the longer names, as sorted by the writer.
+        size_t const length = std::min<size_t>(entry.nameLength, name.size());
+        int32_t result = std::memcmp(base + entry.nameOffset, name.data(), length);
+        if (result == 0)
+        {
+            result = entry.nameLength < name.size() ? -1 : (entry.nameLength > name.size() ? 1 : 0);
+        }
+        if (result == 0)
+        {
+            bool const valid = entry.dataOffset <= size && entry.byteSize <= size - entry.dataOffset
+                && entry.dataOffset % mAlignment == 0 && entry.nbDims >= 0
+                && entry.nbDims <= nvinfer1::Dims::MAX_DIMS
+                && std::all_of(entry.dims, entry.dims + entry.nbDims, [](int32_t d) { return d >= 0; });
+            return valid ? &entry : nullptr;
+        }
+        if (result < 0)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return nullptr;
+}
+
+nvinfer1::Weights WeightsFile::getWeights(std::string const& name, nvinfer1::Dims* dims) const
+{
+    nvinfer1::Weights weights{nvinfer1::DataType::kFLOAT, nullptr, 0};
+    WtsIndexEntry const* entry = isValid() ? find(name) : nullptr;
+    if (entry == nullptr)
+    {
+        return weights;
+    }
+
+    nvinfer1::Dims shape{};
+    shape.nbDims = entry->nbDims;
+    std::copy(entry->dims, entry->dims + entry->nbDims, shape.d);
+    weights.type = static_cast<nvinfer1::DataType>(entry->type);
+    size_t const elementSize = dataTypeSize(weights.type);
+    weights.count = elementSize > 0 ? static_cast<int64_t>(entry->byteSize / elementSize) : -1;
+    if (weights.count != volume(shape, 0, shape.nbDims) || entry->byteSize % std::max<size_t>(elementSize, 1) != 0)
+    {
+        return nvinfer1::Weights{nvinfer1::DataType::kFLOAT, nullptr, 0};
+    }
+    weights.values = static_cast<char const*>(mFile.data()) + entry->dataOffset;
+    if (dims != nullptr)
+    {
+        *dims = shape;
+    }
+    return weights;
+}
+
+bool isDirectory(std::string const& path)
+{
+#if defined(_WIN32)
+    DWORD const attributes = GetFileAttributesA(path.c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+#else
+    struct stat pathStat;
+    return stat(path.c_str(), &pathStat) == 0 && S_ISDIR(pathStat.st_mode);
+#endif
+}
+
+std::vector<std::string> listFiles(std::string const& directory)
+{
+    std::vector<std::string> files;
+#if defined(_WIN32)
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA((directory + "\\*").c_str(), &entry);
+    if (find == INVALID_HANDLE_VALUE)
+    {
+        return files;
+    }
+    do
+    {
+        if ((entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+        {
+            files.emplace_back(directory + "\\" + entry.cFileName);
+        }
+    } while (FindNextFileA(find, &entry));
+    FindClose(find);
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr)
+    {
+        return files;
+    }
+    while (dirent const* entry = readdir(dir))
+    {
+        std::string const path = directory + "/" + entry->d_name;
+        struct stat pathStat;
+        if (stat(path.c_str(), &pathStat) == 0 && S_ISREG(pathStat.st_mode))
+        {
+            files.push_back(path);
+        }
+    }
+    closedir(dir);
+#endif
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::vector<int32_t> parseCpuList(std::string const& list)
+{
+    std::vector<int32_t> cpus;
+    for (auto const& range : splitToStringVec(list, ','))
+    {
+        auto const isNumber = [](std::string const& s) {
+            return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return std::isdigit(c) != 0; });
+        };
+        auto const bounds = splitToStringVec(range, '-');
+        if (bounds.empty() || bounds.size() > 2 || !std::all_of(bounds.begin(), bounds.end(), isNumber))
+        {
+            throw std::invalid_argument("Invalid CPU list: " + list);
+        }
+        int32_t const first = std::stoi(bounds.front());
+        int32_t const last = std::stoi(bounds.back());
+        if (last < first)
+        {
+            throw std::invalid_argument("Invalid CPU list: " + list);
+        }
+        for (int32_t cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::string cpuListToString(std::vector<int32_t> const& cpus)
+{
+    std::ostringstream os;
+    char const* sep = "";
+    for (size_t i = 0; i < cpus.size();)
+    {
+        size_t last = i;
+        while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1)
+        {
+            ++last;
+        }
+        os << sep << cpus[i];
+        if (last > i)
+        {
+            os << "-" << cpus[last];
+        }
+        sep = ",";
+        i = last + 1;
+    }
+    return os.str();
+}
+
+std::vector<int32_t> getNumaNodeCpus(int32_t node)
+{
+    if (node < 0)
+    {
+        return {};
+    }
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string list;
+    if (!std::getline(file, list) || list.empty())
+    {
+        return {};
+    }
+    try
+    {
+        return parseCpuList(list);
+    }
+    catch (std::invalid_argument const&)
+    {
+        return {};
+    }
+}
+
+int32_t getPciNumaNode(std::string const& pciBusId)
+{
+    // sysfs names PCI devices in lower case, while CUDA reports the bus id in upper case.
+    std::string name(pciBusId);
+    std::transform(name.begin(), name.end(), name.begin(), [](char c) { return std::tolower(c); });
+    std::ifstream file("/sys/bus/pci/devices/" + name + "/numa_node");
+    int32_t node{-1};
+    if (!(file >> node))
+    {
+        return -1;
+    }
+    // Single-node systems report -1.
+    return node;
+}
+
+std::vector<int32_t> getThreadAffinity()
+{
+    std::vector<int32_t> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
+bool setThreadAffinity(std::vector<int32_t> const& cpus)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : cpus)
+    {
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return !cpus.empty() && sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+bool getThreadUsage(double& cpuMs, int64_t& voluntarySwitches, int64_t& involuntarySwitches)
+{
+#if defined(__linux__)
+    // The thread CPU clock has nanosecond resolution, unlike the tick based times of getrusage.
+    timespec time{};
+    rusage usage{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0 || getrusage(RUSAGE_THREAD, &usage) != 0)
+    {
+        return false;
+    }
+    cpuMs = time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+    voluntarySwitches = usage.ru_nvcsw;
+    involuntarySwitches = usage.ru_nivcsw;
+    return true;
+#else
+    return false;
+#endif
+}
+
+int64_t getResidentSetSize()
+{
+#if defined(__linux__)
+    // The second field of statm is the number of resident pages.
+    std::ifstream statm("/proc/self/statm");
+    int64_t size{0};
+    int64_t resident{0};
+    if (!(statm >> size >> resident))
+    {
+        return 0;
+    }
+    return resident * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
 bool broadcastIOFormats(std::vector<IOFormat> const& formats, size_t nbBindings, bool isInput /*= true*/)
 {
     bool broadcast = formats.size() == 1;
@@ -78,6 +78,119 @@ std::vector<std::string> splitToStringVec(std::string const& option, char separa
 
 bool broadcastIOFormats(std::vector<IOFormat> const& formats, size_t nbBindings, bool isInput = true);
 
+//!
+//! \class MappedFile
+//! \brief Read-only memory mapping of a whole file. Empty if the file cannot be mapped or is empty.
+//!
+//! With copyOnWrite, the pages are also writable and modified pages are private to the process: the file is unchanged.
+//!
+class MappedFile
+{
+public:
+    explicit MappedFile(std::string const& fileName, bool copyOnWrite = false);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    void const* data() const
+    {
+        return mData;
+    }
+
+    size_t size() const
+    {
+        return mSize;
+    }
+
+private:
+    void* mData{nullptr};
+    size_t mSize{0};
+#if defined(_WIN32)
+    void* mMapping{nullptr};
+#endif
+};
+
+//!
+//! \class WeightsFile
+//! \brief Memory-mapped reader of wts v3 weight files, as written by dumpTFWts.py --wtsv3.
+//!
+//! \details A wts v3 file is little-endian and laid out as:
+//!          header: char magic[4] "WTS3", uint32 count, uint32 alignment, uint32 reserved
+//!          index: count WtsIndexEntry records, sorted by the bytes of the names
+//!          names: the names of the tensors, without terminators
+//!          payloads: the tensor data, each starting at a multiple of alignment
+//!          Lookups are binary searches of the index: opening the file reads only the header, and loading a
+//!          tensor touches log2(count) index entries and its own payload. The file is mapped copy-on-write, so
+//!          the returned Weights point into the mapping and may be modified in place, e.g. transposed.
+//!
+class WeightsFile
+{
+public:
+    struct WtsIndexEntry
+    {
+        uint64_t nameOffset;
+        uint64_t dataOffset;
+        uint64_t byteSize;
+        uint32_t nameLength;
+        int32_t type;
+        int32_t nbDims;
+        int32_t dims[nvinfer1::Dims::MAX_DIMS];
+        int32_t reserved;
+    };
+
+    explicit WeightsFile(std::string const& fileName);
+
+    //! Whether the file is a mapped wts v3 file.
+    bool isValid() const
+    {
+        return mCount > 0;
+    }
+
+    //! Weights of a tensor, pointing into the mapping, or {kFLOAT, nullptr, 0} if the file has no such tensor.
+    //! If dims is not null, it receives the shape of the tensor.
+    nvinfer1::Weights getWeights(std::string const& name, nvinfer1::Dims* dims = nullptr) const;
+
+private:
+    //! Index entry of a tensor, nullptr if absent or malformed.
+    WtsIndexEntry const* find(std::string const& name) const;
+
+    MappedFile mFile;
+    uint32_t mCount{0};
+    uint32_t mAlignment{0};
+};
+
+//! Whether path names a directory.
+bool isDirectory(std::string const& path);
+
+//! Paths of the regular files of a directory, sorted by name. Empty if the directory cannot be read.
+std::vector<std::string> listFiles(std::string const& directory);
+
+//! Parse a list of CPUs in the Linux cpulist format, e.g. "0-3,8". Throws std::invalid_argument if malformed.
+std::vector<int32_t> parseCpuList(std::string const& list);
+
+//! Format a list of CPUs in the Linux cpulist format.
+std::string cpuListToString(std::vector<int32_t> const& cpus);
+
+//! CPUs of a NUMA node, empty if the node or the topology is unknown.
+std::vector<int32_t> getNumaNodeCpus(int32_t node);
+
+//! NUMA node of the PCI device with the given bus id, e.g. "0000:3b:00.0", -1 if unknown.
+int32_t getPciNumaNode(std::string const& pciBusId);
+
+//! CPUs the calling thread may run on, empty if unsupported.
+std::vector<int32_t> getThreadAffinity();
+
+//! Restrict the calling thread to cpus. Returns false if unsupported or if the CPUs are not available.
+bool setThreadAffinity(std::vector<int32_t> const& cpus);
+
+//! User and system CPU time in ms and context switches of the calling thread so far. Returns false if unsupported.
+bool getThreadUsage(double& cpuMs, int64_t& voluntarySwitches, int64_t& involuntarySwitches);
+
+//! Resident set size of the process in bytes, 0 if unknown.
+int64_t getResidentSetSize();
+
 int32_t getCudaDriverVersion();
 
 int32_t getCudaRuntimeVersion();
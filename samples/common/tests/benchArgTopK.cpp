@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! benchArgTopK.cpp
+//! Compares the time of samplesCommon::argMagnitudeSort(), argMagnitudeTopK() and argMax() on the rows of a batch of
+//! classifier outputs, over the number of classes. Usage: bench_arg_top_k [iterations]
+//!
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "logger.h"
+#include "testUtils.h"
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.bench_arg_top_k";
+
+constexpr size_t kBATCH{32};
+constexpr size_t kTOP_K{5};
+
+void benchmark(size_t nbClasses, int32_t iterations)
+{
+    std::mt19937 generator(1);
+    std::normal_distribution<float> distribution;
+    std::vector<float> logits(kBATCH * nbClasses);
+    for (auto& logit : logits)
+    {
+        logit = distribution(generator);
+    }
+
+    // Accumulated so that the calls are not optimized away, and checked so that the three agree.
+    size_t sortSum{0};
+    size_t topKSum{0};
+    size_t argMaxSum{0};
+    double const sortMs = samplesTest::meanMilliseconds(
+        [&]() {
+            for (size_t b = 0; b < kBATCH; ++b)
+            {
+                float const* row = logits.data() + b * nbClasses;
+                sortSum += samplesCommon::argMagnitudeSort(row, row + nbClasses)[0];
+            }
+        },
+        iterations);
+    double const topKMs = samplesTest::meanMilliseconds(
+        [&]() {
+            for (size_t b = 0; b < kBATCH; ++b)
+            {
+                float const* row = logits.data() + b * nbClasses;
+                topKSum += samplesCommon::argMagnitudeTopK(row, row + nbClasses, kTOP_K)[0];
+            }
+        },
+        iterations);
+    // argMax() ranks values rather than magnitudes, so it is checked on the magnitudes.
+    std::vector<float> magnitudes(logits.size());
+    std::transform(logits.begin(), logits.end(), magnitudes.begin(), [](float v) { return std::abs(v); });
+    double const argMaxMs = samplesTest::meanMilliseconds(
+        [&]() {
+            for (size_t b = 0; b < kBATCH; ++b)
+            {
+                argMaxSum += samplesCommon::argMax(magnitudes.data() + b * nbClasses, nbClasses);
+            }
+        },
+        iterations);
+    TEST_EXPECT(sortSum == topKSum && topKSum == argMaxSum);
+
+    sample::gLogInfo << "classes " << nbClasses << ": full sort " << sortMs << " ms, top-" << kTOP_K << " " << topKMs
+                     << " ms, argmax " << argMaxMs << " ms" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    int32_t const iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 10;
+    sample::gLogInfo << "Batch " << kBATCH << ", " << iterations << " iterations" << std::endl;
+    for (size_t nbClasses : {1000, 21841, 50257, 250000})
+    {
+        benchmark(nbClasses, iterations);
+    }
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,197 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testArgTopK.cpp
+//! Checks samplesCommon::argMagnitudeTopK() and samplesCommon::argMax() against a full sort and a linear scan, on
+//! inputs with ties, with k at least the sequence length, and with the blocks of samplesCommon::kSCAN_BLOCK elements
+//! that the scans skip or keep.
+//!
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "logger.h"
+#include "testUtils.h"
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_arg_top_k";
+
+//! The indices of the k largest magnitudes, by a stable full sort.
+std::vector<size_t> referenceTopK(std::vector<float> const& values, size_t k)
+{
+    std::vector<size_t> indices(values.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::stable_sort(indices.begin(), indices.end(),
+        [&](size_t i, size_t j) { return std::abs(values[i]) > std::abs(values[j]); });
+    indices.resize(std::min(k, values.size()));
+    return indices;
+}
+
+//! The index of the first largest value, by a linear scan.
+size_t referenceArgMax(std::vector<float> const& values)
+{
+    size_t best{0};
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        best = values[i] > values[best] ? i : best;
+    }
+    return best;
+}
+
+bool expectTopK(std::vector<float> const& values, size_t k)
+{
+    auto const actual = samplesCommon::argMagnitudeTopK(values.begin(), values.end(), k);
+    bool const ok = TEST_EXPECT(actual == referenceTopK(values, k));
+    if (!ok)
+    {
+        sample::gLogError << "n = " << values.size() << ", k = " << k << std::endl;
+    }
+    return ok;
+}
+
+bool expectArgMax(std::vector<float> const& values)
+{
+    bool const ok = TEST_EXPECT(samplesCommon::argMax(values.data(), values.size()) == referenceArgMax(values));
+    if (!ok)
+    {
+        sample::gLogError << "n = " << values.size() << std::endl;
+    }
+    return ok;
+}
+
+//! Few distinct magnitudes of both signs, so that most elements tie with others.
+std::vector<float> valuesWithTies(size_t n, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int32_t> distribution(-4, 4);
+    std::vector<float> values(n);
+    for (auto& value : values)
+    {
+        value = static_cast<float>(distribution(generator));
+    }
+    return values;
+}
+
+void testRandomInputs()
+{
+    size_t constexpr kBLOCK = samplesCommon::kSCAN_BLOCK;
+    uint32_t seed{1};
+    for (size_t n : {size_t{1}, size_t{5}, kBLOCK - 1, kBLOCK, kBLOCK + 1, 3 * kBLOCK, 3 * kBLOCK + 7, size_t{1000}})
+    {
+        for (int32_t trial = 0; trial < 20; ++trial)
+        {
+            auto const values = valuesWithTies(n, seed++);
+            for (size_t k : {size_t{1}, size_t{3}, n / 2, n - 1, n})
+            {
+                expectTopK(values, k);
+            }
+            expectArgMax(values);
+        }
+    }
+}
+
+void testEmptyAndLargeK()
+{
+    std::vector<float> const empty;
+    TEST_EXPECT(samplesCommon::argMagnitudeTopK(empty.begin(), empty.end(), 3).empty());
+    TEST_EXPECT(samplesCommon::argMax(empty.data(), 0) == 0);
+
+    // k of zero, and k at or past the length, which returns every index in order of magnitude.
+    std::vector<float> const values{1.F, -3.F, 2.F, -2.F, 0.F};
+    TEST_EXPECT(samplesCommon::argMagnitudeTopK(values.begin(), values.end(), 0).empty());
+    std::vector<size_t> const all{1, 2, 3, 0, 4};
+    TEST_EXPECT(samplesCommon::argMagnitudeTopK(values.begin(), values.end(), values.size()) == all);
+    TEST_EXPECT(samplesCommon::argMagnitudeTopK(values.begin(), values.end(), values.size() + 10) == all);
+}
+
+void testTies()
+{
+    // Equal magnitudes, whatever their sign, go to the lowest index first.
+    std::vector<float> values(4 * samplesCommon::kSCAN_BLOCK, 1.F);
+    values[7] = -5.F;
+    values[40] = 5.F;
+    values[20] = -5.F;
+    std::vector<size_t> const expected{7, 20, 40, 0, 1};
+    TEST_EXPECT(samplesCommon::argMagnitudeTopK(values.begin(), values.end(), 5) == expected);
+
+    // The first of several maxima, in the blocks and in the tail.
+    std::vector<float> maxima(2 * samplesCommon::kSCAN_BLOCK + 3, 0.F);
+    maxima[2 * samplesCommon::kSCAN_BLOCK + 1] = 2.F;
+    maxima[samplesCommon::kSCAN_BLOCK + 3] = 2.F;
+    maxima[samplesCommon::kSCAN_BLOCK + 9] = 2.F;
+    TEST_EXPECT(samplesCommon::argMax(maxima.data(), maxima.size()) == samplesCommon::kSCAN_BLOCK + 3);
+}
+
+void testBlockSkip()
+{
+    size_t constexpr kBLOCK = samplesCommon::kSCAN_BLOCK;
+    // Decreasing magnitudes: after the first k, every block is skipped.
+    std::vector<float> decreasing(10 * kBLOCK);
+    for (size_t i = 0; i < decreasing.size(); ++i)
+    {
+        decreasing[i] = (i % 2 ? -1.F : 1.F) * static_cast<float>(decreasing.size() - i);
+    }
+    expectTopK(decreasing, 4);
+
+    // Skipped blocks followed by a block holding a single better magnitude, at each position of that block, and in
+    // the partial block at the end.
+    for (size_t position = 6 * kBLOCK; position < 9 * kBLOCK + 5; ++position)
+    {
+        std::vector<float> values(9 * kBLOCK + 5, 0.5F);
+        std::fill_n(values.begin(), 3, 2.F);
+        values[position] = -3.F;
+        if (!expectTopK(values, 3) || !expectArgMax(values))
+        {
+            break;
+        }
+    }
+
+    // A magnitude that equals the worst candidate does not replace it, so the block is skipped.
+    std::vector<float> equal(4 * kBLOCK, 0.F);
+    equal[0] = 1.F;
+    equal[3 * kBLOCK + 2] = -1.F;
+    std::vector<size_t> const expected{0};
+    TEST_EXPECT(samplesCommon::argMagnitudeTopK(equal.begin(), equal.end(), 1) == expected);
+
+    // A maximum that is only in the tail past the last full block, and negative values.
+    std::vector<float> tail(3 * kBLOCK + 4, -7.F);
+    tail[3 * kBLOCK + 2] = -1.F;
+    expectArgMax(tail);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    testRandomInputs();
+    testEmptyAndLargeK();
+    testTies();
+    testBlockSkip();
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,184 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testBuffers.cpp
+//! Checks the pinned host memory pool, and that the host buffers of each BufferManager mode round-trip through an
+//! engine with the expected number of host-device copies.
+//!
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "NvInfer.h"
+#include "buffers.h"
+#include "common.h"
+#include "logger.h"
+#include "testUtils.h"
+
+using samplesCommon::SampleUniquePtr;
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_buffers";
+
+//! 124 floats, so that the bindings are 496 bytes and padded to a 512 byte stride.
+constexpr int32_t kNB_ELEMENTS{124};
+constexpr int32_t kNB_PAIRS{2};
+
+void testMemoryPool()
+{
+    samplesCommon::PinnedHostMemoryPool pool;
+    auto* first = static_cast<char*>(pool.allocate(1000));
+    TEST_EXPECT(first != nullptr);
+    std::memset(first, 0x5A, 1000);
+    pool.deallocate(first);
+    TEST_EXPECT(pool.getCachedBytes() >= 1000);
+
+    // A request of the same size class reuses the freed block.
+    auto* second = static_cast<char*>(pool.allocate(900));
+    TEST_EXPECT(second == first);
+    TEST_EXPECT(pool.getNbAllocations() == 1);
+    TEST_EXPECT(pool.getNbReuses() == 1);
+    TEST_EXPECT(pool.getCachedBytes() == 0);
+    pool.deallocate(second);
+
+    pool.release();
+    TEST_EXPECT(pool.getCachedBytes() == 0);
+    TEST_EXPECT(pool.allocate(0) == nullptr);
+}
+
+//! Build an engine that copies each input "input<i>" to the output "output<i>".
+std::shared_ptr<nvinfer1::ICudaEngine> buildIdentityEngine(nvinfer1::IRuntime& runtime)
+{
+    auto builder = SampleUniquePtr<nvinfer1::IBuilder>(nvinfer1::createInferBuilder(sample::gLogger.getTRTLogger()));
+    auto const flags = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
+    auto network = SampleUniquePtr<nvinfer1::INetworkDefinition>(builder->createNetworkV2(flags));
+    auto config = SampleUniquePtr<nvinfer1::IBuilderConfig>(builder->createBuilderConfig());
+    if (!builder || !network || !config)
+    {
+        return nullptr;
+    }
+    for (int32_t i = 0; i < kNB_PAIRS; ++i)
+    {
+        auto* input = network->addInput(
+            ("input" + std::to_string(i)).c_str(), nvinfer1::DataType::kFLOAT, nvinfer1::Dims2{1, kNB_ELEMENTS});
+        auto* identity = network->addIdentity(*input);
+        identity->getOutput(0)->setName(("output" + std::to_string(i)).c_str());
+        network->markOutput(*identity->getOutput(0));
+    }
+    auto plan = SampleUniquePtr<nvinfer1::IHostMemory>(builder->buildSerializedNetwork(*network, *config));
+    if (!plan)
+    {
+        return nullptr;
+    }
+    return std::shared_ptr<nvinfer1::ICudaEngine>(
+        runtime.deserializeCudaEngine(plan->data(), plan->size()), samplesCommon::InferDeleter());
+}
+
+//! Run the identity engine once on the current host buffer set and check the outputs.
+void roundTrip(samplesCommon::BufferManager& buffers, nvinfer1::IExecutionContext& context, cudaStream_t stream,
+    float offset)
+{
+    for (int32_t i = 0; i < kNB_PAIRS; ++i)
+    {
+        auto* input = static_cast<float*>(buffers.getHostBuffer("input" + std::to_string(i)));
+        auto* output = static_cast<float*>(buffers.getHostBuffer("output" + std::to_string(i)));
+        for (int32_t j = 0; j < kNB_ELEMENTS; ++j)
+        {
+            input[j] = offset + static_cast<float>(i * kNB_ELEMENTS + j);
+        }
+        std::memset(output, 0, kNB_ELEMENTS * sizeof(float));
+    }
+
+    buffers.copyInputToDeviceAsync(stream);
+    TEST_EXPECT(context.enqueueV2(buffers.getDeviceBindings().data(), stream, nullptr));
+    buffers.copyOutputToHostAsync(stream);
+    CHECK(cudaStreamSynchronize(stream));
+
+    for (int32_t i = 0; i < kNB_PAIRS; ++i)
+    {
+        auto const* input = static_cast<float const*>(buffers.getHostBuffer("input" + std::to_string(i)));
+        auto const* output = static_cast<float const*>(buffers.getHostBuffer("output" + std::to_string(i)));
+        TEST_EXPECT_NEAR(output, input, kNB_ELEMENTS, 0.0);
+    }
+}
+
+void testBufferManager(std::shared_ptr<nvinfer1::ICudaEngine> const& engine, cudaStream_t stream)
+{
+    auto context = SampleUniquePtr<nvinfer1::IExecutionContext>(engine->createExecutionContext());
+    TEST_EXPECT(context != nullptr);
+    if (!context)
+    {
+        return;
+    }
+
+    // Pageable buffers are separate allocations: one copy per binding, even if they happen to be equally spaced.
+    {
+        samplesCommon::BufferManager buffers(engine, 0, nullptr, samplesCommon::HostMemoryMode::kPAGEABLE);
+        roundTrip(buffers, *context, stream, 0.F);
+        TEST_EXPECT(buffers.getNbCopies() == 2 * kNB_PAIRS);
+    }
+
+    // Pinned buffers are contiguous per direction: one copy for all the inputs, and one for all the outputs.
+    {
+        samplesCommon::BufferManager buffers(engine, 0, nullptr, samplesCommon::HostMemoryMode::kPINNED);
+        roundTrip(buffers, *context, stream, 1000.F);
+        TEST_EXPECT(buffers.getNbCopies() == 2);
+    }
+
+    // Double-buffered: each set round-trips with coalesced copies, and the sets do not alias.
+    {
+        samplesCommon::BufferManager buffers(
+            engine, 0, nullptr, samplesCommon::HostMemoryMode::kPINNED_DOUBLE_BUFFERED);
+        void const* firstSet = buffers.getHostBuffer("input0");
+        roundTrip(buffers, *context, stream, 2000.F);
+        buffers.swapHostBuffers();
+        TEST_EXPECT(buffers.getHostBuffer("input0") != firstSet);
+        roundTrip(buffers, *context, stream, 3000.F);
+        TEST_EXPECT(buffers.getNbCopies() == 4);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    testMemoryPool();
+
+    auto runtime = SampleUniquePtr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(sample::gLogger.getTRTLogger()));
+    auto engine = runtime ? buildIdentityEngine(*runtime) : nullptr;
+    auto stream = samplesCommon::makeCudaStream();
+    if (!TEST_EXPECT(engine != nullptr && stream != nullptr))
+    {
+        return sample::gLogger.reportFail(test);
+    }
+    testBufferManager(engine, *stream);
+
+    // The buffers are destroyed, so every pinned block is cached. Free them while CUDA is still up.
+    TEST_EXPECT(samplesCommon::getPinnedHostMemoryPool().getCachedBytes() > 0);
+    samplesCommon::releasePinnedHostMemoryPool();
+    TEST_EXPECT(samplesCommon::getPinnedHostMemoryPool().getCachedBytes() == 0);
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testContextPool.cpp
+//! Checks the least recently used eviction and the memory budget of the contexts of a ContextPool, through the
+//! ContextSlots bookkeeping that it delegates to, with fake engines in place of InferenceEnvironment.
+//!
+
+#include <string>
+#include <vector>
+
+#include "logger.h"
+#include "sampleContextSlots.h"
+#include "testUtils.h"
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_context_pool";
+
+//! Stands in for an InferenceEnvironment: records the stream indices whose context was freed.
+struct FakeEngine
+{
+    std::vector<int32_t> freed;
+};
+
+using Slots = sample::ContextSlots<FakeEngine>;
+
+//! Frees the context of an evicted slot like ContextPool does.
+void freeContext(Slots::Slot const& slot)
+{
+    slot.owner->freed.push_back(slot.streamIdx);
+}
+
+void testNoBudget()
+{
+    FakeEngine engine;
+    Slots slots;
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        TEST_EXPECT(slots.acquire("context" + std::to_string(i)) == nullptr);
+        slots.add(&engine, "context" + std::to_string(i), i, 1000, freeContext);
+        slots.release(&engine, i, freeContext);
+    }
+    TEST_EXPECT(slots.getSlots().size() == 4);
+    TEST_EXPECT(slots.getMemoryUsage() == 4000);
+    TEST_EXPECT(slots.getNbEvictions() == 0);
+    TEST_EXPECT(engine.freed.empty());
+}
+
+void testReuse()
+{
+    FakeEngine engine;
+    Slots slots(1000);
+    TEST_EXPECT(slots.acquire("a") == nullptr);
+    slots.add(&engine, "a", 0, 100, freeContext);
+    // A leased slot is not handed out twice.
+    TEST_EXPECT(slots.acquire("a") == nullptr);
+    slots.release(&engine, 0, freeContext);
+    auto const* slot = slots.acquire("a");
+    if (TEST_EXPECT(slot != nullptr))
+    {
+        TEST_EXPECT(slot->streamIdx == 0 && slot->inUse);
+    }
+    TEST_EXPECT(slots.acquire("b") == nullptr);
+    TEST_EXPECT(slots.getSlots().size() == 1);
+}
+
+void testLruEviction()
+{
+    FakeEngine engine;
+    Slots slots(300);
+    for (int32_t i = 0; i < 3; ++i)
+    {
+        std::string const key(1, static_cast<char>('a' + i));
+        slots.acquire(key);
+        slots.add(&engine, key, i, 100, freeContext);
+        slots.release(&engine, i, freeContext);
+    }
+    TEST_EXPECT(slots.getMemoryUsage() == 300);
+    TEST_EXPECT(slots.getNbEvictions() == 0);
+
+    // Using a makes b the least recently used slot.
+    TEST_EXPECT(slots.acquire("a") != nullptr);
+    slots.release(&engine, 0, freeContext);
+
+    // d needs one more slot of memory: b is evicted, and its stream index reused.
+    TEST_EXPECT(slots.acquire("d") == nullptr);
+    slots.add(&engine, "d", 1, 100, freeContext);
+    TEST_EXPECT(engine.freed == std::vector<int32_t>{1});
+    TEST_EXPECT(slots.getNbEvictions() == 1);
+    TEST_EXPECT(slots.getMemoryUsage() == 300);
+
+    // e needs two slots of memory while d is leased: c then a are evicted.
+    TEST_EXPECT(slots.acquire("e") == nullptr);
+    slots.add(&engine, "e", 0, 200, freeContext);
+    TEST_EXPECT((engine.freed == std::vector<int32_t>{1, 2, 0}));
+    TEST_EXPECT(slots.getNbEvictions() == 3);
+    TEST_EXPECT(slots.getMemoryUsage() == 300);
+    TEST_EXPECT(slots.getPeakMemoryUsage() == 300);
+    TEST_EXPECT(slots.acquire("a") == nullptr);
+    TEST_EXPECT(slots.acquire("c") == nullptr);
+}
+
+void testBudgetExceededWhileInUse()
+{
+    FakeEngine first;
+    FakeEngine second;
+    Slots slots(150);
+    slots.acquire("a");
+    slots.add(&first, "a", 0, 100, freeContext);
+    // Every slot is leased, so the pool goes over its budget instead of evicting.
+    slots.acquire("b");
+    slots.add(&second, "b", 0, 100, freeContext);
+    TEST_EXPECT(slots.getMemoryUsage() == 200);
+    TEST_EXPECT(slots.getPeakMemoryUsage() == 200);
+    TEST_EXPECT(slots.getNbEvictions() == 0);
+
+    // Releasing a slot brings the pool back within its budget. Slots of different owners with the same stream index
+    // are told apart.
+    slots.release(&second, 0, freeContext);
+    TEST_EXPECT(second.freed == std::vector<int32_t>{0});
+    TEST_EXPECT(first.freed.empty());
+    TEST_EXPECT(slots.getMemoryUsage() == 100);
+    TEST_EXPECT(slots.getNbEvictions() == 1);
+
+    // A slot larger than the budget evicts everything idle, then is kept while it is leased.
+    slots.release(&first, 0, freeContext);
+    TEST_EXPECT(first.freed.empty());
+    slots.acquire("c");
+    slots.add(&first, "c", 1, 400, freeContext);
+    TEST_EXPECT(first.freed == std::vector<int32_t>{0});
+    TEST_EXPECT(slots.getMemoryUsage() == 400);
+    slots.release(&first, 1, freeContext);
+    TEST_EXPECT(slots.getMemoryUsage() == 0);
+    TEST_EXPECT(slots.getSlots().empty());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    testNoBudget();
+    testReuse();
+    testLruEviction();
+    testBudgetExceededWhileInUse();
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
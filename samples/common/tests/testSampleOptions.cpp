@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testSampleOptions.cpp
+//! Checks how the --buildVariant options of trtexec are parsed into the build options of each variant.
+//!
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "logger.h"
+#include "sampleOptions.h"
+#include "testUtils.h"
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_sample_options";
+
+//! Parses a trtexec command line, returning whether it was accepted.
+bool parse(std::vector<char const*> argv, sample::AllOptions& options)
+{
+    argv.insert(argv.begin(), "trtexec");
+    auto arguments = sample::argsToArgumentsMap(static_cast<int32_t>(argv.size()), const_cast<char**>(argv.data()));
+    try
+    {
+        options.parse(arguments);
+        return true;
+    }
+    catch (std::invalid_argument const& e)
+    {
+        sample::gLogInfo << "Rejected: " << e.what() << std::endl;
+    }
+    return false;
+}
+
+void testVariantOptions()
+{
+    sample::AllOptions options;
+    bool const parsed = parse({"--onnx=model.onnx", "--timingCacheFile=model.cache",
+                                  "--buildVariant=--saveEngine=model_fp32.plan",
+                                  "--buildVariant=--fp16 --saveEngine=model_fp16.plan"},
+        options);
+    if (!TEST_EXPECT(parsed && options.buildVariants.size() == 2))
+    {
+        return;
+    }
+    // The variants inherit the options of the command line that they do not set.
+    for (auto const& variant : options.buildVariants)
+    {
+        TEST_EXPECT(variant.timingCacheMode == sample::TimingCacheMode::kGLOBAL);
+        TEST_EXPECT(variant.timingCacheFile == "model.cache");
+    }
+    TEST_EXPECT(options.buildVariants[0].engine == "model_fp32.plan");
+    TEST_EXPECT(options.buildVariants[1].engine == "model_fp16.plan");
+}
+
+void testInvalidVariants()
+{
+    sample::AllOptions sharedEngine;
+    TEST_EXPECT(!parse({"--onnx=model.onnx", "--buildVariant=--saveEngine=model.plan",
+                           "--buildVariant=--fp16 --saveEngine=model.plan"},
+        sharedEngine));
+
+    // The variants share one timing cache, so they cannot name different files.
+    sample::AllOptions cacheFiles;
+    TEST_EXPECT(!parse({"--onnx=model.onnx", "--timingCacheFile=a.cache", "--buildVariant=--saveEngine=a.plan",
+                           "--buildVariant=--saveEngine=b.plan --timingCacheFile=b.cache"},
+        cacheFiles));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    testVariantOptions();
+    testInvalidVariants();
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
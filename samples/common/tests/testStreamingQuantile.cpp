@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//!
+//! testStreamingQuantile.cpp
+//! Checks the P-square estimates of StreamingQuantile, used by --streamingProfile, against the exact quantiles of
+//! samples of known distributions.
+//!
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "logger.h"
+// sampleReporting.h needs the declarations of sampleInference.h first.
+#include "sampleInference.h"
+#include "sampleReporting.h"
+#include "testUtils.h"
+
+namespace
+{
+
+std::string const gTestName = "TensorRT.test_streaming_quantile";
+
+constexpr int32_t kNB_SAMPLES{20000};
+
+//! The quantile of sorted values, interpolated between the closest ranks like StreamingQuantile::get().
+float exactQuantile(std::vector<float> const& sorted, float quantile)
+{
+    float const rank = quantile * (sorted.size() - 1);
+    size_t const lower = static_cast<size_t>(rank);
+    size_t const upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (rank - lower) * (sorted[upper] - sorted[lower]);
+}
+
+//! Adds the values to an estimator of each quantile, and compares the estimates with the exact quantiles. The error
+//! is relative to the interquartile range of the values, so that it does not depend on their scale. The few samples
+//! in the tail make the estimates of extreme quantiles less accurate.
+void checkQuantiles(std::string const& distribution, std::vector<float> const& values)
+{
+    std::vector<float> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    float const scale = exactQuantile(sorted, 0.75F) - exactQuantile(sorted, 0.25F);
+    for (float const quantile : {0.1F, 0.5F, 0.9F, 0.99F})
+    {
+        sample::StreamingQuantile estimator(quantile);
+        for (float const value : values)
+        {
+            estimator.add(value);
+        }
+        float const exact = exactQuantile(sorted, quantile);
+        float const error = std::abs(estimator.get() - exact) / scale;
+        float const tolerance = quantile > 0.95F ? 0.1F : 0.02F;
+        sample::gLogInfo << distribution << " p" << quantile * 100 << ": estimated " << estimator.get() << ", exact "
+                         << exact << ", error " << error * 100 << "% of the interquartile range" << std::endl;
+        TEST_EXPECT(error <= tolerance);
+    }
+}
+
+void testDistributions()
+{
+    std::mt19937 generator(42);
+    std::vector<float> uniform(kNB_SAMPLES);
+    std::vector<float> normal(kNB_SAMPLES);
+    std::vector<float> exponential(kNB_SAMPLES);
+    // Layer times: mostly around a mode, with a long tail.
+    std::vector<float> lognormal(kNB_SAMPLES);
+    std::uniform_real_distribution<float> uniformDistribution(1.F, 2.F);
+    std::normal_distribution<float> normalDistribution(5.F, 0.5F);
+    std::exponential_distribution<float> exponentialDistribution(2.F);
+    std::lognormal_distribution<float> lognormalDistribution(-2.F, 0.5F);
+    for (int32_t i = 0; i < kNB_SAMPLES; ++i)
+    {
+        uniform[i] = uniformDistribution(generator);
+        normal[i] = normalDistribution(generator);
+        exponential[i] = exponentialDistribution(generator);
+        lognormal[i] = lognormalDistribution(generator);
+    }
+    checkQuantiles("uniform", uniform);
+    checkQuantiles("normal", normal);
+    checkQuantiles("exponential", exponential);
+    checkQuantiles("lognormal", lognormal);
+}
+
+void testFewValues()
+{
+    // Below five values the quantile is exact.
+    sample::StreamingQuantile median;
+    TEST_EXPECT(median.get() == 0.F);
+    median.add(3.F);
+    TEST_EXPECT(median.get() == 3.F);
+    median.add(1.F);
+    TEST_EXPECT(median.get() == 2.F);
+    median.add(2.F);
+    TEST_EXPECT(median.get() == 2.F);
+
+    sample::StreamingQuantile p75(0.75F);
+    for (float const value : {4.F, 1.F, 3.F, 2.F})
+    {
+        p75.add(value);
+    }
+    TEST_EXPECT(p75.get() == 3.25F);
+}
+
+void testConstant()
+{
+    sample::StreamingQuantile median;
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        median.add(0.125F);
+    }
+    TEST_EXPECT(median.get() == 0.125F);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto test = sample::gLogger.defineTest(gTestName, argc, argv);
+    sample::gLogger.reportTestStart(test);
+
+    testFewValues();
+    testConstant();
+    testDistributions();
+
+    return sample::gLogger.reportTest(test, samplesTest::getNbFailures() == 0);
+}
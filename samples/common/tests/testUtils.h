@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_SAMPLES_TEST_UTILS_H
+#define TRT_SAMPLES_TEST_UTILS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "logger.h"
+
+//!
+//! \file testUtils.h
+//! \brief Checks shared by the sample and plugin tests. Failed checks are logged and counted, and the test reports
+//!        its result with sample::gLogger.reportTest(), like the samples.
+//!
+
+namespace samplesTest
+{
+
+//! Returns the number of failed checks so far.
+inline int32_t& getNbFailures()
+{
+    static int32_t nbFailures{0};
+    return nbFailures;
+}
+
+//! Count and log a failed check.
+inline bool expect(bool condition, char const* what, char const* file, int32_t line)
+{
+    if (!condition)
+    {
+        ++getNbFailures();
+        sample::gLogError << file << ":" << line << ": check failed: " << what << std::endl;
+    }
+    return condition;
+}
+
+//!
+//! \brief Compare two arrays elementwise, with an absolute and a relative tolerance.
+//!        Logs the first mismatch and returns whether all the elements match.
+//!
+template <typename T>
+bool expectNear(T const* actual, T const* expected, size_t count, double tolerance, char const* what, char const* file,
+    int32_t line)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        double const a = static_cast<double>(actual[i]);
+        double const e = static_cast<double>(expected[i]);
+        if (std::abs(a - e) > tolerance * std::max(1.0, std::abs(e)))
+        {
+            ++getNbFailures();
+            sample::gLogError << file << ":" << line << ": " << what << "[" << i << "] is " << a << ", expected " << e
+                              << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+//! The mean wall clock time of func in milliseconds over iterations calls, after one call to warm up. Used by the
+//! benchmarks, which are built with the tests but not run by ctest.
+template <typename Func>
+double meanMilliseconds(Func&& func, int32_t iterations)
+{
+    func();
+    auto const start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < iterations; ++i)
+    {
+        func();
+    }
+    std::chrono::duration<double, std::milli> const elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / std::max(iterations, 1);
+}
+
+} // namespace samplesTest
+
+#define TEST_EXPECT(condition) samplesTest::expect((condition), #condition, __FILE__, __LINE__)
+
+#define TEST_EXPECT_NEAR(actual, expected, count, tolerance)                                                          \
+    samplesTest::expectNear((actual), (expected), (count), (tolerance), #actual, __FILE__, __LINE__)
+
+#endif // TRT_SAMPLES_TEST_UTILS_H
@@ -568,11 +568,9 @@ bool SampleAlgorithmSelector::verifyOutput(
 
     std::for_each(prob, prob + kDIGITS, [sum](float& n) { n = n / sum; });
 
-    auto max_ele = std::max_element(prob, prob + kDIGITS);
+    int32_t const idx = static_cast<int32_t>(samplesCommon::argMax(prob, kDIGITS));
 
-    float const val = *max_ele;
-
-    int32_t const idx = max_ele - prob;
+    float const val = prob[idx];
 
     // Print histogram of the output probability distribution.
     sample::gLogInfo << "Output:\n";
@@ -49,6 +49,7 @@
 #include "cuda_runtime_api.h"
 #include "logger.h"
 #include "sampleEngines.h"
+#include "sampleUtils.h"
 using namespace nvinfer1;
 using samplesCommon::SampleUniquePtr;
 
@@ -187,6 +188,7 @@ protected:
 
     std::map<std::string, nvinfer1::Weights> mWeightMap;
     std::vector<std::unique_ptr<samplesCommon::HostMemory>> weightsMemory;
+    std::unique_ptr<sample::WeightsFile> mWeightsFile;
     SampleCharRNNParams mParams;
 
     nvinfer1::ITensor* addReshape(
@@ -361,10 +363,32 @@ bool SampleCharRNNBase::build()
 //!        for each buffer: [name] [type] [shape] <data as binary blob>\n
 //!        Note: type is the integer value of the DataType enum in NvInfer.h.
 //!
+//!        Weight V3 files are indexed and memory-mapped, see sample::WeightsFile. The requested
+//!        weights are looked up in the index and point into the mapping, without copies.
+//!
 std::map<std::string, nvinfer1::Weights> SampleCharRNNBase::loadWeights(const std::string file)
 {
     std::map<std::string, nvinfer1::Weights> weightMap;
 
+    mWeightsFile.reset(new sample::WeightsFile(file));
+    if (mWeightsFile->isValid())
+    {
+        for (auto it = mParams.weightNames.names.begin(); it != mParams.weightNames.names.end();)
+        {
+            nvinfer1::Weights const wt = mWeightsFile->getWeights(*it);
+            if (wt.values == nullptr)
+            {
+                ++it;
+                continue;
+            }
+            weightMap[*it] = wt;
+            it = mParams.weightNames.names.erase(it);
+        }
+        sample::gLogInfo << "Done mapping weights from file..." << std::endl;
+        return weightMap;
+    }
+    mWeightsFile.reset();
+
     std::ifstream input(file, std::ios_base::binary);
     ASSERT(input.is_open() && "Unable to load weight file.");
 
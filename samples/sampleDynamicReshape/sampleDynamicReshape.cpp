@@ -473,7 +473,7 @@ bool SampleDynamicReshape::validateOutput(int digit)
         ++curIndex;
     }
 
-    int predictedDigit = std::max_element(prob.begin(), prob.end()) - prob.begin();
+    int predictedDigit = static_cast<int>(samplesCommon::argMax(prob.data(), prob.size()));
     return digit == predictedDigit;
 }
 
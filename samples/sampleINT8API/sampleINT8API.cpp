@@ -464,8 +464,6 @@ bool SampleINT8API::verifyOutput(const samplesCommon::BufferManager& buffers) co
     const float* probPtr = static_cast<const float*>(buffers.getHostBuffer(mInOut.at("output")));
     std::vector<float> output(probPtr, probPtr + mOutputDims.d[1]);
 
-    auto inds = samplesCommon::argMagnitudeSort(output.cbegin(), output.cend());
-
     // read reference lables to generate prediction lables
     std::vector<std::string> referenceVector;
     if (!samplesCommon::readReferenceFile(mParams.referenceFileName, referenceVector))
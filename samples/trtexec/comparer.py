@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: Copyright (c) 1993-2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""
+Compare trtexec timing traces and profiles from JSON files
+
+Given a reference and one or more target timing traces, as written
+by --exportTimes, this program prints for each target the difference
+of the mean, median and p99 of a metric, with bootstrap confidence
+intervals. Given the matching profiles, as written by --exportProfile,
+it also prints the per-layer differences of the average time, ranked
+by their contribution to the reference time.
+
+The exit code is 1 if a target regresses beyond the thresholds: the
+lower bound of the confidence interval of a gated statistic is more
+than the threshold above the reference, or a layer adds more than
+the layer threshold to the reference time. It is 0 otherwise.
+"""
+
+import sys
+import json
+import random
+import argparse
+import prn_utils as pu
+
+
+allMetrics = ["latencyMs", "computeMs", "h2dMs", "d2hMs"]
+
+allStatistics = ["mean", "median", "p99"]
+
+statisticsHeader = ["target", "statistic", "reference", "value", "difference", "ciLow", "ciHigh", "% difference",
+                    "verdict"]
+
+layersHeader = ["target", "name", "refAverageMs", "averageMs", "differenceMs", "% contribution", "verdict"]
+
+
+def mean(values):
+    """Mean of a sequence"""
+
+    return sum(values) / len(values)
+
+
+def median(values):
+    """Median of a sorted sequence"""
+
+    m = len(values) // 2
+    if len(values) % 2:
+        return values[m]
+    return (values[m - 1] + values[m]) / 2
+
+
+def percentile(p, values):
+    """Percentile of a sorted sequence, as computed by trtexec"""
+
+    exclude = int((1 - p / 100) * len(values))
+    return values[max(len(values) - 1 - exclude, 0)]
+
+
+def statistic(name, values):
+    """Compute a named statistic of a sorted sequence"""
+
+    if name == "mean":
+        return mean(values)
+    if name == "median":
+        return median(values)
+    return percentile(float(name[1:]), values)
+
+
+def loadTrace(name, metric):
+    """Load the values of one metric from a timing trace"""
+
+    with open(name) as f:
+        trace = json.load(f)
+    values = sorted(t[metric] for t in trace if metric in t)
+    if not values:
+        raise ValueError("{} has no {} values".format(name, metric))
+    return values
+
+
+def loadProfile(name):
+    """Load a profile as a dictionary of average layer times"""
+
+    with open(name) as f:
+        profile = json.load(f)
+    return {layer["name"]: layer["averageMs"] for layer in profile[1:]}
+
+
+def bootstrap(reference, target, statistics, resamples, confidence, rng):
+    """Confidence intervals of the differences of statistics, by resampling both traces"""
+
+    differences = {s: [] for s in statistics}
+    for _ in range(resamples):
+        ref = sorted(rng.choices(reference, k=len(reference)))
+        tgt = sorted(rng.choices(target, k=len(target)))
+        for s in statistics:
+            differences[s].append(statistic(s, tgt) - statistic(s, ref))
+
+    tail = (100 - confidence) / 2
+    intervals = {}
+    for s in statistics:
+        d = sorted(differences[s])
+        intervals[s] = (d[int(tail / 100 * (len(d) - 1))], d[int((1 - tail / 100) * (len(d) - 1))])
+    return intervals
+
+
+def compareTraces(targetName, reference, target, gates, threshold, resamples, confidence, rng):
+    """Compare the statistics of two traces, returning the table rows and whether the target regresses"""
+
+    rows = []
+    regression = False
+    intervals = bootstrap(reference, target, allStatistics, resamples, confidence, rng)
+    for s in allStatistics:
+        ref = statistic(s, reference)
+        tgt = statistic(s, target)
+        low, high = intervals[s]
+        verdict = "unchanged"
+        if low > 0:
+            verdict = "slower"
+        elif high < 0:
+            verdict = "faster"
+        if s in gates and ref > 0 and low / ref * 100 > threshold:
+            verdict = "regression"
+            regression = True
+        diff = (tgt / ref - 1) * 100 if ref > 0 else 0
+        rows.append([targetName, s, ref, tgt, tgt - ref, low, high, diff, verdict])
+    return rows, regression
+
+
+def compareProfiles(targetName, reference, profile, layerThreshold):
+    """Compare the average layer times of two profiles, ranked by contribution to the reference time"""
+
+    total = sum(reference.values())
+    rows = []
+    regression = False
+    for name in list(reference) + [n for n in profile if n not in reference]:
+        ref = reference.get(name, 0)
+        tgt = profile.get(name, 0)
+        contribution = (tgt - ref) / total * 100 if total > 0 else 0
+        verdict = ""
+        if name not in profile:
+            verdict = "removed"
+        elif name not in reference:
+            verdict = "added"
+        if layerThreshold is not None and contribution > layerThreshold:
+            verdict = "regression"
+            regression = True
+        rows.append([targetName, name, ref, tgt, tgt - ref, contribution, verdict])
+    rows.sort(key=lambda r: r[5], reverse=True)
+    return rows, regression
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument(
+        "--metric",
+        default="latencyMs",
+        choices=allMetrics,
+        help="Metric of the timing traces to compare (default: latencyMs).",
+    )
+    parser.add_argument(
+        "--gate",
+        metavar="S[,S]*",
+        default=",".join(allStatistics),
+        help="Comma separated list of statistics checked against the threshold. Statistics are: "
+        + ", ".join(allStatistics)
+        + ".",
+    )
+    parser.add_argument(
+        "--threshold",
+        metavar="T",
+        default=5.0,
+        type=float,
+        help="Regression threshold, in percent of the reference statistic (default: 5).",
+    )
+    parser.add_argument(
+        "--layer-threshold",
+        metavar="T",
+        default=None,
+        type=float,
+        help="Layer regression threshold, in percent of the total reference layer time (default: disabled).",
+    )
+    parser.add_argument(
+        "--confidence", metavar="C", default=95.0, type=float, help="Confidence level in percent (default: 95)."
+    )
+    parser.add_argument(
+        "--resamples", metavar="N", default=1000, type=int, help="Number of bootstrap resamples (default: 1000)."
+    )
+    parser.add_argument("--seed", metavar="S", default=0, type=int, help="Seed of the bootstrap resampling.")
+    parser.add_argument(
+        "--profiles",
+        metavar="P",
+        nargs="+",
+        help="Profile files, in the same order as the timing trace files.",
+    )
+    parser.add_argument("--no-header", action="store_true", help="Omit the header rows.")
+    parser.add_argument("reference", metavar="reference", help="Reference timing trace file.")
+    parser.add_argument("targets", metavar="target", nargs="+", help="Target timing trace files.")
+    args = parser.parse_args()
+
+    gates = args.gate.split(",")
+    for g in gates:
+        if not g in allStatistics:
+            parser.error("Statistic {} not recognized".format(g))
+    if not 0 < args.confidence < 100:
+        parser.error("Confidence must be in (0, 100)")
+    if args.resamples < 1:
+        parser.error("Number of resamples must be positive")
+    if args.profiles and len(args.profiles) != len(args.targets) + 1:
+        parser.error("Expected one profile per timing trace")
+
+    rng = random.Random(args.seed)
+    regression = False
+
+    reference = loadTrace(args.reference, args.metric)
+    rows = []
+    for name in args.targets:
+        targetRows, targetRegression = compareTraces(
+            name,
+            reference,
+            loadTrace(name, args.metric),
+            gates,
+            args.threshold,
+            args.resamples,
+            args.confidence,
+            rng,
+        )
+        rows += targetRows
+        regression = regression or targetRegression
+
+    if not args.no_header:
+        print("reference: {} - metric: {} - confidence: {}%".format(args.reference, args.metric, args.confidence))
+        pu.printHeader(statisticsHeader, statisticsHeader)
+    pu.printCsv(rows)
+
+    if args.profiles:
+        referenceProfile = loadProfile(args.profiles[0])
+        rows = []
+        for name, profileName in zip(args.targets, args.profiles[1:]):
+            targetRows, targetRegression = compareProfiles(
+                name, referenceProfile, loadProfile(profileName), args.layer_threshold
+            )
+            rows += targetRows
+            regression = regression or targetRegression
+
+        if not args.no_header:
+            print("")
+            pu.printHeader(layersHeader, layersHeader)
+        pu.printCsv(rows)
+
+    return 1 if regression else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
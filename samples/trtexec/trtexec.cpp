@@ -390,6 +390,46 @@ int main(int argc, char** argv)
             options.build.consistency = false;
         }
 
+        // Build variants only, in place of the engine of the command line.
+        if (!options.buildVariants.empty())
+        {
+            std::vector<VariantBuildResult> results;
+            time_point const variantsStartTime{std::chrono::high_resolution_clock::now()};
+            bool const variantsPass = buildVariants(options.model, options.buildVariants, options.system,
+                options.build.buildWorkers, results, sample::gLogError);
+            time_point const variantsEndTime{std::chrono::high_resolution_clock::now()};
+            printBuildVariantsReport(results, sample::gLogInfo);
+            sample::gLogInfo << "Variants built in " << duration(variantsEndTime - variantsStartTime).count()
+                             << " sec." << std::endl;
+            return variantsPass ? sample::gLogger.reportPass(sampleTest) : sample::gLogger.reportFail(sampleTest);
+        }
+
+        // Run the tasks only, in place of the model of the command line.
+        if (!options.tasks.empty())
+        {
+            std::vector<std::vector<InferenceTrace>> traces;
+            ContextPoolStatistics poolStatistics;
+            sample::gLogInfo << "Starting tasks" << std::endl;
+            bool const tasksPass = runPooledTasks(options.tasks, options.inference, traces, poolStatistics);
+            for (size_t t = 0; t < options.tasks.size(); ++t)
+            {
+                sample::gLogInfo << std::endl
+                                 << "=== Task " << t << ": " << options.tasks[t].engine << " ===" << std::endl;
+                if (!traces[t].empty())
+                {
+                    printPerformanceReport(traces[t], options.reporting,
+                        getTaskInferenceOptions(options.inference, options.tasks[t]), sample::gLogInfo,
+                        sample::gLogWarning, sample::gLogVerbose);
+                }
+            }
+            printContextPoolReport(poolStatistics, sample::gLogInfo);
+            if (!tasksPass)
+            {
+                sample::gLogError << "Error occurred during task inference" << std::endl;
+            }
+            return tasksPass ? sample::gLogger.reportPass(sampleTest) : sample::gLogger.reportFail(sampleTest);
+        }
+
         // Start engine building phase.
         std::unique_ptr<BuildEnvironment> bEnv(new BuildEnvironment(options.build.safe, options.build.versionCompatible,
             options.system.DLACore, options.build.tempdir, options.build.tempfileControls, options.build.leanDLLPath));
@@ -469,19 +509,47 @@ int main(int argc, char** argv)
             return sample::gLogger.reportFail(sampleTest);
         }
 
-        bool const profilerEnabled = options.reporting.profile || !options.reporting.exportProfile.empty();
+        bool const profilerEnabled = options.reporting.profile || !options.reporting.exportProfile.empty()
+            || !options.reporting.exportProfileTrace.empty();
+        int32_t const profileTraceSampling
+            = options.reporting.exportProfileTrace.empty() ? 0 : options.reporting.profileTraceSampling;
 
         if (iEnv->safe && profilerEnabled)
         {
-            sample::gLogError << "Safe runtime does not support --dumpProfile or --exportProfile=<file>, please use "
+            sample::gLogError << "Safe runtime does not support --dumpProfile, --exportProfile=<file> or "
+                                 "--exportProfileTrace=<file>, please use "
                                  "--verbose to print profiling info."
                               << std::endl;
             return sample::gLogger.reportFail(sampleTest);
         }
 
+        if (options.inference.autotuneLatency != autotuneDisabled)
+        {
+            if (profilerEnabled)
+            {
+                sample::gLogError << "--autotune cannot be used with --dumpProfile, --exportProfile=<file> or "
+                                     "--exportProfileTrace=<file>."
+                                  << std::endl;
+                return sample::gLogger.reportFail(sampleTest);
+            }
+            sample::gLogInfo << "Starting autotuning" << std::endl;
+            AutotuneResult result;
+            if (!runAutotune(options.inference, options.system, *iEnv, result))
+            {
+                sample::gLogError << "Error occurred during autotuning" << std::endl;
+                return sample::gLogger.reportFail(sampleTest);
+            }
+            printAutotuneReport(result, sample::gLogInfo);
+            if (!options.reporting.exportAutotune.empty())
+            {
+                exportJSONAutotune(result, options.reporting.exportAutotune);
+            }
+            return sample::gLogger.reportPass(sampleTest);
+        }
+
         if (profilerEnabled && !options.inference.rerun)
         {
-            iEnv->profiler.reset(new Profiler);
+            iEnv->profiler.reset(new Profiler(options.reporting.streamingProfile, profileTraceSampling));
             if (options.inference.graph && (getCudaDriverVersion() < 11010 || getCudaRuntimeVersion() < 11000))
             {
                 options.inference.graph = false;
@@ -512,6 +580,12 @@ int main(int argc, char** argv)
             return sample::gLogger.reportFail(sampleTest);
         }
 
+        printHostPlacement(iEnv->placement, sample::gLogInfo);
+        if (options.inference.graph && !options.inference.shapeSequence.empty())
+        {
+            printGraphCacheReport(iEnv->graphCacheStatistics, sample::gLogInfo);
+        }
+
         if (profilerEnabled && !options.inference.rerun)
         {
             sample::gLogInfo << "The e2e network timing is not reported since it is inaccurate due to the extra "
@@ -523,14 +597,14 @@ int main(int argc, char** argv)
         else
         {
             printPerformanceReport(trace, options.reporting, options.inference, sample::gLogInfo, sample::gLogWarning,
-                sample::gLogVerbose);
+                sample::gLogVerbose, iEnv->hostUsage);
         }
 
         printOutput(options.reporting, *iEnv, options.inference.batch);
 
         if (profilerEnabled && options.inference.rerun)
         {
-            auto* profiler = new Profiler;
+            auto* profiler = new Profiler(options.reporting.streamingProfile, profileTraceSampling);
             iEnv->profiler.reset(profiler);
             iEnv->contexts.front()->setProfiler(profiler);
             iEnv->contexts.front()->setEnqueueEmitsProfile(false);